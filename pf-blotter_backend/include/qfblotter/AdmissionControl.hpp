@@ -0,0 +1,124 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace qfblotter {
+
+// Admission control for order entry (HTTP and FIX). At most maxInFlight
+// requests are processed at once; the rest wait for a slot, and a freed slot
+// goes to a waiting cancel before any new order. New orders are shed, with a
+// retry hint, instead of queueing without bound when
+//   - a downstream queue (event publisher, drop copy, audit writer, ...) is
+//     deeper than its limit,
+//   - the wait for a slot, estimated from the recent per-request processing
+//     latency, would exceed maxQueueWait, or too many are already waiting,
+//   - or a slot did not free up within maxQueueWait.
+// Cancels reduce risk, so they are only shed once a queue is past
+// cancelHeadroom times its limit or no slot frees up within the longer
+// maxCancelWait. Callers that must not block at all (the FIX acceptor
+// thread) use tryAdmit, which sheds instead of waiting.
+class AdmissionControl {
+public:
+    enum class Priority { CANCEL, NEW_ORDER };
+
+    struct Options {
+        size_t maxInFlight{4};
+        size_t maxQueued{64};                       // New orders waiting for a slot
+        std::chrono::milliseconds maxQueueWait{50};
+        std::chrono::milliseconds maxCancelWait{500};
+        double cancelHeadroom{4.0};
+        std::chrono::milliseconds minRetryAfter{100};
+        double latencyAlpha{0.1};                   // EWMA weight of the newest sample
+    };
+
+    // Held while the request is processed; destroying it frees the slot and
+    // records the processing latency. A rejected ticket carries the retry hint.
+    class Ticket {
+    public:
+        Ticket() = default;
+        Ticket(Ticket&& other) noexcept;
+        Ticket& operator=(Ticket&& other) noexcept;
+        Ticket(const Ticket&) = delete;
+        Ticket& operator=(const Ticket&) = delete;
+        ~Ticket();
+
+        explicit operator bool() const { return admitted_; }
+        int64_t retryAfterMs() const { return retryAfterMs_; }
+        const char* reason() const { return reason_; }
+        void release();
+
+    private:
+        friend class AdmissionControl;
+        AdmissionControl* owner_{nullptr};
+        bool admitted_{false};
+        int64_t retryAfterMs_{0};
+        const char* reason_{""};
+        std::chrono::steady_clock::time_point start_{};
+    };
+
+    struct Stats {
+        uint64_t admitted{0};
+        uint64_t shedNewOrders{0};
+        uint64_t shedCancels{0};
+        size_t inFlight{0};
+        size_t queued{0};
+        int64_t latencyEwmaUs{0};
+        std::string saturatedQueue;  // Queue over its limit at the last check
+    };
+
+    AdmissionControl();
+    explicit AdmissionControl(Options options);
+
+    AdmissionControl(const AdmissionControl&) = delete;
+    AdmissionControl& operator=(const AdmissionControl&) = delete;
+
+    // Depth gauge of a downstream stage, in whatever unit `limit` is in;
+    // register before traffic starts
+    void addQueue(std::string name, std::function<size_t()> depth, size_t limit);
+
+    // Blocks for at most maxQueueWait (new orders) or maxCancelWait
+    // (cancels) while waiting for a slot
+    Ticket admit(Priority priority);
+    // Never blocks: a request that would have to wait for a slot is shed
+    Ticket tryAdmit(Priority priority);
+
+    Stats stats() const;
+
+private:
+    struct Queue {
+        std::string name;
+        std::function<size_t()> depth;
+        size_t limit;
+    };
+
+    Ticket admit(Priority priority, bool mayWait);
+    void release(std::chrono::steady_clock::time_point start);
+    Ticket rejectLocked(Priority priority, const char* reason);
+    // Index of the first queue at or past `scale` times its limit, or -1
+    int saturatedQueue(double scale) const;
+    int64_t expectedWaitUsLocked() const;
+
+    const Options options_;
+    std::vector<Queue> queues_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cancelCv_;
+    std::condition_variable orderCv_;
+    size_t inFlight_{0};
+    size_t waitingCancels_{0};
+    size_t waitingOrders_{0};
+    double latencyEwmaUs_{0.0};
+    uint64_t admitted_{0};
+    uint64_t shedNewOrders_{0};
+    uint64_t shedCancels_{0};
+    int lastSaturated_{-1};
+};
+
+}  // namespace qfblotter
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "qfblotter/TimerWheel.hpp"
+
+namespace qfblotter {
+
+enum class AlgoStrategy { TWAP, VWAP, POV };
+
+// Parent order parameters
+struct AlgoParams {
+    std::string parentId;
+    std::string symbol;
+    char side{'1'};
+    int quantity{0};
+    double limitPx{0.0};        // 0 = children are market orders
+    AlgoStrategy strategy{AlgoStrategy::TWAP};
+    int64_t startMs{0};         // 0 = now
+    int64_t endMs{0};
+    int64_t sliceMs{5'000};     // Scheduling interval
+    double participation{0.1};  // POV: target share of market volume
+};
+
+// Child order produced by a slice
+struct ChildOrder {
+    std::string clOrdId;
+    std::string parentId;
+    std::string symbol;
+    char side{'1'};
+    int quantity{0};
+    double limitPx{0.0};
+};
+
+// Parent state after a child fill
+struct ParentFill {
+    std::string parentId;
+    int cumQty{0};
+    int leavesQty{0};
+    double avgPx{0.0};
+    bool complete{false};
+};
+
+// Slices parent algo orders into child orders. All parents share one timer
+// wheel driven by a single background thread; each due parent costs O(1)
+// per slice. Children are handed to the router outside the engine lock, so
+// the router may fill synchronously and call back into onChildFill.
+// A parent ends when it fills, or when its schedule is over and nothing it
+// released is still working; either way it is dropped from the engine.
+class AlgoEngine {
+public:
+    // Returns false if the child was rejected; its quantity is re-released
+    using ChildRouter = std::function<bool(const ChildOrder&)>;
+    // A parent that ended short of its quantity (schedule over, remainder unfilled)
+    using ParentListener = std::function<void(const ParentFill&)>;
+    // After a runDue pass that routed children or ended parents: the place
+    // to publish once for all of them
+    using PassListener = std::function<void()>;
+
+    explicit AlgoEngine(int64_t tickMs = 100);
+    ~AlgoEngine();
+
+    void setChildRouter(ChildRouter router);
+    void setParentListener(ParentListener listener);
+    void setPassListener(PassListener listener);
+
+    void start();
+    void stop();
+
+    bool submit(AlgoParams params, std::string& error);
+
+    // Stop slicing. Returns false for an unknown parent; otherwise fills
+    // `children` with every child routed so far.
+    bool cancel(const std::string& parentId, std::vector<std::string>& children);
+
+    // Roll a child fill into its parent in O(1); nullopt if not a child
+    std::optional<ParentFill> onChildFill(const std::string& clOrdId, int qty, double px);
+
+    // A child ended (canceled, expired, rejected) with unfilledQty never
+    // traded: the quantity goes back to the schedule. Safe to call under the
+    // caller's locks; a parent this ends is reported from the next runDue.
+    void onChildDone(const std::string& clOrdId, int unfilledQty);
+
+    // A child amended down by qty returns it to the schedule
+    void onChildReduced(const std::string& clOrdId, int qty);
+
+    // Keep the child -> parent link when a child is amended under a new id
+    void renameChild(const std::string& oldId, const std::string& newId);
+
+    // Market volume printed for a symbol (POV benchmark)
+    void onMarketVolume(const std::string& symbol, int64_t qty);
+
+    bool isParent(const std::string& parentId) const;
+    size_t activeParents() const;
+
+    // Route every slice due at nowMs on the caller's thread (the background
+    // thread calls this with the wall clock), then report parents that ended
+    // short to the parent listener, outside the engine lock
+    void runDue(int64_t nowMs);
+
+    // Cumulative quantity a parent should have released after `slice` of
+    // `slices` intervals; mktVolume is the volume printed since start
+    static int targetQty(const AlgoParams& params, int slice, int slices, int64_t mktVolume);
+
+    // Cumulative share of volume by fraction x of the window (U-shaped intraday profile)
+    static double vwapCurve(double x);
+
+    static std::optional<AlgoStrategy> parseStrategy(const std::string& name);
+    static const char* strategyName(AlgoStrategy strategy);
+
+private:
+    struct Parent {
+        AlgoParams params;
+        int slices{1};
+        int nextSlice{0};
+        int released{0};
+        int cumQty{0};
+        double notional{0.0};
+        int64_t volumeAtStart{0};
+        TimerWheel::TimerId timer{TimerWheel::INVALID_TIMER};
+        std::vector<std::string> children;
+    };
+
+    using ParentMap = std::unordered_map<std::string, Parent>;
+
+    void run();
+    void scheduleSlice(Parent& parent);
+    void returnQtyLocked(ParentMap::iterator it, int qty);
+    static ParentFill fillOf(const Parent& parent);
+    static bool scheduleDone(const Parent& parent);
+    // Drop a parent and its child links
+    void eraseLocked(ParentMap::iterator it);
+
+    ChildRouter router_;
+    ParentListener parentListener_;
+    PassListener passListener_;
+    mutable std::mutex mutex_;
+    TimerWheel wheel_;
+    ParentMap parents_;
+    std::unordered_map<std::string, std::string> childToParent_;
+    std::vector<ParentFill> ended_;  // Ended short, not yet reported
+    std::unordered_map<std::string, int64_t> marketVolume_;  // Cumulative per symbol
+    std::atomic<bool> running_{false};
+    std::thread thread_;
+};
+
+}  // namespace qfblotter
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <quickfix/Log.h>
+#include <quickfix/SessionID.h>
+#include <quickfix/SessionSettings.h>
+
+#include "qfblotter/AsyncFileWriter.hpp"
+
+namespace qfblotter {
+
+// QuickFIX message/event log on AsyncFileWriter: same file layout and line
+// format as FIX::FileLog (<FileLogPath>/<prefix>.messages.current.log and
+// .event.current.log), but onIncoming/onOutgoing run on the session thread
+// and only copy into a buffer instead of writing and flushing a stream.
+// Logs are diagnostic, so batches are not fdatasync'd; the message store
+// remains the recovery source.
+class AsyncFileLog : public FIX::Log {
+public:
+    AsyncFileLog(const std::string& directory, const std::string& prefix);
+
+    void clear() override;
+    void backup() override;
+    void onIncoming(const std::string& value) override;
+    void onOutgoing(const std::string& value) override;
+    void onEvent(const std::string& value) override;
+
+private:
+    void open(bool truncate);
+    void write(AsyncFileWriter& file, const std::string& value);
+
+    std::string messagesPath_;
+    std::string eventPath_;
+    std::mutex mutex_;  // Guards reopening in clear()/backup()
+    std::unique_ptr<AsyncFileWriter> messages_;
+    std::unique_ptr<AsyncFileWriter> events_;
+};
+
+// Drop-in replacement for FIX::FileLogFactory; reads FileLogPath per session
+class AsyncFileLogFactory : public FIX::LogFactory {
+public:
+    explicit AsyncFileLogFactory(const FIX::SessionSettings& settings);
+
+    FIX::Log* create() override;
+    FIX::Log* create(const FIX::SessionID& sessionID) override;
+    void destroy(FIX::Log* log) override;
+
+private:
+    FIX::SessionSettings settings_;
+};
+
+}  // namespace qfblotter
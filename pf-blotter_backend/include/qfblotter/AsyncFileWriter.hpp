@@ -0,0 +1,111 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace qfblotter {
+
+// Append-only file writer that keeps write(2) and fdatasync(2) off the
+// calling thread. append() copies into one of a fixed set of buffers; a
+// writer thread submits everything filled since its last round as one batch
+// (a group commit), then syncs. On Linux the batch goes through io_uring as
+// linked writes into registered buffers followed by a linked fsync, so one
+// system call covers the whole batch; elsewhere, or if io_uring cannot be
+// set up (old kernel, seccomp, memlock limit), the same thread falls back
+// to pwrite + fdatasync.
+//
+// Durability is asynchronous: a line is on disk once a later flush()
+// returns, or within one batch of being appended.
+class AsyncFileWriter {
+public:
+    enum class Backend { IO_URING, BLOCKING };
+
+    struct Options {
+        size_t bufferSize{64 * 1024};  // Bytes per buffer; larger appends span buffers
+        size_t bufferCount{8};         // Registered with io_uring once
+        bool sync{true};               // fdatasync after every batch
+        bool truncate{false};          // Start empty instead of appending
+        bool useIoUring{true};         // false forces the blocking backend
+    };
+
+    explicit AsyncFileWriter(const std::string& path);
+    AsyncFileWriter(const std::string& path, Options options);  // Throws std::runtime_error if it cannot open
+    ~AsyncFileWriter();  // Flushes
+
+    AsyncFileWriter(const AsyncFileWriter&) = delete;
+    AsyncFileWriter& operator=(const AsyncFileWriter&) = delete;
+
+    // Never waits for the disk; blocks only while every buffer is in flight
+    void append(std::string_view data);
+
+    // Wait until everything appended so far is written (and synced)
+    void flush();
+
+    // Flush, then continue in a new, empty file at path(), keeping the
+    // buffers, ring and writer thread; the old file is left as written
+    // (e.g. renamed into place). Throws std::runtime_error if it cannot open.
+    void reopen();
+
+    // Drops to BLOCKING for good if the ring fails mid-session
+    Backend backend() const { return backend_.load(std::memory_order_relaxed); }
+    const std::string& path() const { return path_; }
+    uint64_t bytesWritten() const { return bytesWritten_.load(std::memory_order_relaxed); }
+    uint64_t batches() const { return batches_.load(std::memory_order_relaxed); }
+    uint64_t stalls() const { return stalls_.load(std::memory_order_relaxed); }
+    // Bytes appended but not yet written
+    uint64_t backlog() const {
+        const uint64_t written = bytesWritten_.load(std::memory_order_acquire);
+        const uint64_t appended = bytesAppended_.load(std::memory_order_acquire);
+        return appended > written ? appended - written : 0;
+    }
+
+    static const char* backendName(Backend backend);
+
+private:
+    struct Buffer {
+        char* data{nullptr};
+        size_t len{0};
+    };
+    class Uring;
+
+    void run();
+    void writeBatch(const std::vector<int>& batch, uint64_t offset);
+    void writeBlocking(const char* data, size_t len, uint64_t offset);
+
+    std::string path_;
+    Options options_;
+    int fd_{-1};
+    std::atomic<Backend> backend_{Backend::BLOCKING};
+    std::unique_ptr<Uring> uring_;
+
+    std::vector<Buffer> buffers_;
+    std::unique_ptr<char, void (*)(void*)> arena_{nullptr, nullptr};
+
+    std::mutex appendMutex_;  // Keeps each append() contiguous
+    std::mutex mutex_;
+    std::condition_variable writerCv_;  // Work for the writer thread
+    std::condition_variable doneCv_;    // A batch completed (flushers, stalled appenders)
+    std::vector<int> free_;   // Stack: the most recently written buffer is reused first
+    std::vector<int> ready_;  // Both sized to bufferCount up front; append() never grows them
+    int filling_{-1};
+    uint64_t appended_{0};  // Bytes accepted by append()
+    uint64_t durable_{0};   // Bytes written (and synced)
+    uint64_t offset_{0};    // File offset of the next batch
+    bool stopping_{false};
+
+    std::atomic<uint64_t> bytesAppended_{0};
+    std::atomic<uint64_t> bytesWritten_{0};
+    std::atomic<uint64_t> batches_{0};
+    std::atomic<uint64_t> stalls_{0};
+    std::thread thread_;
+};
+
+}  // namespace qfblotter
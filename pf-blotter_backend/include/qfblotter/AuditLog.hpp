@@ -1,13 +1,18 @@
 #pragma once
 
 #include <chrono>
-#include <fstream>
-#include <mutex>
+#include <cstddef>
 #include <string>
+#include <string_view>
+#include <vector>
+
+#include "qfblotter/AsyncFileWriter.hpp"
 
 namespace qfblotter {
 
-// Thread-safe, append-only audit log for regulatory compliance
+// Thread-safe, append-only audit log for regulatory compliance. Lines are
+// formatted on the caller and handed to an AsyncFileWriter, so logging never
+// waits on the disk; each writer batch is fdatasync'd.
 class AuditLog {
 public:
     enum class EventType {
@@ -20,6 +25,8 @@ public:
         ORDER_CANCEL_REJECTED,
         ORDER_REPLACED,      // Order amendment
         ORDER_REPLACE_REJECTED,
+        ORDER_EXPIRED,       // DAY/GTD expiry or IOC/FOK remainder
+        ORDER_TRIGGERED,     // Stop / stop-limit activated
         SYSTEM_START,
         SYSTEM_STOP,
         FIX_SESSION_LOGON,
@@ -30,21 +37,26 @@ public:
     ~AuditLog();
 
     // Log an event (thread-safe, append-only)
-    void log(EventType type, const std::string& clOrdId, const std::string& details);
+    void log(EventType type, std::string_view clOrdId, std::string_view details);
+
+    // Log one event per order with a single flush (bulk expiry at session end)
+    void logBatch(EventType type, const std::vector<std::string>& clOrdIds, std::string_view details);
     
     // System events
-    void logSystemEvent(const std::string& event, const std::string& details);
+    void logSystemEvent(std::string_view event, std::string_view details);
+
+    // Block until every event logged so far is on disk
+    void flush();
 
     // Get log path
     std::string getLogPath() const { return logPath_; }
+    const AsyncFileWriter& writer() const { return file_; }
 
 private:
-    std::string eventTypeToString(EventType type) const;
-    std::string currentTimestamp() const;
+    static const char* eventTypeToString(EventType type);
 
     std::string logPath_;
-    std::ofstream file_;
-    mutable std::mutex mutex_;
+    AsyncFileWriter file_;
 };
 
 }  // namespace qfblotter
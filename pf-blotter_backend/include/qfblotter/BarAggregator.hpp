@@ -0,0 +1,88 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace qfblotter {
+
+// One OHLCV bucket
+struct Bar {
+    int64_t startMs{0};   // Bucket start, milliseconds since epoch
+    double open{0.0};
+    double high{0.0};
+    double low{0.0};
+    double close{0.0};
+    int64_t volume{0};    // Filled quantity in this bucket (ticks carry no volume)
+    int trades{0};        // Number of fills in this bucket
+};
+
+enum class BarInterval { Sec1 = 0, Min1 = 1, Min5 = 2 };
+
+// Per-symbol intraday bar history kept in fixed-size ring buffers.
+// Rings are allocated for every configured symbol at construction and never
+// grow, so memory is symbols * bytesPerSymbol() for the whole session.
+// Updates for symbols outside the configured set are ignored.
+class BarAggregator {
+public:
+    static constexpr size_t INTERVAL_COUNT = 3;
+    // Ring capacities: 15 minutes of 1s bars, a trading day of 1m bars, 24h of 5m bars
+    static constexpr std::array<size_t, INTERVAL_COUNT> CAPACITY = {900, 390, 288};
+
+    // Called with up to two contiguous spans (ring wrap), oldest bars first
+    using SpanVisitor = std::function<void(const Bar* bars, size_t count)>;
+
+    explicit BarAggregator(const std::vector<std::string>& symbols);
+
+    // Price-only update from the market data feed
+    void onTick(const std::string& symbol, double price, int64_t timeMs);
+
+    // Execution update - contributes price and volume
+    void onFill(const std::string& symbol, double price, int qty, int64_t timeMs);
+
+    // Visit the most recent n bars in place (no copy). Returns bars visited,
+    // 0 for an unknown symbol. The symbol's ring is locked for the duration.
+    size_t visit(const std::string& symbol, BarInterval interval, size_t n,
+                 const SpanVisitor& visitor) const;
+
+    // JSON document for /history, serialized straight from the ring; empty
+    // for a symbol outside the configured set (answered as 404)
+    std::string historyJson(const std::string& symbol, BarInterval interval, size_t n) const;
+
+    bool hasSymbol(const std::string& symbol) const;
+    size_t symbolCount() const { return series_.size(); }
+
+    static constexpr size_t bytesPerSymbol() {
+        return (CAPACITY[0] + CAPACITY[1] + CAPACITY[2]) * sizeof(Bar);
+    }
+
+    static std::optional<BarInterval> parseInterval(const std::string& text);
+    static const char* intervalName(BarInterval interval);
+    static int64_t intervalMs(BarInterval interval);
+
+private:
+    struct Ring {
+        std::vector<Bar> bars;  // Sized to capacity once, never resized
+        size_t head{0};         // Index of the newest (in-progress) bar
+        size_t count{0};
+    };
+
+    struct Series {
+        mutable std::mutex mutex;
+        std::array<Ring, INTERVAL_COUNT> rings;
+    };
+
+    void update(const std::string& symbol, double price, int qty, int64_t timeMs);
+
+    // Populated in the constructor only, so lookups need no lock
+    std::unordered_map<std::string, std::unique_ptr<Series>> series_;
+};
+
+}  // namespace qfblotter
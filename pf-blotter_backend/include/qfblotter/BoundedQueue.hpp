@@ -0,0 +1,78 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace qfblotter {
+
+// Multi-producer queue with a fixed capacity. Producers never wait for the
+// consumer: tryPush() fails immediately when the queue is full, so a slow
+// consumer can only cost the producer a short critical section.
+// Items live in a ring that grows (doubling, up to capacity) only when the
+// queue gets deeper than before, so steady-state traffic reuses its slots
+// instead of allocating deque blocks.
+template <typename T>
+class BoundedQueue {
+public:
+    explicit BoundedQueue(size_t capacity) : capacity_(capacity == 0 ? 1 : capacity) {}
+
+    bool tryPush(T item) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (count_ >= capacity_) {
+                return false;
+            }
+            if (count_ == slots_.size()) {
+                grow();
+            }
+            slots_[(head_ + count_) % slots_.size()] = std::move(item);
+            ++count_;
+        }
+        cv_.notify_one();
+        return true;
+    }
+
+    // Wait up to `timeout` for an item; false if none arrived
+    template <typename Rep, typename Period>
+    bool popWait(T& out, std::chrono::duration<Rep, Period> timeout) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (!cv_.wait_for(lock, timeout, [this]() { return count_ > 0; })) {
+            return false;
+        }
+        out = std::move(slots_[head_]);
+        head_ = (head_ + 1) % slots_.size();
+        --count_;
+        return true;
+    }
+
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return count_;
+    }
+
+    size_t capacity() const { return capacity_; }
+
+private:
+    void grow() {
+        std::vector<T> slots(slots_.empty() ? std::min<size_t>(capacity_, 16) : std::min(capacity_, slots_.size() * 2));
+        for (size_t i = 0; i < count_; ++i) {
+            slots[i] = std::move(slots_[(head_ + i) % slots_.size()]);
+        }
+        slots_.swap(slots);
+        head_ = 0;
+    }
+
+    const size_t capacity_;
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::vector<T> slots_;
+    size_t head_{0};
+    size_t count_{0};
+};
+
+}  // namespace qfblotter
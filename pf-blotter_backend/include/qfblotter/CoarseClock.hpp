@@ -0,0 +1,39 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace qfblotter {
+
+// Cached wall clock for timestamps on hot paths. A refresher thread
+// republishes the epoch in milliseconds every tick, reformatting the
+// second-resolution UTC prefixes only when the second changes; reads copy
+// that snapshot lock-free (seqlock) and append just the milliseconds. Without
+// the refresher (tools, tests) reads fall back to the system clock with a
+// per-thread cache of the current second's prefix, so output is the same.
+// Times are at most one tick (plus scheduling delay) behind.
+class CoarseClock {
+public:
+    static constexpr size_t ISO_SECONDS_SIZE = 20;  // YYYY-MM-DDTHH:MM:SSZ
+    static constexpr size_t ISO_MILLIS_SIZE = 24;   // YYYY-MM-DDTHH:MM:SS.mmmZ
+    static constexpr size_t FIX_MILLIS_SIZE = 21;   // YYYYMMDD-HH:MM:SS.sss
+
+    // Start the refresher (no-op if already running); stop() joins it
+    static void start(std::chrono::milliseconds tick = std::chrono::milliseconds(1));
+    static void stop();
+    static bool running();
+
+    static int64_t nowMs();
+
+    // Current UTC time, ISO-8601 to the second
+    static std::string isoSeconds();
+    // Into `buf` (at least ISO_MILLIS_SIZE / FIX_MILLIS_SIZE bytes); the
+    // view is valid while `buf` is
+    static std::string_view isoMillis(char* buf);
+    static std::string_view fixMillis(char* buf);
+};
+
+}  // namespace qfblotter
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace qfblotter {
+
+struct OrderRecord;
+
+// A buy and a sell blotter order matched against each other
+struct Cross {
+    std::string symbol;
+    std::string buyClOrdId;
+    std::string sellClOrdId;
+    int qty{0};
+    double price{0.0};
+    uint64_t buySeq{0};   // Time priority of each leg at the match, so a
+    uint64_t sellSeq{0};  // voided cross can put the survivor back in place
+};
+
+// Internal crossing of resting blotter limit orders, one book per symbol.
+// Buys and sells whose limits overlap match each other in price-time
+// priority at the bid/ask midpoint, clamped to both limits, before either is
+// offered to the simulated market, so internal flow does not move its
+// price. Only books changed since the last match are examined: a pass
+// costs O(1) when nothing new rests and O(log n) per cross otherwise.
+class CrossingEngine {
+public:
+    using MidPrice = std::function<double(const std::string& symbol)>;
+
+    // Rest `leavesQty` of an order. A new order, a changed limit or a larger
+    // quantity joins the back of its price level; a smaller one keeps its place.
+    void upsert(const std::string& clOrdId, const std::string& symbol, char side, double limitPx, int leavesQty);
+    bool remove(const std::string& clOrdId);
+
+    // Keep the books in step with the store (register as a change
+    // listener): open DAY/GTC/GTD limit orders rest, anything else leaves
+    void onOrderChange(const OrderRecord& record);
+    static bool crossable(const OrderRecord& record);
+
+    // A cross was voided (the other leg went away): put this leg back as
+    // `record` says, at time priority `seq` from the Cross, unless the order
+    // has been re-placed since the match, which then keeps its new place
+    void restore(const OrderRecord& record, uint64_t seq);
+
+    // Match every changed book until its best bid is below its best ask,
+    // appending crosses in match order. Crossed quantity leaves the books.
+    void match(const MidPrice& mid, std::vector<Cross>& crosses);
+
+    size_t size() const;
+    uint64_t crosses() const;
+    uint64_t crossedQty() const;
+
+private:
+    struct Resting {
+        std::string clOrdId;
+        int qty{0};
+    };
+    using Key = std::pair<double, uint64_t>;  // Limit, arrival sequence
+    struct HighestFirst {
+        bool operator()(const Key& a, const Key& b) const {
+            return a.first != b.first ? a.first > b.first : a.second < b.second;
+        }
+    };
+    using Buys = std::map<Key, Resting, HighestFirst>;  // Highest limit, then earliest
+    using Sells = std::map<Key, Resting>;               // Lowest limit, then earliest
+
+    struct Book {
+        std::string symbol;
+        Buys buys;
+        Sells sells;
+        bool dirty{false};
+    };
+
+    struct Location {
+        Book* book{nullptr};
+        char side{'1'};
+        Buys::iterator buyIt;
+        Sells::iterator sellIt;
+    };
+
+    void insertLocked(const std::string& clOrdId, const std::string& symbol, char side, double limitPx,
+                      int leavesQty, uint64_t seq);
+    void eraseLocked(const Location& loc);
+    void markDirtyLocked(Book& book);
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, Book> books_;          // Nodes never move, so Book* stays valid
+    std::unordered_map<std::string, Location> locations_;  // clOrdId -> position for O(log n) removal
+    std::vector<Book*> dirty_;
+    uint64_t nextSeq_{0};
+    uint64_t crosses_{0};
+    uint64_t crossedQty_{0};
+};
+
+}  // namespace qfblotter
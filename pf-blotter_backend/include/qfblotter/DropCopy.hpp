@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include <quickfix/Message.h>
+#include <quickfix/SessionID.h>
+
+#include "qfblotter/BoundedQueue.hpp"
+
+namespace qfblotter {
+
+// Mirrors execution reports to drop-copy FIX sessions on a worker thread.
+// publish() never blocks: when the queue is full the copy is not queued
+// but its ClOrdID is remembered, and once the worker has drained the queue
+// it sends an ExecType=ORDER_STATUS report with the order's current state
+// from the status source, so the trading session is never held up by a
+// slow consumer and the consumer still converges on every order.
+// Reports sent while a drop-copy session is logged out are persisted by
+// the QuickFIX message store and replayed on the consumer's ResendRequest.
+class DropCopy {
+public:
+    // Fills `report` with the current state of `clOrdId`; false if unknown
+    using StatusSource = std::function<bool(const std::string& clOrdId, FIX::Message& report)>;
+
+    explicit DropCopy(size_t capacity = 16384);
+    ~DropCopy();
+
+    // Register sessions before start()
+    void addSession(const FIX::SessionID& sessionID);
+    bool isDropCopySession(const FIX::SessionID& sessionID) const;
+    bool enabled() const { return !sessions_.empty(); }
+
+    // Set before start(); without it overflowed copies are only counted
+    void setStatusSource(StatusSource source);
+
+    void start();
+    void stop();
+
+    bool publish(const FIX::Message& report);
+
+    uint64_t published() const { return published_.load(std::memory_order_relaxed); }
+    uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+    uint64_t resynced() const { return resynced_.load(std::memory_order_relaxed); }
+    size_t queued() const { return queue_.size(); }
+
+private:
+    void run();
+    void forward(FIX::Message& report);
+    void resync();
+
+    BoundedQueue<FIX::Message> queue_;
+    std::vector<FIX::SessionID> sessions_;
+    StatusSource statusSource_;
+    std::mutex pendingMutex_;
+    std::unordered_set<std::string> pendingResync_;  // ClOrdIDs with an overflowed copy
+    std::atomic<bool> hasPending_{false};
+    std::atomic<uint64_t> published_{0};
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<uint64_t> resynced_{0};
+    std::atomic<bool> running_{false};
+    std::thread thread_;
+};
+
+}  // namespace qfblotter
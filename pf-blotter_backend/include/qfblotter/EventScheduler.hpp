@@ -0,0 +1,80 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace qfblotter {
+
+// Discrete-event scheduler for simulated delays: callbacks are queued in a
+// min-heap on their due time (microseconds, SimClock::steadyUs) and run in
+// due order, FIFO among equal times. One dispatcher thread serves every
+// pending event, so a thousand orders in flight to a venue cost heap
+// entries, not sleeping threads. runDue() is the same step without the
+// thread, for tests and callers that own the clock; runUntil() drives a
+// virtual SimClock instead, jumping straight to each event.
+class EventScheduler {
+public:
+    using Callback = std::function<void()>;
+
+    EventScheduler() = default;
+    ~EventScheduler();
+
+    EventScheduler(const EventScheduler&) = delete;
+    EventScheduler& operator=(const EventScheduler&) = delete;
+
+    static int64_t nowUs();
+
+    // Callbacks may schedule further events; one due in the past runs on the
+    // next dispatch
+    void at(int64_t dueUs, Callback callback);
+    void after(int64_t delayUs, Callback callback);
+    // Fixed rate, first run one interval from now
+    void every(int64_t intervalUs, Callback callback);
+
+    // Run every event due at or before `nowUs` on the calling thread
+    size_t runDue(int64_t nowUs);
+
+    // Virtual time: run events in due order up to `endUs`, advancing
+    // SimClock to each one as it runs and to `endUs` after the last
+    size_t runUntil(int64_t endUs);
+
+    // Real-time dispatcher thread; stop() drops whatever is still pending
+    void start();
+    void stop();
+
+    size_t pending() const;
+    uint64_t executed() const { return executed_.load(std::memory_order_relaxed); }
+
+private:
+    struct Event {
+        int64_t dueUs{0};
+        uint64_t seq{0};
+        Callback callback;
+    };
+    // Heap order: earliest due first, then schedule order
+    struct Later {
+        bool operator()(const Event& a, const Event& b) const {
+            return a.dueUs != b.dueUs ? a.dueUs > b.dueUs : a.seq > b.seq;
+        }
+    };
+
+    void run();
+    void repeat(int64_t dueUs, int64_t intervalUs, std::shared_ptr<Callback> callback);
+
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    std::vector<Event> heap_;
+    uint64_t nextSeq_{0};
+    std::atomic<bool> running_{false};
+    std::atomic<uint64_t> executed_{0};
+    std::thread thread_;
+};
+
+}  // namespace qfblotter
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "qfblotter/Json.hpp"
+
+namespace qfblotter {
+
+struct OrderRecord;
+
+// Venues for executions that were not routed out: the in-process market,
+// and a cross between two blotter orders
+inline const std::string VENUE_MARKET = "SIM";
+inline const std::string VENUE_INTERNAL = "INTERNAL";
+
+// One row of the ledger, materialised for a reader
+struct Execution {
+    uint64_t execId{0};
+    std::string clOrdId;
+    std::string orderId;
+    std::string symbol;
+    char side{'1'};
+    int qty{0};
+    double px{0.0};
+    int64_t timeUs{0};  // Epoch microseconds (SimClock)
+    std::string venue;
+};
+
+// Append-only record of every execution, independent of the order state a
+// fill overwrites. Rows live column by column in fixed-size chunks that
+// never move, so appends never copy and a scan over one column (quantity,
+// price, venue) touches only that column's cache lines. Order and venue
+// names are interned once; each row stores small integer references, plus
+// the execId of the same order's previous execution, so one order's
+// executions are a chain through the ledger rather than a list per order.
+// ExecIds are dense and ascending from 1: the cursor for readers.
+class ExecutionLedger {
+public:
+    static constexpr size_t CHUNK_ROWS = 4096;
+
+    struct VenueTotals {
+        std::string venue;
+        uint64_t executions{0};
+        uint64_t qty{0};
+        double notional{0.0};
+    };
+
+    uint64_t append(const OrderRecord& order, int qty, double px, int64_t timeUs, const std::string& venue);
+
+    // Executions after `since` (an execId, 0 for the start), oldest first
+    std::vector<Execution> since(uint64_t since, size_t limit) const;
+    // One order's executions, oldest first
+    std::vector<Execution> forOrder(const std::string& clOrdId) const;
+    // Per-venue totals, kept up to date by append
+    std::vector<VenueTotals> venueTotals() const;
+
+    uint64_t size() const;
+    size_t chunks() const;
+
+    // {"executions":[...],"next":<last execId returned, or since>,"total":n}
+    Json sinceJson(uint64_t since, size_t limit) const;
+    Json orderJson(const std::string& clOrdId) const;
+
+private:
+    struct Chunk {
+        std::array<uint32_t, CHUNK_ROWS> order;  // Into orders_
+        std::array<int32_t, CHUNK_ROWS> qty;
+        std::array<double, CHUNK_ROWS> px;
+        std::array<int64_t, CHUNK_ROWS> timeUs;
+        std::array<uint16_t, CHUNK_ROWS> venue;  // Into venues_
+        std::array<uint64_t, CHUNK_ROWS> prev;   // The order's previous execId, 0 for its first
+    };
+    struct OrderRef {
+        std::string clOrdId;
+        std::string orderId;
+        std::string symbol;
+        char side{'1'};
+        uint64_t lastExecId{0};
+    };
+
+    Execution rowLocked(uint64_t execId) const;
+    static Json toJson(const Execution& execution);
+
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<Chunk>> chunks_;
+    uint64_t size_{0};
+    std::vector<OrderRef> orders_;
+    std::unordered_map<std::string, uint32_t> orderIndex_;
+    std::vector<VenueTotals> venues_;  // Interned venue names, with their running totals
+};
+
+}  // namespace qfblotter
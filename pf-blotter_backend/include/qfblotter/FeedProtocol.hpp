@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace qfblotter {
+
+// Wire format of the UDP multicast market data feed and its TCP recovery
+// service. All integers are little-endian (host order on supported
+// platforms). Any change to these structs must bump FEED_VERSION.
+//
+// Every entry carries an implicit sequence number: entry i of a packet is
+// firstSeq + i. Consumers detect gaps from the sequence and fill them from
+// the recovery service with a RETRANSMIT request, or resynchronise from a
+// SNAPSHOT when the gap is older than the publisher's retention.
+
+inline constexpr uint32_t FEED_MAGIC = 0x444D4651;  // "QFMD"
+inline constexpr uint16_t FEED_VERSION = 1;
+inline constexpr size_t FEED_MAX_PACKET = 1400;  // Stays under a 1500 byte MTU
+
+enum class FeedPacketType : uint8_t {
+    INCREMENTAL = 1,
+    SNAPSHOT = 2,  // firstSeq is the last sequence the snapshot reflects
+    END = 3,       // Terminates a recovery response; firstSeq is the next sequence to be published
+};
+
+struct FeedPacketHeader {
+    uint32_t magic;
+    uint16_t version;
+    FeedPacketType type;
+    uint8_t reserved;
+    uint64_t firstSeq;
+    uint16_t count;
+    uint16_t reserved2;
+    uint32_t reserved3;
+    int64_t sendTimeNs;
+};
+
+struct FeedEntry {
+    char symbol[16];  // NUL-padded
+    double price;
+    int64_t volume;
+};
+
+enum class FeedRequestType : uint8_t {
+    RETRANSMIT = 1,
+    SNAPSHOT = 2,
+};
+
+struct FeedRecoveryRequest {
+    uint32_t magic;
+    FeedRequestType type;
+    uint8_t reserved[3];
+    uint64_t fromSeq;
+    uint32_t count;
+    uint32_t reserved2;
+};
+
+static_assert(sizeof(FeedPacketHeader) == 32, "FeedPacketHeader layout changed");
+static_assert(sizeof(FeedEntry) == 32, "FeedEntry layout changed");
+static_assert(sizeof(FeedRecoveryRequest) == 24, "FeedRecoveryRequest layout changed");
+
+inline constexpr size_t FEED_MAX_ENTRIES = (FEED_MAX_PACKET - sizeof(FeedPacketHeader)) / sizeof(FeedEntry);
+inline constexpr uint32_t FEED_MAX_RETRANSMIT = 10000;  // Entries per RETRANSMIT request
+
+}  // namespace qfblotter
@@ -2,27 +2,87 @@
 
 #include <atomic>
 #include <functional>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include <quickfix/Application.h>
 #include <quickfix/MessageCracker.h>
+#include <quickfix/SessionID.h>
 
 namespace FIX44 {
+class ExecutionReport;
+class MarketDataRequest;
 class NewOrderSingle;
 class OrderCancelRequest;
 }  // namespace FIX44
 
 namespace qfblotter {
 
+class AdmissionControl;
 class OrderStore;
 class MarketSim;
+class DropCopy;
+class FixMarketData;
+struct OrderRecord;
 
 class FixApplication final : public FIX::Application, public FIX::MessageCracker {
 public:
     using EventPublisher = std::function<void(const std::string&)>;
+    // Invoked for every execution with the order as it was before the fill
+    // and the venue that executed it
+    using FillListener = std::function<void(const OrderRecord&, int fillQty, double fillPx, const std::string& venue)>;
+    // Invoked once for every accepted (acknowledged) order
+    using OrderListener = std::function<void(const OrderRecord&)>;
+    // True if this gateway owns the symbol (sharding)
+    using SymbolFilter = std::function<bool(const std::string&)>;
 
     FixApplication(OrderStore& store, MarketSim& market, EventPublisher publisher);
 
+    void setFillListener(FillListener listener);
+    void setNewOrderListener(OrderListener listener);
+    // Invoked once for every order canceled over FIX, with its canceled state
+    void setCancelListener(OrderListener listener);
+
+    // Mirror every ExecutionReport to the drop-copy sessions (optional); a
+    // copy the drop-copy queue cannot take is resynced from the store
+    void setDropCopy(DropCopy* dropCopy);
+
+    // Serve MarketDataRequest; without it V is rejected as unsupported
+    void setMarketData(FixMarketData* marketData);
+
+    // Daily UTC cutoff ("HH:MM:SS") at which DAY orders expire
+    void setSessionEndTime(const std::string& hhmmss);
+
+    // Give sessions the build-time compiled FIX 4.4 dictionary as they are
+    // created and validate inbound messages against it (FixDictionary.hpp);
+    // set before the acceptor starts
+    void setCompiledDictionary(bool enabled);
+
+    // Pass NewOrderSingle and OrderCancelRequest through `admission`; a shed
+    // message is answered with a BusinessMessageReject carrying a retry hint
+    void setAdmissionControl(AdmissionControl* admission);
+
+    // Reject NewOrderSingle for symbols another shard owns, as the HTTP
+    // order path does; unset, every symbol is accepted
+    void setSymbolFilter(SymbolFilter ownsSymbol);
+
+    // Report an event on any order, FIX or UI, with `record` as the state
+    // after it: sent to the originating session if the order arrived over
+    // FIX, and mirrored to drop-copy sessions either way
+    void reportExecution(const OrderRecord& record, char execType, int lastQty = 0, double lastPx = 0.0);
+
+    // ExecType=EXPIRED reports for a batch of expired orders
+    void onOrdersExpired(const std::vector<OrderRecord>& expired);
+
+    // ExecType=TRIGGERED report when a stop order is activated
+    void onStopTriggered(const OrderRecord& activated);
+
+    // ExecType=TRADE report for a fill produced outside the FIX thread;
+    // `before` is the order state prior to the fill
+    void reportFill(const OrderRecord& before, int fillQty, double fillPx);
+
     void onCreate(const FIX::SessionID& sessionID) override;
     void onLogon(const FIX::SessionID& sessionID) override;
     void onLogout(const FIX::SessionID& sessionID) override;
@@ -34,14 +94,35 @@ public:
 private:
     void onMessage(const FIX44::NewOrderSingle& message, const FIX::SessionID& sessionID) override;
     void onMessage(const FIX44::OrderCancelRequest& message, const FIX::SessionID& sessionID) override;
+    void onMessage(const FIX44::MarketDataRequest& message, const FIX::SessionID& sessionID) override;
 
     std::string nextOrderId();
     std::string nextExecId();
+    FIX44::ExecutionReport buildReport(const OrderRecord& record, char execType, int lastQty = 0,
+                                       double lastPx = 0.0);
     void publishSnapshot();
+    void notifyFill(const OrderRecord& before, int fillQty, double fillPx);
+    void sendReport(FIX::Message& report, const FIX::SessionID& sessionID);
+    void sendOverloaded(const FIX::Message& message, const std::string& msgType, int64_t retryAfterMs,
+                        const FIX::SessionID& sessionID);
+    void mirror(const FIX::Message& report);
+    void forgetSession(const std::string& clOrdId);
+    bool findSession(const std::string& clOrdId, FIX::SessionID& sessionID);
 
     OrderStore& store_;
     MarketSim& market_;
     EventPublisher publisher_;
+    FillListener fillListener_;
+    OrderListener newOrderListener_;
+    OrderListener cancelListener_;
+    DropCopy* dropCopy_{nullptr};
+    FixMarketData* marketData_{nullptr};
+    std::string sessionEndTime_{"23:59:59"};
+    bool compiledDictionary_{false};
+    AdmissionControl* admission_{nullptr};
+    SymbolFilter ownsSymbol_;
+    std::mutex sessionsMutex_;
+    std::unordered_map<std::string, FIX::SessionID> orderSessions_;  // ClOrdID -> originating session
     std::atomic<unsigned long long> orderCounter_{1};
     std::atomic<unsigned long long> execCounter_{1};
 };
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <memory>
+
+namespace FIX {
+class DataDictionary;
+class Message;
+class SessionID;
+}  // namespace FIX
+
+namespace qfblotter {
+
+// QuickFIX side of the dictionary compiled from fix/FIX44.xml at build time.
+// Sessions run with UseDataDictionary=N so QuickFIX never loads the XML;
+// instead each session gets a DataDictionary built from the generated tables,
+// carrying message structure (fields, types, values, groups) but no version,
+// so QuickFIX parses repeating groups with it and skips its own validation.
+// Inbound messages are then checked by validateFixMessage() from the
+// application callbacks.
+
+// Build a DataDictionary from the generated tables (no caching)
+std::shared_ptr<FIX::DataDictionary> buildCompiledDataDictionary();
+
+// Shared instance, built on first use
+std::shared_ptr<FIX::DataDictionary> compiledDataDictionary();
+
+// Install compiledDataDictionary() on a session; call from onCreate
+void useCompiledDataDictionary(const FIX::SessionID& sessionID);
+
+// Validate an inbound message, throwing the QuickFIX exception that makes
+// the session answer with the matching Reject (or BusinessMessageReject for
+// a message type that is not compiled in); call from fromAdmin/fromApp
+void validateCompiled(const FIX::Message& message);
+
+}  // namespace qfblotter
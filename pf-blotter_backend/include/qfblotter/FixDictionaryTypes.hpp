@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// Table layout for the generated FIX dictionary (Fix44Dictionary.hpp, built
+// from fix/FIX44.xml by scripts/gen_fix_dictionary.py)
+namespace qfblotter::fixdict {
+
+// Value syntax the validator checks; String is unchecked
+enum class FieldFormat : uint8_t { String, Char, Boolean, Int, Float, UtcTimestamp, UtcDateOnly, UtcTimeOnly };
+
+struct FieldDef {
+    int tag;
+    std::string_view name;
+    std::string_view xmlType;  // Type as written in the XML
+    FieldFormat format;
+    bool multiValue;           // Space-separated list of enum values
+    uint16_t firstValue;       // Range in VALUES, sorted by value; empty = any value
+    uint16_t valueCount;
+};
+
+struct ValueDef {
+    std::string_view value;
+    std::string_view description;
+};
+
+// A field or repeating group of a message, group entry, header or trailer
+struct MemberDef {
+    int tag;
+    bool required;
+    int group;  // Index in GROUPS when `tag` is a NumInGroup count, else -1
+};
+
+// Members of a header, trailer, message body or group entry: a range in
+// MEMBERS (declared order) and MEMBERS_BY_TAG (sorted by tag)
+struct ScopeDef {
+    uint16_t firstMember;
+    uint16_t memberCount;
+    uint16_t requiredCount;
+};
+
+struct GroupDef {
+    int countTag;
+    int delimiter;  // First field of every entry
+    ScopeDef entry;
+};
+
+struct MessageDef {
+    std::string_view msgType;
+    std::string_view name;
+    bool admin;
+    ScopeDef body;
+};
+
+}  // namespace qfblotter::fixdict
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#include <quickfix/SessionID.h>
+
+#include "qfblotter/MarketDataConflator.hpp"
+
+namespace FIX44 {
+class MarketDataRequest;
+}  // namespace FIX44
+
+namespace qfblotter {
+
+class MarketSim;
+
+// Serves FIX MarketDataRequest (V): a MarketDataSnapshotFullRefresh (W) per
+// symbol on request, then for SubscriptionRequestType=1 conflated
+// MarketDataIncrementalRefresh (X) trade updates driven by MarketSim ticks.
+// Updates are published every `conflationMs`, at most one X per subscription.
+class FixMarketData {
+public:
+    explicit FixMarketData(MarketSim& market, int64_t conflationMs = 100, int maxDepth = 10);
+    ~FixMarketData();
+
+    void start();
+    void stop();
+
+    // Register with MarketSim::addTickListener
+    void onTick(const std::string& symbol, double price);
+
+    void onRequest(const FIX44::MarketDataRequest& request, const FIX::SessionID& sessionID);
+    void onLogout(const FIX::SessionID& sessionID);
+
+    size_t subscriptions() const { return conflator_.subscriptionCount(); }
+    uint64_t snapshotsSent() const { return snapshotsSent_.load(std::memory_order_relaxed); }
+    uint64_t incrementalsSent() const { return incrementalsSent_.load(std::memory_order_relaxed); }
+
+private:
+    void run();
+    void publish(const std::string& subscriber, const std::string& mdReqId,
+                 const std::vector<MdUpdate>& updates);
+    void sendSnapshot(const std::string& mdReqId, const std::string& symbol, int depth,
+                      const FIX::SessionID& sessionID);
+    void reject(const std::string& mdReqId, char reason, const std::string& text,
+                const FIX::SessionID& sessionID);
+
+    MarketSim& market_;
+    MarketDataConflator conflator_;
+    const int64_t conflationMs_;
+    const int maxDepth_;
+    std::mutex sessionsMutex_;
+    std::unordered_map<std::string, FIX::SessionID> sessions_;  // SessionID string -> session
+    std::atomic<uint64_t> snapshotsSent_{0};
+    std::atomic<uint64_t> incrementalsSent_{0};
+    std::atomic<bool> running_{false};
+    std::thread thread_;
+};
+
+}  // namespace qfblotter
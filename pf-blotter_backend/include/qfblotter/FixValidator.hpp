@@ -0,0 +1,50 @@
+#pragma once
+
+#include <span>
+#include <string_view>
+
+namespace qfblotter {
+
+// Why a message failed validation; each maps to a SessionRejectReason
+// (373), except UNSUPPORTED_MSG_TYPE which is a BusinessMessageReject
+enum class FixReject {
+    NONE,
+    INVALID_TAG,                  // Tag the dictionary does not define
+    REQUIRED_TAG_MISSING,
+    TAG_NOT_DEFINED_FOR_MESSAGE,
+    EMPTY_VALUE,
+    INCORRECT_VALUE,              // Not one of the field's enumerated values
+    INCORRECT_FORMAT,             // Not valid for the field's type
+    INVALID_MSG_TYPE,
+    UNSUPPORTED_MSG_TYPE,         // Valid FIX 4.4, but not compiled in
+    REPEATED_TAG,
+    TAG_OUT_OF_ORDER,             // Header field after the body, etc.
+    GROUP_COUNT_MISMATCH,
+};
+
+const char* fixRejectToString(FixReject reject);
+
+struct FixField {
+    int tag;
+    std::string_view value;
+};
+
+struct FixValidation {
+    FixReject reject{FixReject::NONE};
+    int tag{0};  // Offending field; 0 when the failure is not about one field
+
+    bool ok() const { return reject == FixReject::NONE; }
+};
+
+// Validate a message against the FIX 4.4 dictionary compiled at build time
+// (scripts/gen_fix_dictionary.py): MsgType, header/body/trailer placement,
+// required fields including inside group entries, repeated tags, group
+// counts, value syntax per type and enumerated values. `fields` is the whole
+// message in wire order, BeginString through CheckSum. Allocation-free.
+FixValidation validateFixMessage(std::span<const FixField> fields);
+
+// Same for a raw SOH-delimited message; BodyLength and CheckSum values are
+// not verified
+FixValidation validateFixMessage(std::string_view raw);
+
+}  // namespace qfblotter
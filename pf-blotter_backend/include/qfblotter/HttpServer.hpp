@@ -1,6 +1,8 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <string>
@@ -8,6 +10,8 @@
 
 namespace qfblotter {
 
+class AdmissionControl;
+
 // Order request from UI
 struct OrderRequest {
     std::string clOrdId;
@@ -15,7 +19,24 @@ struct OrderRequest {
     char side;       // '1' = Buy, '2' = Sell
     int quantity;
     double price;
-    char orderType;  // '1' = Market, '2' = Limit (default)
+    char orderType;  // '1' = Market, '2' = Limit (default), '3' = Stop, '4' = StopLimit
+    double stopPrice{0.0};     // Trigger price, required for Stop / StopLimit
+    char timeInForce{'0'};     // FIX TimeInForce: '0' = DAY (default), '1' = GTC, '3' = IOC, '4' = FOK, '6' = GTD
+    int64_t expireTimeMs{0};   // Required for GTD, milliseconds since epoch
+    std::string parentId;      // Set for algo child orders, never from the UI
+};
+
+// Algo parent order request from UI
+struct AlgoRequest {
+    std::string clOrdId;
+    std::string symbol;
+    char side;                   // '1' = Buy, '2' = Sell
+    int quantity;
+    double price{0.0};           // Child limit price, 0 = market children
+    std::string strategy;        // TWAP, VWAP or POV
+    int durationSec{300};
+    int sliceSec{10};
+    double participation{0.1};   // POV only
 };
 
 // Amend request from UI
@@ -38,10 +59,21 @@ public:
     using OrderHandler = std::function<bool(const OrderRequest&, std::string&)>;
     using CancelHandler = std::function<bool(const CancelRequest&, std::string&)>;
     using AmendHandler = std::function<bool(const AmendRequest&, std::string&)>;
+    using AlgoHandler = std::function<bool(const AlgoRequest&, std::string&)>;
     using OrderBookProvider = std::function<std::string(const std::string&)>;
     using StatsProvider = std::function<std::string()>;
+    // Rolling-window stats for the last N seconds (0 = session)
+    using WindowStatsProvider = std::function<std::string(int64_t windowSec)>;
     using MarketDataProvider = std::function<std::string(const std::string&)>;
     using MarketHoursProvider = std::function<std::string()>;
+    using HistoryProvider = std::function<std::string(const std::string& symbol, const std::string& interval, int count)>;
+    // Empty clOrdId = summary; returns empty string for an unknown order
+    using TcaProvider = std::function<std::string(const std::string& clOrdId)>;
+    // Executions after the `since` cursor (at most `limit`), or with a
+    // clOrdId that order's executions; returns empty string for an unknown order
+    using ExecutionsProvider = std::function<std::string(uint64_t since, size_t limit, const std::string& clOrdId)>;
+    // Hot-standby promotion; returns a JSON status
+    using PromoteHandler = std::function<std::string()>;
 
     explicit HttpServer(int port, SnapshotProvider snapshotProvider);
     ~HttpServer();
@@ -49,15 +81,52 @@ public:
     void setOrderHandler(OrderHandler handler);
     void setCancelHandler(CancelHandler handler);
     void setAmendHandler(AmendHandler handler);
+    void setAlgoHandler(AlgoHandler handler);
     void setOrderBookProvider(OrderBookProvider provider);
     void setStatsProvider(StatsProvider provider);
+    void setWindowStatsProvider(WindowStatsProvider provider);
     void setMarketDataProvider(MarketDataProvider provider);
     void setMarketHoursProvider(MarketHoursProvider provider);
+    void setHistoryProvider(HistoryProvider provider);
+    void setTcaProvider(TcaProvider provider);
+    void setExecutionsProvider(ExecutionsProvider provider);
+    void setPromoteHandler(PromoteHandler handler);
+
+    // While read-only (a standby or read replica) every POST except /promote
+    // gets a 503 with `message`; set the message before start()
+    void setReadOnly(bool readOnly,
+                     const std::string& message = "Standby gateway: not accepting requests until promoted");
+
+    // Per-client-IP limits (default 60 orders, 30 cancels per minute); 0
+    // disables, e.g. on shards behind qf_router, which limits per client
+    void setRateLimits(int ordersPerMinute, int cancelsPerMinute);
+
+    // Pass /order, /algo, /amend and /cancel through `admission` (cancels
+    // first); shed requests get a 503 with Retry-After. Set before start()
+    void setAdmissionControl(AdmissionControl* admission);
+
+    // Concurrent identical GETs of /snapshot, /stats, /orderbook, /history and
+    // /tca share one computation; setCacheTtl also serves that result to
+    // later requests for `ttl` (path without query, e.g. "/stats"; default 0).
+    // Error answers (e.g. /tca 404) are never cached. Set before start()
+    void setCacheTtl(const std::string& path, std::chrono::milliseconds ttl);
+    // Drop the cached result for `key` (the path plus query, e.g. "/snapshot")
+    // once its source has changed, so the next request recomputes it
+    void invalidateCache(const std::string& key);
+
+    // Deepest per-client backlog of the order event stream (SSE)
+    size_t eventBacklog() const;
 
     void start();
     void stop();
 
     void publishEvent(const std::string& eventJson);
+    // Sent on /events as `event: stats`, alongside the order updates
+    void publishStats(const std::string& statsJson);
+    // Sent on /events as `event: terminal`: a JSON array of the ClOrdIDs
+    // that reached a terminal status since the last one (qf_router evicts
+    // their routes from it)
+    void publishTerminal(const std::string& clOrdIdsJson);
     void publishMarketData(const std::string& marketDataJson);
 
 private:
@@ -11,6 +11,13 @@ class Logger {
 public:
     static void init(const std::string& name, const std::string& logfile);
     static std::shared_ptr<spdlog::logger> get();
+    // Drain the async logger's queue and stop its worker; call at exit
+    static void shutdown();
+
+    // Calls shutdown() when it goes out of scope, on every exit path
+    struct ShutdownGuard {
+        ~ShutdownGuard() { Logger::shutdown(); }
+    };
 
 private:
     static std::shared_ptr<spdlog::logger> logger_;
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace qfblotter {
+
+struct MdUpdate {
+    std::string symbol;
+    double price{0.0};
+};
+
+// Per-subscriber market data subscriptions with last-value conflation.
+// Ticks only overwrite a pending price per symbol; drain() turns whatever
+// changed since the previous drain into one batch per subscription, so a
+// slow publish interval bounds outbound traffic instead of queueing ticks.
+class MarketDataConflator {
+public:
+    using Sink = std::function<void(const std::string& subscriber, const std::string& mdReqId,
+                                    const std::vector<MdUpdate>& updates)>;
+
+    // False if the subscriber already has a subscription with this MDReqID
+    bool subscribe(const std::string& subscriber, const std::string& mdReqId,
+                   const std::vector<std::string>& symbols);
+    bool unsubscribe(const std::string& subscriber, const std::string& mdReqId);
+    void removeSubscriber(const std::string& subscriber);
+
+    // Ignored for symbols nobody subscribes to
+    void onTick(const std::string& symbol, double price);
+
+    // Sink runs outside the lock; returns the number of batches delivered
+    size_t drain(const Sink& sink);
+
+    size_t subscriptionCount() const;
+
+private:
+    struct Subscription {
+        std::string subscriber;
+        std::string mdReqId;
+        std::vector<std::string> symbols;
+    };
+
+    static std::string key(const std::string& subscriber, const std::string& mdReqId);
+    void removeLocked(const std::string& subKey);
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, Subscription> subscriptions_;
+    std::unordered_map<std::string, std::vector<std::string>> bySymbol_;
+    std::unordered_map<std::string, double> pending_;
+};
+
+}  // namespace qfblotter
@@ -1,9 +1,11 @@
 #pragma once
 
+#include <functional>
 #include <mutex>
 #include <random>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace qfblotter {
@@ -32,21 +34,49 @@ struct OrderBook {
 
 class MarketSim {
 public:
+    // Called with every new trade price, after the internal lock is released
+    using TickListener = std::function<void(const std::string& symbol, double price)>;
+
     explicit MarketSim(unsigned int seed = 42, double startPrice = 100.0, double step = 0.05);
 
+    // Register before ticking starts; not synchronised with concurrent ticks
+    void addTickListener(TickListener listener);
+
+    // Called with every new trade price while the internal lock is still
+    // held, so calls arrive in the order prices changed and ahead of any
+    // fill priced off the tick (replication journal). Must not call back
+    // into MarketSim. Set before ticking starts.
+    void setTickJournal(TickListener journal);
+
+    // Create state for these symbols up front (at their reference prices,
+    // without ticking) so the first order or tick on each does not insert
+    void initSymbols(const std::vector<std::string>& symbols);
+
     double mark(const std::string& symbol);
+    // Midpoint of the simulated book's best bid and ask (mark if one side is empty)
+    double midPrice(const std::string& symbol);
     double nextTick(const std::string& symbol);
     bool shouldFill(const std::string& symbol, char side, double limitPx);
     
     // Partial fill support - returns how much to fill
     FillResult attemptFill(const std::string& symbol, char side, double limitPx, int leavesQty);
+
+    // Fill-or-kill: all of `qty` at the next tick if it is within the limit,
+    // otherwise nothing; the partial-fill ratio does not apply
+    FillResult attemptFillAll(const std::string& symbol, char side, double limitPx, int qty);
     
     // Get simulated order book for a symbol
     OrderBook getOrderBook(const std::string& symbol, int depth = 5);
 
+    // Replication: every symbol's last price, and setting one without
+    // notifying tick listeners (a standby must not trigger anything)
+    std::vector<std::pair<std::string, double>> lastPrices() const;
+    void restorePrice(const std::string& symbol, double price);
+
 private:
     // Internal helper - must be called with mutex held
     double nextTickUnsafe(const std::string& symbol);
+    void notifyTick(const std::string& symbol, double price);
     struct State {
         double last{0.0};
     };
@@ -59,6 +89,8 @@ private:
     double startPrice_;
     double step_;
     std::unordered_map<std::string, State> state_;
+    std::vector<TickListener> tickListeners_;
+    TickListener tickJournal_;
 };
 
 }  // namespace qfblotter
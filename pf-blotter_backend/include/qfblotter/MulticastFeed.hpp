@@ -0,0 +1,142 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "qfblotter/FeedProtocol.hpp"
+
+namespace qfblotter {
+
+struct MulticastConfig {
+    std::string group{"239.255.0.1"};
+    uint16_t port{30001};
+    std::string interfaceAddr{"127.0.0.1"};  // Local interface for send/join
+    int ttl{1};
+    bool loopback{true};                     // Deliver to receivers on this host
+    std::string recoveryHost{"127.0.0.1"};   // Subscriber side: where to recover from
+    uint16_t recoveryPort{30002};
+    size_t retain{65536};                    // Entries kept for retransmission
+};
+
+struct FeedTick {
+    std::string symbol;
+    double price{0.0};
+    int64_t volume{0};
+};
+
+// Publishes batches of ticks as sequence-numbered UDP multicast packets and
+// serves a TCP recovery port (retransmission of retained entries, or a
+// snapshot of the latest entry per symbol). Server cost per batch is the
+// same regardless of how many consumers have joined the group.
+class MulticastPublisher {
+public:
+    // Throws std::runtime_error if the sockets cannot be set up
+    explicit MulticastPublisher(const MulticastConfig& config);
+    ~MulticastPublisher();
+
+    MulticastPublisher(const MulticastPublisher&) = delete;
+    MulticastPublisher& operator=(const MulticastPublisher&) = delete;
+
+    void start();  // Recovery service
+    void stop();
+
+    // One batch is split into as few packets as fit the MTU
+    void publish(const std::vector<FeedTick>& ticks);
+
+    uint64_t lastSeq() const;
+    uint64_t packetsSent() const { return packetsSent_.load(std::memory_order_relaxed); }
+    uint64_t sendErrors() const { return sendErrors_.load(std::memory_order_relaxed); }
+    uint64_t recoveryRequests() const { return recoveryRequests_.load(std::memory_order_relaxed); }
+
+private:
+    void serve();
+    void handle(int fd);
+
+    MulticastConfig config_;
+    int udpFd_{-1};
+    int listenFd_{-1};
+    uint32_t groupIp_{0};  // Network byte order
+
+    mutable std::mutex mutex_;
+    std::vector<FeedEntry> journal_;        // Ring of the last `retain` entries
+    std::map<std::string, FeedEntry> latest_;
+    uint64_t nextSeq_{1};
+
+    std::atomic<uint64_t> packetsSent_{0};
+    std::atomic<uint64_t> sendErrors_{0};
+    std::atomic<uint64_t> recoveryRequests_{0};
+    std::atomic<bool> running_{false};
+    std::thread thread_;
+};
+
+// Consumer-side sequence tracking, independent of any socket
+class FeedSequencer {
+public:
+    struct Result {
+        uint64_t gapFrom{0};   // First missing sequence (gapCount > 0)
+        uint64_t gapCount{0};
+        uint16_t skip{0};      // Leading entries already seen
+    };
+
+    // A packet carrying [firstSeq, firstSeq + count) arrived
+    Result onPacket(uint64_t firstSeq, uint16_t count);
+    void reset(uint64_t nextSeq) { expected_ = nextSeq; }
+    uint64_t expected() const { return expected_; }
+
+private:
+    uint64_t expected_{0};  // 0 = not synchronised yet
+};
+
+// Joins the multicast group and delivers entries strictly in sequence,
+// filling gaps from the recovery service before later entries.
+class FeedSubscriber {
+public:
+    // seq is 0 for entries delivered from a snapshot
+    using Handler = std::function<void(uint64_t seq, const FeedEntry& entry)>;
+
+    // Throws std::runtime_error if the group cannot be joined
+    FeedSubscriber(const MulticastConfig& config, Handler handler);
+    ~FeedSubscriber();
+
+    FeedSubscriber(const FeedSubscriber&) = delete;
+    FeedSubscriber& operator=(const FeedSubscriber&) = delete;
+
+    // Wait up to timeoutMs for packets; returns entries delivered
+    size_t poll(int timeoutMs);
+
+    // Latest entry per symbol; the stream continues after it
+    bool snapshot();
+
+    // Resume at a sequence the consumer processed up to before a restart;
+    // the gap to the live stream is filled on the next packet
+    void resumeFrom(uint64_t nextSeq) { sequencer_.reset(nextSeq); }
+
+    // Fetch [fromSeq, fromSeq + count) over TCP; false if any are gone
+    bool retransmit(uint64_t fromSeq, uint32_t count, std::vector<FeedEntry>& out);
+
+    uint64_t expectedSeq() const { return sequencer_.expected(); }
+    uint64_t gapsRecovered() const { return gapsRecovered_; }
+    uint64_t entriesLost() const { return entriesLost_; }
+
+private:
+    // Collects the data packets of one recovery response; firstSeq is that
+    // of the first data packet and endSeq the END packet's next sequence
+    bool request(const FeedRecoveryRequest& req, std::vector<FeedEntry>& out,
+                 uint64_t& firstSeq, uint64_t& endSeq);
+    void deliver(uint64_t firstSeq, const FeedEntry* entries, size_t count, size_t skip);
+
+    MulticastConfig config_;
+    Handler handler_;
+    int fd_{-1};
+    FeedSequencer sequencer_;
+    uint64_t gapsRecovered_{0};
+    uint64_t entriesLost_{0};
+};
+
+}  // namespace qfblotter
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "qfblotter/TimerWheel.hpp"
+
+namespace qfblotter {
+
+// Drives DAY/GTD order expiry from a timer wheel on a background thread.
+// All orders due in the same tick are handed to the handler as one batch,
+// so a session-end expiry of thousands of orders is one callback.
+class OrderExpiry {
+public:
+    using ExpiryHandler = std::function<void(const std::vector<std::string>& clOrdIds)>;
+
+    explicit OrderExpiry(ExpiryHandler handler, int64_t tickMs = 100);
+    ~OrderExpiry();
+
+    void start();
+    void stop();
+
+    // Replaces any existing deadline for the order
+    void schedule(const std::string& clOrdId, int64_t deadlineMs);
+    void cancel(const std::string& clOrdId);
+
+    size_t pending() const;
+
+    // Expire everything due at `nowMs`; what the thread does each tick
+    void runDue(int64_t nowMs);
+
+    // Next occurrence of a daily UTC cutoff ("HH:MM:SS") strictly after nowMs
+    static int64_t nextDailyCutoffMs(const std::string& hhmmss, int64_t nowMs);
+
+private:
+    void run();
+
+    ExpiryHandler handler_;
+    mutable std::mutex mutex_;
+    TimerWheel wheel_;
+    std::unordered_map<std::string, TimerWheel::TimerId> timers_;
+    std::atomic<bool> running_{false};
+    std::thread thread_;
+};
+
+}  // namespace qfblotter
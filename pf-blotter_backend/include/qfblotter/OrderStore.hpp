@@ -1,10 +1,13 @@
 #pragma once
 
 #include <chrono>
+#include <functional>
+#include <memory_resource>
 #include <mutex>
 #include <optional>
 #include <shared_mutex>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
@@ -12,6 +15,26 @@
 
 namespace qfblotter {
 
+class RollingStats;
+
+// FIX TimeInForce (tag 59) values carried on OrderRecord
+constexpr char TIF_DAY = '0';
+constexpr char TIF_GTC = '1';
+constexpr char TIF_IOC = '3';
+constexpr char TIF_FOK = '4';
+constexpr char TIF_GTD = '6';
+
+// FIX OrdType (tag 40) values carried on OrderRecord
+constexpr char ORD_MARKET = '1';
+constexpr char ORD_LIMIT = '2';
+constexpr char ORD_STOP = '3';
+constexpr char ORD_STOP_LIMIT = '4';
+
+// Stop orders rest in this status until their trigger price trades
+inline constexpr const char* STATUS_PENDING_STOP = "PENDING_STOP";
+// Algo parent orders: never filled directly, only through their children
+inline constexpr const char* STATUS_WORKING = "WORKING";
+
 struct OrderRecord {
     std::string clOrdId;
     std::string orderId;
@@ -22,9 +45,16 @@ struct OrderRecord {
     int leavesQty{0};
     int cumQty{0};
     double avgPx{0.0};
+    double arrivalPx{0.0};     // Market mark when the order was received (TCA benchmark)
     std::string status;
     std::string rejectReason;
     std::string transactTime;
+    char timeInForce{'0'};     // FIX TimeInForce: 0=DAY 1=GTC 3=IOC 4=FOK 6=GTD
+    int64_t expireTimeMs{0};   // DAY/GTD expiry, milliseconds since epoch (0 = none)
+    char orderType{'2'};       // FIX OrdType: 1=Market 2=Limit 3=Stop 4=StopLimit
+    double stopPx{0.0};        // Trigger price for stop / stop-limit orders
+    std::string algo;          // Parent algo strategy (TWAP/VWAP/POV), empty otherwise
+    std::string parentId;      // Parent ClOrdID for algo child orders
     
     // Performance metrics
     int64_t submitTimeUs{0};   // Microseconds since epoch when order received
@@ -41,6 +71,15 @@ struct OrderStats {
     int filledOrders{0};
     int rejectedOrders{0};
     int canceledOrders{0};
+    int expiredOrders{0};
+    int pendingStopOrders{0};
+    int workingOrders{0};
+    // Algo parents (any status) and their progress; kept out of the
+    // notional totals, which their children already carry
+    int algoParents{0};
+    int64_t algoQty{0};
+    int64_t algoCumQty{0};
+    double algoFilledNotional{0.0};
     int64_t avgLatencyUs{0};
     int64_t minLatencyUs{0};
     int64_t maxLatencyUs{0};
@@ -51,17 +90,49 @@ struct OrderStats {
 
 class OrderStore {
 public:
+    // Invoked with the new state after every change, under the write lock so
+    // changes to one order are seen in order. Must be cheap and must not call
+    // back into the store. Add before the store is shared between threads.
+    using ChangeListener = std::function<void(const OrderRecord&)>;
+    void addChangeListener(ChangeListener listener);
+
+    // Record new orders, fills, rejects, cancels and ack latency into `stats`
+    // as they happen (algo parents are skipped: their children carry the
+    // flow). Attach after recovery so replayed orders are not counted.
+    void setFlowStats(RollingStats* stats);
+
     void upsert(const OrderRecord& record);
+    void upsert(OrderRecord&& record);  // Takes the record's strings instead of copying them
     void updateStatus(const std::string& clOrdId, const std::string& status,
                       int leavesQty, int cumQty, double avgPx);
     void reject(const std::string& clOrdId, const std::string& reason);
     void remove(const std::string& clOrdId);
 
+    // Size buckets, the arrival index and the node pool for this many more
+    // orders, so inserting them (by move) and updating them never reaches
+    // the global heap. Call at startup, before the store is shared.
+    void reserve(size_t orders);
+
+    // Expire a batch of orders under a single write lock. Orders that are
+    // no longer open are skipped; returns the records that were expired.
+    std::vector<OrderRecord> expireOrders(const std::vector<std::string>& clOrdIds);
+
     std::optional<OrderRecord> get(const std::string& clOrdId) const;
     bool exists(const std::string& clOrdId) const;
     
     // Get all orders that can still be filled (NEW or PARTIAL status)
     std::vector<OrderRecord> getOpenOrders() const;
+
+    // Every order, in arrival order
+    std::vector<OrderRecord> getAll() const;
+
+    // Get stop orders still waiting for their trigger price
+    std::vector<OrderRecord> getPendingStops() const;
+
+    // Activate a triggered stop order: PENDING_STOP -> NEW, Stop becoming
+    // Market and StopLimit becoming Limit. Returns the activated record, or
+    // nullopt if the order is no longer pending (canceled or expired).
+    std::optional<OrderRecord> activateStop(const std::string& clOrdId);
     
     // Get aggregate statistics
     OrderStats getStats() const;
@@ -74,8 +145,37 @@ private:
     // Readers (get, exists, getOpenOrders, getStats, snapshot) don't block each other
     // Writers (upsert, updateStatus, reject, remove) get exclusive access
     mutable std::shared_mutex mutex_;
-    std::unordered_map<std::string, OrderRecord> orders_;
-    std::vector<std::string> orderIndex_;
+
+    // Map nodes and index slots come from a pool that recycles freed blocks
+    // (only touched under the write lock). The key is a view of the node's
+    // own clOrdId, so indexing an order allocates no key string.
+    using OrderMap = std::pmr::unordered_map<std::string_view, OrderRecord>;
+    std::pmr::unsynchronized_pool_resource pool_;
+    OrderMap orders_{&pool_};
+    std::pmr::vector<const OrderRecord*> orderIndex_{&pool_};  // Arrival order; nodes never move
+    std::vector<ChangeListener> changeListeners_;
+    RollingStats* flowStats_{nullptr};
+
+    // What recordFlow compares against; `exists` is false for a new order
+    struct FlowState {
+        bool exists{false};
+        bool rejected{false};
+        bool canceled{false};
+        int cumQty{0};
+        double avgPx{0.0};
+        int64_t latencyUs{0};
+    };
+    static FlowState flowState(const OrderRecord& record);
+    void recordFlow(const FlowState& before, const OrderRecord& after) const;
+
+    void notifyChange(const OrderRecord& record) const;
+    template <typename Record>
+    void upsertLocked(Record&& record);
+    void rekey(OrderMap::iterator& it);
 };
 
+// JSON form shared by snapshots, persistence and replication
+Json orderToJson(const OrderRecord& order);
+OrderRecord orderFromJson(const Json& j);
+
 }  // namespace qfblotter
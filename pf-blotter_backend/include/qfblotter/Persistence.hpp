@@ -3,6 +3,7 @@
 #include <atomic>
 #include <chrono>
 #include <fstream>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
@@ -12,6 +13,8 @@
 
 namespace qfblotter {
 
+class AsyncFileWriter;
+
 // File-based persistence for order recovery
 // Saves order state to JSON file periodically and on shutdown
 class PersistenceManager {
@@ -51,6 +54,7 @@ private:
     std::atomic<int> saveCount_{0};
     int loadCount_{0};
     std::chrono::system_clock::time_point lastSaveTime_;
+    std::unique_ptr<AsyncFileWriter> writer_;  // The temp file, reopened per save; guarded by mutex_
 };
 
 }  // namespace qfblotter
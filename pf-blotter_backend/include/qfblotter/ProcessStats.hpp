@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+
+namespace qfblotter {
+
+// Resource usage of the current process, for /stats and soak tests. Fields
+// that cannot be read on this platform are -1.
+struct ProcessStats {
+    int64_t rssKB{-1};        // Resident set size
+    int64_t heapUsedKB{-1};   // malloc'd and not freed, mmap'd blocks included (glibc)
+    int64_t openFds{-1};
+    int64_t threads{-1};
+};
+
+ProcessStats sampleProcessStats();
+
+}  // namespace qfblotter
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "qfblotter/BoundedQueue.hpp"
+#include "qfblotter/OrderStore.hpp"
+
+namespace qfblotter {
+
+// Next expected FIX sequence numbers for one session
+struct FixSeqState {
+    std::string session;  // SessionID::toString()
+    int senderSeq{0};
+    int targetSeq{0};
+};
+
+// Everything a standby needs to start from
+struct ReplicationSnapshot {
+    std::vector<OrderRecord> orders;
+    std::vector<std::pair<std::string, double>> prices;
+    std::vector<FixSeqState> fixSeqs;
+};
+
+// Journal shipping, primary side. Serves up to `maxFollowers` followers
+// (hot standbys and read replicas) over TCP as newline-delimited JSON: on
+// connect a full snapshot, then every journalled event in order, plus a
+// heartbeat each second so a follower can measure lag while idle. Events
+// are full states (an order's record, a symbol's last price), so a follower
+// converges even when events that were queued while its snapshot was taken
+// replay older states first.
+//
+// publish*() never blocks: a follower that falls behind far enough to fill
+// its queue, or whose socket accepts nothing for a few seconds, is
+// disconnected and resynchronises from a new snapshot. Sends time out, so
+// stop() and the reaper never wait on a stalled follower.
+class ReplicationPrimary {
+public:
+    using SnapshotProvider = std::function<ReplicationSnapshot()>;
+
+    ReplicationPrimary(uint16_t port, SnapshotProvider snapshot, size_t queueCapacity = 65536,
+                       size_t maxFollowers = 4);
+    ~ReplicationPrimary();
+
+    void start();  // Throws std::runtime_error if the port cannot be bound
+    void stop();
+
+    void publishOrder(const OrderRecord& record);
+    void publishTick(const std::string& symbol, double price);
+    void publishFixSeq(const FixSeqState& state);
+    // One market data batch exactly as published to /marketdata, so
+    // followers can fan it out unchanged
+    void publishMarketData(const Json& ticks);
+
+    size_t followers() const { return followerCount_.load(std::memory_order_relaxed); }
+    uint64_t lastSeq() const { return seq_.load(std::memory_order_relaxed); }
+    uint64_t resyncs() const { return resyncs_.load(std::memory_order_relaxed); }
+
+private:
+    struct Follower {
+        explicit Follower(size_t capacity) : queue(capacity) {}
+        int fd{-1};
+        BoundedQueue<std::string> queue;
+        std::atomic<bool> overflowed{false};
+        std::atomic<bool> done{false};
+        std::thread thread;
+    };
+
+    void run();
+    void stream(Follower& follower);
+    void enqueue(Json event);
+    void reap(bool all);
+
+    uint16_t port_;
+    SnapshotProvider snapshot_;
+    size_t queueCapacity_;
+    size_t maxFollowers_;
+    int listenFd_{-1};
+    std::mutex followersMutex_;  // Guards followers_ and orders seq_ with the pushes
+    std::vector<std::unique_ptr<Follower>> followers_;
+    std::atomic<size_t> followerCount_{0};
+    std::atomic<uint64_t> seq_{0};
+    std::atomic<uint64_t> resyncs_{0};
+    std::atomic<bool> running_{false};
+    std::thread thread_;
+};
+
+// Follower side, for a hot standby or a read replica: connects to the
+// primary (retrying until it is up), applies the snapshot and the event
+// stream through the handlers, and stops on promote(). Handlers run on the
+// replication thread. A line it cannot apply (malformed JSON, a missing or
+// mistyped field, a handler throwing) drops the connection, and the
+// follower resyncs from a new snapshot.
+class ReplicationStandby {
+public:
+    struct Handlers {
+        std::function<void(const OrderRecord&)> onOrder;
+        std::function<void(const std::string& symbol, double price)> onTick;
+        std::function<void(const FixSeqState&)> onFixSeq;
+        std::function<void(const Json& ticks)> onMarketData;
+    };
+
+    ReplicationStandby(std::string host, uint16_t port, Handlers handlers);
+    ~ReplicationStandby();
+
+    void start();
+    // Stop applying; returns once the replication thread has exited
+    void promote();
+
+    // Latest FIX sequence numbers received, for use at promotion
+    std::vector<FixSeqState> fixSeqs() const;
+
+    bool connected() const { return connected_.load(std::memory_order_relaxed); }
+    bool synced() const { return synced_.load(std::memory_order_relaxed); }  // Snapshot applied
+    uint64_t lastSeq() const { return lastSeq_.load(std::memory_order_relaxed); }
+    uint64_t eventsApplied() const { return applied_.load(std::memory_order_relaxed); }
+    // Primary timestamp to apply time of the last event or heartbeat
+    int64_t lagUs() const { return lagUs_.load(std::memory_order_relaxed); }
+
+private:
+    void run();
+    void session(int fd);
+    void apply(const std::string& line);  // Throws on a line it cannot apply
+
+    std::string host_;
+    uint16_t port_;
+    Handlers handlers_;
+    mutable std::mutex fixSeqMutex_;
+    std::vector<FixSeqState> fixSeqs_;
+    std::atomic<bool> connected_{false};
+    std::atomic<bool> synced_{false};
+    std::atomic<uint64_t> lastSeq_{0};
+    std::atomic<uint64_t> applied_{0};
+    std::atomic<int64_t> lagUs_{0};
+    std::atomic<bool> running_{false};
+    std::thread thread_;
+};
+
+}  // namespace qfblotter
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "qfblotter/Json.hpp"
+
+namespace qfblotter {
+
+// Order flow and order-to-ack latency over rolling windows. Events land in a
+// ring of per-second buckets (counts, notional and a log-linear latency
+// histogram), so recording is O(1); a window is the merge of its buckets at
+// read time. The session totals are kept alongside and never roll off.
+class RollingStats {
+public:
+    static constexpr int64_t MAX_WINDOW_SEC = 300;
+
+    enum class Flow { ORDER, FILL, REJECT, CANCEL };
+
+    struct Window {
+        int64_t seconds{0};  // Span covered; for the session, seconds since it started
+        uint64_t orders{0};
+        uint64_t fills{0};
+        uint64_t rejects{0};
+        uint64_t cancels{0};
+        double notional{0.0};        // Of new orders
+        double filledNotional{0.0};  // Of fills
+        uint64_t latencySamples{0};
+        int64_t avgLatencyUs{0};
+        int64_t p50LatencyUs{0};     // Percentiles are histogram bin upper bounds (within 12.5%)
+        int64_t p90LatencyUs{0};
+        int64_t p99LatencyUs{0};
+        int64_t maxLatencyUs{0};
+    };
+
+    RollingStats();                        // Session starts now
+    explicit RollingStats(int64_t startSec);
+
+    // `nowSec` is the epoch second (CoarseClock when omitted)
+    void record(Flow flow, double notional, int64_t nowSec);
+    void record(Flow flow, double notional = 0.0);
+    void recordLatency(int64_t latencyUs, int64_t nowSec);
+    void recordLatency(int64_t latencyUs);
+
+    // The last `seconds` (1..MAX_WINDOW_SEC, the current second included),
+    // or the whole session for 0
+    Window window(int64_t seconds, int64_t nowSec) const;
+    Window window(int64_t seconds) const;
+    Json windowJson(int64_t seconds) const;
+
+    // "60s", "5m", "300" or "session" (0); -1 if not a supported window
+    static int64_t parseWindow(const std::string& text);
+
+private:
+    // Values below 16us are exact; above, 8 bins per power of two
+    static constexpr size_t LATENCY_BINS = 16 + 32 * 8;
+
+    struct Bucket {
+        int64_t second{-1};
+        std::array<uint64_t, 4> flows{};
+        double notional{0.0};
+        double filledNotional{0.0};
+        uint64_t latencyCount{0};
+        int64_t latencySumUs{0};
+        int64_t latencyMaxUs{0};
+        std::array<uint32_t, LATENCY_BINS> latency{};
+    };
+
+    Bucket& bucketLocked(int64_t nowSec);
+    static void merge(Window& out, const Bucket& bucket, std::array<uint64_t, LATENCY_BINS>& histogram);
+    static void finish(Window& out, const std::array<uint64_t, LATENCY_BINS>& histogram);
+    static size_t latencyBin(int64_t us);
+    static int64_t binUpperUs(size_t bin);
+
+    const int64_t startSec_;
+    mutable std::mutex mutex_;
+    std::vector<Bucket> ring_;
+    Bucket session_;
+};
+
+}  // namespace qfblotter
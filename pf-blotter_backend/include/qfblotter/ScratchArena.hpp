@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+
+namespace qfblotter {
+
+// Per-thread bump allocator for request-scoped temporaries (strings and
+// containers that live only while one message is handled). Allocation is a
+// pointer bump in a fixed thread-local buffer; a request that outgrows it
+// spills to the heap. The outermost Scope on a thread rewinds the arena, so
+// nothing allocated from resource() may outlive that Scope.
+//
+//     ScratchArena::Scope scope;
+//     std::pmr::string line{ScratchArena::resource()};
+class ScratchArena {
+public:
+    static constexpr size_t CAPACITY = 64 * 1024;
+
+    static std::pmr::memory_resource* resource();
+
+    class Scope {
+    public:
+        Scope();
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+};
+
+}  // namespace qfblotter
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "qfblotter/Json.hpp"
+
+namespace qfblotter {
+
+// Consistent hashing of symbols onto named shards. Each shard owns
+// `virtualNodes` points on a 64-bit ring and a symbol belongs to the first
+// point at or after its hash, so adding a shard only moves the symbols that
+// land on the new shard's points (about 1/N of them). The hash is FNV-1a,
+// stable across processes and builds, so a router and its gateways agree.
+class ShardRing {
+public:
+    explicit ShardRing(std::vector<std::string> shards, int virtualNodes = 64);
+
+    size_t shardFor(std::string_view symbol) const;
+    const std::string& name(size_t shard) const { return shards_[shard]; }
+    size_t size() const { return shards_.size(); }
+
+    static uint64_t hash(std::string_view key);
+
+private:
+    std::vector<std::string> shards_;
+    std::vector<std::pair<uint64_t, uint32_t>> ring_;  // (point, shard), sorted
+};
+
+// Shard names used by qf_router and the gateways' ShardIndex/ShardCount
+std::vector<std::string> defaultShardNames(size_t count);
+
+// Merging shard responses for the router. Shards that failed to answer are
+// passed as null and skipped.
+
+// Order snapshots (arrays) concatenated in shard order
+Json mergeSnapshots(const std::vector<Json>& shards);
+
+// Counters on an explicit allow-list summed, in nested objects too. Other
+// numbers are gauges: latency and admission-latency averages weighted by
+// order and admission counts, min/max/p99 latency taken as the min/max over
+// shards (p99 is therefore an upper bound), the rest as the max over shards.
+// Gauges and fields that cannot be summed (strings, flags, arrays such as
+// the venue lists) are kept per shard under "byShard", null for a down shard.
+Json mergeStats(const std::vector<Json>& shards);
+
+// Rolling-window stats (RollingStats::windowJson) for the same window:
+// counts, notionals and rates summed, latency average weighted by samples,
+// percentiles and max taken as the max over shards (upper bounds)
+Json mergeWindowStats(const std::vector<Json>& shards);
+
+// TCA summaries: buckets concatenated (symbols are disjoint), totals recombined
+Json mergeTcaSummaries(const std::vector<Json>& shards);
+
+}  // namespace qfblotter
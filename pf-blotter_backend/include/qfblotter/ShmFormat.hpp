@@ -0,0 +1,97 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace qfblotter {
+
+// Binary layout of the shared-memory feed, shared by the gateway's
+// ShmPublisher and the ShmReader client library. Any change to these
+// structs must bump SHM_VERSION.
+//
+// The segment is a ShmHeader followed by slotCount ShmSlots (a power of
+// two). Record n lives in slot n & (slotCount - 1). Each slot is a seqlock:
+// the writer sets seq to 2n-1 while copying and 2n once the record is
+// complete, so a reader can tell "not written yet", "being written" and
+// "overwritten by a later lap" apart without any syscall or lock.
+
+inline constexpr uint64_t SHM_MAGIC = 0x5146424C4F545452ULL;  // "QFBLOTTR"
+inline constexpr uint32_t SHM_VERSION = 1;
+
+enum class ShmRecordType : uint16_t {
+    TICK = 1,
+    ORDER = 2,
+};
+
+struct ShmTick {
+    char symbol[16];
+    double price;
+};
+
+// Order state after a change; strings are NUL-padded and may be truncated
+struct ShmOrderEvent {
+    char clOrdId[32];
+    char symbol[16];
+    char status[16];
+    char side;
+    char orderType;
+    char timeInForce;
+    char reserved[5];
+    double price;
+    double avgPx;
+    int32_t quantity;
+    int32_t leavesQty;
+    int32_t cumQty;
+    int32_t reserved2;
+};
+
+struct ShmRecord {
+    ShmRecordType type;
+    uint16_t reserved{0};
+    uint32_t reserved2{0};
+    int64_t timestampNs;  // Publisher wall clock, nanoseconds since epoch
+    union {
+        ShmTick tick;
+        ShmOrderEvent order;
+    };
+};
+
+struct alignas(64) ShmSlot {
+    std::atomic<uint64_t> seq;
+    ShmRecord record;
+};
+
+struct alignas(64) ShmHeader {
+    std::atomic<uint64_t> magic;  // Written last, once the header is valid
+    uint32_t version;
+    uint32_t slotCount;
+    uint32_t slotSize;
+    uint32_t reserved;
+    alignas(64) std::atomic<uint64_t> writeSeq;  // Last published record (0 = none)
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "shared-memory atomics must be lock-free");
+static_assert(sizeof(ShmRecord) == 120, "ShmRecord layout changed");
+static_assert(sizeof(ShmSlot) == 128, "ShmSlot must stay two cache lines");
+static_assert(sizeof(ShmHeader) == 128, "ShmHeader layout changed");
+
+inline size_t shmSegmentSize(uint32_t slotCount) {
+    return sizeof(ShmHeader) + static_cast<size_t>(slotCount) * sizeof(ShmSlot);
+}
+
+// Copy into a fixed-width field, truncating and NUL-padding
+template <size_t N>
+void shmCopyField(char (&dst)[N], const std::string& src) {
+    std::memset(dst, 0, N);
+    std::memcpy(dst, src.data(), src.size() < N ? src.size() : N);
+}
+
+template <size_t N>
+std::string shmFieldString(const char (&src)[N]) {
+    return std::string(src, strnlen(src, N));
+}
+
+}  // namespace qfblotter
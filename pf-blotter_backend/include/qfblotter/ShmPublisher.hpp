@@ -0,0 +1,48 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+#include "qfblotter/ShmFormat.hpp"
+
+namespace qfblotter {
+
+struct OrderRecord;
+
+// Writes ticks and order events into a POSIX shared-memory ring (see
+// ShmFormat.hpp) for co-located consumers using ShmReader. Producers on
+// different threads are serialised by a short lock so the ring itself only
+// ever has a single writer. The ring never waits for readers: a reader that
+// falls a full lap behind is told how many records it lost.
+class ShmPublisher {
+public:
+    // `name` is a POSIX shm name such as "/qfblotter_feed"; slotCount is
+    // rounded up to a power of two. Throws std::runtime_error on failure.
+    explicit ShmPublisher(const std::string& name, uint32_t slotCount = 65536);
+    ~ShmPublisher();
+
+    ShmPublisher(const ShmPublisher&) = delete;
+    ShmPublisher& operator=(const ShmPublisher&) = delete;
+
+    void publishTick(const std::string& symbol, double price);
+    void publishOrder(const OrderRecord& record);
+
+    uint64_t published() const { return published_.load(std::memory_order_relaxed); }
+    uint32_t slotCount() const { return slotCount_; }
+
+private:
+    void write(ShmRecord& record);
+
+    std::string name_;
+    uint32_t slotCount_;
+    size_t size_;
+    ShmHeader* header_{nullptr};
+    ShmSlot* slots_{nullptr};
+    std::mutex writeMutex_;
+    uint64_t nextSeq_{1};
+    std::atomic<uint64_t> published_{0};
+};
+
+}  // namespace qfblotter
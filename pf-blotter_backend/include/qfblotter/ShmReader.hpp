@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "qfblotter/ShmFormat.hpp"
+
+namespace qfblotter {
+
+// Client for the gateway's shared-memory feed. Opening the segment costs a
+// few syscalls; poll() afterwards only reads mapped memory, so a consumer
+// can busy-poll with no kernel involvement. One reader per thread.
+class ShmReader {
+public:
+    enum class Poll {
+        RECORD,   // `out` holds the next record
+        EMPTY,    // Nothing new yet
+        OVERRUN,  // Fell a full lap behind; lost() records were skipped
+    };
+
+    // Starts at the next record published; with `replay` it starts at the
+    // oldest record still in the ring. Throws std::runtime_error if the
+    // segment is missing or from an incompatible version.
+    explicit ShmReader(const std::string& name, bool replay = false);
+    ~ShmReader();
+
+    ShmReader(const ShmReader&) = delete;
+    ShmReader& operator=(const ShmReader&) = delete;
+
+    Poll poll(ShmRecord& out);
+
+    uint64_t nextSeq() const { return nextSeq_; }
+    uint64_t lost() const { return lost_; }
+
+private:
+    void resync();
+
+    size_t size_{0};
+    const ShmHeader* header_{nullptr};
+    const ShmSlot* slots_{nullptr};
+    uint64_t mask_{0};
+    uint64_t nextSeq_{1};
+    uint64_t lost_{0};
+};
+
+}  // namespace qfblotter
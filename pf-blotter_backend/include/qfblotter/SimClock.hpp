@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+
+namespace qfblotter {
+
+// Process-wide time source for simulated activity: timestamps, expiry and
+// algo timers, the event scheduler and the simulation loops. Real by
+// default (system clock for epoch time, steady clock for intervals). In
+// virtual mode both read one counter that only moves when a driver
+// advances it, so a run takes as long as its work and, driven from one
+// thread, replays identically.
+class SimClock {
+public:
+    // Switch to virtual time starting at `startEpochMs`; setReal() switches back
+    static void setVirtual(int64_t startEpochMs);
+    static void setReal();
+    static bool isVirtual();
+
+    static int64_t epochMs();
+    static int64_t epochUs();
+    // Monotonic; in virtual mode the same counter as epochUs()
+    static int64_t steadyUs();
+
+    // Virtual mode only; time never moves backwards
+    static void advanceTo(int64_t epochUs);
+    static void advanceBy(int64_t us);
+};
+
+}  // namespace qfblotter
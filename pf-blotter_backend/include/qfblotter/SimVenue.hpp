@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "qfblotter/MarketSim.hpp"
+
+namespace qfblotter {
+
+struct VenueConfig {
+    std::string name;
+    int64_t latencyUs{500};      // Median one-way order latency
+    int64_t jitterUs{100};       // Standard deviation around it
+    double feePerShare{0.0030};  // Taker fee; negative is a rebate
+    double dislocationBps{2.0};  // Standard deviation of the venue mid around the reference
+    unsigned seed{1};
+};
+
+// "NAME:latencyUs:jitterUs:feePerShare,..." (e.g. "ARCA:400:80:0.003");
+// throws std::runtime_error on a malformed entry
+std::vector<VenueConfig> parseVenues(const std::string& spec);
+
+// What a child order took from a venue's book
+struct VenueFill {
+    int qty{0};
+    double avgPx{0.0};
+    double fee{0.0};  // qty x feePerShare
+};
+
+// A simulated exchange: its own MarketSim book, quoted around a reference
+// price (the consolidated mark) with a per-quote dislocation, plus a latency
+// distribution and a fee schedule. Thread-safe.
+class SimVenue {
+public:
+    explicit SimVenue(VenueConfig config);
+
+    const VenueConfig& config() const { return config_; }
+
+    OrderBook quote(const std::string& symbol, double referencePx, int depth = 5);
+
+    // Take up to `qty` from the book as quoted now, walking levels no worse
+    // than `limitPx` (<= 0 for no limit)
+    VenueFill execute(const std::string& symbol, char side, double limitPx, int qty, double referencePx);
+
+    // One draw from the latency distribution, floored at a quarter of the median
+    int64_t sampleLatencyUs();
+
+private:
+    VenueConfig config_;
+    MarketSim book_;
+    std::mutex mutex_;  // A quote is restorePrice + getOrderBook on book_
+    std::mt19937 rng_;
+    std::normal_distribution<double> unit_{0.0, 1.0};
+};
+
+}  // namespace qfblotter
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace qfblotter {
+
+// Coalesces concurrent computations of the same key: the first caller runs
+// `compute`, callers arriving while it runs wait for and share its result,
+// and the result is then served from cache for `ttl` (0 = not cached, only
+// shared with callers that were already waiting). An exception from
+// `compute` reaches every waiter and is not cached, and neither is an empty
+// result (the providers' "not found", answered as an error).
+class SingleFlight {
+public:
+    using Result = std::shared_ptr<const std::string>;
+
+    // Expired results are pruned once `maxEntries` keys are held
+    explicit SingleFlight(size_t maxEntries = 1024);
+
+    Result get(const std::string& key, std::chrono::milliseconds ttl, const std::function<std::string()>& compute);
+
+    // The source changed: drop the cached result for `key`. A computation
+    // already running still answers its waiters, but later callers start a
+    // new one and its result is not cached.
+    void invalidate(const std::string& key);
+
+    uint64_t computed() const { return computed_.load(std::memory_order_relaxed); }
+    uint64_t coalesced() const { return coalesced_.load(std::memory_order_relaxed); }
+    uint64_t cacheHits() const { return cacheHits_.load(std::memory_order_relaxed); }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Entry {
+        std::shared_future<Result> result;
+        bool done{false};
+        Clock::time_point expires{};
+        uint64_t id{0};  // Tells the leader its entry from a newer one after invalidate()
+    };
+
+    void pruneLocked(Clock::time_point now);
+
+    const size_t maxEntries_;
+    std::mutex mutex_;
+    std::unordered_map<std::string, Entry> entries_;
+    uint64_t nextId_{0};
+    std::atomic<uint64_t> computed_{0};
+    std::atomic<uint64_t> coalesced_{0};
+    std::atomic<uint64_t> cacheHits_{0};
+};
+
+}  // namespace qfblotter
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "qfblotter/EventScheduler.hpp"
+#include "qfblotter/SimVenue.hpp"
+
+namespace qfblotter {
+
+// One venue's share of a routed order
+struct RouteSlice {
+    size_t venue{0};
+    int qty{0};
+    double expectedPx{0.0};  // Average over the quoted levels it was sized on
+};
+
+// A slice's outcome, reported when it returns from the venue
+struct VenueExecution {
+    std::string clOrdId;
+    std::string venue;
+    int sentQty{0};
+    int fillQty{0};  // 0 when the book moved away before the slice arrived
+    double fillPx{0.0};
+    double expectedPx{0.0};
+    double fee{0.0};
+    int64_t latencyUs{0};  // Order to venue and back
+};
+
+struct VenueStats {
+    std::string name;
+    uint64_t slices{0};
+    uint64_t sentQty{0};
+    uint64_t filledQty{0};
+    uint64_t bustedQty{0};  // Filled at the venue but refused by the handler
+    double fees{0.0};
+    int64_t avgLatencyUs{0};
+};
+
+// Smart order routing over simulated venues. An order is split across the
+// venues' visible liquidity within its limit, cheapest first by effective
+// price: the level price plus the venue's fee plus the expected adverse
+// drift over its latency. Each slice travels on the EventScheduler: it
+// executes against the venue's book as quoted when it arrives, and its
+// result comes back after the return leg. An order with slices out is in
+// flight and is not routed again until they have all returned.
+class SmartOrderRouter {
+public:
+    // Returns the quantity it booked; the rest of the fill counts as busted
+    using ExecutionHandler = std::function<int(const VenueExecution&)>;
+    using ReferencePrice = std::function<double(const std::string& symbol)>;
+
+    SmartOrderRouter(const std::vector<VenueConfig>& venues, EventScheduler& scheduler, ReferencePrice reference,
+                     double latencyPenaltyBpsPerMs = 0.5);
+
+    // Slices for `qty` given one book per venue (same order as the venues)
+    std::vector<RouteSlice> plan(char side, double limitPx, int qty, const std::vector<OrderBook>& books) const;
+
+    // Quote every venue and send the planned slices. `onExecution` runs on
+    // the scheduler thread once per slice. Returns the quantity sent: 0 if
+    // nothing is available within the limit or the order is in flight.
+    int route(const std::string& clOrdId, const std::string& symbol, char side, double limitPx, int qty,
+              ExecutionHandler onExecution);
+
+    bool inFlight(const std::string& clOrdId) const;
+    size_t venueCount() const { return venues_.size(); }
+    std::vector<VenueStats> stats() const;
+
+private:
+    void complete(const std::string& clOrdId, size_t venue, const VenueExecution& execution, int booked);
+
+    std::vector<std::unique_ptr<SimVenue>> venues_;
+    EventScheduler& scheduler_;
+    ReferencePrice reference_;
+    double latencyPenaltyBpsPerMs_;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, int> inFlight_;  // clOrdId -> slices out
+    std::vector<VenueStats> stats_;
+    std::vector<int64_t> latencySumUs_;
+};
+
+}  // namespace qfblotter
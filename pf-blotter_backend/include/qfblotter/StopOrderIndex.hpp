@@ -0,0 +1,57 @@
+#pragma once
+
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace qfblotter {
+
+// A stop order whose trigger price has been reached
+struct StopTrigger {
+    std::string clOrdId;
+    std::string symbol;
+    char side{'1'};
+    double stopPx{0.0};
+    double triggerPx{0.0};  // Market price that triggered it
+};
+
+// Per-symbol sorted trigger index for resting stop / stop-limit orders.
+// Buy stops trigger when the market trades at or above the stop price,
+// sell stops at or below. Each side is kept sorted so the nearest stop is
+// always at begin(): a tick costs O(1) when nothing triggers and
+// O(log n + triggered) otherwise.
+class StopOrderIndex {
+public:
+    void add(const std::string& clOrdId, const std::string& symbol, char side, double stopPx);
+    bool remove(const std::string& clOrdId);
+
+    // Remove every stop triggered by `price`, appending them nearest-first
+    void onTick(const std::string& symbol, double price, std::vector<StopTrigger>& triggered);
+
+    size_t size() const;
+
+private:
+    using BuyStops = std::multimap<double, std::string>;                        // Lowest stop first
+    using SellStops = std::multimap<double, std::string, std::greater<double>>;  // Highest stop first
+
+    struct Book {
+        BuyStops buys;
+        SellStops sells;
+    };
+
+    struct Location {
+        std::string symbol;
+        char side{'1'};
+        BuyStops::iterator buyIt;
+        SellStops::iterator sellIt;
+    };
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, Book> books_;
+    std::unordered_map<std::string, Location> locations_;  // clOrdId -> position for O(log n) removal
+};
+
+}  // namespace qfblotter
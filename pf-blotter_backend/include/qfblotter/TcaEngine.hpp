@@ -0,0 +1,107 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include "qfblotter/Json.hpp"
+
+namespace qfblotter {
+
+struct OrderRecord;
+
+// Per-order transaction cost state, updated on each fill
+struct OrderTca {
+    std::string symbol;
+    char side{'1'};
+    double arrivalPx{0.0};
+    double mktNotionalAtArrival{0.0};  // Symbol market totals when the order arrived,
+    int64_t mktVolumeAtArrival{0};     // used to derive interval VWAP in O(1)
+    double mktNotionalAtEnd{0.0};      // ... and when it became terminal
+    int64_t mktVolumeAtEnd{0};
+    bool done{false};
+    int64_t filledQty{0};
+    double filledNotional{0.0};
+    double shortfallCost{0.0};         // Implementation shortfall vs arrival, currency
+};
+
+// Aggregated cost for one symbol/side
+struct TcaBucket {
+    int orders{0};
+    int fills{0};
+    int64_t filledQty{0};
+    double filledNotional{0.0};
+    double arrivalNotional{0.0};  // Sum of arrivalPx * fillQty
+    double shortfallCost{0.0};
+    double vwapNotional{0.0};     // Sum of market VWAP (at fill) * fillQty
+    double vwapCost{0.0};
+};
+
+// Incremental transaction cost analysis.
+// Every update is O(1): per-order and per-bucket running sums, plus
+// cumulative market notional/volume per symbol so interval VWAP over an
+// order's lifetime is a difference of two snapshots rather than a scan.
+// The market totals come from the tick stream's prints, not the blotter's
+// own fills, so VWAP slippage measures against the market.
+// Costs are signed so that positive means worse than the benchmark.
+// Terminal orders leave the live table; the last `finishedCapacity` of
+// them stay available to orderJson().
+class TcaEngine {
+public:
+    explicit TcaEngine(size_t finishedCapacity = 10000) : finishedCapacity_(finishedCapacity) {}
+
+    // Register an accepted order with its arrival mark
+    void onArrival(const std::string& clOrdId, const std::string& symbol, char side, double arrivalPx);
+
+    // Record an execution. Orders not seen at arrival (e.g. recovered from
+    // persistence) are registered from the record's stored arrivalPx. If
+    // the fill completes the order, it is retired.
+    void onFill(const OrderRecord& order, int fillQty, double fillPx);
+
+    // A market print (tick price and volume): the VWAP benchmark
+    void onMarketPrint(const std::string& symbol, double price, int64_t qty);
+
+    // The order was canceled, expired or rejected
+    void onTerminal(const std::string& clOrdId);
+
+    // Follow a cancel/replace that changed the ClOrdID
+    void rename(const std::string& oldClOrdId, const std::string& newClOrdId);
+
+    double marketVwap(const std::string& symbol) const;
+    size_t liveOrders() const;
+
+    std::optional<Json> orderJson(const std::string& clOrdId) const;
+    Json summaryJson() const;
+
+private:
+    // Market totals and cost buckets for one symbol (index 0 = buy, 1 = sell)
+    struct SymbolTca {
+        double mktNotional{0.0};
+        int64_t mktVolume{0};
+        std::array<TcaBucket, 2> sides;
+    };
+
+    static double sideSign(char side) { return side == '2' ? -1.0 : 1.0; }
+    static size_t sideIndex(char side) { return side == '2' ? 1 : 0; }
+    static double bps(double cost, double notional) {
+        return notional > 0.0 ? cost / notional * 10'000.0 : 0.0;
+    }
+
+    OrderTca& registerUnlocked(const std::string& clOrdId, const std::string& symbol,
+                               char side, double arrivalPx);
+    void retireUnlocked(const std::string& clOrdId);
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, OrderTca> orders_;    // Live
+    std::unordered_map<std::string, OrderTca> finished_;  // Most recent terminal orders
+    std::deque<std::string> finishedOrder_;               // Oldest first
+    size_t finishedCapacity_;
+    std::unordered_map<std::string, SymbolTca> symbols_;
+};
+
+}  // namespace qfblotter
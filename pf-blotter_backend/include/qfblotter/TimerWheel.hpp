@@ -0,0 +1,66 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace qfblotter {
+
+// Hierarchical timer wheel (4 levels x 256 slots) keyed by string IDs.
+// schedule() and cancel() are O(1); advance() costs O(expired) plus an
+// amortized cascade of far-out timers into lower levels. With a 100ms tick
+// the wheel spans ~13 years; later deadlines are parked in the top level and
+// re-placed on cascade.
+// Not thread-safe - owners serialize access.
+class TimerWheel {
+public:
+    using TimerId = uint64_t;
+    static constexpr TimerId INVALID_TIMER = 0;
+
+    TimerWheel(int64_t tickMs, int64_t startMs);
+
+    // Deadlines at or before the current time fire on the next advance()
+    TimerId schedule(const std::string& key, int64_t deadlineMs);
+
+    // Returns false if the timer already fired or was cancelled
+    bool cancel(TimerId id);
+
+    // Move time forward to nowMs, appending keys of all due timers
+    size_t advance(int64_t nowMs, std::vector<std::string>& expired);
+
+    size_t size() const { return active_; }
+    int64_t tickMs() const { return tickMs_; }
+
+private:
+    static constexpr int LEVELS = 4;
+    static constexpr int SLOT_BITS = 8;
+    static constexpr uint32_t SLOTS = 1u << SLOT_BITS;
+    static constexpr uint32_t SLOT_MASK = SLOTS - 1;
+    static constexpr uint32_t NIL = UINT32_MAX;
+
+    struct Node {
+        std::string key;
+        uint64_t deadlineTick{0};
+        uint32_t prev{NIL};
+        uint32_t next{NIL};
+        uint32_t generation{0};
+        int level{-1};       // -1 = free
+        uint32_t slot{0};
+    };
+
+    void place(uint32_t index);
+    void unlink(uint32_t index);
+    void release(uint32_t index);
+    void cascade(int level);
+
+    int64_t tickMs_;
+    int64_t startMs_;
+    uint64_t currentTick_{0};
+    size_t active_{0};
+    std::vector<Node> nodes_;
+    std::vector<uint32_t> freeList_;
+    std::array<std::array<uint32_t, SLOTS>, LEVELS> heads_;
+};
+
+}  // namespace qfblotter
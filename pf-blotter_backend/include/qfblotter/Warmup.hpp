@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace qfblotter {
+
+struct WarmupOptions {
+    std::vector<std::string> symbols;
+    size_t syntheticOrders{5000};  // Driven through a shadow store/market/TCA/bars
+    size_t prefaultBytes{0};       // Main-arena heap to fault in and keep (0 = skip)
+    bool hugePages{false};         // madvise(MADV_HUGEPAGE) the prefaulted heap
+    bool lockMemory{false};        // mlockall(MCL_CURRENT | MCL_FUTURE)
+};
+
+struct WarmupReport {
+    size_t syntheticOrders{0};
+    size_t fills{0};
+    size_t prefaultedBytes{0};
+    bool memoryLocked{false};
+    bool hugePages{false};
+    double elapsedMs{0.0};
+    std::vector<std::string> warnings;  // Optional steps that could not be applied
+};
+
+// Startup warmup, run before the FIX acceptor and HTTP port open: faults in
+// and keeps heap, optionally locks it, and pushes synthetic orders through
+// the order path on shadow objects so allocator free lists, lazily built
+// tables and the code itself are warm for the first real order. Live state
+// is never touched; reserve the live store and initialise the live market's
+// symbols separately.
+WarmupReport runWarmup(const WarmupOptions& options);
+
+}  // namespace qfblotter
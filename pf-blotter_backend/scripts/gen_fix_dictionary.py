@@ -0,0 +1,222 @@
+#!/usr/bin/env python3
+"""Compile a QuickFIX XML data dictionary into constexpr C++ tables.
+
+Only the listed message types (plus header and trailer) are compiled;
+components are flattened into their message or group. A field inside a
+component or group is required only if it and every enclosing component
+and group are required. Run by the build (see CMakeLists.txt):
+
+    gen_fix_dictionary.py --xml fix/FIX44.xml --out Fix44Dictionary.hpp \
+        --messages 0,1,2,3,4,5,A,D,F,8,9,V,W,X,Y,j
+"""
+
+import argparse
+import sys
+import xml.etree.ElementTree as ET
+
+# What the validator checks for each XML type; anything else is free text
+FORMATS = {
+    'CHAR': 'Char',
+    'BOOLEAN': 'Boolean',
+    'INT': 'Int', 'LENGTH': 'Int', 'SEQNUM': 'Int', 'NUMINGROUP': 'Int',
+    'DAYOFMONTH': 'Int', 'TAGNUM': 'Int',
+    'FLOAT': 'Float', 'PRICE': 'Float', 'QTY': 'Float', 'AMT': 'Float',
+    'PRICEOFFSET': 'Float', 'PERCENTAGE': 'Float',
+    'UTCTIMESTAMP': 'UtcTimestamp', 'UTCDATEONLY': 'UtcDateOnly', 'UTCDATE': 'UtcDateOnly',
+    'UTCTIMEONLY': 'UtcTimeOnly',
+}
+MULTI_VALUE = {'MULTIPLEVALUESTRING', 'MULTIPLESTRINGVALUE', 'MULTIPLECHARVALUE'}
+
+
+def cstr(text):
+    return '"' + text.replace('\\', '\\\\').replace('"', '\\"') + '"'
+
+
+class Compiler:
+    def __init__(self, root):
+        self.fields = {}  # name -> (tag, type, [(enum, description)])
+        for node in root.find('fields'):
+            values = [(v.get('enum'), v.get('description', '')) for v in node.findall('value')]
+            self.fields[node.get('name')] = (int(node.get('number')), node.get('type'), values)
+        components = root.find('components')
+        self.components = {c.get('name'): c for c in (components if components is not None else [])}
+        self.used = set()
+        self.members = []  # (tag, required, group index) in declared order, per scope
+        self.groups = []   # (count tag, delimiter, scope)
+
+    def tag(self, name):
+        if name not in self.fields:
+            sys.exit('unknown field ' + name)
+        self.used.add(name)
+        return self.fields[name][0]
+
+    def flatten(self, node, required, out):
+        for child in node:
+            child_required = required and child.get('required', 'N') in ('Y', 'y')
+            if child.tag == 'field':
+                out.append((self.tag(child.get('name')), child_required, -1))
+            elif child.tag == 'group':
+                out.append((self.tag(child.get('name')), child_required, self.group(child, child_required)))
+            elif child.tag == 'component':
+                name = child.get('name')
+                if name not in self.components:
+                    sys.exit('unknown component ' + name)
+                self.flatten(self.components[name], child_required, out)
+
+    def group(self, node, required):
+        entries = []
+        self.flatten(node, required, entries)
+        if not entries:
+            sys.exit('empty group ' + node.get('name'))
+        # Nested groups were compiled by flatten() and come first
+        self.groups.append((self.tag(node.get('name')), entries[0][0], self.scope(entries)))
+        return len(self.groups) - 1
+
+    def scope(self, entries):
+        """Append a scope's members; returns (first member, member count, required count)"""
+        tags = [e[0] for e in entries]
+        if len(set(tags)) != len(tags):
+            sys.exit('tag repeated within one message or group entry')
+        first = len(self.members)
+        self.members.extend(entries)
+        return first, len(entries), sum(1 for e in entries if e[1])
+
+    def compile_scope(self, node):
+        entries = []
+        self.flatten(node, True, entries)
+        return self.scope(entries)
+
+
+def generate(xml_path, msg_types):
+    root = ET.parse(xml_path).getroot()
+    version = '%s.%s.%s' % (root.get('type'), root.get('major'), root.get('minor'))
+    compiler = Compiler(root)
+
+    header = compiler.compile_scope(root.find('header'))
+    trailer = compiler.compile_scope(root.find('trailer'))
+    all_msg_types = sorted(m.get('msgtype') for m in root.find('messages'))
+    messages = []
+    for node in root.find('messages'):
+        if node.get('msgtype') in msg_types:
+            messages.append((node.get('msgtype'), node.get('name'), node.get('msgcat') == 'admin',
+                             compiler.compile_scope(node)))
+    missing = set(msg_types) - {m[0] for m in messages}
+    if missing:
+        sys.exit('message types not in dictionary: ' + ','.join(sorted(missing)))
+    messages.sort(key=lambda m: m[0])
+
+    # MsgType's own values are restricted to the compiled messages
+    compiler.used.add('MsgType')
+    fields = sorted((compiler.fields[name] + (name,) for name in compiler.used), key=lambda f: f[0])
+    values = []
+    field_rows = []
+    for tag, xml_type, enums, name in fields:
+        if name == 'MsgType':
+            enums = [(m[0], m[1]) for m in messages]
+        first = len(values)
+        values.extend(sorted(enums))
+        field_rows.append((tag, name, xml_type, FORMATS.get(xml_type, 'String'), xml_type in MULTI_VALUE,
+                           first, len(enums)))
+    max_tag = max(f[0] for f in compiler.fields.values())
+    index = [-2] * (max_tag + 1)  # -2: not a FIX tag at all
+    for f in compiler.fields.values():
+        index[f[0]] = -1           # -1: defined by the dictionary but not compiled
+    for i, row in enumerate(field_rows):
+        index[row[0]] = i
+    scopes = [header, trailer] + [m[3] for m in messages] + [g[2] for g in compiler.groups]
+    max_scope = max(s[1] for s in scopes)
+
+    def member_rows(members):
+        return ',\n'.join('    {%d, %s, %d}' % (t, 'true' if r else 'false', g) for t, r, g in members)
+
+    # Same ranges as MEMBERS, each range sorted by tag for lookups
+    by_tag = []
+    for first, count, _ in scopes:
+        by_tag.append((first, sorted(compiler.members[first:first + count], key=lambda m: m[0])))
+    sorted_members = list(compiler.members)
+    for first, members in by_tag:
+        sorted_members[first:first + len(members)] = members
+
+    out = []
+    out.append('// Generated by scripts/gen_fix_dictionary.py from %s; do not edit.' % xml_path.split('/')[-1])
+    out.append('// Message types: %s' % ','.join(m[0] for m in messages))
+    out.append('#pragma once')
+    out.append('')
+    out.append('#include <array>')
+    out.append('#include <cstdint>')
+    out.append('#include <string_view>')
+    out.append('')
+    out.append('#include "qfblotter/FixDictionaryTypes.hpp"')
+    out.append('')
+    out.append('namespace qfblotter::fixdict {')
+    out.append('')
+    out.append('inline constexpr std::string_view BEGIN_STRING = %s;' % cstr(version))
+    out.append('inline constexpr size_t MAX_SCOPE_MEMBERS = %d;' % max_scope)
+    out.append('')
+    out.append('inline constexpr std::array<FieldDef, %d> FIELDS{{' % len(field_rows))
+    out.append(',\n'.join('    {%d, %s, %s, FieldFormat::%s, %s, %d, %d}' % (
+        t, cstr(n), cstr(x), f, 'true' if mv else 'false', first, count)
+        for t, n, x, f, mv, first, count in field_rows))
+    out.append('}};')
+    out.append('')
+    out.append('inline constexpr std::array<ValueDef, %d> VALUES{{' % max(len(values), 1))
+    out.append(',\n'.join('    {%s, %s}' % (cstr(v), cstr(d)) for v, d in values) or '    {}')
+    out.append('}};')
+    out.append('')
+    out.append('// FIELDS index by tag; -1 for tags outside the compiled messages, -2 for')
+    out.append('// tags the dictionary does not define')
+    out.append('inline constexpr std::array<int16_t, %d> FIELD_INDEX{{' % len(index))
+    for i in range(0, len(index), 24):
+        out.append('    ' + ', '.join(str(v) for v in index[i:i + 24]) + ',')
+    out.append('}};')
+    out.append('')
+    out.append('inline constexpr std::array<std::string_view, %d> ALL_MSG_TYPES{{' % len(all_msg_types))
+    for i in range(0, len(all_msg_types), 16):
+        out.append('    ' + ', '.join(cstr(m) for m in all_msg_types[i:i + 16]) + ',')
+    out.append('}};')
+    out.append('')
+    out.append('// Declared order, which QuickFIX uses to order group fields')
+    out.append('inline constexpr std::array<MemberDef, %d> MEMBERS{{' % len(compiler.members))
+    out.append(member_rows(compiler.members))
+    out.append('}};')
+    out.append('')
+    out.append('inline constexpr std::array<MemberDef, %d> MEMBERS_BY_TAG{{' % len(sorted_members))
+    out.append(member_rows(sorted_members))
+    out.append('}};')
+    out.append('')
+    out.append('inline constexpr std::array<GroupDef, %d> GROUPS{{' % max(len(compiler.groups), 1))
+    out.append(',\n'.join('    {%d, %d, {%d, %d, %d}}' % (c, d, *scope) for c, d, scope in compiler.groups)
+               or '    {}')
+    out.append('}};')
+    out.append('')
+    out.append('inline constexpr ScopeDef HEADER{%d, %d, %d};' % header)
+    out.append('inline constexpr ScopeDef TRAILER{%d, %d, %d};' % trailer)
+    out.append('')
+    out.append('inline constexpr std::array<MessageDef, %d> MESSAGES{{' % len(messages))
+    out.append(',\n'.join('    {%s, %s, %s, {%d, %d, %d}}' % (cstr(t), cstr(n), 'true' if a else 'false', *scope)
+                          for t, n, a, scope in messages))
+    out.append('}};')
+    out.append('')
+    out.append('}  // namespace qfblotter::fixdict')
+    return '\n'.join(out) + '\n'
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('\n')[0])
+    parser.add_argument('--xml', required=True)
+    parser.add_argument('--out', required=True)
+    parser.add_argument('--messages', required=True, help='comma-separated MsgType values to compile')
+    args = parser.parse_args()
+    text = generate(args.xml, [m for m in args.messages.split(',') if m])
+    try:
+        with open(args.out) as existing:
+            if existing.read() == text:
+                return  # Leave the timestamp alone so dependants do not rebuild
+    except OSError:
+        pass
+    with open(args.out, 'w') as f:
+        f.write(text)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,50 @@
+#!/usr/bin/env bash
+# Aggregate HTTP order throughput through qf_router with 1 to 4 gateway
+# shards on one machine, and its scaling over one shard. Run from
+# pf-blotter_backend after building.
+# Usage: scripts/shard_bench.sh [build_dir] [seconds_per_run] [bench_threads]
+set -euo pipefail
+
+BUILD=${1:-build/build/Release}
+RUN_SECONDS=${2:-10}
+THREADS=${3:-16}
+WORK=$(mktemp -d)
+trap 'kill $(jobs -p) 2>/dev/null || true; rm -rf "$WORK"' EXIT
+
+run() {
+  local shards=$1
+  local urls=()
+  for ((i = 0; i < shards; i++)); do
+    local cfg="$WORK/shard$i.cfg"
+    # Own FIX port, stores and order file per shard; no shm feed or replication
+    sed -e "s#config/store/acceptor#$WORK/store$i#" \
+        -e "s#config/log/acceptor#$WORK/log$i#" \
+        -e "s#SocketAcceptPort=5001#SocketAcceptPort=$((5101 + i))#" \
+        -e "/^SharedMemory/d" -e "/^ReplicationListenPort/d" \
+        -e "/^\[DEFAULT\]/a ShardIndex=$i\nShardCount=$shards\nHttpOrderRateLimit=0\nHttpCancelRateLimit=0\nPersistencePath=$WORK/orders$i.json" \
+        config/acceptor.cfg > "$cfg"
+    "$BUILD/qf_gateway" "$cfg" $((8101 + i)) > "$WORK/gateway$i.out" 2>&1 &
+    urls+=("http://127.0.0.1:$((8101 + i))")
+  done
+  "$BUILD/qf_router" 8100 "${urls[@]}" --rate-limit 0 > "$WORK/router.out" 2>&1 &
+  sleep 2
+
+  local out
+  out=$("$BUILD/qf_order_bench" http://127.0.0.1:8100 --threads "$THREADS" --seconds "$RUN_SECONDS")
+  echo "$shards shard(s): $out"
+  RATES[$shards]=$(sed -E 's/.*: ([0-9]+) orders\/s.*/\1/' <<< "$out")
+
+  kill $(jobs -p) 2>/dev/null || true
+  wait 2>/dev/null || true
+}
+
+declare -a RATES
+for n in 1 2 3 4; do
+  run "$n"
+done
+
+echo "Scaling over 1 shard:"
+for n in 1 2 3 4; do
+  awk -v n="$n" -v r="${RATES[$n]}" -v base="${RATES[1]}" \
+    'BEGIN { printf "  %d shard(s): %8.0f orders/s  %.2fx\n", n, r, base > 0 ? r / base : 0 }'
+done
@@ -0,0 +1,176 @@
+#include "qfblotter/AdmissionControl.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace qfblotter {
+
+AdmissionControl::Ticket::Ticket(Ticket&& other) noexcept
+    : owner_(std::exchange(other.owner_, nullptr)),
+      admitted_(other.admitted_),
+      retryAfterMs_(other.retryAfterMs_),
+      reason_(other.reason_),
+      start_(other.start_) {}
+
+AdmissionControl::Ticket& AdmissionControl::Ticket::operator=(Ticket&& other) noexcept {
+    if (this != &other) {
+        release();
+        owner_ = std::exchange(other.owner_, nullptr);
+        admitted_ = other.admitted_;
+        retryAfterMs_ = other.retryAfterMs_;
+        reason_ = other.reason_;
+        start_ = other.start_;
+    }
+    return *this;
+}
+
+AdmissionControl::Ticket::~Ticket() {
+    release();
+}
+
+void AdmissionControl::Ticket::release() {
+    if (owner_) {
+        owner_->release(start_);
+        owner_ = nullptr;
+    }
+}
+
+AdmissionControl::AdmissionControl() : AdmissionControl(Options{}) {}
+
+AdmissionControl::AdmissionControl(Options options) : options_(options) {
+    if (options_.maxInFlight == 0) {
+        throw std::runtime_error("AdmissionControl: maxInFlight must be positive");
+    }
+}
+
+void AdmissionControl::addQueue(std::string name, std::function<size_t()> depth, size_t limit) {
+    queues_.push_back(Queue{std::move(name), std::move(depth), limit});
+}
+
+int AdmissionControl::saturatedQueue(double scale) const {
+    for (size_t i = 0; i < queues_.size(); ++i) {
+        const auto& queue = queues_[i];
+        if (queue.limit > 0 && static_cast<double>(queue.depth()) >= static_cast<double>(queue.limit) * scale) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+int64_t AdmissionControl::expectedWaitUsLocked() const {
+    // Everyone ahead, plus this request, shares maxInFlight slots
+    const auto ahead = static_cast<double>(waitingOrders_ + waitingCancels_ + 1);
+    return static_cast<int64_t>(ahead * latencyEwmaUs_ / static_cast<double>(options_.maxInFlight));
+}
+
+AdmissionControl::Ticket AdmissionControl::rejectLocked(Priority priority, const char* reason) {
+    if (priority == Priority::CANCEL) {
+        ++shedCancels_;
+    } else {
+        ++shedNewOrders_;
+    }
+    // Long enough for the current backlog to drain through the slots
+    const auto backlog = static_cast<double>(inFlight_ + waitingOrders_ + waitingCancels_);
+    const auto drainMs =
+        static_cast<int64_t>(backlog * latencyEwmaUs_ / static_cast<double>(options_.maxInFlight) / 1000.0) + 1;
+    Ticket ticket;
+    ticket.retryAfterMs_ = std::max<int64_t>(options_.minRetryAfter.count(), drainMs);
+    ticket.reason_ = reason;
+    return ticket;
+}
+
+AdmissionControl::Ticket AdmissionControl::admit(Priority priority) {
+    return admit(priority, true);
+}
+
+AdmissionControl::Ticket AdmissionControl::tryAdmit(Priority priority) {
+    return admit(priority, false);
+}
+
+AdmissionControl::Ticket AdmissionControl::admit(Priority priority, bool mayWait) {
+    const auto arrival = std::chrono::steady_clock::now();
+    const bool cancel = priority == Priority::CANCEL;
+    // Depth gauges take their own locks, so they are read outside ours
+    const int saturated = saturatedQueue(cancel ? options_.cancelHeadroom : 1.0);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!cancel || saturated >= 0) {
+        lastSaturated_ = saturated;
+    }
+    if (saturated >= 0) {
+        return rejectLocked(priority, "downstream queue full");
+    }
+
+    if (cancel) {
+        if (inFlight_ >= options_.maxInFlight) {
+            if (!mayWait) {
+                return rejectLocked(priority, "order entry saturated");
+            }
+            ++waitingCancels_;
+            const bool slot = cancelCv_.wait_until(lock, arrival + options_.maxCancelWait, [this]() {
+                return inFlight_ < options_.maxInFlight;
+            });
+            --waitingCancels_;
+            if (!slot) {
+                return rejectLocked(priority, "order entry saturated");
+            }
+        }
+    } else if (inFlight_ >= options_.maxInFlight || waitingCancels_ > 0) {
+        if (!mayWait || waitingOrders_ >= options_.maxQueued ||
+            expectedWaitUsLocked() > std::chrono::duration_cast<std::chrono::microseconds>(options_.maxQueueWait).count()) {
+            return rejectLocked(priority, "order entry saturated");
+        }
+        ++waitingOrders_;
+        const bool slot = orderCv_.wait_until(lock, arrival + options_.maxQueueWait, [this]() {
+            return inFlight_ < options_.maxInFlight && waitingCancels_ == 0;
+        });
+        --waitingOrders_;
+        if (!slot) {
+            return rejectLocked(priority, "order entry saturated");
+        }
+    }
+
+    ++inFlight_;
+    ++admitted_;
+    Ticket ticket;
+    ticket.owner_ = this;
+    ticket.admitted_ = true;
+    ticket.start_ = std::chrono::steady_clock::now();
+    return ticket;
+}
+
+void AdmissionControl::release(std::chrono::steady_clock::time_point start) {
+    const auto sampleUs = static_cast<double>(
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+    bool wakeCancel = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        --inFlight_;
+        latencyEwmaUs_ = latencyEwmaUs_ == 0.0 ? sampleUs
+                                               : latencyEwmaUs_ + options_.latencyAlpha * (sampleUs - latencyEwmaUs_);
+        wakeCancel = waitingCancels_ > 0;
+    }
+    if (wakeCancel) {
+        cancelCv_.notify_one();
+    } else {
+        orderCv_.notify_one();
+    }
+}
+
+AdmissionControl::Stats AdmissionControl::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats stats;
+    stats.admitted = admitted_;
+    stats.shedNewOrders = shedNewOrders_;
+    stats.shedCancels = shedCancels_;
+    stats.inFlight = inFlight_;
+    stats.queued = waitingOrders_ + waitingCancels_;
+    stats.latencyEwmaUs = static_cast<int64_t>(latencyEwmaUs_);
+    if (lastSaturated_ >= 0) {
+        stats.saturatedQueue = queues_[static_cast<size_t>(lastSaturated_)].name;
+    }
+    return stats;
+}
+
+}  // namespace qfblotter
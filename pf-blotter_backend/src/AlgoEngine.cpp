@@ -0,0 +1,375 @@
+#include "qfblotter/AlgoEngine.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+
+#include "qfblotter/SimClock.hpp"
+
+namespace qfblotter {
+
+namespace {
+int64_t now_ms() {
+    return SimClock::epochMs();
+}
+
+// Typical US equity volume by half-hour bucket (09:30-16:00), in percent.
+// Applied across the parent's window, whatever its length.
+constexpr std::array<double, 13> VOLUME_PROFILE = {
+    12.0, 8.5, 7.0, 6.3, 5.9, 5.6, 5.5, 5.6, 5.9, 6.5, 7.5, 9.5, 14.2,
+};
+}  // namespace
+
+AlgoEngine::AlgoEngine(int64_t tickMs) : wheel_(tickMs, now_ms()) {}
+
+AlgoEngine::~AlgoEngine() {
+    stop();
+}
+
+void AlgoEngine::setChildRouter(ChildRouter router) {
+    router_ = std::move(router);
+}
+
+void AlgoEngine::setParentListener(ParentListener listener) {
+    parentListener_ = std::move(listener);
+}
+
+void AlgoEngine::setPassListener(PassListener listener) {
+    passListener_ = std::move(listener);
+}
+
+void AlgoEngine::start() {
+    if (running_.exchange(true)) {
+        return;
+    }
+    thread_ = std::thread([this]() { run(); });
+}
+
+void AlgoEngine::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+bool AlgoEngine::submit(AlgoParams params, std::string& error) {
+    if (params.quantity <= 0) {
+        error = "Quantity must be positive";
+        return false;
+    }
+    if (params.sliceMs <= 0) {
+        error = "Slice interval must be positive";
+        return false;
+    }
+    if (params.strategy == AlgoStrategy::POV &&
+        (params.participation <= 0.0 || params.participation > 1.0)) {
+        error = "Participation must be in (0, 1]";
+        return false;
+    }
+    if (params.startMs <= 0) {
+        params.startMs = now_ms();
+    }
+    if (params.endMs <= params.startMs) {
+        error = "End time must be after start time";
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (parents_.count(params.parentId)) {
+        error = "Duplicate parent ClOrdID";
+        return false;
+    }
+
+    Parent parent;
+    const int64_t window = params.endMs - params.startMs;
+    parent.slices = static_cast<int>(std::max<int64_t>(1, (window + params.sliceMs - 1) / params.sliceMs));
+    auto vol = marketVolume_.find(params.symbol);
+    parent.volumeAtStart = vol == marketVolume_.end() ? 0 : vol->second;
+    parent.params = std::move(params);
+
+    auto& stored = parents_.emplace(parent.params.parentId, std::move(parent)).first->second;
+    scheduleSlice(stored);
+    return true;
+}
+
+bool AlgoEngine::cancel(const std::string& parentId, std::vector<std::string>& children) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = parents_.find(parentId);
+    if (it == parents_.end()) {
+        return false;
+    }
+    children = it->second.children;
+    eraseLocked(it);
+    return true;
+}
+
+std::optional<ParentFill> AlgoEngine::onChildFill(const std::string& clOrdId, int qty, double px) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto link = childToParent_.find(clOrdId);
+    if (link == childToParent_.end()) {
+        return std::nullopt;
+    }
+    auto it = parents_.find(link->second);
+    if (it == parents_.end()) {
+        return std::nullopt;
+    }
+    auto& parent = it->second;
+    parent.cumQty += qty;
+    parent.notional += qty * px;
+
+    ParentFill fill = fillOf(parent);
+    if (fill.complete) {
+        eraseLocked(it);
+    } else if (scheduleDone(parent)) {
+        // Last working child filled after the schedule ended short
+        ended_.push_back(fill);
+        eraseLocked(it);
+    }
+    return fill;
+}
+
+void AlgoEngine::onChildDone(const std::string& clOrdId, int unfilledQty) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto link = childToParent_.find(clOrdId);
+    if (link == childToParent_.end()) {
+        return;
+    }
+    auto it = parents_.find(link->second);
+    childToParent_.erase(link);  // A second terminal update returns nothing
+    if (it != parents_.end()) {
+        returnQtyLocked(it, unfilledQty);
+    }
+}
+
+void AlgoEngine::onChildReduced(const std::string& clOrdId, int qty) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto link = childToParent_.find(clOrdId);
+    if (link == childToParent_.end()) {
+        return;
+    }
+    auto it = parents_.find(link->second);
+    if (it != parents_.end()) {
+        returnQtyLocked(it, qty);
+    }
+}
+
+void AlgoEngine::returnQtyLocked(ParentMap::iterator it, int qty) {
+    auto& parent = it->second;
+    parent.released -= std::clamp(qty, 0, parent.released - parent.cumQty);
+    // Mid-schedule the next slice releases it again; after the last slice
+    // there is nothing left to wait for
+    if (scheduleDone(parent)) {
+        ended_.push_back(fillOf(parent));
+        eraseLocked(it);
+    }
+}
+
+ParentFill AlgoEngine::fillOf(const Parent& parent) {
+    ParentFill fill;
+    fill.parentId = parent.params.parentId;
+    fill.cumQty = parent.cumQty;
+    fill.leavesQty = std::max(0, parent.params.quantity - parent.cumQty);
+    fill.avgPx = parent.cumQty > 0 ? parent.notional / parent.cumQty : 0.0;
+    fill.complete = fill.leavesQty == 0;
+    return fill;
+}
+
+bool AlgoEngine::scheduleDone(const Parent& parent) {
+    return parent.nextSlice >= parent.slices && parent.released <= parent.cumQty;
+}
+
+void AlgoEngine::eraseLocked(ParentMap::iterator it) {
+    wheel_.cancel(it->second.timer);
+    for (const auto& child : it->second.children) {
+        childToParent_.erase(child);
+    }
+    parents_.erase(it);
+}
+
+void AlgoEngine::renameChild(const std::string& oldId, const std::string& newId) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto link = childToParent_.find(oldId);
+    if (link == childToParent_.end()) {
+        return;
+    }
+    std::string parentId = std::move(link->second);
+    childToParent_.erase(link);
+    auto it = parents_.find(parentId);
+    if (it == parents_.end()) {
+        return;
+    }
+    auto& children = it->second.children;
+    std::replace(children.begin(), children.end(), oldId, newId);
+    childToParent_.emplace(newId, std::move(parentId));
+}
+
+void AlgoEngine::onMarketVolume(const std::string& symbol, int64_t qty) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    marketVolume_[symbol] += qty;
+}
+
+bool AlgoEngine::isParent(const std::string& parentId) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return parents_.count(parentId) > 0;
+}
+
+size_t AlgoEngine::activeParents() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return parents_.size();
+}
+
+void AlgoEngine::runDue(int64_t nowMs) {
+    std::vector<std::string> due;
+    std::vector<ChildOrder> children;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        wheel_.advance(nowMs, due);
+        for (const auto& parentId : due) {
+            auto it = parents_.find(parentId);
+            if (it == parents_.end()) {
+                continue;
+            }
+            auto& parent = it->second;
+            parent.timer = TimerWheel::INVALID_TIMER;
+
+            // A late wakeup releases every overdue slice as one child
+            const int64_t elapsed = std::max<int64_t>(0, nowMs - parent.params.startMs);
+            const int slice = static_cast<int>(std::clamp<int64_t>(elapsed / parent.params.sliceMs,
+                                                                   parent.nextSlice, parent.slices - 1));
+
+            auto vol = marketVolume_.find(parent.params.symbol);
+            const int64_t printed = (vol == marketVolume_.end() ? 0 : vol->second) - parent.volumeAtStart;
+            const int target = targetQty(parent.params, slice, parent.slices, printed);
+            const int qty = target - parent.released;
+
+            if (qty > 0) {
+                ChildOrder child;
+                child.clOrdId = parent.params.parentId + "-" + std::to_string(parent.children.size() + 1);
+                child.parentId = parent.params.parentId;
+                child.symbol = parent.params.symbol;
+                child.side = parent.params.side;
+                child.quantity = qty;
+                child.limitPx = parent.params.limitPx;
+                parent.released += qty;
+                parent.children.push_back(child.clOrdId);
+                childToParent_.emplace(child.clOrdId, parent.params.parentId);
+                children.push_back(std::move(child));
+            }
+
+            // After the last slice the parent stays registered until its
+            // children end; with none working (POV short of the tape) it ends now
+            parent.nextSlice = slice + 1;
+            if (parent.nextSlice < parent.slices) {
+                scheduleSlice(parent);
+            } else if (scheduleDone(parent)) {
+                ended_.push_back(fillOf(parent));
+                eraseLocked(it);
+            }
+        }
+    }
+
+    for (const auto& child : children) {
+        if (router_ && router_(child)) {
+            continue;
+        }
+        // Rejected: release the quantity again for the next slice, or end
+        // the parent if that was its last
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = parents_.find(child.parentId);
+        if (it != parents_.end()) {
+            childToParent_.erase(child.clOrdId);
+            returnQtyLocked(it, child.quantity);
+        }
+    }
+
+    std::vector<ParentFill> ended;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ended.swap(ended_);
+    }
+    for (const auto& parent : ended) {
+        if (parentListener_) {
+            parentListener_(parent);
+        }
+    }
+    if (passListener_ && (!children.empty() || !ended.empty())) {
+        passListener_();
+    }
+}
+
+int AlgoEngine::targetQty(const AlgoParams& params, int slice, int slices, int64_t mktVolume) {
+    if (slices <= 0) {
+        return params.quantity;
+    }
+    const double done = static_cast<double>(slice + 1) / slices;
+    double target = 0.0;
+    switch (params.strategy) {
+        case AlgoStrategy::TWAP:
+            target = params.quantity * done;
+            break;
+        case AlgoStrategy::VWAP:
+            target = params.quantity * vwapCurve(done);
+            break;
+        case AlgoStrategy::POV:
+            // Tracks the tape; no catch-up at the end of the window, the
+            // parent ends with the remainder unfilled
+            target = params.participation * static_cast<double>(std::max<int64_t>(0, mktVolume));
+            return std::min(params.quantity, static_cast<int>(target));
+    }
+    if (slice + 1 >= slices) {
+        return params.quantity;  // Final slice releases any remainder
+    }
+    return std::min(params.quantity, static_cast<int>(target + 1e-9));
+}
+
+double AlgoEngine::vwapCurve(double x) {
+    if (x <= 0.0) return 0.0;
+    if (x >= 1.0) return 1.0;
+
+    double total = 0.0;
+    for (double pct : VOLUME_PROFILE) {
+        total += pct;
+    }
+    const double pos = x * static_cast<double>(VOLUME_PROFILE.size());
+    const auto full = static_cast<size_t>(pos);
+    double cum = 0.0;
+    for (size_t i = 0; i < full; ++i) {
+        cum += VOLUME_PROFILE[i];
+    }
+    cum += VOLUME_PROFILE[full] * (pos - static_cast<double>(full));
+    return cum / total;
+}
+
+std::optional<AlgoStrategy> AlgoEngine::parseStrategy(const std::string& name) {
+    if (name == "TWAP") return AlgoStrategy::TWAP;
+    if (name == "VWAP") return AlgoStrategy::VWAP;
+    if (name == "POV") return AlgoStrategy::POV;
+    return std::nullopt;
+}
+
+const char* AlgoEngine::strategyName(AlgoStrategy strategy) {
+    switch (strategy) {
+        case AlgoStrategy::TWAP: return "TWAP";
+        case AlgoStrategy::VWAP: return "VWAP";
+        case AlgoStrategy::POV: return "POV";
+    }
+    return "TWAP";
+}
+
+void AlgoEngine::scheduleSlice(Parent& parent) {
+    const int64_t due = parent.params.startMs + parent.nextSlice * parent.params.sliceMs;
+    parent.timer = wheel_.schedule(parent.params.parentId, due);
+}
+
+void AlgoEngine::run() {
+    const auto tick = std::chrono::milliseconds(wheel_.tickMs());
+    while (running_) {
+        std::this_thread::sleep_for(tick);
+        runDue(now_ms());
+    }
+}
+
+}  // namespace qfblotter
@@ -0,0 +1,116 @@
+#include "qfblotter/AsyncFileLog.hpp"
+
+#include <filesystem>
+#include <memory_resource>
+
+#include "qfblotter/CoarseClock.hpp"
+#include "qfblotter/ScratchArena.hpp"
+
+namespace qfblotter {
+
+namespace {
+AsyncFileWriter::Options logOptions(bool truncate) {
+    AsyncFileWriter::Options options;
+    options.sync = false;
+    options.truncate = truncate;
+    options.bufferCount = 4;
+    return options;
+}
+
+std::string sessionPrefix(const FIX::SessionID& sessionID) {
+    std::string prefix = sessionID.getBeginString().getValue() + "-" + sessionID.getSenderCompID().getValue() +
+                         "-" + sessionID.getTargetCompID().getValue();
+    if (!sessionID.getSessionQualifier().empty()) {
+        prefix += "-" + sessionID.getSessionQualifier();
+    }
+    return prefix;
+}
+}  // namespace
+
+AsyncFileLog::AsyncFileLog(const std::string& directory, const std::string& prefix) {
+    std::filesystem::create_directories(directory.empty() ? "." : directory);
+    const auto base = std::filesystem::path(directory.empty() ? "." : directory) / prefix;
+    messagesPath_ = base.string() + ".messages.current.log";
+    eventPath_ = base.string() + ".event.current.log";
+    open(false);
+}
+
+void AsyncFileLog::open(bool truncate) {
+    messages_ = std::make_unique<AsyncFileWriter>(messagesPath_, logOptions(truncate));
+    events_ = std::make_unique<AsyncFileWriter>(eventPath_, logOptions(truncate));
+}
+
+void AsyncFileLog::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    messages_.reset();
+    events_.reset();
+    open(true);
+}
+
+void AsyncFileLog::backup() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    messages_.reset();  // Drains before the rename
+    events_.reset();
+
+    // <prefix>.messages.N.log, first free N, as FIX::FileLog does
+    const auto backupPath = [](const std::string& current, int n) {
+        const std::string stem = current.substr(0, current.size() - std::string("current.log").size());
+        return stem + std::to_string(n) + ".log";
+    };
+    for (int n = 1;; ++n) {
+        const std::string messagesBackup = backupPath(messagesPath_, n);
+        const std::string eventBackup = backupPath(eventPath_, n);
+        if (std::filesystem::exists(messagesBackup) || std::filesystem::exists(eventBackup)) {
+            continue;
+        }
+        std::error_code ec;
+        std::filesystem::rename(messagesPath_, messagesBackup, ec);
+        std::filesystem::rename(eventPath_, eventBackup, ec);
+        break;
+    }
+    open(true);
+}
+
+void AsyncFileLog::write(AsyncFileWriter& file, const std::string& value) {
+    // FIX::FileLog line format: YYYYMMDD-HH:MM:SS.sss : message
+    ScratchArena::Scope scope;
+    char ts[CoarseClock::FIX_MILLIS_SIZE];
+    std::pmr::string line{ScratchArena::resource()};
+    line.reserve(sizeof(ts) + value.size() + 4);
+    line.append(CoarseClock::fixMillis(ts)).append(" : ").append(value).append("\n");
+    file.append(line);
+}
+
+void AsyncFileLog::onIncoming(const std::string& value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    write(*messages_, value);
+}
+
+void AsyncFileLog::onOutgoing(const std::string& value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    write(*messages_, value);
+}
+
+void AsyncFileLog::onEvent(const std::string& value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    write(*events_, value);
+}
+
+AsyncFileLogFactory::AsyncFileLogFactory(const FIX::SessionSettings& settings) : settings_(settings) {}
+
+FIX::Log* AsyncFileLogFactory::create() {
+    const auto& dict = settings_.get();
+    return new AsyncFileLog(dict.has("FileLogPath") ? dict.getString("FileLogPath") : std::string(), "GLOBAL");
+}
+
+FIX::Log* AsyncFileLogFactory::create(const FIX::SessionID& sessionID) {
+    const auto& dict = settings_.get(sessionID);
+    return new AsyncFileLog(dict.has("FileLogPath") ? dict.getString("FileLogPath") : std::string(),
+                            sessionPrefix(sessionID));
+}
+
+void AsyncFileLogFactory::destroy(FIX::Log* log) {
+    delete log;
+}
+
+}  // namespace qfblotter
@@ -0,0 +1,433 @@
+#include "qfblotter/AsyncFileWriter.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define QF_HAVE_IO_URING 1
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#endif
+
+namespace qfblotter {
+
+namespace {
+constexpr size_t PAGE = 4096;
+
+size_t roundUp(size_t n, size_t to) {
+    return (n + to - 1) / to * to;
+}
+
+// fdatasync where the platform has it, fsync elsewhere
+int syncData(int fd) {
+#if defined(__linux__)
+    return ::fdatasync(fd);
+#else
+    return ::fsync(fd);
+#endif
+}
+}  // namespace
+
+#ifdef QF_HAVE_IO_URING
+
+// Minimal io_uring over the raw system calls (no liburing dependency): one
+// submission per batch, waited on by the writer thread
+class AsyncFileWriter::Uring {
+public:
+    Uring(int fd, std::vector<Buffer>& buffers, size_t bufferSize) : fd_(fd) {
+        io_uring_params params{};
+        const unsigned entries = static_cast<unsigned>(roundUpPow2(buffers.size() * 2 + 2));
+        ringFd_ = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+        if (ringFd_ < 0) {
+            throw std::runtime_error(std::string("io_uring_setup: ") + std::strerror(errno));
+        }
+
+        sqRingSize_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cqRingSize_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        const bool single = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single) {
+            sqRingSize_ = cqRingSize_ = std::max(sqRingSize_, cqRingSize_);
+        }
+        sqRing_ = ::mmap(nullptr, sqRingSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd_,
+                         IORING_OFF_SQ_RING);
+        cqRing_ = single ? sqRing_
+                         : ::mmap(nullptr, cqRingSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd_,
+                                  IORING_OFF_CQ_RING);
+        sqes_ = static_cast<io_uring_sqe*>(::mmap(nullptr, params.sq_entries * sizeof(io_uring_sqe),
+                                                  PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd_,
+                                                  IORING_OFF_SQES));
+        sqesSize_ = params.sq_entries * sizeof(io_uring_sqe);
+        if (sqRing_ == MAP_FAILED || cqRing_ == MAP_FAILED || sqes_ == MAP_FAILED) {
+            release();
+            throw std::runtime_error("io_uring mmap failed");
+        }
+
+        auto* sq = static_cast<char*>(sqRing_);
+        sqTail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sqMask_ = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sqArray_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        auto* cq = static_cast<char*>(cqRing_);
+        cqHead_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cqTail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cqMask_ = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+        // Registered buffers save the kernel pinning pages on every write;
+        // RLIMIT_MEMLOCK can refuse them, in which case plain writes are used
+        std::vector<iovec> iov(buffers.size());
+        for (size_t i = 0; i < buffers.size(); ++i) {
+            iov[i].iov_base = buffers[i].data;
+            iov[i].iov_len = bufferSize;
+        }
+        fixed_ = ::syscall(__NR_io_uring_register, ringFd_, IORING_REGISTER_BUFFERS, iov.data(),
+                           static_cast<unsigned>(iov.size())) == 0;
+    }
+
+    ~Uring() { release(); }
+
+    // Linked writes of each buffer at consecutive offsets, then a linked
+    // fdatasync. Returns per-buffer bytes written (negative errno on failure)
+    // and whether the sync succeeded; the caller repairs short writes. If
+    // io_uring_enter itself fails the ring is left holding this batch, so it
+    // is marked failed() and must not be submitted to again.
+    bool submit(const std::vector<Buffer>& buffers, const std::vector<int>& batch, uint64_t offset, bool sync,
+                std::vector<int>& results) {
+        results.assign(batch.size(), -ECANCELED);
+        unsigned tail = *sqTail_;
+        for (size_t i = 0; i < batch.size(); ++i) {
+            const Buffer& buf = buffers[static_cast<size_t>(batch[i])];
+            io_uring_sqe* sqe = &sqes_[tail & sqMask_];
+            std::memset(sqe, 0, sizeof(*sqe));
+            sqe->opcode = fixed_ ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE;
+            sqe->fd = fd_;
+            sqe->addr = reinterpret_cast<uint64_t>(buf.data);
+            sqe->len = static_cast<uint32_t>(buf.len);
+            sqe->off = offset;
+            sqe->buf_index = static_cast<uint16_t>(batch[i]);
+            sqe->flags = (sync || i + 1 < batch.size()) ? IOSQE_IO_LINK : 0;
+            sqe->user_data = i;
+            sqArray_[tail & sqMask_] = tail & sqMask_;
+            offset += buf.len;
+            ++tail;
+        }
+        if (sync) {
+            io_uring_sqe* sqe = &sqes_[tail & sqMask_];
+            std::memset(sqe, 0, sizeof(*sqe));
+            sqe->opcode = IORING_OP_FSYNC;
+            sqe->fd = fd_;
+            sqe->fsync_flags = IORING_FSYNC_DATASYNC;
+            sqe->user_data = SYNC_TAG;
+            sqArray_[tail & sqMask_] = tail & sqMask_;
+            ++tail;
+        }
+        const unsigned count = static_cast<unsigned>(batch.size()) + (sync ? 1u : 0u);
+        std::atomic_ref<unsigned>(*sqTail_).store(tail, std::memory_order_release);
+
+        unsigned submitted = 0;
+        unsigned completed = 0;
+        bool synced = !sync;
+        while (completed < count) {
+            const unsigned toSubmit = count - submitted;
+            long rc = ::syscall(__NR_io_uring_enter, ringFd_, toSubmit, 1u, IORING_ENTER_GETEVENTS, nullptr, 0);
+            if (rc < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                failed_ = true;  // Ring unusable; the caller tears it down
+                return false;
+            }
+            submitted += static_cast<unsigned>(rc);
+
+            unsigned head = *cqHead_;
+            const unsigned cqTail = std::atomic_ref<unsigned>(*cqTail_).load(std::memory_order_acquire);
+            for (; head != cqTail; ++head, ++completed) {
+                const io_uring_cqe& cqe = cqes_[head & cqMask_];
+                if (cqe.user_data == SYNC_TAG) {
+                    synced = cqe.res == 0;
+                } else if (cqe.user_data < results.size()) {
+                    results[cqe.user_data] = cqe.res;
+                }
+            }
+            std::atomic_ref<unsigned>(*cqHead_).store(head, std::memory_order_release);
+        }
+        return synced;
+    }
+
+    bool failed() const { return failed_; }
+    void setFd(int fd) { fd_ = fd; }
+
+private:
+    static constexpr uint64_t SYNC_TAG = ~uint64_t{0};
+
+    static size_t roundUpPow2(size_t n) {
+        size_t p = 1;
+        while (p < n) {
+            p <<= 1;
+        }
+        return p;
+    }
+
+    void release() {
+        if (sqes_ != nullptr && sqes_ != MAP_FAILED) ::munmap(sqes_, sqesSize_);
+        if (cqRing_ != nullptr && cqRing_ != MAP_FAILED && cqRing_ != sqRing_) ::munmap(cqRing_, cqRingSize_);
+        if (sqRing_ != nullptr && sqRing_ != MAP_FAILED) ::munmap(sqRing_, sqRingSize_);
+        sqes_ = nullptr;
+        cqRing_ = sqRing_ = nullptr;
+        if (ringFd_ >= 0) ::close(ringFd_);
+        ringFd_ = -1;
+    }
+
+    int fd_;
+    int ringFd_{-1};
+    bool fixed_{false};
+    bool failed_{false};
+    void* sqRing_{nullptr};
+    void* cqRing_{nullptr};
+    io_uring_sqe* sqes_{nullptr};
+    size_t sqRingSize_{0};
+    size_t cqRingSize_{0};
+    size_t sqesSize_{0};
+    unsigned* sqTail_{nullptr};
+    unsigned* sqArray_{nullptr};
+    unsigned sqMask_{0};
+    unsigned* cqHead_{nullptr};
+    unsigned* cqTail_{nullptr};
+    unsigned cqMask_{0};
+    io_uring_cqe* cqes_{nullptr};
+};
+
+#else
+
+class AsyncFileWriter::Uring {};
+
+#endif
+
+AsyncFileWriter::AsyncFileWriter(const std::string& path) : AsyncFileWriter(path, Options{}) {}
+
+AsyncFileWriter::AsyncFileWriter(const std::string& path, Options options)
+    : path_(path), options_(options) {
+    options_.bufferSize = roundUp(std::max<size_t>(options_.bufferSize, PAGE), PAGE);
+    options_.bufferCount = std::max<size_t>(options_.bufferCount, 2);
+
+    const int flags = O_WRONLY | O_CREAT | O_CLOEXEC | (options_.truncate ? O_TRUNC : 0);
+    fd_ = ::open(path_.c_str(), flags, 0644);
+    if (fd_ < 0) {
+        throw std::runtime_error("Failed to open " + path_ + ": " + std::strerror(errno));
+    }
+    struct stat st{};
+    if (::fstat(fd_, &st) == 0) {
+        offset_ = static_cast<uint64_t>(st.st_size);  // Appends continue at the end
+    }
+
+    arena_ = std::unique_ptr<char, void (*)(void*)>(
+        static_cast<char*>(std::aligned_alloc(PAGE, options_.bufferSize * options_.bufferCount)), std::free);
+    if (!arena_) {
+        ::close(fd_);
+        throw std::runtime_error("Failed to allocate write buffers for " + path_);
+    }
+    buffers_.resize(options_.bufferCount);
+    free_.reserve(options_.bufferCount);
+    ready_.reserve(options_.bufferCount);
+    for (size_t i = 0; i < buffers_.size(); ++i) {
+        buffers_[i].data = arena_.get() + i * options_.bufferSize;
+        free_.push_back(static_cast<int>(i));
+    }
+
+#ifdef QF_HAVE_IO_URING
+    if (options_.useIoUring) {
+        try {
+            uring_ = std::make_unique<Uring>(fd_, buffers_, options_.bufferSize);
+            backend_.store(Backend::IO_URING, std::memory_order_relaxed);
+        } catch (const std::exception&) {
+            backend_.store(Backend::BLOCKING, std::memory_order_relaxed);  // Kernel or sandbox without io_uring
+        }
+    }
+#endif
+
+    thread_ = std::thread([this]() { run(); });
+}
+
+AsyncFileWriter::~AsyncFileWriter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    writerCv_.notify_one();
+    if (thread_.joinable()) {
+        thread_.join();  // Drains every buffer first
+    }
+    uring_.reset();
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+}
+
+const char* AsyncFileWriter::backendName(Backend backend) {
+    return backend == Backend::IO_URING ? "io_uring" : "blocking";
+}
+
+void AsyncFileWriter::append(std::string_view data) {
+    // Held across a stall so another appender cannot claim the next buffer
+    // and split this record
+    std::lock_guard<std::mutex> order(appendMutex_);
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!data.empty()) {
+        if (filling_ < 0) {
+            if (free_.empty()) {
+                stalls_.fetch_add(1, std::memory_order_relaxed);
+                writerCv_.notify_one();
+                doneCv_.wait(lock, [this]() { return !free_.empty(); });
+            }
+            filling_ = free_.back();
+            free_.pop_back();
+        }
+        Buffer& buf = buffers_[static_cast<size_t>(filling_)];
+        const size_t n = std::min(data.size(), options_.bufferSize - buf.len);
+        std::memcpy(buf.data + buf.len, data.data(), n);
+        buf.len += n;
+        appended_ += n;
+        bytesAppended_.fetch_add(n, std::memory_order_release);
+        data.remove_prefix(n);
+        if (buf.len == options_.bufferSize) {
+            ready_.push_back(filling_);
+            filling_ = -1;
+        }
+    }
+    lock.unlock();
+    writerCv_.notify_one();
+}
+
+void AsyncFileWriter::flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    const uint64_t target = appended_;
+    writerCv_.notify_one();
+    doneCv_.wait(lock, [this, target]() { return durable_ >= target; });
+}
+
+void AsyncFileWriter::reopen() {
+    // Holding the append lock keeps the writer idle once flushed
+    std::lock_guard<std::mutex> order(appendMutex_);
+    flush();
+    const int fd = ::open(path_.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC | O_TRUNC, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open " + path_ + ": " + std::strerror(errno));
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    ::close(fd_);
+    fd_ = fd;
+#ifdef QF_HAVE_IO_URING
+    if (uring_) {
+        uring_->setFd(fd);
+    }
+#endif
+    offset_ = 0;
+}
+
+void AsyncFileWriter::run() {
+    std::vector<int> batch;
+    batch.reserve(options_.bufferCount);  // Swapped with ready_, so both keep full capacity
+    while (true) {
+        uint64_t offset = 0;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            writerCv_.wait(lock, [this]() { return stopping_ || !ready_.empty() || filling_ >= 0; });
+            // Everything appended since the last round goes out together
+            if (filling_ >= 0) {
+                ready_.push_back(filling_);
+                filling_ = -1;
+            }
+            if (ready_.empty()) {
+                return;  // Stopping and fully drained
+            }
+            batch.swap(ready_);
+            offset = offset_;
+            for (int idx : batch) {
+                offset_ += buffers_[static_cast<size_t>(idx)].len;
+            }
+        }
+
+        writeBatch(batch, offset);
+
+        uint64_t written = 0;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (int idx : batch) {
+                written += buffers_[static_cast<size_t>(idx)].len;
+                buffers_[static_cast<size_t>(idx)].len = 0;
+                free_.push_back(idx);
+            }
+            durable_ += written;
+        }
+        batch.clear();
+        bytesWritten_.fetch_add(written, std::memory_order_release);
+        batches_.fetch_add(1, std::memory_order_relaxed);
+        doneCv_.notify_all();
+    }
+}
+
+void AsyncFileWriter::writeBatch(const std::vector<int>& batch, uint64_t offset) {
+#ifdef QF_HAVE_IO_URING
+    if (uring_) {
+        std::vector<int> results;
+        const bool synced = uring_->submit(buffers_, batch, offset, options_.sync, results);
+        bool repaired = false;
+        for (size_t i = 0; i < batch.size(); ++i) {
+            const Buffer& buf = buffers_[static_cast<size_t>(batch[i])];
+            const size_t done = results[i] > 0 ? static_cast<size_t>(results[i]) : 0;
+            if (done < buf.len) {
+                // Short, failed or canceled link: finish it synchronously
+                writeBlocking(buf.data + done, buf.len - done, offset + done);
+                repaired = true;
+            }
+            offset += buf.len;
+        }
+        if (options_.sync && (!synced || repaired)) {
+            syncData(fd_);
+        }
+        if (uring_->failed()) {
+            // Closing the ring cancels whatever it still holds; every later
+            // batch takes the blocking path
+            std::cerr << "[IO] io_uring failed for " << path_ << "; falling back to blocking writes" << std::endl;
+            uring_.reset();
+            backend_.store(Backend::BLOCKING, std::memory_order_relaxed);
+        }
+        return;
+    }
+#endif
+    for (int idx : batch) {
+        const Buffer& buf = buffers_[static_cast<size_t>(idx)];
+        writeBlocking(buf.data, buf.len, offset);
+        offset += buf.len;
+    }
+    if (options_.sync) {
+        syncData(fd_);
+    }
+}
+
+void AsyncFileWriter::writeBlocking(const char* data, size_t len, uint64_t offset) {
+    while (len > 0) {
+        ssize_t n = ::pwrite(fd_, data, len, static_cast<off_t>(offset));
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            std::cerr << "[IO] write to " << path_ << " failed: " << std::strerror(errno) << std::endl;
+            return;
+        }
+        data += n;
+        len -= static_cast<size_t>(n);
+        offset += static_cast<uint64_t>(n);
+    }
+}
+
+}  // namespace qfblotter
@@ -1,59 +1,81 @@
 #include "qfblotter/AuditLog.hpp"
 
-#include <iomanip>
-#include <sstream>
+#include <memory_resource>
 #include <stdexcept>
 
+#include "qfblotter/CoarseClock.hpp"
+#include "qfblotter/ScratchArena.hpp"
+
 namespace qfblotter {
 
-AuditLog::AuditLog(const std::string& logPath)
-    : logPath_(logPath) {
-    file_.open(logPath_, std::ios::app);  // Append mode
-    if (!file_.is_open()) {
-        throw std::runtime_error("Failed to open audit log: " + logPath_);
+namespace {
+AsyncFileWriter openAuditFile(const std::string& logPath) {
+    try {
+        return AsyncFileWriter(logPath);
+    } catch (const std::exception&) {
+        throw std::runtime_error("Failed to open audit log: " + logPath);
     }
-    
+}
+}  // namespace
+
+AuditLog::AuditLog(const std::string& logPath)
+    : logPath_(logPath), file_(openAuditFile(logPath)) {
     // Log startup
     logSystemEvent("AUDIT_LOG_OPENED", "Audit log initialized");
 }
 
 AuditLog::~AuditLog() {
-    if (file_.is_open()) {
-        logSystemEvent("AUDIT_LOG_CLOSED", "Audit log closed");
-        file_.close();
-    }
+    logSystemEvent("AUDIT_LOG_CLOSED", "Audit log closed");
+    file_.flush();
 }
 
-void AuditLog::log(EventType type, const std::string& clOrdId, const std::string& details) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
-    if (!file_.is_open()) {
-        return;
-    }
-    
+void AuditLog::log(EventType type, std::string_view clOrdId, std::string_view details) {
     // Format: TIMESTAMP|EVENT_TYPE|CLORDID|DETAILS
-    file_ << currentTimestamp() << "|"
-          << eventTypeToString(type) << "|"
-          << clOrdId << "|"
-          << details << "\n";
-    file_.flush();  // Ensure immediate write for durability
+    ScratchArena::Scope scope;
+    char ts[CoarseClock::ISO_MILLIS_SIZE];
+    std::pmr::string line{ScratchArena::resource()};
+    line.reserve(48 + clOrdId.size() + details.size());
+    line.append(CoarseClock::isoMillis(ts)).append("|")
+        .append(eventTypeToString(type)).append("|")
+        .append(clOrdId).append("|")
+        .append(details).append("\n");
+
+    file_.append(line);  // One append keeps the line contiguous
 }
 
-void AuditLog::logSystemEvent(const std::string& event, const std::string& details) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
-    if (!file_.is_open()) {
+void AuditLog::logBatch(EventType type, const std::vector<std::string>& clOrdIds, std::string_view details) {
+    if (clOrdIds.empty()) {
         return;
     }
-    
-    file_ << currentTimestamp() << "|"
-          << "SYSTEM|"
-          << event << "|"
-          << details << "\n";
+
+    ScratchArena::Scope scope;
+    char ts[CoarseClock::ISO_MILLIS_SIZE];
+    const std::string_view timestamp = CoarseClock::isoMillis(ts);
+    const std::string_view typeStr = eventTypeToString(type);
+    std::pmr::string lines{ScratchArena::resource()};
+    for (const auto& clOrdId : clOrdIds) {
+        lines.append(timestamp).append("|").append(typeStr).append("|")
+             .append(clOrdId).append("|").append(details).append("\n");
+    }
+
+    file_.append(lines);
+}
+
+void AuditLog::logSystemEvent(std::string_view event, std::string_view details) {
+    ScratchArena::Scope scope;
+    char ts[CoarseClock::ISO_MILLIS_SIZE];
+    std::pmr::string line{ScratchArena::resource()};
+    line.append(CoarseClock::isoMillis(ts)).append("|SYSTEM|")
+        .append(event).append("|").append(details).append("\n");
+
+    file_.append(line);
+}
+
+void AuditLog::flush() {
     file_.flush();
 }
 
-std::string AuditLog::eventTypeToString(EventType type) const {
+const char* AuditLog::eventTypeToString(EventType type) {
     switch (type) {
         case EventType::ORDER_NEW: return "ORDER_NEW";
         case EventType::ORDER_ACKNOWLEDGED: return "ORDER_ACK";
@@ -64,6 +86,8 @@ std::string AuditLog::eventTypeToString(EventType type) const {
         case EventType::ORDER_CANCEL_REJECTED: return "CANCEL_REJECTED";
         case EventType::ORDER_REPLACED: return "ORDER_REPLACED";
         case EventType::ORDER_REPLACE_REJECTED: return "REPLACE_REJECTED";
+        case EventType::ORDER_EXPIRED: return "ORDER_EXPIRED";
+        case EventType::ORDER_TRIGGERED: return "ORDER_TRIGGERED";
         case EventType::SYSTEM_START: return "SYS_START";
         case EventType::SYSTEM_STOP: return "SYS_STOP";
         case EventType::FIX_SESSION_LOGON: return "FIX_LOGON";
@@ -72,24 +96,4 @@ std::string AuditLog::eventTypeToString(EventType type) const {
     }
 }
 
-std::string AuditLog::currentTimestamp() const {
-    using namespace std::chrono;
-    
-    auto now = system_clock::now();
-    auto ms = duration_cast<milliseconds>(now.time_since_epoch()) % 1000;
-    std::time_t t = system_clock::to_time_t(now);
-    std::tm tm{};
-    
-#if defined(_WIN32)
-    gmtime_s(&tm, &t);
-#else
-    gmtime_r(&t, &tm);
-#endif
-    
-    std::ostringstream oss;
-    oss << std::put_time(&tm, "%Y-%m-%dT%H:%M:%S")
-        << '.' << std::setfill('0') << std::setw(3) << ms.count() << 'Z';
-    return oss.str();
-}
-
 }  // namespace qfblotter
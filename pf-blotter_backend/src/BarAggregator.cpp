@@ -0,0 +1,165 @@
+#include "qfblotter/BarAggregator.hpp"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+
+namespace qfblotter {
+
+namespace {
+constexpr std::array<BarInterval, BarAggregator::INTERVAL_COUNT> ALL_INTERVALS = {
+    BarInterval::Sec1, BarInterval::Min1, BarInterval::Min5};
+
+void appendBar(std::string& out, const Bar& bar) {
+    char buf[192];
+    int len = std::snprintf(buf, sizeof(buf),
+        "{\"time\":%" PRId64 ",\"open\":%.2f,\"high\":%.2f,\"low\":%.2f,\"close\":%.2f,"
+        "\"volume\":%" PRId64 ",\"trades\":%d}",
+        bar.startMs, bar.open, bar.high, bar.low, bar.close, bar.volume, bar.trades);
+    if (len > 0) {
+        out.append(buf, static_cast<size_t>(std::min(len, static_cast<int>(sizeof(buf) - 1))));
+    }
+}
+}  // namespace
+
+BarAggregator::BarAggregator(const std::vector<std::string>& symbols) {
+    series_.reserve(symbols.size());
+    for (const auto& symbol : symbols) {
+        auto series = std::make_unique<Series>();
+        for (size_t i = 0; i < INTERVAL_COUNT; ++i) {
+            series->rings[i].bars.resize(CAPACITY[i]);
+        }
+        series_.emplace(symbol, std::move(series));
+    }
+}
+
+void BarAggregator::onTick(const std::string& symbol, double price, int64_t timeMs) {
+    update(symbol, price, 0, timeMs);
+}
+
+void BarAggregator::onFill(const std::string& symbol, double price, int qty, int64_t timeMs) {
+    if (qty <= 0) {
+        return;
+    }
+    update(symbol, price, qty, timeMs);
+}
+
+void BarAggregator::update(const std::string& symbol, double price, int qty, int64_t timeMs) {
+    auto it = series_.find(symbol);
+    if (it == series_.end() || price <= 0.0) {
+        return;
+    }
+
+    auto& series = *it->second;
+    std::lock_guard<std::mutex> lock(series.mutex);
+
+    for (size_t i = 0; i < INTERVAL_COUNT; ++i) {
+        auto& ring = series.rings[i];
+        const int64_t width = intervalMs(ALL_INTERVALS[i]);
+        const int64_t bucket = timeMs - (timeMs % width);
+
+        // Late updates (older than the current bucket) fold into the current bar
+        if (ring.count == 0 || bucket > ring.bars[ring.head].startMs) {
+            if (ring.count > 0) {
+                ring.head = (ring.head + 1) % ring.bars.size();
+            }
+            ring.count = std::min(ring.count + 1, ring.bars.size());
+            ring.bars[ring.head] = Bar{bucket, price, price, price, price, 0, 0};
+        }
+
+        auto& bar = ring.bars[ring.head];
+        bar.high = std::max(bar.high, price);
+        bar.low = std::min(bar.low, price);
+        bar.close = price;
+        if (qty > 0) {
+            bar.volume += qty;
+            bar.trades++;
+        }
+    }
+}
+
+size_t BarAggregator::visit(const std::string& symbol, BarInterval interval, size_t n,
+                            const SpanVisitor& visitor) const {
+    auto it = series_.find(symbol);
+    if (it == series_.end()) {
+        return 0;
+    }
+
+    const auto& series = *it->second;
+    std::lock_guard<std::mutex> lock(series.mutex);
+    const auto& ring = series.rings[static_cast<size_t>(interval)];
+
+    n = std::min(n, ring.count);
+    if (n == 0) {
+        return 0;
+    }
+
+    // Oldest requested bar, then at most two contiguous spans up to head
+    const size_t cap = ring.bars.size();
+    const size_t first = (ring.head + cap + 1 - n) % cap;
+    if (first + n <= cap) {
+        visitor(ring.bars.data() + first, n);
+    } else {
+        visitor(ring.bars.data() + first, cap - first);
+        visitor(ring.bars.data(), n - (cap - first));
+    }
+    return n;
+}
+
+std::string BarAggregator::historyJson(const std::string& symbol, BarInterval interval, size_t n) const {
+    if (!hasSymbol(symbol)) {
+        return {};
+    }
+    std::string out;
+    out.reserve(64 + std::min(n, CAPACITY[static_cast<size_t>(interval)]) * 128);
+    out += "{\"symbol\":\"";
+    out += symbol;
+    out += "\",\"interval\":\"";
+    out += intervalName(interval);
+    out += "\",\"bars\":[";
+
+    bool first = true;
+    visit(symbol, interval, n, [&out, &first](const Bar* bars, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            if (!first) {
+                out += ',';
+            }
+            first = false;
+            appendBar(out, bars[i]);
+        }
+    });
+
+    out += "]}";
+    return out;
+}
+
+bool BarAggregator::hasSymbol(const std::string& symbol) const {
+    return series_.find(symbol) != series_.end();
+}
+
+std::optional<BarInterval> BarAggregator::parseInterval(const std::string& text) {
+    if (text == "1s") return BarInterval::Sec1;
+    if (text == "1m") return BarInterval::Min1;
+    if (text == "5m") return BarInterval::Min5;
+    return std::nullopt;
+}
+
+const char* BarAggregator::intervalName(BarInterval interval) {
+    switch (interval) {
+        case BarInterval::Sec1: return "1s";
+        case BarInterval::Min1: return "1m";
+        case BarInterval::Min5: return "5m";
+    }
+    return "1m";
+}
+
+int64_t BarAggregator::intervalMs(BarInterval interval) {
+    switch (interval) {
+        case BarInterval::Sec1: return 1'000;
+        case BarInterval::Min1: return 60'000;
+        case BarInterval::Min5: return 300'000;
+    }
+    return 60'000;
+}
+
+}  // namespace qfblotter
@@ -0,0 +1,221 @@
+#include "qfblotter/CoarseClock.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <ctime>
+#include <mutex>
+#include <thread>
+
+#include "qfblotter/SimClock.hpp"
+
+namespace qfblotter {
+
+namespace {
+struct Snapshot {
+    int64_t epochMs;
+    char iso[24];  // YYYY-MM-DDTHH:MM:SS
+    char fix[24];  // YYYYMMDD-HH:MM:SS
+};
+constexpr size_t ISO_PREFIX = 19;
+constexpr size_t FIX_PREFIX = 17;
+constexpr size_t WORDS = sizeof(Snapshot) / sizeof(uint64_t);
+static_assert(sizeof(Snapshot) % sizeof(uint64_t) == 0);
+
+int64_t systemMs() {
+    return SimClock::epochMs();
+}
+
+void putDigits(char* out, int value, int width) {
+    for (int i = width - 1; i >= 0; --i) {
+        out[i] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+}
+
+void formatPrefixes(int64_t epochSec, Snapshot& s) {
+    const std::time_t t = static_cast<std::time_t>(epochSec);
+    std::tm tm{};
+#if defined(_WIN32)
+    gmtime_s(&tm, &t);
+#else
+    gmtime_r(&t, &tm);
+#endif
+    const int year = tm.tm_year + 1900;
+    const int month = tm.tm_mon + 1;
+
+    char* iso = s.iso;
+    putDigits(iso, year, 4);
+    iso[4] = '-';
+    putDigits(iso + 5, month, 2);
+    iso[7] = '-';
+    putDigits(iso + 8, tm.tm_mday, 2);
+    iso[10] = 'T';
+    putDigits(iso + 11, tm.tm_hour, 2);
+    iso[13] = ':';
+    putDigits(iso + 14, tm.tm_min, 2);
+    iso[16] = ':';
+    putDigits(iso + 17, tm.tm_sec, 2);
+
+    char* fix = s.fix;
+    putDigits(fix, year, 4);
+    putDigits(fix + 4, month, 2);
+    putDigits(fix + 6, tm.tm_mday, 2);
+    fix[8] = '-';
+    putDigits(fix + 9, tm.tm_hour, 2);
+    fix[11] = ':';
+    putDigits(fix + 12, tm.tm_min, 2);
+    fix[14] = ':';
+    putDigits(fix + 15, tm.tm_sec, 2);
+}
+
+// Move `s` to `ms`, reformatting the prefixes only on a new second
+void advance(Snapshot& s, int64_t ms) {
+    if (s.epochMs == 0 || ms / 1000 != s.epochMs / 1000) {
+        formatPrefixes(ms / 1000, s);
+    }
+    s.epochMs = ms;
+}
+
+// Single-writer seqlock; the snapshot is stored as atomic words so a torn
+// read is detected by the sequence check rather than being a data race
+class SeqSnapshot {
+public:
+    void publish(const Snapshot& s) {
+        uint64_t words[WORDS];
+        std::memcpy(words, &s, sizeof(s));
+        const uint64_t seq = seq_.load(std::memory_order_relaxed);
+        seq_.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < WORDS; ++i) {
+            words_[i].store(words[i], std::memory_order_relaxed);
+        }
+        seq_.store(seq + 2, std::memory_order_release);
+    }
+
+    Snapshot read() const {
+        uint64_t words[WORDS];
+        for (;;) {
+            const uint64_t before = seq_.load(std::memory_order_acquire);
+            if ((before & 1) != 0) {
+                continue;  // Mid-update; the writer holds it for a few stores
+            }
+            for (size_t i = 0; i < WORDS; ++i) {
+                words[i] = words_[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (seq_.load(std::memory_order_relaxed) == before) {
+                break;
+            }
+        }
+        Snapshot s;
+        std::memcpy(&s, words, sizeof(s));
+        return s;
+    }
+
+private:
+    std::atomic<uint64_t> seq_{0};
+    std::atomic<uint64_t> words_[WORDS]{};
+};
+
+struct Refresher {
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::thread thread;
+    bool stopping{false};
+    std::atomic<bool> running{false};
+    SeqSnapshot shared;
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!thread.joinable()) {
+                return;
+            }
+            running.store(false, std::memory_order_release);
+            stopping = true;
+        }
+        cv.notify_all();
+        thread.join();
+    }
+
+    ~Refresher() { stop(); }
+};
+
+Refresher& refresher() {
+    static Refresher instance;
+    return instance;
+}
+
+Snapshot current() {
+    Refresher& r = refresher();
+    if (r.running.load(std::memory_order_acquire) && !SimClock::isVirtual()) {
+        return r.shared.read();
+    }
+    thread_local Snapshot local{};
+    advance(local, systemMs());
+    return local;
+}
+
+void putMillis(char* out, int64_t epochMs) {
+    putDigits(out, static_cast<int>(epochMs % 1000), 3);
+}
+}  // namespace
+
+void CoarseClock::start(std::chrono::milliseconds tick) {
+    Refresher& r = refresher();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    if (r.thread.joinable()) {
+        return;
+    }
+    Snapshot first{};
+    advance(first, systemMs());
+    r.shared.publish(first);  // Valid before the first read switches over
+    r.stopping = false;
+    r.running.store(true, std::memory_order_release);
+    r.thread = std::thread([&r, tick, s = first]() mutable {
+        std::unique_lock<std::mutex> wait(r.mutex);
+        while (!r.cv.wait_for(wait, tick, [&r] { return r.stopping; })) {
+            advance(s, systemMs());
+            r.shared.publish(s);
+        }
+    });
+}
+
+void CoarseClock::stop() {
+    refresher().stop();
+}
+
+bool CoarseClock::running() {
+    return refresher().running.load(std::memory_order_acquire);
+}
+
+int64_t CoarseClock::nowMs() {
+    return current().epochMs;
+}
+
+std::string CoarseClock::isoSeconds() {
+    const Snapshot s = current();
+    std::string out(s.iso, ISO_PREFIX);
+    out.push_back('Z');
+    return out;
+}
+
+std::string_view CoarseClock::isoMillis(char* buf) {
+    const Snapshot s = current();
+    std::memcpy(buf, s.iso, ISO_PREFIX);
+    buf[ISO_PREFIX] = '.';
+    putMillis(buf + ISO_PREFIX + 1, s.epochMs);
+    buf[ISO_PREFIX + 4] = 'Z';
+    return std::string_view(buf, ISO_MILLIS_SIZE);
+}
+
+std::string_view CoarseClock::fixMillis(char* buf) {
+    const Snapshot s = current();
+    std::memcpy(buf, s.fix, FIX_PREFIX);
+    buf[FIX_PREFIX] = '.';
+    putMillis(buf + FIX_PREFIX + 1, s.epochMs);
+    return std::string_view(buf, FIX_MILLIS_SIZE);
+}
+
+}  // namespace qfblotter
@@ -0,0 +1,159 @@
+#include "qfblotter/CrossingEngine.hpp"
+
+#include <algorithm>
+
+#include "qfblotter/OrderStore.hpp"
+
+namespace qfblotter {
+
+void CrossingEngine::upsert(const std::string& clOrdId, const std::string& symbol, char side, double limitPx,
+                            int leavesQty) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = locations_.find(clOrdId);
+    if (it != locations_.end()) {
+        Location& loc = it->second;
+        const bool samePrice = loc.side == '1' ? loc.buyIt->first.first == limitPx : loc.sellIt->first.first == limitPx;
+        int& restingQty = loc.side == '1' ? loc.buyIt->second.qty : loc.sellIt->second.qty;
+        if (loc.side == side && samePrice && leavesQty <= restingQty) {
+            restingQty = leavesQty;  // Fill or size-down: keeps its place, cannot newly cross
+            return;
+        }
+        eraseLocked(loc);
+        locations_.erase(it);
+    }
+
+    insertLocked(clOrdId, symbol, side, limitPx, leavesQty, ++nextSeq_);
+}
+
+void CrossingEngine::insertLocked(const std::string& clOrdId, const std::string& symbol, char side, double limitPx,
+                                  int leavesQty, uint64_t seq) {
+    auto& book = books_[symbol];
+    if (book.symbol.empty()) {
+        book.symbol = symbol;
+    }
+    Location loc;
+    loc.book = &book;
+    loc.side = side;
+    if (side == '1') {
+        loc.buyIt = book.buys.emplace(Key{limitPx, seq}, Resting{clOrdId, leavesQty}).first;
+    } else {
+        loc.sellIt = book.sells.emplace(Key{limitPx, seq}, Resting{clOrdId, leavesQty}).first;
+    }
+    locations_.emplace(clOrdId, loc);
+    markDirtyLocked(book);
+}
+
+void CrossingEngine::restore(const OrderRecord& record, uint64_t seq) {
+    if (!crossable(record)) {
+        remove(record.clOrdId);
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = locations_.find(record.clOrdId);
+    if (it == locations_.end()) {
+        // Crossed out in full: back at its old place
+        insertLocked(record.clOrdId, record.symbol, record.side, record.price, record.leavesQty, seq);
+        return;
+    }
+    Location& loc = it->second;
+    const uint64_t restingSeq = loc.side == '1' ? loc.buyIt->first.second : loc.sellIt->first.second;
+    if (restingSeq != seq) {
+        return;  // Re-placed since the match, as the store listener saw it
+    }
+    // Partly crossed: still in place, with the voided quantity back
+    (loc.side == '1' ? loc.buyIt->second.qty : loc.sellIt->second.qty) = record.leavesQty;
+    markDirtyLocked(*loc.book);
+}
+
+bool CrossingEngine::remove(const std::string& clOrdId) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = locations_.find(clOrdId);
+    if (it == locations_.end()) {
+        return false;
+    }
+    eraseLocked(it->second);
+    locations_.erase(it);
+    return true;
+}
+
+void CrossingEngine::eraseLocked(const Location& loc) {
+    if (loc.side == '1') {
+        loc.book->buys.erase(loc.buyIt);
+    } else {
+        loc.book->sells.erase(loc.sellIt);
+    }
+}
+
+void CrossingEngine::markDirtyLocked(Book& book) {
+    if (!book.dirty) {
+        book.dirty = true;
+        dirty_.push_back(&book);
+    }
+}
+
+bool CrossingEngine::crossable(const OrderRecord& record) {
+    return (record.status == "NEW" || record.status == "PARTIAL") && record.orderType == ORD_LIMIT &&
+           record.algo.empty() && record.leavesQty > 0 && record.price > 0.0 &&
+           record.timeInForce != TIF_IOC && record.timeInForce != TIF_FOK;
+}
+
+void CrossingEngine::onOrderChange(const OrderRecord& record) {
+    if (crossable(record)) {
+        upsert(record.clOrdId, record.symbol, record.side, record.price, record.leavesQty);
+    } else {
+        remove(record.clOrdId);
+    }
+}
+
+void CrossingEngine::match(const MidPrice& mid, std::vector<Cross>& crosses) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (Book* book : dirty_) {
+        book->dirty = false;
+        if (book->buys.empty() || book->sells.empty() ||
+            book->buys.begin()->first.first < book->sells.begin()->first.first) {
+            continue;
+        }
+        const double midPx = mid(book->symbol);
+        while (!book->buys.empty() && !book->sells.empty()) {
+            auto buy = book->buys.begin();
+            auto sell = book->sells.begin();
+            if (buy->first.first < sell->first.first) {
+                break;
+            }
+            const int qty = std::min(buy->second.qty, sell->second.qty);
+            crosses.push_back(Cross{book->symbol, buy->second.clOrdId, sell->second.clOrdId, qty,
+                                    std::clamp(midPx, sell->first.first, buy->first.first), buy->first.second,
+                                    sell->first.second});
+            ++crosses_;
+            crossedQty_ += static_cast<uint64_t>(qty);
+            buy->second.qty -= qty;
+            sell->second.qty -= qty;
+            if (buy->second.qty == 0) {
+                locations_.erase(buy->second.clOrdId);
+                book->buys.erase(buy);
+            }
+            if (sell->second.qty == 0) {
+                locations_.erase(sell->second.clOrdId);
+                book->sells.erase(sell);
+            }
+        }
+    }
+    dirty_.clear();
+}
+
+size_t CrossingEngine::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return locations_.size();
+}
+
+uint64_t CrossingEngine::crosses() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return crosses_;
+}
+
+uint64_t CrossingEngine::crossedQty() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return crossedQty_;
+}
+
+}  // namespace qfblotter
@@ -0,0 +1,116 @@
+#include "qfblotter/DropCopy.hpp"
+
+#include <algorithm>
+
+#include <quickfix/Session.h>
+
+namespace qfblotter {
+
+DropCopy::DropCopy(size_t capacity) : queue_(capacity) {}
+
+DropCopy::~DropCopy() {
+    stop();
+}
+
+void DropCopy::addSession(const FIX::SessionID& sessionID) {
+    sessions_.push_back(sessionID);
+}
+
+bool DropCopy::isDropCopySession(const FIX::SessionID& sessionID) const {
+    return std::find(sessions_.begin(), sessions_.end(), sessionID) != sessions_.end();
+}
+
+void DropCopy::setStatusSource(StatusSource source) {
+    statusSource_ = std::move(source);
+}
+
+void DropCopy::start() {
+    if (!enabled() || running_.exchange(true)) {
+        return;
+    }
+    thread_ = std::thread([this]() { run(); });
+}
+
+void DropCopy::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+bool DropCopy::publish(const FIX::Message& report) {
+    if (!enabled()) {
+        return false;
+    }
+    if (!queue_.tryPush(report)) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        // Coalesced per order: one status report covers every lost copy
+        FIX::ClOrdID clOrdId;
+        if (report.isSetField(clOrdId)) {
+            report.getField(clOrdId);
+            std::lock_guard<std::mutex> lock(pendingMutex_);
+            pendingResync_.insert(clOrdId.getValue());
+            hasPending_.store(true, std::memory_order_release);
+        }
+        return false;
+    }
+    return true;
+}
+
+void DropCopy::run() {
+    FIX::Message report;
+    while (running_) {
+        if (queue_.popWait(report, std::chrono::milliseconds(100))) {
+            forward(report);
+        }
+        // Resync once caught up, so the status report follows every copy
+        // that was queued ahead of it
+        if (queue_.size() == 0) {
+            resync();
+        }
+    }
+    // Flush what was accepted before shutdown
+    while (queue_.popWait(report, std::chrono::milliseconds(0))) {
+        forward(report);
+    }
+    resync();
+}
+
+void DropCopy::resync() {
+    if (!hasPending_.load(std::memory_order_acquire)) {
+        return;
+    }
+    std::unordered_set<std::string> pending;
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        pending.swap(pendingResync_);
+        hasPending_.store(false, std::memory_order_release);
+    }
+    if (!statusSource_) {
+        return;
+    }
+    for (const auto& clOrdId : pending) {
+        FIX::Message report;
+        if (statusSource_(clOrdId, report)) {
+            forward(report);
+            resynced_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+void DropCopy::forward(FIX::Message& report) {
+    for (const auto& sessionID : sessions_) {
+        // sendToTarget rewrites the header, so each session gets its own copy
+        FIX::Message copy(report);
+        try {
+            FIX::Session::sendToTarget(copy, sessionID);
+        } catch (const FIX::SessionNotFound&) {
+            continue;
+        }
+    }
+    published_.fetch_add(1, std::memory_order_relaxed);
+}
+
+}  // namespace qfblotter
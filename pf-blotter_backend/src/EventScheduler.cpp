@@ -0,0 +1,134 @@
+#include "qfblotter/EventScheduler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+#include "qfblotter/SimClock.hpp"
+
+namespace qfblotter {
+
+EventScheduler::~EventScheduler() {
+    stop();
+}
+
+int64_t EventScheduler::nowUs() {
+    return SimClock::steadyUs();
+}
+
+void EventScheduler::at(int64_t dueUs, Callback callback) {
+    bool earliest = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        heap_.push_back(Event{dueUs, nextSeq_++, std::move(callback)});
+        std::push_heap(heap_.begin(), heap_.end(), Later{});
+        earliest = heap_.front().seq == nextSeq_ - 1;
+    }
+    if (earliest) {
+        wake_.notify_one();  // The dispatcher is sleeping towards a later event
+    }
+}
+
+void EventScheduler::after(int64_t delayUs, Callback callback) {
+    at(nowUs() + std::max<int64_t>(delayUs, 0), std::move(callback));
+}
+
+void EventScheduler::every(int64_t intervalUs, Callback callback) {
+    const int64_t interval = std::max<int64_t>(intervalUs, 1);
+    repeat(nowUs() + interval, interval, std::make_shared<Callback>(std::move(callback)));
+}
+
+void EventScheduler::repeat(int64_t dueUs, int64_t intervalUs, std::shared_ptr<Callback> callback) {
+    at(dueUs, [this, dueUs, intervalUs, callback]() {
+        (*callback)();
+        repeat(dueUs + intervalUs, intervalUs, callback);  // From the due time, so it never drifts
+    });
+}
+
+size_t EventScheduler::runDue(int64_t nowUs) {
+    size_t ran = 0;
+    while (true) {
+        Event event;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (heap_.empty() || heap_.front().dueUs > nowUs) {
+                break;
+            }
+            std::pop_heap(heap_.begin(), heap_.end(), Later{});
+            event = std::move(heap_.back());
+            heap_.pop_back();
+        }
+        event.callback();  // Unlocked: it may schedule more
+        ++ran;
+        executed_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return ran;
+}
+
+size_t EventScheduler::runUntil(int64_t endUs) {
+    size_t ran = 0;
+    while (true) {
+        int64_t dueUs = 0;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (heap_.empty() || heap_.front().dueUs > endUs) {
+                break;
+            }
+            dueUs = heap_.front().dueUs;
+        }
+        SimClock::advanceTo(dueUs);
+        ran += runDue(dueUs);
+    }
+    SimClock::advanceTo(endUs);
+    return ran;
+}
+
+void EventScheduler::start() {
+    if (running_.exchange(true)) {
+        return;
+    }
+    thread_ = std::thread([this]() { run(); });
+}
+
+void EventScheduler::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_.exchange(false)) {
+            return;
+        }
+    }
+    wake_.notify_one();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    heap_.clear();
+}
+
+void EventScheduler::run() {
+    while (running_) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            if (heap_.empty()) {
+                wake_.wait(lock, [this]() { return !running_ || !heap_.empty(); });
+            } else {
+                // Until the head is due, or an earlier event replaces it
+                const uint64_t head = heap_.front().seq;
+                const auto due = std::chrono::steady_clock::time_point(std::chrono::microseconds(heap_.front().dueUs));
+                wake_.wait_until(lock, due, [this, head]() {
+                    return !running_ || heap_.empty() || heap_.front().seq != head;
+                });
+            }
+        }
+        if (running_) {
+            runDue(nowUs());
+        }
+    }
+}
+
+size_t EventScheduler::pending() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return heap_.size();
+}
+
+}  // namespace qfblotter
@@ -0,0 +1,155 @@
+#include "qfblotter/ExecutionLedger.hpp"
+
+#include <algorithm>
+
+#include "qfblotter/OrderStore.hpp"
+
+namespace qfblotter {
+
+uint64_t ExecutionLedger::append(const OrderRecord& order, int qty, double px, int64_t timeUs,
+                                 const std::string& venue) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto [it, inserted] = orderIndex_.try_emplace(order.clOrdId, static_cast<uint32_t>(orders_.size()));
+    if (inserted) {
+        orders_.push_back({order.clOrdId, order.orderId, order.symbol, order.side, 0});
+    }
+    const uint32_t orderRef = it->second;
+
+    const size_t row = static_cast<size_t>(size_ % CHUNK_ROWS);
+    if (row == 0) {
+        // Not value-initialised: rows are written before they are read. Owned
+        // before the push, so a failed push does not leak it.
+        std::unique_ptr<Chunk> fresh(new Chunk);
+        chunks_.push_back(std::move(fresh));
+    }
+    Chunk& chunk = *chunks_.back();
+
+    auto venueIt = std::find_if(venues_.begin(), venues_.end(),  // A handful of venues
+                                [&venue](const VenueTotals& totals) { return totals.venue == venue; });
+    const auto venueRef = static_cast<uint16_t>(venueIt - venues_.begin());
+    if (venueIt == venues_.end()) {
+        venues_.push_back(VenueTotals{venue, 0, 0, 0.0});
+    }
+    VenueTotals& totals = venues_[venueRef];
+    ++totals.executions;
+    totals.qty += static_cast<uint64_t>(qty);
+    totals.notional += qty * px;
+
+    const uint64_t execId = ++size_;
+    chunk.order[row] = orderRef;
+    chunk.qty[row] = qty;
+    chunk.px[row] = px;
+    chunk.timeUs[row] = timeUs;
+    chunk.venue[row] = venueRef;
+    chunk.prev[row] = orders_[orderRef].lastExecId;
+    orders_[orderRef].lastExecId = execId;
+    return execId;
+}
+
+Execution ExecutionLedger::rowLocked(uint64_t execId) const {
+    const uint64_t index = execId - 1;
+    const Chunk& chunk = *chunks_[static_cast<size_t>(index / CHUNK_ROWS)];
+    const auto row = static_cast<size_t>(index % CHUNK_ROWS);
+    const OrderRef& order = orders_[chunk.order[row]];
+    Execution out;
+    out.execId = execId;
+    out.clOrdId = order.clOrdId;
+    out.orderId = order.orderId;
+    out.symbol = order.symbol;
+    out.side = order.side;
+    out.qty = chunk.qty[row];
+    out.px = chunk.px[row];
+    out.timeUs = chunk.timeUs[row];
+    out.venue = venues_[chunk.venue[row]].venue;
+    return out;
+}
+
+std::vector<Execution> ExecutionLedger::since(uint64_t since, size_t limit) const {
+    std::vector<Execution> out;
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (since >= size_) {
+        return out;  // Caught up, or a cursor from beyond the end
+    }
+    const uint64_t end = since + std::min<uint64_t>(limit, size_ - since);
+    out.reserve(static_cast<size_t>(end - since));
+    for (uint64_t execId = since + 1; execId <= end; ++execId) {
+        out.push_back(rowLocked(execId));
+    }
+    return out;
+}
+
+std::vector<Execution> ExecutionLedger::forOrder(const std::string& clOrdId) const {
+    std::vector<Execution> out;
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = orderIndex_.find(clOrdId);
+    if (it == orderIndex_.end()) {
+        return out;
+    }
+    for (uint64_t execId = orders_[it->second].lastExecId; execId != 0;) {
+        out.push_back(rowLocked(execId));
+        const uint64_t index = execId - 1;
+        execId = chunks_[static_cast<size_t>(index / CHUNK_ROWS)]->prev[static_cast<size_t>(index % CHUNK_ROWS)];
+    }
+    std::reverse(out.begin(), out.end());
+    return out;
+}
+
+std::vector<ExecutionLedger::VenueTotals> ExecutionLedger::venueTotals() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return venues_;
+}
+
+uint64_t ExecutionLedger::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return size_;
+}
+
+size_t ExecutionLedger::chunks() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return chunks_.size();
+}
+
+Json ExecutionLedger::toJson(const Execution& execution) {
+    Json j;
+    j["execId"] = execution.execId;
+    j["clOrdId"] = execution.clOrdId;
+    j["orderId"] = execution.orderId;
+    j["symbol"] = execution.symbol;
+    j["side"] = std::string(1, execution.side);
+    j["qty"] = execution.qty;
+    j["px"] = execution.px;
+    j["timeUs"] = execution.timeUs;
+    j["venue"] = execution.venue;
+    return j;
+}
+
+Json ExecutionLedger::sinceJson(uint64_t since, size_t limit) const {
+    const auto rows = this->since(since, limit);
+    Json j;
+    j["executions"] = Json::array();
+    for (const auto& row : rows) {
+        j["executions"].push_back(toJson(row));
+    }
+    j["next"] = rows.empty() ? since : rows.back().execId;
+    j["total"] = size();
+    return j;
+}
+
+Json ExecutionLedger::orderJson(const std::string& clOrdId) const {
+    const auto rows = forOrder(clOrdId);
+    Json j;
+    j["clOrdId"] = clOrdId;
+    j["executions"] = Json::array();
+    int cumQty = 0;
+    double notional = 0.0;
+    for (const auto& row : rows) {
+        j["executions"].push_back(toJson(row));
+        cumQty += row.qty;
+        notional += row.qty * row.px;
+    }
+    j["cumQty"] = cumQty;
+    j["avgPx"] = cumQty > 0 ? notional / cumQty : 0.0;
+    return j;
+}
+
+}  // namespace qfblotter
@@ -1,35 +1,45 @@
 #include "qfblotter/FixApplication.hpp"
 
+#include <algorithm>
 #include <chrono>
-#include <iomanip>
-#include <sstream>
+#include <limits>
 
 #include <quickfix/Session.h>
+#include <quickfix/fix44/BusinessMessageReject.h>
 #include <quickfix/fix44/ExecutionReport.h>
+#include <quickfix/fix44/MarketDataRequest.h>
 #include <quickfix/fix44/NewOrderSingle.h>
 #include <quickfix/fix44/OrderCancelReject.h>
 #include <quickfix/fix44/OrderCancelRequest.h>
 
+#include "qfblotter/AdmissionControl.hpp"
+#include "qfblotter/CoarseClock.hpp"
+#include "qfblotter/DropCopy.hpp"
+#include "qfblotter/ExecutionLedger.hpp"
+#include "qfblotter/FixDictionary.hpp"
+#include "qfblotter/FixMarketData.hpp"
 #include "qfblotter/MarketSim.hpp"
+#include "qfblotter/OrderExpiry.hpp"
 #include "qfblotter/OrderStore.hpp"
+#include "qfblotter/SimClock.hpp"
 
 namespace qfblotter {
 
 namespace {
-std::string utc_now_iso() {
-    using namespace std::chrono;
-    auto now = system_clock::now();
-    std::time_t t = system_clock::to_time_t(now);
-    std::tm tm{};
-#if defined(_WIN32)
-    gmtime_s(&tm, &t);
-#else
-    gmtime_r(&t, &tm);
-#endif
-    std::ostringstream oss;
-    oss << std::put_time(&tm, "%Y-%m-%dT%H:%M:%SZ");
-    return oss.str();
+int64_t epoch_ms() {
+    return SimClock::epochMs();
 }
+
+// FIX OrdStatus (tag 39) for an order's current state
+char ord_status(const OrderRecord& record) {
+    if (record.status == "FILLED") return FIX::OrdStatus_FILLED;
+    if (record.status == "CANCELED") return FIX::OrdStatus_CANCELED;
+    if (record.status == "REJECTED") return FIX::OrdStatus_REJECTED;
+    if (record.status == "EXPIRED") return FIX::OrdStatus_EXPIRED;
+    if (record.cumQty > 0) return FIX::OrdStatus_PARTIALLY_FILLED;
+    return FIX::OrdStatus_NEW;
+}
+
 // Pre-trade risk limits
 constexpr int MAX_ORDER_QTY = 10000;
 constexpr double MAX_NOTIONAL = 1'000'000.0;
@@ -46,8 +56,131 @@ constexpr int ORD_REJ_OTHER = 99;
 FixApplication::FixApplication(OrderStore& store, MarketSim& market, EventPublisher publisher)
     : store_(store), market_(market), publisher_(std::move(publisher)) {}
 
+void FixApplication::setFillListener(FillListener listener) {
+    fillListener_ = std::move(listener);
+}
+
+void FixApplication::setCancelListener(OrderListener listener) {
+    cancelListener_ = std::move(listener);
+}
+
+void FixApplication::setNewOrderListener(OrderListener listener) {
+    newOrderListener_ = std::move(listener);
+}
+
+void FixApplication::setDropCopy(DropCopy* dropCopy) {
+    dropCopy_ = dropCopy;
+    if (!dropCopy_) {
+        return;
+    }
+    // Overflowed copies are replaced by the order's current state
+    dropCopy_->setStatusSource([this](const std::string& clOrdId, FIX::Message& report) {
+        const auto record = store_.get(clOrdId);
+        if (!record) {
+            return false;
+        }
+        FIX44::ExecutionReport status = buildReport(*record, FIX::ExecType_ORDER_STATUS);
+        status.set(FIX::Text("Drop-copy resync: earlier reports for this order were not delivered"));
+        report = status;
+        return true;
+    });
+}
+
+void FixApplication::setMarketData(FixMarketData* marketData) {
+    marketData_ = marketData;
+}
+
+void FixApplication::setSessionEndTime(const std::string& hhmmss) {
+    sessionEndTime_ = hhmmss;
+}
+
+void FixApplication::setCompiledDictionary(bool enabled) {
+    compiledDictionary_ = enabled;
+}
+
+void FixApplication::setAdmissionControl(AdmissionControl* admission) {
+    admission_ = admission;
+}
+
+void FixApplication::setSymbolFilter(SymbolFilter ownsSymbol) {
+    ownsSymbol_ = std::move(ownsSymbol);
+}
+
+void FixApplication::onOrdersExpired(const std::vector<OrderRecord>& expired) {
+    for (const auto& record : expired) {
+        reportExecution(record, FIX::ExecType_EXPIRED);
+        forgetSession(record.clOrdId);
+    }
+}
+
+void FixApplication::onStopTriggered(const OrderRecord& activated) {
+    reportExecution(activated, FIX::ExecType_TRIGGERED_OR_ACTIVATED_BY_SYSTEM);
+}
+
+void FixApplication::reportFill(const OrderRecord& before, int fillQty, double fillPx) {
+    if (fillQty <= 0) {
+        return;
+    }
+    OrderRecord after = before;
+    after.cumQty = before.cumQty + fillQty;
+    after.leavesQty = std::max(0, before.quantity - after.cumQty);
+    after.avgPx = (before.avgPx * before.cumQty + fillPx * fillQty) / after.cumQty;
+    after.status = after.leavesQty == 0 ? "FILLED" : "PARTIAL";
+    reportExecution(after, FIX::ExecType_TRADE, fillQty, fillPx);
+    if (after.leavesQty == 0) {
+        forgetSession(before.clOrdId);
+    }
+}
+
+FIX44::ExecutionReport FixApplication::buildReport(const OrderRecord& record, char execType, int lastQty,
+                                                   double lastPx) {
+    FIX44::ExecutionReport report(
+        FIX::OrderID(record.orderId),
+        FIX::ExecID(nextExecId()),
+        FIX::ExecType(execType),
+        FIX::OrdStatus(ord_status(record)),
+        FIX::Side(record.side),
+        FIX::LeavesQty(record.leavesQty),
+        FIX::CumQty(record.cumQty),
+        FIX::AvgPx(record.avgPx)
+    );
+    report.set(FIX::ClOrdID(record.clOrdId));
+    report.set(FIX::Symbol(record.symbol));
+    report.set(FIX::OrderQty(record.quantity));
+    report.set(FIX::OrdType(record.orderType));
+    report.set(FIX::TimeInForce(record.timeInForce));
+    if (record.orderType == ORD_LIMIT || record.orderType == ORD_STOP_LIMIT) {
+        report.set(FIX::Price(record.price));
+    }
+    if (record.stopPx > 0.0) {
+        report.set(FIX::StopPx(record.stopPx));
+    }
+    if (lastQty > 0) {
+        report.set(FIX::LastQty(lastQty));
+        report.set(FIX::LastPx(lastPx));
+    }
+    report.set(FIX::TransactTime());
+    return report;
+}
+
+void FixApplication::reportExecution(const OrderRecord& record, char execType, int lastQty, double lastPx) {
+    FIX44::ExecutionReport report = buildReport(record, execType, lastQty, lastPx);
+
+    FIX::SessionID sessionID;
+    if (findSession(record.clOrdId, sessionID)) {
+        try {
+            FIX::Session::sendToTarget(report, sessionID);
+        } catch (const FIX::SessionNotFound&) {
+            // Session gone; the event is still reflected in the store
+        }
+    }
+    mirror(report);
+}
+
 void FixApplication::onCreate(const FIX::SessionID& sessionID) {
-    (void)sessionID;
+    if (compiledDictionary_) {
+        useCompiledDataDictionary(sessionID);
+    }
 }
 
 void FixApplication::onLogon(const FIX::SessionID& sessionID) {
@@ -55,7 +188,9 @@ void FixApplication::onLogon(const FIX::SessionID& sessionID) {
 }
 
 void FixApplication::onLogout(const FIX::SessionID& sessionID) {
-    (void)sessionID;
+    if (marketData_) {
+        marketData_->onLogout(sessionID);
+    }
 }
 
 void FixApplication::toAdmin(FIX::Message& message, const FIX::SessionID& sessionID) {
@@ -64,8 +199,10 @@ void FixApplication::toAdmin(FIX::Message& message, const FIX::SessionID& sessio
 }
 
 void FixApplication::fromAdmin(const FIX::Message& message, const FIX::SessionID& sessionID) {
-    (void)message;
     (void)sessionID;
+    if (compiledDictionary_) {
+        validateCompiled(message);
+    }
 }
 
 void FixApplication::toApp(FIX::Message& message, const FIX::SessionID& sessionID) {
@@ -74,10 +211,33 @@ void FixApplication::toApp(FIX::Message& message, const FIX::SessionID& sessionI
 }
 
 void FixApplication::fromApp(const FIX::Message& message, const FIX::SessionID& sessionID) {
+    if (compiledDictionary_) {
+        validateCompiled(message);
+    }
+    // Drop-copy consumers are receive-only
+    if (dropCopy_ && dropCopy_->isDropCopySession(sessionID)) {
+        throw FIX::UnsupportedMessageType();
+    }
+    AdmissionControl::Ticket ticket;
+    if (admission_) {
+        FIX::MsgType msgType;
+        message.getHeader().getField(msgType);
+        const bool cancel = msgType.getValue() == FIX::MsgType_OrderCancelRequest;
+        if (cancel || msgType.getValue() == FIX::MsgType_NewOrderSingle) {
+            // fromApp runs on the acceptor thread, so shed rather than wait
+            ticket = admission_->tryAdmit(cancel ? AdmissionControl::Priority::CANCEL
+                                                 : AdmissionControl::Priority::NEW_ORDER);
+            if (!ticket) {
+                sendOverloaded(message, msgType.getValue(), ticket.retryAfterMs(), sessionID);
+                return;
+            }
+        }
+    }
     crack(message, sessionID);
 }
 
 void FixApplication::onMessage(const FIX44::NewOrderSingle& message, const FIX::SessionID& sessionID) {
+    const auto submitTime = std::chrono::steady_clock::now();
     FIX::ClOrdID clOrdId;
     FIX::Symbol symbol;
     FIX::Side side;
@@ -94,9 +254,38 @@ void FixApplication::onMessage(const FIX44::NewOrderSingle& message, const FIX::
         message.get(price);
     }
 
+    FIX::TimeInForce timeInForce(FIX::TimeInForce_DAY);
+    if (message.isSetField(timeInForce)) {
+        message.get(timeInForce);
+    }
+    const char tif = timeInForce.getValue();
+
+    int64_t expireTimeMs = 0;
+    FIX::ExpireTime expireTime;
+    if (message.isSetField(expireTime)) {
+        message.get(expireTime);
+        const auto& ts = expireTime.getValue();
+        expireTimeMs = static_cast<int64_t>(ts.getTimeT()) * 1000 + ts.getMillisecond();
+    }
+
+    FIX::OrdType ordType(hasPrice ? FIX::OrdType_LIMIT : FIX::OrdType_MARKET);
+    if (message.isSetField(ordType)) {
+        message.get(ordType);
+    }
+    const char type = ordType.getValue();
+    const bool isStop = (type == ORD_STOP || type == ORD_STOP_LIMIT);
+
+    FIX::StopPx stopPx;
+    const bool hasStopPx = message.isSetField(stopPx);
+    if (hasStopPx) {
+        message.get(stopPx);
+    }
+    const double stopPrice = hasStopPx ? stopPx.getValue() : 0.0;
+
     const int qty = static_cast<int>(orderQty.getValue());
     const double px = hasPrice ? price.getValue() : 0.0;
-    const double notional = qty * px;
+    // Stop orders are risk-checked at their trigger price when no limit is given
+    const double notional = qty * (hasPrice ? px : stopPrice);
 
     // --- PRE-TRADE VALIDATION ---
     std::string rejectReason;
@@ -105,6 +294,9 @@ void FixApplication::onMessage(const FIX44::NewOrderSingle& message, const FIX::
     if (symbol.getValue().empty()) {
         rejectReason = "Symbol is required";
         rejectCode = ORD_REJ_UNKNOWN_SYMBOL;
+    } else if (ownsSymbol_ && !ownsSymbol_(symbol.getValue())) {
+        rejectReason = symbol.getValue() + " is not owned by this shard";
+        rejectCode = ORD_REJ_UNKNOWN_SYMBOL;
     } else if (side.getValue() != '1' && side.getValue() != '2') {
         rejectReason = "Invalid side (must be 1=Buy or 2=Sell)";
         rejectCode = ORD_REJ_OTHER;
@@ -117,9 +309,27 @@ void FixApplication::onMessage(const FIX44::NewOrderSingle& message, const FIX::
     } else if (qty > MAX_ORDER_QTY) {
         rejectReason = "Order quantity exceeds limit (" + std::to_string(MAX_ORDER_QTY) + ")";
         rejectCode = ORD_REJ_ORDER_EXCEEDS_LIMIT;
-    } else if (hasPrice && notional > MAX_NOTIONAL) {
+    } else if (type != ORD_MARKET && type != ORD_LIMIT && !isStop) {
+        rejectReason = "Unsupported OrdType";
+        rejectCode = ORD_REJ_OTHER;
+    } else if ((type == ORD_LIMIT || type == ORD_STOP_LIMIT) && !hasPrice) {
+        rejectReason = "Price is required for limit orders";
+        rejectCode = ORD_REJ_OTHER;
+    } else if (isStop && stopPrice <= 0.0) {
+        rejectReason = "StopPx must be positive for stop orders";
+        rejectCode = ORD_REJ_OTHER;
+    } else if (isStop && (tif == TIF_IOC || tif == TIF_FOK)) {
+        rejectReason = "IOC/FOK not supported for stop orders";
+        rejectCode = ORD_REJ_OTHER;
+    } else if ((hasPrice || isStop) && notional > MAX_NOTIONAL) {
         rejectReason = "Notional exceeds limit ($" + std::to_string(static_cast<int>(MAX_NOTIONAL)) + ")";
         rejectCode = ORD_REJ_ORDER_EXCEEDS_LIMIT;
+    } else if (tif != TIF_DAY && tif != TIF_GTC && tif != TIF_IOC && tif != TIF_FOK && tif != TIF_GTD) {
+        rejectReason = "Unsupported TimeInForce";
+        rejectCode = ORD_REJ_OTHER;
+    } else if (tif == TIF_GTD && expireTimeMs <= epoch_ms()) {
+        rejectReason = "GTD order requires a future ExpireTime";
+        rejectCode = ORD_REJ_OTHER;
     } else if (store_.exists(clOrdId.getValue())) {
         rejectReason = "Duplicate ClOrdID";
         rejectCode = ORD_REJ_DUPLICATE_ORDER;
@@ -148,7 +358,7 @@ void FixApplication::onMessage(const FIX44::NewOrderSingle& message, const FIX::
         reject.set(FIX::Text(rejectReason));
         reject.set(FIX::TransactTime());
 
-        FIX::Session::sendToTarget(reject, sessionID);
+        sendReport(reject, sessionID);
 
         // Record rejected order in store for UI visibility
         OrderRecord record;
@@ -163,7 +373,7 @@ void FixApplication::onMessage(const FIX44::NewOrderSingle& message, const FIX::
         record.avgPx = 0.0;
         record.status = "REJECTED";
         record.rejectReason = rejectReason;
-        record.transactTime = utc_now_iso();
+        record.transactTime = CoarseClock::isoSeconds();
         store_.upsert(record);
 
         publishSnapshot();
@@ -188,12 +398,18 @@ void FixApplication::onMessage(const FIX44::NewOrderSingle& message, const FIX::
     ack.set(clOrdId);
     ack.set(symbol);
     ack.set(orderQty);
+    ack.set(timeInForce);
+    ack.set(ordType);
     ack.set(FIX::TransactTime());
     if (hasPrice) {
         ack.set(price);
     }
+    if (isStop) {
+        ack.set(stopPx);
+    }
 
-    FIX::Session::sendToTarget(ack, sessionID);
+    sendReport(ack, sessionID);
+    const auto ackTime = std::chrono::steady_clock::now();
 
     OrderRecord record;
     record.clOrdId = clOrdId.getValue();
@@ -205,9 +421,95 @@ void FixApplication::onMessage(const FIX44::NewOrderSingle& message, const FIX::
     record.leavesQty = qty;
     record.cumQty = 0;
     record.avgPx = 0.0;
-    record.status = "NEW";
-    record.transactTime = utc_now_iso();
+    record.arrivalPx = market_.mark(symbol.getValue());
+    record.status = isStop ? STATUS_PENDING_STOP : "NEW";
+    record.transactTime = CoarseClock::isoSeconds();
+    record.timeInForce = tif;
+    record.orderType = type;
+    record.stopPx = stopPrice;
+    if (tif == TIF_DAY) {
+        record.expireTimeMs = OrderExpiry::nextDailyCutoffMs(sessionEndTime_, epoch_ms());
+    } else if (tif == TIF_GTD) {
+        record.expireTimeMs = expireTimeMs;
+    }
+    // Order → ack latency, on the same clock as UI orders
+    record.submitTimeUs = std::chrono::duration_cast<std::chrono::microseconds>(submitTime.time_since_epoch()).count();
+    record.ackTimeUs = std::chrono::duration_cast<std::chrono::microseconds>(ackTime.time_since_epoch()).count();
+    record.latencyUs = record.ackTimeUs - record.submitTimeUs;
     store_.upsert(record);
+    {
+        std::lock_guard<std::mutex> lock(sessionsMutex_);
+        orderSessions_[record.clOrdId] = sessionID;
+    }
+    if (newOrderListener_) {
+        newOrderListener_(record);
+    }
+
+    // --- STOP: rests in the trigger index until the market reaches StopPx ---
+    if (isStop) {
+        publishSnapshot();
+        return;
+    }
+
+    // --- IOC / FOK: one matching attempt, remainder canceled ---
+    if (tif == TIF_IOC || tif == TIF_FOK) {
+        const double limitPx = hasPrice ? px : (side.getValue() == '1' ? std::numeric_limits<double>::max() : 0.0);
+        FillResult result = tif == TIF_FOK ? market_.attemptFillAll(symbol.getValue(), side.getValue(), limitPx, qty)
+                                           : market_.attemptFill(symbol.getValue(), side.getValue(), limitPx, qty);
+
+        if (result.fillQty > 0) {
+            const int leaves = qty - result.fillQty;
+            FIX44::ExecutionReport fill(
+                FIX::OrderID(orderId),
+                FIX::ExecID(nextExecId()),
+                FIX::ExecType(FIX::ExecType_TRADE),
+                FIX::OrdStatus(leaves == 0 ? FIX::OrdStatus_FILLED : FIX::OrdStatus_PARTIALLY_FILLED),
+                side,
+                FIX::LeavesQty(leaves),
+                FIX::CumQty(result.fillQty),
+                FIX::AvgPx(result.fillPx)
+            );
+            fill.set(clOrdId);
+            fill.set(symbol);
+            fill.set(orderQty);
+            fill.set(timeInForce);
+            fill.set(FIX::LastQty(result.fillQty));
+            fill.set(FIX::LastPx(result.fillPx));
+            fill.set(FIX::TransactTime());
+            sendReport(fill, sessionID);
+
+            store_.updateStatus(record.clOrdId, leaves == 0 ? "FILLED" : "PARTIAL", leaves,
+                                result.fillQty, result.fillPx);
+            notifyFill(record, result.fillQty, result.fillPx);
+        }
+
+        if (!result.complete) {
+            FIX44::ExecutionReport cancel(
+                FIX::OrderID(orderId),
+                FIX::ExecID(nextExecId()),
+                FIX::ExecType(FIX::ExecType_CANCELED),
+                FIX::OrdStatus(FIX::OrdStatus_CANCELED),
+                side,
+                FIX::LeavesQty(0),
+                FIX::CumQty(result.fillQty),
+                FIX::AvgPx(result.fillPx)
+            );
+            cancel.set(clOrdId);
+            cancel.set(symbol);
+            cancel.set(orderQty);
+            cancel.set(timeInForce);
+            cancel.set(FIX::Text(tif == TIF_FOK ? "FOK order could not be fully filled"
+                                                : "IOC remainder canceled"));
+            cancel.set(FIX::TransactTime());
+            sendReport(cancel, sessionID);
+
+            store_.updateStatus(record.clOrdId, "CANCELED", 0, result.fillQty, result.fillPx);
+        }
+
+        forgetSession(record.clOrdId);
+        publishSnapshot();
+        return;
+    }
 
     // --- FILL PATH (if market crosses limit) ---
     if (hasPrice && market_.shouldFill(symbol.getValue(), side.getValue(), px)) {
@@ -232,9 +534,11 @@ void FixApplication::onMessage(const FIX44::NewOrderSingle& message, const FIX::
         fill.set(FIX::LastPx(px));
         fill.set(FIX::TransactTime());
 
-        FIX::Session::sendToTarget(fill, sessionID);
+        sendReport(fill, sessionID);
 
         store_.updateStatus(record.clOrdId, "FILLED", 0, qty, px);
+        notifyFill(record, qty, px);
+        forgetSession(record.clOrdId);
     }
 
     publishSnapshot();
@@ -296,8 +600,8 @@ void FixApplication::onMessage(const FIX44::OrderCancelRequest& message, const F
     FIX::ExecType execType(FIX::ExecType_CANCELED);
     FIX::OrdStatus ordStatus(FIX::OrdStatus_CANCELED);
     FIX::LeavesQty leaves(0);
-    FIX::CumQty cum(0);
-    FIX::AvgPx avg(0);
+    FIX::CumQty cum(record.cumQty);
+    FIX::AvgPx avg(record.avgPx);
 
     FIX44::ExecutionReport cancel(
         FIX::OrderID(origClOrdId.getValue()),
@@ -315,12 +619,25 @@ void FixApplication::onMessage(const FIX44::OrderCancelRequest& message, const F
     cancel.set(symbol);
     cancel.set(FIX::TransactTime());
 
-    FIX::Session::sendToTarget(cancel, sessionID);
+    sendReport(cancel, sessionID);
 
-    store_.updateStatus(origClOrdId.getValue(), "CANCELED", 0, 0, 0.0);
+    store_.updateStatus(origClOrdId.getValue(), "CANCELED", 0, record.cumQty, record.avgPx);
+    forgetSession(origClOrdId.getValue());
+    if (cancelListener_) {
+        if (auto canceled = store_.get(origClOrdId.getValue())) {
+            cancelListener_(*canceled);
+        }
+    }
     publishSnapshot();
 }
 
+void FixApplication::onMessage(const FIX44::MarketDataRequest& message, const FIX::SessionID& sessionID) {
+    if (!marketData_) {
+        throw FIX::UnsupportedMessageType();
+    }
+    marketData_->onRequest(message, sessionID);
+}
+
 std::string FixApplication::nextOrderId() {
     return "ORD" + std::to_string(orderCounter_.fetch_add(1));
 }
@@ -329,6 +646,62 @@ std::string FixApplication::nextExecId() {
     return "EXEC" + std::to_string(execCounter_.fetch_add(1));
 }
 
+void FixApplication::notifyFill(const OrderRecord& before, int fillQty, double fillPx) {
+    if (fillListener_) {
+        fillListener_(before, fillQty, fillPx, VENUE_MARKET);
+    }
+}
+
+void FixApplication::forgetSession(const std::string& clOrdId) {
+    std::lock_guard<std::mutex> lock(sessionsMutex_);
+    orderSessions_.erase(clOrdId);
+}
+
+void FixApplication::sendReport(FIX::Message& report, const FIX::SessionID& sessionID) {
+    FIX::Session::sendToTarget(report, sessionID);
+    mirror(report);
+}
+
+void FixApplication::sendOverloaded(const FIX::Message& message, const std::string& msgType, int64_t retryAfterMs,
+                                    const FIX::SessionID& sessionID) {
+    FIX44::BusinessMessageReject reject(
+        FIX::RefMsgType(msgType),
+        FIX::BusinessRejectReason(FIX::BusinessRejectReason_APPLICATION_NOT_AVAILABLE)
+    );
+    FIX::MsgSeqNum seqNum;
+    if (message.getHeader().isSetField(seqNum)) {
+        message.getHeader().getField(seqNum);
+        reject.set(FIX::RefSeqNum(seqNum.getValue()));
+    }
+    FIX::ClOrdID clOrdId;
+    if (message.isSetField(clOrdId)) {
+        message.getField(clOrdId);
+        reject.set(FIX::BusinessRejectRefID(clOrdId.getValue()));
+    }
+    reject.set(FIX::Text("Gateway overloaded, retry after " + std::to_string(retryAfterMs) + "ms"));
+    try {
+        FIX::Session::sendToTarget(reject, sessionID);
+    } catch (const FIX::SessionNotFound&) {
+        // Session gone; nothing was accepted
+    }
+}
+
+void FixApplication::mirror(const FIX::Message& report) {
+    if (dropCopy_) {
+        dropCopy_->publish(report);
+    }
+}
+
+bool FixApplication::findSession(const std::string& clOrdId, FIX::SessionID& sessionID) {
+    std::lock_guard<std::mutex> lock(sessionsMutex_);
+    auto it = orderSessions_.find(clOrdId);
+    if (it == orderSessions_.end()) {
+        return false;  // UI order
+    }
+    sessionID = it->second;
+    return true;
+}
+
 void FixApplication::publishSnapshot() {
     if (!publisher_) {
         return;
@@ -0,0 +1,203 @@
+#include "qfblotter/FixDictionary.hpp"
+
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <quickfix/DataDictionary.h>
+#include <quickfix/DataDictionaryProvider.h>
+#include <quickfix/Exceptions.h>
+#include <quickfix/Message.h>
+#include <quickfix/Session.h>
+
+#include "qfblotter/Fix44Dictionary.hpp"
+#include "qfblotter/FixValidator.hpp"
+
+namespace qfblotter {
+
+namespace {
+using namespace fixdict;
+
+// Same mapping QuickFIX applies when it reads the XML
+FIX::TYPE::Type quickfixType(std::string_view xmlType) {
+    static constexpr std::pair<std::string_view, FIX::TYPE::Type> TYPES[] = {
+        {"STRING", FIX::TYPE::String},
+        {"CHAR", FIX::TYPE::Char},
+        {"PRICE", FIX::TYPE::Price},
+        {"INT", FIX::TYPE::Int},
+        {"AMT", FIX::TYPE::Amt},
+        {"QTY", FIX::TYPE::Qty},
+        {"CURRENCY", FIX::TYPE::Currency},
+        {"MULTIPLEVALUESTRING", FIX::TYPE::MultipleValueString},
+        {"MULTIPLESTRINGVALUE", FIX::TYPE::MultipleStringValue},
+        {"MULTIPLECHARVALUE", FIX::TYPE::MultipleCharValue},
+        {"EXCHANGE", FIX::TYPE::Exchange},
+        {"UTCTIMESTAMP", FIX::TYPE::UtcTimeStamp},
+        {"BOOLEAN", FIX::TYPE::Boolean},
+        {"LOCALMKTDATE", FIX::TYPE::LocalMktDate},
+        {"DATA", FIX::TYPE::Data},
+        {"FLOAT", FIX::TYPE::Float},
+        {"PRICEOFFSET", FIX::TYPE::PriceOffset},
+        {"MONTHYEAR", FIX::TYPE::MonthYear},
+        {"DAYOFMONTH", FIX::TYPE::DayOfMonth},
+        {"UTCDATE", FIX::TYPE::UtcDate},
+        {"UTCDATEONLY", FIX::TYPE::UtcDateOnly},
+        {"UTCTIMEONLY", FIX::TYPE::UtcTimeOnly},
+        {"NUMINGROUP", FIX::TYPE::NumInGroup},
+        {"PERCENTAGE", FIX::TYPE::Percentage},
+        {"SEQNUM", FIX::TYPE::SeqNum},
+        {"LENGTH", FIX::TYPE::Length},
+        {"COUNTRY", FIX::TYPE::Country},
+        {"TZTIMEONLY", FIX::TYPE::TzTimeOnly},
+        {"TZTIMESTAMP", FIX::TYPE::TzTimeStamp},
+        {"XMLDATA", FIX::TYPE::XmlData},
+        {"LANGUAGE", FIX::TYPE::Language},
+    };
+    for (const auto& [name, type] : TYPES) {
+        if (name == xmlType) {
+            return type;
+        }
+    }
+    return FIX::TYPE::Unknown;
+}
+
+void addGroups(FIX::DataDictionary& dd, const std::string& msgType, const ScopeDef& scope);
+
+// One entry's fields in declared order, which QuickFIX keeps when it writes
+// the group out
+FIX::DataDictionary buildGroup(const std::string& msgType, const GroupDef& group) {
+    FIX::DataDictionary dd;
+    for (size_t i = 0; i < group.entry.memberCount; ++i) {
+        dd.addField(MEMBERS[group.entry.firstMember + i].tag);
+    }
+    addGroups(dd, msgType, group.entry);
+    return dd;
+}
+
+void addGroups(FIX::DataDictionary& dd, const std::string& msgType, const ScopeDef& scope) {
+    for (size_t i = 0; i < scope.memberCount; ++i) {
+        const MemberDef& member = MEMBERS[scope.firstMember + i];
+        if (member.group >= 0) {
+            const GroupDef& group = GROUPS[static_cast<size_t>(member.group)];
+            dd.addGroup(msgType, group.countTag, group.delimiter, buildGroup(msgType, group));
+        }
+    }
+}
+
+// Fields of a message in wire order, group entries after their count
+void flatten(const FIX::FieldMap& map, std::vector<FixField>& out) {
+    for (auto it = map.begin(); it != map.end(); ++it) {
+        const int tag = it->getTag();
+        out.push_back({tag, it->getString()});
+        if (map.hasGroup(tag)) {
+            const size_t count = map.groupCount(tag);
+            for (size_t i = 1; i <= count; ++i) {
+                flatten(map.getGroupRef(static_cast<int>(i), tag), out);
+            }
+        }
+    }
+}
+}  // namespace
+
+std::shared_ptr<FIX::DataDictionary> buildCompiledDataDictionary() {
+    auto dd = std::make_shared<FIX::DataDictionary>();
+    for (const FieldDef& field : FIELDS) {
+        dd->addField(field.tag);
+        dd->addFieldName(field.tag, std::string(field.name));
+        dd->addFieldType(field.tag, quickfixType(field.xmlType));
+        for (size_t i = 0; i < field.valueCount; ++i) {
+            const ValueDef& value = VALUES[field.firstValue + i];
+            dd->addFieldValue(field.tag, std::string(value.value));
+            dd->addValueName(field.tag, std::string(value.value), std::string(value.description));
+        }
+    }
+
+    for (size_t i = 0; i < HEADER.memberCount; ++i) {
+        const MemberDef& member = MEMBERS[HEADER.firstMember + i];
+        dd->addHeaderField(member.tag, member.required);
+    }
+    addGroups(*dd, "_header_", HEADER);
+    for (size_t i = 0; i < TRAILER.memberCount; ++i) {
+        const MemberDef& member = MEMBERS[TRAILER.firstMember + i];
+        dd->addTrailerField(member.tag, member.required);
+    }
+    addGroups(*dd, "_trailer_", TRAILER);
+
+    for (const MessageDef& message : MESSAGES) {
+        const std::string msgType(message.msgType);
+        dd->addMsgType(msgType);
+        for (size_t i = 0; i < message.body.memberCount; ++i) {
+            dd->addMsgField(msgType, MEMBERS[message.body.firstMember + i].tag);
+        }
+        addGroups(*dd, msgType, message.body);
+    }
+    // No setVersion(): with a version QuickFIX would validate every message
+    // itself, which validateCompiled() replaces
+    return dd;
+}
+
+std::shared_ptr<FIX::DataDictionary> compiledDataDictionary() {
+    static const std::shared_ptr<FIX::DataDictionary> dd = buildCompiledDataDictionary();
+    return dd;
+}
+
+void useCompiledDataDictionary(const FIX::SessionID& sessionID) {
+    const std::string beginString = sessionID.getBeginString().getValue();
+    if (beginString != BEGIN_STRING) {
+        throw std::runtime_error("Compiled data dictionary is " + std::string(BEGIN_STRING) + ", session " +
+                                 sessionID.toString() + " is " + beginString);
+    }
+    FIX::Session* session = FIX::Session::lookupSession(sessionID);
+    if (session == nullptr) {
+        throw std::runtime_error("Session not found: " + sessionID.toString());
+    }
+    const auto dd = compiledDataDictionary();
+    FIX::DataDictionaryProvider provider;
+    provider.addTransportDataDictionary(sessionID.getBeginString(), dd);
+    provider.addApplicationDataDictionary(FIX::Message::toApplVerID(sessionID.getBeginString()), dd);
+    session->setDataDictionaryProvider(provider);
+}
+
+void validateCompiled(const FIX::Message& message) {
+    int outOfOrder = 0;
+    if (!message.hasValidStructure(outOfOrder)) {
+        throw FIX::TagOutOfOrder(outOfOrder);
+    }
+    thread_local std::vector<FixField> fields;
+    fields.clear();
+    flatten(message.getHeader(), fields);
+    flatten(message, fields);
+    flatten(message.getTrailer(), fields);
+
+    const FixValidation result = validateFixMessage(std::span<const FixField>(fields));
+    switch (result.reject) {
+        case FixReject::NONE:
+            return;
+        case FixReject::INVALID_TAG:
+            throw FIX::InvalidTagNumber(result.tag);
+        case FixReject::REQUIRED_TAG_MISSING:
+            throw FIX::RequiredTagMissing(result.tag);
+        case FixReject::TAG_NOT_DEFINED_FOR_MESSAGE:
+            throw FIX::TagNotDefinedForMessage(result.tag);
+        case FixReject::EMPTY_VALUE:
+            throw FIX::NoTagValue(result.tag);
+        case FixReject::INCORRECT_VALUE:
+            throw FIX::IncorrectTagValue(result.tag);
+        case FixReject::INCORRECT_FORMAT:
+            throw FIX::IncorrectDataFormat(result.tag);
+        case FixReject::INVALID_MSG_TYPE:
+            throw FIX::InvalidMessageType();
+        case FixReject::UNSUPPORTED_MSG_TYPE:
+            throw FIX::UnsupportedMessageType();
+        case FixReject::REPEATED_TAG:
+            throw FIX::RepeatedTag(result.tag);
+        case FixReject::TAG_OUT_OF_ORDER:
+            throw FIX::TagOutOfOrder(result.tag);
+        case FixReject::GROUP_COUNT_MISMATCH:
+            throw FIX::RepeatingGroupCountMismatch(result.tag);
+    }
+}
+
+}  // namespace qfblotter
@@ -0,0 +1,193 @@
+#include "qfblotter/FixMarketData.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include <quickfix/Session.h>
+#include <quickfix/fix44/MarketDataIncrementalRefresh.h>
+#include <quickfix/fix44/MarketDataRequest.h>
+#include <quickfix/fix44/MarketDataRequestReject.h>
+#include <quickfix/fix44/MarketDataSnapshotFullRefresh.h>
+
+#include "qfblotter/MarketSim.hpp"
+
+namespace qfblotter {
+
+FixMarketData::FixMarketData(MarketSim& market, int64_t conflationMs, int maxDepth)
+    : market_(market), conflationMs_(std::max<int64_t>(conflationMs, 1)), maxDepth_(std::max(maxDepth, 1)) {}
+
+FixMarketData::~FixMarketData() {
+    stop();
+}
+
+void FixMarketData::start() {
+    if (running_.exchange(true)) {
+        return;
+    }
+    thread_ = std::thread([this]() { run(); });
+}
+
+void FixMarketData::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void FixMarketData::onTick(const std::string& symbol, double price) {
+    conflator_.onTick(symbol, price);
+}
+
+void FixMarketData::onRequest(const FIX44::MarketDataRequest& request, const FIX::SessionID& sessionID) {
+    FIX::MDReqID mdReqId;
+    FIX::SubscriptionRequestType requestType;
+    request.get(mdReqId);
+    request.get(requestType);
+
+    const std::string subscriber = sessionID.toString();
+    const char type = requestType.getValue();
+    if (type == FIX::SubscriptionRequestType_DISABLE_PREVIOUS_SNAPSHOT_PLUS_UPDATE_REQUEST) {
+        conflator_.unsubscribe(subscriber, mdReqId.getValue());
+        return;
+    }
+    if (type != FIX::SubscriptionRequestType_SNAPSHOT &&
+        type != FIX::SubscriptionRequestType_SNAPSHOT_PLUS_UPDATES) {
+        reject(mdReqId.getValue(), FIX::MDReqRejReason_UNSUPPORTED_SUBSCRIPTIONREQUESTTYPE,
+               "Unsupported SubscriptionRequestType", sessionID);
+        return;
+    }
+
+    // MarketDepth 0 means full book; the simulated book is capped at maxDepth_
+    FIX::MarketDepth marketDepth(1);
+    if (request.isSetField(marketDepth)) {
+        request.get(marketDepth);
+    }
+    const int depth = marketDepth.getValue() <= 0 ? maxDepth_ : std::min(marketDepth.getValue(), maxDepth_);
+
+    std::vector<std::string> symbols;
+    FIX::NoRelatedSym noRelatedSym(0);
+    if (request.isSetField(noRelatedSym)) {
+        request.get(noRelatedSym);
+    }
+    for (int i = 1; i <= noRelatedSym.getValue(); ++i) {
+        FIX44::MarketDataRequest::NoRelatedSym group;
+        request.getGroup(static_cast<unsigned>(i), group);
+        FIX::Symbol symbol;
+        group.get(symbol);
+        if (!symbol.getValue().empty()) {
+            symbols.push_back(symbol.getValue());
+        }
+    }
+    if (symbols.empty()) {
+        reject(mdReqId.getValue(), FIX::MDReqRejReason_UNKNOWN_SYMBOL, "No symbols requested", sessionID);
+        return;
+    }
+
+    if (type == FIX::SubscriptionRequestType_SNAPSHOT_PLUS_UPDATES) {
+        {
+            std::lock_guard<std::mutex> lock(sessionsMutex_);
+            sessions_[subscriber] = sessionID;
+        }
+        // Subscribe before the snapshot so no tick between the two is lost;
+        // an X overtaking its W carries absolute prices and is harmless
+        if (!conflator_.subscribe(subscriber, mdReqId.getValue(), symbols)) {
+            reject(mdReqId.getValue(), FIX::MDReqRejReason_DUPLICATE_MDREQID, "Duplicate MDReqID", sessionID);
+            return;
+        }
+    }
+    for (const auto& symbol : symbols) {
+        sendSnapshot(mdReqId.getValue(), symbol, depth, sessionID);
+    }
+}
+
+void FixMarketData::onLogout(const FIX::SessionID& sessionID) {
+    const std::string subscriber = sessionID.toString();
+    conflator_.removeSubscriber(subscriber);
+    std::lock_guard<std::mutex> lock(sessionsMutex_);
+    sessions_.erase(subscriber);
+}
+
+void FixMarketData::run() {
+    const auto interval = std::chrono::milliseconds(conflationMs_);
+    auto next = std::chrono::steady_clock::now() + interval;
+    while (running_) {
+        std::this_thread::sleep_until(next);
+        next += interval;
+        conflator_.drain([this](const std::string& subscriber, const std::string& mdReqId,
+                                const std::vector<MdUpdate>& updates) {
+            publish(subscriber, mdReqId, updates);
+        });
+    }
+}
+
+void FixMarketData::publish(const std::string& subscriber, const std::string& mdReqId,
+                            const std::vector<MdUpdate>& updates) {
+    FIX::SessionID sessionID;
+    {
+        std::lock_guard<std::mutex> lock(sessionsMutex_);
+        auto it = sessions_.find(subscriber);
+        if (it == sessions_.end()) {
+            return;
+        }
+        sessionID = it->second;
+    }
+
+    FIX44::MarketDataIncrementalRefresh refresh;
+    refresh.set(FIX::MDReqID(mdReqId));
+    for (const auto& update : updates) {
+        FIX44::MarketDataIncrementalRefresh::NoMDEntries entry;
+        entry.set(FIX::MDUpdateAction(FIX::MDUpdateAction_NEW));
+        entry.set(FIX::MDEntryType(FIX::MDEntryType_TRADE));
+        entry.set(FIX::Symbol(update.symbol));
+        entry.set(FIX::MDEntryPx(update.price));
+        refresh.addGroup(entry);
+    }
+    try {
+        FIX::Session::sendToTarget(refresh, sessionID);
+        incrementalsSent_.fetch_add(1, std::memory_order_relaxed);
+    } catch (const FIX::SessionNotFound&) {
+        conflator_.removeSubscriber(subscriber);
+    }
+}
+
+void FixMarketData::sendSnapshot(const std::string& mdReqId, const std::string& symbol, int depth,
+                                 const FIX::SessionID& sessionID) {
+    OrderBook book = market_.getOrderBook(symbol, depth);
+
+    FIX44::MarketDataSnapshotFullRefresh snapshot;
+    snapshot.set(FIX::MDReqID(mdReqId));
+    snapshot.set(FIX::Symbol(symbol));
+
+    auto addEntry = [&snapshot](char entryType, double px, int qty) {
+        FIX44::MarketDataSnapshotFullRefresh::NoMDEntries entry;
+        entry.set(FIX::MDEntryType(entryType));
+        entry.set(FIX::MDEntryPx(px));
+        if (qty > 0) {
+            entry.set(FIX::MDEntrySize(qty));
+        }
+        snapshot.addGroup(entry);
+    };
+    for (const auto& level : book.bids) {
+        addEntry(FIX::MDEntryType_BID, level.price, level.quantity);
+    }
+    for (const auto& level : book.asks) {
+        addEntry(FIX::MDEntryType_OFFER, level.price, level.quantity);
+    }
+    addEntry(FIX::MDEntryType_TRADE, book.lastPrice, 0);
+
+    FIX::Session::sendToTarget(snapshot, sessionID);
+    snapshotsSent_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FixMarketData::reject(const std::string& mdReqId, char reason, const std::string& text,
+                           const FIX::SessionID& sessionID) {
+    FIX44::MarketDataRequestReject rejectMsg(FIX::MDReqID{mdReqId});
+    rejectMsg.set(FIX::MDReqRejReason(reason));
+    rejectMsg.set(FIX::Text(text));
+    FIX::Session::sendToTarget(rejectMsg, sessionID);
+}
+
+}  // namespace qfblotter
@@ -0,0 +1,338 @@
+#include "qfblotter/FixValidator.hpp"
+
+#include <algorithm>
+#include <bitset>
+#include <charconv>
+#include <vector>
+
+#include "qfblotter/Fix44Dictionary.hpp"
+
+namespace qfblotter {
+
+namespace {
+using namespace fixdict;
+
+constexpr int TAG_BEGIN_STRING = 8;
+constexpr int TAG_BODY_LENGTH = 9;
+constexpr int TAG_MSG_TYPE = 35;
+constexpr int TAG_CHECKSUM = 10;
+
+const FieldDef* findField(int tag) {
+    if (tag <= 0 || static_cast<size_t>(tag) >= FIELD_INDEX.size()) {
+        return nullptr;
+    }
+    const int index = FIELD_INDEX[static_cast<size_t>(tag)];
+    return index >= 0 ? &FIELDS[static_cast<size_t>(index)] : nullptr;
+}
+
+bool isDictionaryTag(int tag) {
+    return tag > 0 && static_cast<size_t>(tag) < FIELD_INDEX.size() && FIELD_INDEX[static_cast<size_t>(tag)] != -2;
+}
+
+// Index in MEMBERS_BY_TAG of `tag` within `scope`, or -1
+int findMember(const ScopeDef& scope, int tag) {
+    const auto first = MEMBERS_BY_TAG.begin() + scope.firstMember;
+    const auto last = first + scope.memberCount;
+    const auto it = std::lower_bound(first, last, tag, [](const MemberDef& m, int t) { return m.tag < t; });
+    return (it != last && it->tag == tag) ? static_cast<int>(it - MEMBERS_BY_TAG.begin()) : -1;
+}
+
+const MessageDef* findMessage(std::string_view msgType) {
+    const auto it = std::lower_bound(MESSAGES.begin(), MESSAGES.end(), msgType,
+                                     [](const MessageDef& m, std::string_view t) { return m.msgType < t; });
+    return (it != MESSAGES.end() && it->msgType == msgType) ? &*it : nullptr;
+}
+
+bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+bool allDigits(std::string_view v) {
+    return !v.empty() && std::all_of(v.begin(), v.end(), isDigit);
+}
+
+bool validInt(std::string_view v) {
+    if (!v.empty() && v.front() == '-') {
+        v.remove_prefix(1);
+    }
+    return allDigits(v);
+}
+
+bool validFloat(std::string_view v) {
+    if (!v.empty() && v.front() == '-') {
+        v.remove_prefix(1);
+    }
+    bool digit = false;
+    bool point = false;
+    for (const char c : v) {
+        if (isDigit(c)) {
+            digit = true;
+        } else if (c == '.' && !point) {
+            point = true;
+        } else {
+            return false;
+        }
+    }
+    return digit;
+}
+
+int twoDigits(std::string_view v, size_t pos) {
+    return (v[pos] - '0') * 10 + (v[pos + 1] - '0');
+}
+
+// YYYYMMDD
+bool validDate(std::string_view v) {
+    if (v.size() != 8 || !allDigits(v)) {
+        return false;
+    }
+    const int month = twoDigits(v, 4);
+    const int day = twoDigits(v, 6);
+    return month >= 1 && month <= 12 && day >= 1 && day <= 31;
+}
+
+// HH:MM:SS[.f...], up to nanoseconds
+bool validTime(std::string_view v) {
+    if (v.size() < 8 || v[2] != ':' || v[5] != ':' || !allDigits(v.substr(0, 2)) || !allDigits(v.substr(3, 2)) ||
+        !allDigits(v.substr(6, 2))) {
+        return false;
+    }
+    if (twoDigits(v, 0) > 23 || twoDigits(v, 3) > 59 || twoDigits(v, 6) > 60) {
+        return false;
+    }
+    return v.size() == 8 || (v[8] == '.' && v.size() <= 18 && allDigits(v.substr(9)));
+}
+
+bool validFormat(FieldFormat format, std::string_view v) {
+    switch (format) {
+        case FieldFormat::String:
+            return true;
+        case FieldFormat::Char:
+            return v.size() == 1;
+        case FieldFormat::Boolean:
+            return v == "Y" || v == "N";
+        case FieldFormat::Int:
+            return validInt(v);
+        case FieldFormat::Float:
+            return validFloat(v);
+        case FieldFormat::UtcTimestamp:
+            return v.size() >= 17 && v[8] == '-' && validDate(v.substr(0, 8)) && validTime(v.substr(9));
+        case FieldFormat::UtcDateOnly:
+            return validDate(v);
+        case FieldFormat::UtcTimeOnly:
+            return validTime(v);
+    }
+    return false;
+}
+
+bool isEnumValue(const FieldDef& field, std::string_view v) {
+    const auto first = VALUES.begin() + field.firstValue;
+    const auto last = first + field.valueCount;
+    const auto it = std::lower_bound(first, last, v, [](const ValueDef& d, std::string_view s) { return d.value < s; });
+    return it != last && it->value == v;
+}
+
+bool validValue(const FieldDef& field, std::string_view v) {
+    if (field.valueCount == 0) {
+        return true;
+    }
+    if (!field.multiValue) {
+        return isEnumValue(field, v);
+    }
+    while (!v.empty()) {
+        const size_t space = v.find(' ');
+        const std::string_view token = v.substr(0, space);
+        if (!token.empty() && !isEnumValue(field, token)) {
+            return false;
+        }
+        if (space == std::string_view::npos) {
+            break;
+        }
+        v.remove_prefix(space + 1);
+    }
+    return true;
+}
+
+// Walks the fields in wire order, one part of the message at a time
+class Walker {
+public:
+    explicit Walker(std::span<const FixField> fields) : fields_(fields) {}
+
+    FixValidation run() {
+        static constexpr int LEADING[] = {TAG_BEGIN_STRING, TAG_BODY_LENGTH, TAG_MSG_TYPE};
+        for (size_t i = 0; i < std::size(LEADING); ++i) {
+            if (i >= fields_.size()) {
+                return {FixReject::REQUIRED_TAG_MISSING, LEADING[i]};
+            }
+            if (fields_[i].tag != LEADING[i]) {
+                return {FixReject::TAG_OUT_OF_ORDER, fields_[i].tag};
+            }
+        }
+        if (fields_[0].value != BEGIN_STRING) {
+            return {FixReject::INCORRECT_VALUE, TAG_BEGIN_STRING};
+        }
+        const std::string_view msgType = fields_[2].value;
+        message_ = findMessage(msgType);
+        if (message_ == nullptr) {
+            const bool known = std::find(ALL_MSG_TYPES.begin(), ALL_MSG_TYPES.end(), msgType) != ALL_MSG_TYPES.end();
+            return {known ? FixReject::UNSUPPORTED_MSG_TYPE : FixReject::INVALID_MSG_TYPE, TAG_MSG_TYPE};
+        }
+
+        if (!walkScope(Part::HEADER, HEADER) || !walkScope(Part::BODY, message_->body) ||
+            !walkScope(Part::TRAILER, TRAILER)) {
+            return result_;
+        }
+        if (fields_.back().tag != TAG_CHECKSUM) {
+            return {FixReject::TAG_OUT_OF_ORDER, TAG_CHECKSUM};
+        }
+        return {};
+    }
+
+private:
+    enum class Part { HEADER, BODY, TRAILER, GROUP_ENTRY };
+
+    // Consume members of `scope` from pos_. A group entry ends at the first
+    // non-member (left to the enclosing scope) or at its delimiter repeating;
+    // header and body end where the next part starts, and any other field is
+    // rejected where it stands.
+    bool walkScope(Part part, const ScopeDef& scope, int delimiter = 0) {
+        std::bitset<MAX_SCOPE_MEMBERS> seen;
+        size_t required = 0;
+        const size_t start = pos_;
+        while (pos_ < fields_.size()) {
+            const FixField& field = fields_[pos_];
+            if (field.tag == delimiter && pos_ != start) {
+                break;
+            }
+            const int member = findMember(scope, field.tag);
+            if (member < 0) {
+                if (part == Part::GROUP_ENTRY || startsNextPart(part, field.tag)) {
+                    break;
+                }
+                return fail(misplaced(part, field.tag), field.tag);
+            }
+            const size_t bit = static_cast<size_t>(member - scope.firstMember);
+            if (seen.test(bit)) {
+                return fail(FixReject::REPEATED_TAG, field.tag);
+            }
+            seen.set(bit);
+            const MemberDef& def = MEMBERS_BY_TAG[static_cast<size_t>(member)];
+            required += def.required ? 1 : 0;
+
+            const FieldDef& type = *findField(field.tag);
+            if (field.value.empty()) {
+                return fail(FixReject::EMPTY_VALUE, field.tag);
+            }
+            if (!validFormat(type.format, field.value)) {
+                return fail(FixReject::INCORRECT_FORMAT, field.tag);
+            }
+            if (!validValue(type, field.value)) {
+                return fail(FixReject::INCORRECT_VALUE, field.tag);
+            }
+            ++pos_;
+            if (def.group >= 0 && !walkGroup(GROUPS[static_cast<size_t>(def.group)], field.value)) {
+                return false;
+            }
+        }
+        if (required != scope.requiredCount) {
+            for (size_t i = 0; i < scope.memberCount; ++i) {
+                const MemberDef& def = MEMBERS_BY_TAG[scope.firstMember + i];
+                if (def.required && !seen.test(i)) {
+                    return fail(FixReject::REQUIRED_TAG_MISSING, def.tag);
+                }
+            }
+        }
+        return true;
+    }
+
+    bool startsNextPart(Part part, int tag) const {
+        switch (part) {
+            case Part::HEADER:
+                return findMember(message_->body, tag) >= 0 || findMember(TRAILER, tag) >= 0;
+            case Part::BODY:
+                return findMember(TRAILER, tag) >= 0;
+            default:
+                return false;
+        }
+    }
+
+    FixReject misplaced(Part part, int tag) const {
+        if (!isDictionaryTag(tag)) {
+            return FixReject::INVALID_TAG;
+        }
+        const bool earlierPart = (part != Part::HEADER && findMember(HEADER, tag) >= 0) ||
+                                 (part == Part::TRAILER && findMember(message_->body, tag) >= 0);
+        return earlierPart ? FixReject::TAG_OUT_OF_ORDER : FixReject::TAG_NOT_DEFINED_FOR_MESSAGE;
+    }
+
+    bool walkGroup(const GroupDef& group, std::string_view countValue) {
+        long count = 0;
+        std::from_chars(countValue.data(), countValue.data() + countValue.size(), count);
+        long entries = 0;
+        while (pos_ < fields_.size() && fields_[pos_].tag == group.delimiter) {
+            ++entries;
+            if (!walkScope(Part::GROUP_ENTRY, group.entry, group.delimiter)) {
+                return false;
+            }
+        }
+        return entries == count || fail(FixReject::GROUP_COUNT_MISMATCH, group.countTag);
+    }
+
+    bool fail(FixReject reject, int tag) {
+        result_ = {reject, tag};
+        return false;
+    }
+
+    std::span<const FixField> fields_;
+    const MessageDef* message_{nullptr};
+    size_t pos_{0};
+    FixValidation result_;
+};
+}  // namespace
+
+const char* fixRejectToString(FixReject reject) {
+    switch (reject) {
+        case FixReject::NONE: return "NONE";
+        case FixReject::INVALID_TAG: return "INVALID_TAG";
+        case FixReject::REQUIRED_TAG_MISSING: return "REQUIRED_TAG_MISSING";
+        case FixReject::TAG_NOT_DEFINED_FOR_MESSAGE: return "TAG_NOT_DEFINED_FOR_MESSAGE";
+        case FixReject::EMPTY_VALUE: return "EMPTY_VALUE";
+        case FixReject::INCORRECT_VALUE: return "INCORRECT_VALUE";
+        case FixReject::INCORRECT_FORMAT: return "INCORRECT_FORMAT";
+        case FixReject::INVALID_MSG_TYPE: return "INVALID_MSG_TYPE";
+        case FixReject::UNSUPPORTED_MSG_TYPE: return "UNSUPPORTED_MSG_TYPE";
+        case FixReject::REPEATED_TAG: return "REPEATED_TAG";
+        case FixReject::TAG_OUT_OF_ORDER: return "TAG_OUT_OF_ORDER";
+        case FixReject::GROUP_COUNT_MISMATCH: return "GROUP_COUNT_MISMATCH";
+    }
+    return "UNKNOWN";
+}
+
+FixValidation validateFixMessage(std::span<const FixField> fields) {
+    return Walker(fields).run();
+}
+
+FixValidation validateFixMessage(std::string_view raw) {
+    thread_local std::vector<FixField> fields;
+    fields.clear();
+    while (!raw.empty()) {
+        const size_t end = raw.find('\x01');
+        const std::string_view field = raw.substr(0, end);
+        const size_t eq = field.find('=');
+        if (eq == std::string_view::npos) {
+            return {FixReject::INVALID_TAG, 0};
+        }
+        int tag = 0;
+        const auto [ptr, ec] = std::from_chars(field.data(), field.data() + eq, tag);
+        if (ec != std::errc() || ptr != field.data() + eq || tag <= 0) {
+            return {FixReject::INVALID_TAG, 0};
+        }
+        fields.push_back({tag, field.substr(eq + 1)});
+        if (end == std::string_view::npos) {
+            break;
+        }
+        raw.remove_prefix(end + 1);
+    }
+    return validateFixMessage(std::span<const FixField>(fields));
+}
+
+}  // namespace qfblotter
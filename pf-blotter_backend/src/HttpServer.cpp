@@ -1,5 +1,6 @@
 #include "qfblotter/HttpServer.hpp"
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <cmath>
@@ -19,6 +20,11 @@
 #include <httplib.h>
 #include <nlohmann/json.hpp>
 
+#include "qfblotter/AdmissionControl.hpp"
+#include "qfblotter/BarAggregator.hpp"
+#include "qfblotter/RollingStats.hpp"
+#include "qfblotter/SingleFlight.hpp"
+
 namespace qfblotter {
 
 namespace {
@@ -29,6 +35,10 @@ constexpr size_t MAX_CLORDID_LENGTH = 64;
 constexpr size_t MAX_SYMBOL_LENGTH = 16;
 constexpr int MAX_QUANTITY = 1000000;
 constexpr double MAX_PRICE = 1000000.0;
+constexpr int MAX_HISTORY_BARS = 1000;
+constexpr int MAX_EXECUTIONS_PAGE = 10000;
+constexpr int MAX_ALGO_DURATION_SEC = 86400;
+constexpr double MAX_POV_RATE = 0.5;
 
 // Input validation helpers
 bool isValidClOrdId(const std::string& clOrdId) {
@@ -57,6 +67,25 @@ bool isValidPrice(double price) {
     return price >= 0.0 && price <= MAX_PRICE && !std::isnan(price) && !std::isinf(price);
 }
 
+// Map "Market"/"Limit"/"Stop"/"StopLimit" (or the FIX code) to FIX OrdType; 0 if unknown
+char parseOrderType(const std::string& type) {
+    if (type == "Market" || type == "1") return '1';
+    if (type == "Limit" || type == "2") return '2';
+    if (type == "Stop" || type == "3") return '3';
+    if (type == "StopLimit" || type == "4") return '4';
+    return 0;
+}
+
+// Map "DAY"/"GTC"/"IOC"/"FOK"/"GTD" (or the FIX code) to FIX TimeInForce; 0 if unknown
+char parseTimeInForce(const std::string& tif) {
+    if (tif == "DAY" || tif == "0") return '0';
+    if (tif == "GTC" || tif == "1") return '1';
+    if (tif == "IOC" || tif == "3") return '3';
+    if (tif == "FOK" || tif == "4") return '4';
+    if (tif == "GTD" || tif == "6") return '6';
+    return 0;
+}
+
 struct Subscriber {
     std::mutex mutex;
     std::condition_variable cv;
@@ -72,13 +101,14 @@ public:
         return sub;
     }
 
-    void publish(const std::string& event) {
+    // `frame` is a complete SSE frame, built once for every subscriber
+    void publish(const std::string& frame) {
         std::lock_guard<std::mutex> lock(mutex_);
         for (auto it = subscribers_.begin(); it != subscribers_.end();) {
             if (auto sub = it->lock()) {
                 {
                     std::lock_guard<std::mutex> qlock(sub->mutex);
-                    sub->queue.push_back(event);
+                    sub->queue.push_back(frame);
                 }
                 sub->cv.notify_one();
                 ++it;
@@ -88,6 +118,19 @@ public:
         }
     }
 
+    // Events queued for the slowest subscriber
+    size_t maxBacklog() {
+        size_t deepest = 0;
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& weak : subscribers_) {
+            if (auto sub = weak.lock()) {
+                std::lock_guard<std::mutex> qlock(sub->mutex);
+                deepest = std::max(deepest, sub->queue.size());
+            }
+        }
+        return deepest;
+    }
+
 private:
     std::mutex mutex_;
     std::set<std::weak_ptr<Subscriber>, std::owner_less<std::weak_ptr<Subscriber>>> subscribers_;
@@ -102,6 +145,14 @@ std::string sse_market_frame(const std::string& data) {
     return "event: marketdata\ndata: " + data + "\n\n";
 }
 
+std::string sse_stats_frame(const std::string& data) {
+    return "event: stats\ndata: " + data + "\n\n";
+}
+
+std::string sse_terminal_frame(const std::string& data) {
+    return "event: terminal\ndata: " + data + "\n\n";
+}
+
 // Simple rate limiter with automatic cleanup - tracks requests per IP
 class RateLimiter {
 public:
@@ -130,7 +181,14 @@ public:
     RateLimiter(const RateLimiter&) = delete;
     RateLimiter& operator=(const RateLimiter&) = delete;
 
+    void setLimit(int maxRequests) {
+        maxRequests_.store(maxRequests, std::memory_order_relaxed);
+    }
+
     bool allow(const std::string& ip) {
+        if (maxRequests_.load(std::memory_order_relaxed) <= 0) {
+            return true;  // Disabled
+        }
         std::lock_guard<std::mutex> lock(mutex_);
         auto now = std::chrono::steady_clock::now();
         auto& record = records_[ip];
@@ -142,7 +200,7 @@ public:
         }
         
         // Check if under limit
-        if (static_cast<int>(record.size()) >= maxRequests_) {
+        if (static_cast<int>(record.size()) >= maxRequests_.load(std::memory_order_relaxed)) {
             return false;
         }
         
@@ -170,7 +228,7 @@ private:
         }
     }
 
-    int maxRequests_;
+    std::atomic<int> maxRequests_;
     int windowMs_;
     std::mutex mutex_;
     std::unordered_map<std::string, std::deque<std::chrono::steady_clock::time_point>> records_;
@@ -237,6 +295,11 @@ public:
         // CORS middleware - set per-request based on Origin header
         server_.set_pre_routing_handler([this](const httplib::Request& req, httplib::Response& res) {
             setCorsHeaders(req, res);
+            if (readOnly_.load() && req.method == "POST" && req.path != "/promote") {
+                res.status = 503;
+                res.set_content(readOnlyError_, "application/json");
+                return httplib::Server::HandlerResponse::Handled;
+            }
             return httplib::Server::HandlerResponse::Unhandled;  // Continue to actual handler
         });
 
@@ -250,7 +313,7 @@ public:
         });
 
         server_.Get("/snapshot", [this](const httplib::Request&, httplib::Response& res) {
-            res.set_content(snapshotProvider_(), "application/json");
+            res.set_content(*coalesce("/snapshot", "/snapshot", snapshotProvider_), "application/json");
         });
 
         // POST /order - Submit new order (rate limited + validated)
@@ -285,7 +348,10 @@ public:
                 order.quantity = json.at("quantity").get<int>();
                 order.price = json.at("price").get<double>();
                 std::string orderTypeStr = json.value("orderType", "Limit");
-                order.orderType = (orderTypeStr == "Market" || orderTypeStr == "1") ? '1' : '2';
+                order.orderType = parseOrderType(orderTypeStr);
+                order.stopPrice = json.value("stopPrice", 0.0);
+                order.timeInForce = parseTimeInForce(json.value("timeInForce", "DAY"));
+                order.expireTimeMs = json.value("expireTimeMs", int64_t(0));
 
                 // Input validation
                 if (!isValidClOrdId(order.clOrdId)) {
@@ -303,11 +369,37 @@ public:
                     res.set_content(R"({"error":"Invalid quantity: must be 1-1,000,000"})", "application/json");
                     return;
                 }
-                if (order.orderType == '2' && !isValidPrice(order.price)) {
+                if (order.orderType == 0) {
+                    res.status = 400;
+                    res.set_content(R"({"error":"Invalid orderType: must be Market, Limit, Stop or StopLimit"})", "application/json");
+                    return;
+                }
+                if ((order.orderType == '2' || order.orderType == '4') && !isValidPrice(order.price)) {
                     res.status = 400;
                     res.set_content(R"({"error":"Invalid price: must be 0-1,000,000"})", "application/json");
                     return;
                 }
+                if ((order.orderType == '3' || order.orderType == '4') &&
+                    (order.stopPrice <= 0.0 || !isValidPrice(order.stopPrice))) {
+                    res.status = 400;
+                    res.set_content(R"({"error":"stopPrice is required for Stop and StopLimit orders"})", "application/json");
+                    return;
+                }
+                if (order.timeInForce == 0) {
+                    res.status = 400;
+                    res.set_content(R"({"error":"Invalid timeInForce: must be DAY, GTC, IOC, FOK or GTD"})", "application/json");
+                    return;
+                }
+                if (order.timeInForce == '6' && order.expireTimeMs <= 0) {
+                    res.status = 400;
+                    res.set_content(R"({"error":"expireTimeMs is required for GTD orders"})", "application/json");
+                    return;
+                }
+
+                AdmissionControl::Ticket ticket;
+                if (!admit(AdmissionControl::Priority::NEW_ORDER, ticket, res)) {
+                    return;
+                }
 
                 std::string errorMsg;
                 bool success = orderHandler_(order, errorMsg);
@@ -363,6 +455,11 @@ public:
                     return;
                 }
 
+                AdmissionControl::Ticket ticket;
+                if (!admit(AdmissionControl::Priority::CANCEL, ticket, res)) {
+                    return;
+                }
+
                 std::string errorMsg;
                 bool success = cancelHandler_(cancel, errorMsg);
 
@@ -428,6 +525,12 @@ public:
                     return;
                 }
 
+                // Amends can add quantity, so they queue behind cancels
+                AdmissionControl::Ticket ticket;
+                if (!admit(AdmissionControl::Priority::NEW_ORDER, ticket, res)) {
+                    return;
+                }
+
                 std::string errorMsg;
                 bool success = amendHandler_(amend, errorMsg);
 
@@ -447,6 +550,112 @@ public:
             }
         });
 
+        // POST /promote - Promote a hot standby to primary
+        server_.Post("/promote", [this](const httplib::Request&, httplib::Response& res) {
+            if (!promoteHandler_) {
+                res.status = 501;
+                res.set_content(R"({"error":"Replication not configured"})", "application/json");
+                return;
+            }
+            res.set_content(promoteHandler_(), "application/json");
+        });
+
+        // POST /algo - Submit TWAP/VWAP/POV parent order (rate limited + validated)
+        server_.Post("/algo", [this](const httplib::Request& req, httplib::Response& res) {
+            if (req.body.size() > MAX_REQUEST_BODY_SIZE) {
+                res.status = 413;
+                res.set_content(R"({"error":"Request body too large"})", "application/json");
+                return;
+            }
+
+            if (!orderRateLimiter_.allow(req.remote_addr)) {
+                res.status = 429;
+                res.set_content(R"({"error":"Rate limit exceeded."})", "application/json");
+                return;
+            }
+
+            if (!algoHandler_) {
+                res.status = 501;
+                res.set_content(R"({"error":"Algo handler not configured"})", "application/json");
+                return;
+            }
+
+            try {
+                auto json = nlohmann::json::parse(req.body);
+                AlgoRequest algo;
+                algo.clOrdId = json.at("clOrdId").get<std::string>();
+                algo.symbol = json.at("symbol").get<std::string>();
+                std::string sideStr = json.at("side").get<std::string>();
+                algo.side = (sideStr == "Buy" || sideStr == "1") ? '1' : '2';
+                algo.quantity = json.at("quantity").get<int>();
+                algo.price = json.value("price", 0.0);
+                algo.strategy = json.value("strategy", "TWAP");
+                algo.durationSec = json.value("durationSec", 300);
+                algo.sliceSec = json.value("sliceSec", 10);
+                algo.participation = json.value("participation", 0.1);
+
+                // Input validation
+                if (!isValidClOrdId(algo.clOrdId)) {
+                    res.status = 400;
+                    res.set_content(R"({"error":"Invalid clOrdId: must be 1-64 alphanumeric characters"})", "application/json");
+                    return;
+                }
+                if (!isValidSymbol(algo.symbol)) {
+                    res.status = 400;
+                    res.set_content(R"({"error":"Invalid symbol: must be 1-16 alphanumeric characters"})", "application/json");
+                    return;
+                }
+                if (!isValidQuantity(algo.quantity)) {
+                    res.status = 400;
+                    res.set_content(R"({"error":"Invalid quantity: must be 1-1,000,000"})", "application/json");
+                    return;
+                }
+                if (!isValidPrice(algo.price)) {
+                    res.status = 400;
+                    res.set_content(R"({"error":"Invalid price: must be 0-1,000,000"})", "application/json");
+                    return;
+                }
+                if (algo.strategy != "TWAP" && algo.strategy != "VWAP" && algo.strategy != "POV") {
+                    res.status = 400;
+                    res.set_content(R"({"error":"Invalid strategy: must be TWAP, VWAP or POV"})", "application/json");
+                    return;
+                }
+                if (algo.durationSec < 1 || algo.durationSec > MAX_ALGO_DURATION_SEC ||
+                    algo.sliceSec < 1 || algo.sliceSec > algo.durationSec) {
+                    res.status = 400;
+                    res.set_content(R"({"error":"Invalid schedule: durationSec 1-86400, sliceSec 1-durationSec"})", "application/json");
+                    return;
+                }
+                if (algo.strategy == "POV" && (algo.participation <= 0.0 || algo.participation > MAX_POV_RATE)) {
+                    res.status = 400;
+                    res.set_content(R"({"error":"Invalid participation: must be in (0, 0.5]"})", "application/json");
+                    return;
+                }
+
+                AdmissionControl::Ticket ticket;
+                if (!admit(AdmissionControl::Priority::NEW_ORDER, ticket, res)) {
+                    return;
+                }
+
+                std::string errorMsg;
+                bool success = algoHandler_(algo, errorMsg);
+
+                if (success) {
+                    res.set_content(R"({"status":"ok"})", "application/json");
+                } else {
+                    res.status = 400;
+                    nlohmann::json errJson;
+                    errJson["error"] = errorMsg;
+                    res.set_content(errJson.dump(), "application/json");
+                }
+            } catch (const std::exception& e) {
+                res.status = 400;
+                nlohmann::json errJson;
+                errJson["error"] = std::string("Invalid request: ") + e.what();
+                res.set_content(errJson.dump(), "application/json");
+            }
+        });
+
         // GET /market-hours - Check if market is open
         server_.Get("/market-hours", [this](const httplib::Request&, httplib::Response& res) {
             if (marketHoursProvider_) {
@@ -475,14 +684,33 @@ public:
             }
         });
 
-        // GET /stats - Get performance statistics
-        server_.Get("/stats", [this](const httplib::Request&, httplib::Response& res) {
+        // GET /stats[?window=60s|5m|session] - Performance statistics, or
+        // flow and latency over a rolling window
+        server_.Get("/stats", [this](const httplib::Request& req, httplib::Response& res) {
+            if (req.has_param("window")) {
+                if (!windowStatsProvider_) {
+                    res.status = 501;
+                    res.set_content(R"({"error":"Rolling stats not available"})", "application/json");
+                    return;
+                }
+                const int64_t window = RollingStats::parseWindow(req.get_param_value("window"));
+                if (window < 0) {
+                    res.status = 400;
+                    res.set_content(R"({"error":"Invalid window: must be 1-300 seconds (e.g. 60s, 5m) or session"})",
+                                    "application/json");
+                    return;
+                }
+                auto body = coalesce("/stats", "/stats?window=" + std::to_string(window),
+                                     [this, window]() { return windowStatsProvider_(window); });
+                res.set_content(*body, "application/json");
+                return;
+            }
             if (!statsProvider_) {
                 res.status = 501;
                 res.set_content(R"({"error":"Stats not available"})", "application/json");
                 return;
             }
-            res.set_content(statsProvider_(), "application/json");
+            res.set_content(*coalesce("/stats", "/stats", statsProvider_), "application/json");
         });
 
         // GET /orderbook?symbol=AAPL - Get order book for symbol
@@ -498,7 +726,141 @@ public:
                 symbol = "AAPL";  // Default symbol
             }
 
-            res.set_content(orderBookProvider_(symbol), "application/json");
+            auto body = coalesce("/orderbook", "/orderbook?symbol=" + symbol,
+                                 [this, &symbol]() { return orderBookProvider_(symbol); });
+            res.set_content(*body, "application/json");
+        });
+
+        // GET /history?symbol=AAPL&interval=1m&n=100 - Recent OHLCV bars
+        server_.Get("/history", [this](const httplib::Request& req, httplib::Response& res) {
+            if (!historyProvider_) {
+                res.status = 501;
+                res.set_content(R"({"error":"History not available"})", "application/json");
+                return;
+            }
+
+            std::string symbol = req.get_param_value("symbol");
+            if (!isValidSymbol(symbol)) {
+                res.status = 400;
+                res.set_content(R"({"error":"Invalid symbol: must be 1-16 alphanumeric characters"})", "application/json");
+                return;
+            }
+
+            std::string interval = req.has_param("interval") ? req.get_param_value("interval") : "1m";
+            const auto parsed = BarAggregator::parseInterval(interval);
+            if (!parsed) {
+                res.status = 400;
+                res.set_content(R"({"error":"Invalid interval: must be 1s, 1m or 5m"})", "application/json");
+                return;
+            }
+
+            int count = 100;
+            if (req.has_param("n")) {
+                try {
+                    count = std::stoi(req.get_param_value("n"));
+                } catch (const std::exception&) {
+                    count = 0;
+                }
+                if (count <= 0 || count > MAX_HISTORY_BARS) {
+                    res.status = 400;
+                    res.set_content(R"({"error":"Invalid n: must be 1-1000"})", "application/json");
+                    return;
+                }
+            }
+            // Rings hold fewer bars than the API allows (900 1s, 390 1m, 288 5m);
+            // clamping also gives every larger n the same cache key
+            count = std::min(count, static_cast<int>(BarAggregator::CAPACITY[static_cast<size_t>(*parsed)]));
+
+            auto body = coalesce("/history", "/history?symbol=" + symbol + "&interval=" + interval +
+                                 "&n=" + std::to_string(count),
+                                 [this, &symbol, &interval, count]() { return historyProvider_(symbol, interval, count); });
+            if (body->empty()) {
+                res.status = 404;
+                res.set_content(R"({"error":"Unknown symbol"})", "application/json");
+                return;
+            }
+            res.set_content(*body, "application/json");
+        });
+
+        // GET /tca[?clOrdId=X] - Transaction cost summary, or one order's costs
+        server_.Get("/tca", [this](const httplib::Request& req, httplib::Response& res) {
+            if (!tcaProvider_) {
+                res.status = 501;
+                res.set_content(R"({"error":"TCA not available"})", "application/json");
+                return;
+            }
+
+            std::string clOrdId = req.get_param_value("clOrdId");
+            if (!clOrdId.empty() && !isValidClOrdId(clOrdId)) {
+                res.status = 400;
+                res.set_content(R"({"error":"Invalid clOrdId format"})", "application/json");
+                return;
+            }
+
+            auto body = coalesce("/tca", "/tca?clOrdId=" + clOrdId, [this, &clOrdId]() { return tcaProvider_(clOrdId); });
+            if (body->empty()) {
+                res.status = 404;
+                res.set_content(R"({"error":"Unknown order"})", "application/json");
+                return;
+            }
+            res.set_content(*body, "application/json");
+        });
+
+        // GET /executions?since=N[&limit=L] - Executions after cursor N, oldest
+        // first; poll again with the returned "next". ?clOrdId=X - One order's.
+        server_.Get("/executions", [this](const httplib::Request& req, httplib::Response& res) {
+            if (!executionsProvider_) {
+                res.status = 501;
+                res.set_content(R"({"error":"Executions not available"})", "application/json");
+                return;
+            }
+
+            std::string clOrdId = req.get_param_value("clOrdId");
+            if (!clOrdId.empty()) {
+                if (!isValidClOrdId(clOrdId)) {
+                    res.status = 400;
+                    res.set_content(R"({"error":"Invalid clOrdId format"})", "application/json");
+                    return;
+                }
+                auto body = coalesce("/executions", "/executions?clOrdId=" + clOrdId,
+                                     [this, &clOrdId]() { return executionsProvider_(0, 0, clOrdId); });
+                if (body->empty()) {
+                    res.status = 404;
+                    res.set_content(R"({"error":"Unknown order"})", "application/json");
+                    return;
+                }
+                res.set_content(*body, "application/json");
+                return;
+            }
+
+            uint64_t since = 0;
+            size_t limit = 1000;
+            try {
+                if (req.has_param("since")) {
+                    const std::string value = req.get_param_value("since");
+                    if (value.empty() || value.find_first_not_of("0123456789") != std::string::npos) {
+                        throw std::invalid_argument("since");
+                    }
+                    since = std::stoull(value);
+                }
+                if (req.has_param("limit")) {
+                    const int value = std::stoi(req.get_param_value("limit"));
+                    limit = value >= 1 && value <= MAX_EXECUTIONS_PAGE ? static_cast<size_t>(value) : 0;
+                }
+            } catch (const std::exception&) {
+                limit = 0;
+            }
+            if (limit == 0) {
+                res.status = 400;
+                res.set_content(R"({"error":"Invalid since or limit: since is an execId, limit 1-10000"})",
+                                "application/json");
+                return;
+            }
+
+            auto body = coalesce("/executions", "/executions?since=" + std::to_string(since) +
+                                 "&limit=" + std::to_string(limit),
+                                 [this, since, limit]() { return executionsProvider_(since, limit, std::string()); });
+            res.set_content(*body, "application/json");
         });
 
         server_.Get("/events", [this](const httplib::Request&, httplib::Response& res) {
@@ -520,7 +882,7 @@ public:
                     }
 
                     if (!sub->queue.empty()) {
-                        std::string payload = sse_frame(sub->queue.front());
+                        std::string payload = std::move(sub->queue.front());
                         sub->queue.pop_front();
                         lock.unlock();
                         sink.write(payload.c_str(), payload.size());
@@ -552,7 +914,7 @@ public:
                     }
 
                     if (!sub->queue.empty()) {
-                        std::string payload = sse_market_frame(sub->queue.front());
+                        std::string payload = std::move(sub->queue.front());
                         sub->queue.pop_front();
                         lock.unlock();
                         sink.write(payload.c_str(), payload.size());
@@ -581,6 +943,10 @@ public:
         statsProvider_ = std::move(provider);
     }
 
+    void setWindowStatsProvider(WindowStatsProvider provider) {
+        windowStatsProvider_ = std::move(provider);
+    }
+
     void setMarketDataProvider(MarketDataProvider provider) {
         marketDataProvider_ = std::move(provider);
     }
@@ -607,22 +973,103 @@ public:
     }
 
     void publishEvent(const std::string& eventJson) {
-        broker_.publish(eventJson);
+        broker_.publish(sse_frame(eventJson));
+    }
+
+    void publishStats(const std::string& statsJson) {
+        broker_.publish(sse_stats_frame(statsJson));
+    }
+
+    void publishTerminal(const std::string& clOrdIdsJson) {
+        broker_.publish(sse_terminal_frame(clOrdIdsJson));
     }
 
     void publishMarketData(const std::string& marketDataJson) {
-        marketBroker_.publish(marketDataJson);
+        marketBroker_.publish(sse_market_frame(marketDataJson));
     }
 
     void setAmendHandler(AmendHandler handler) {
         amendHandler_ = std::move(handler);
     }
 
+    void setAlgoHandler(AlgoHandler handler) {
+        algoHandler_ = std::move(handler);
+    }
+
     void setMarketHoursProvider(MarketHoursProvider provider) {
         marketHoursProvider_ = std::move(provider);
     }
 
+    void setHistoryProvider(HistoryProvider provider) {
+        historyProvider_ = std::move(provider);
+    }
+
+    void setTcaProvider(TcaProvider provider) {
+        tcaProvider_ = std::move(provider);
+    }
+
+    void setExecutionsProvider(ExecutionsProvider provider) {
+        executionsProvider_ = std::move(provider);
+    }
+
+    void setPromoteHandler(PromoteHandler handler) {
+        promoteHandler_ = std::move(handler);
+    }
+
+    void setReadOnly(bool readOnly, const std::string& message) {
+        if (readOnly) {
+            readOnlyError_ = nlohmann::json{{"error", message}}.dump();
+        }
+        readOnly_.store(readOnly);
+    }
+
+    void setRateLimits(int ordersPerMinute, int cancelsPerMinute) {
+        orderRateLimiter_.setLimit(ordersPerMinute);
+        cancelRateLimiter_.setLimit(cancelsPerMinute);
+    }
+
+    void setAdmissionControl(AdmissionControl* admission) {
+        admission_ = admission;
+    }
+
+    size_t eventBacklog() {
+        return broker_.maxBacklog();
+    }
+
+    void setCacheTtl(const std::string& path, std::chrono::milliseconds ttl) {
+        cacheTtls_[path] = ttl;
+    }
+
+    void invalidateCache(const std::string& key) {
+        readCache_.invalidate(key);
+    }
+
 private:
+    // One computation per `key` at a time, cached for the path's TTL
+    SingleFlight::Result coalesce(const std::string& path, const std::string& key,
+                                  const std::function<std::string()>& compute) {
+        auto it = cacheTtls_.find(path);
+        return readCache_.get(key, it == cacheTtls_.end() ? std::chrono::milliseconds(0) : it->second, compute);
+    }
+
+    // True if the request may proceed; otherwise `res` is the 503 to send
+    bool admit(AdmissionControl::Priority priority, AdmissionControl::Ticket& ticket, httplib::Response& res) {
+        if (!admission_) {
+            return true;
+        }
+        ticket = admission_->admit(priority);
+        if (ticket) {
+            return true;
+        }
+        res.status = 503;
+        res.set_header("Retry-After", std::to_string((ticket.retryAfterMs() + 999) / 1000));
+        nlohmann::json errJson;
+        errJson["error"] = std::string("Gateway overloaded: ") + ticket.reason();
+        errJson["retryAfterMs"] = ticket.retryAfterMs();
+        res.set_content(errJson.dump(), "application/json");
+        return false;
+    }
+
     // Set CORS headers based on request Origin
     void setCorsHeaders(const httplib::Request& req, httplib::Response& res) {
         std::string origin = req.get_header_value("Origin");
@@ -642,10 +1089,18 @@ private:
     OrderHandler orderHandler_;
     CancelHandler cancelHandler_;
     AmendHandler amendHandler_;
+    AlgoHandler algoHandler_;
     OrderBookProvider orderBookProvider_;
     StatsProvider statsProvider_;
+    WindowStatsProvider windowStatsProvider_;
     MarketDataProvider marketDataProvider_;
     MarketHoursProvider marketHoursProvider_;
+    HistoryProvider historyProvider_;
+    TcaProvider tcaProvider_;
+    ExecutionsProvider executionsProvider_;
+    PromoteHandler promoteHandler_;
+    std::atomic<bool> readOnly_{false};
+    std::string readOnlyError_;
     httplib::Server server_;
     std::atomic<bool> running_{false};
     std::thread thread_;
@@ -653,6 +1108,9 @@ private:
     SseBroker marketBroker_;  // Separate broker for market data
     RateLimiter orderRateLimiter_;   // Rate limiter for order submissions
     RateLimiter cancelRateLimiter_;  // Rate limiter for cancel requests
+    AdmissionControl* admission_{nullptr};
+    std::unordered_map<std::string, std::chrono::milliseconds> cacheTtls_;  // Fixed once started
+    SingleFlight readCache_;
     std::set<std::string> allowedOrigins_;  // Set of allowed CORS origins
 };
 
@@ -675,6 +1133,10 @@ void HttpServer::setAmendHandler(AmendHandler handler) {
     impl_->setAmendHandler(std::move(handler));
 }
 
+void HttpServer::setAlgoHandler(AlgoHandler handler) {
+    impl_->setAlgoHandler(std::move(handler));
+}
+
 void HttpServer::setOrderBookProvider(OrderBookProvider provider) {
     impl_->setOrderBookProvider(std::move(provider));
 }
@@ -683,6 +1145,10 @@ void HttpServer::setStatsProvider(StatsProvider provider) {
     impl_->setStatsProvider(std::move(provider));
 }
 
+void HttpServer::setWindowStatsProvider(WindowStatsProvider provider) {
+    impl_->setWindowStatsProvider(std::move(provider));
+}
+
 void HttpServer::setMarketDataProvider(MarketDataProvider provider) {
     impl_->setMarketDataProvider(std::move(provider));
 }
@@ -691,6 +1157,46 @@ void HttpServer::setMarketHoursProvider(MarketHoursProvider provider) {
     impl_->setMarketHoursProvider(std::move(provider));
 }
 
+void HttpServer::setHistoryProvider(HistoryProvider provider) {
+    impl_->setHistoryProvider(std::move(provider));
+}
+
+void HttpServer::setTcaProvider(TcaProvider provider) {
+    impl_->setTcaProvider(std::move(provider));
+}
+
+void HttpServer::setExecutionsProvider(ExecutionsProvider provider) {
+    impl_->setExecutionsProvider(std::move(provider));
+}
+
+void HttpServer::setPromoteHandler(PromoteHandler handler) {
+    impl_->setPromoteHandler(std::move(handler));
+}
+
+void HttpServer::setReadOnly(bool readOnly, const std::string& message) {
+    impl_->setReadOnly(readOnly, message);
+}
+
+void HttpServer::setRateLimits(int ordersPerMinute, int cancelsPerMinute) {
+    impl_->setRateLimits(ordersPerMinute, cancelsPerMinute);
+}
+
+void HttpServer::setAdmissionControl(AdmissionControl* admission) {
+    impl_->setAdmissionControl(admission);
+}
+
+size_t HttpServer::eventBacklog() const {
+    return impl_->eventBacklog();
+}
+
+void HttpServer::setCacheTtl(const std::string& path, std::chrono::milliseconds ttl) {
+    impl_->setCacheTtl(path, ttl);
+}
+
+void HttpServer::invalidateCache(const std::string& key) {
+    impl_->invalidateCache(key);
+}
+
 void HttpServer::start() {
     impl_->start();
 }
@@ -703,6 +1209,14 @@ void HttpServer::publishEvent(const std::string& eventJson) {
     impl_->publishEvent(eventJson);
 }
 
+void HttpServer::publishStats(const std::string& statsJson) {
+    impl_->publishStats(statsJson);
+}
+
+void HttpServer::publishTerminal(const std::string& clOrdIdsJson) {
+    impl_->publishTerminal(clOrdIdsJson);
+}
+
 void HttpServer::publishMarketData(const std::string& marketDataJson) {
     impl_->publishMarketData(marketDataJson);
 }
@@ -2,6 +2,8 @@
 
 #include <filesystem>
 
+#include <spdlog/async.h>
+#include <spdlog/spdlog.h>
 #include <spdlog/sinks/rotating_file_sink.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 
@@ -26,8 +28,12 @@ void Logger::init(const std::string& name, const std::string& logfile) {
     console_sink->set_pattern("[%H:%M:%S] [%^%l%$] %v");
     file_sink->set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%l] %v");
 
+    // Formatting, the write and the per-line flush happen on spdlog's
+    // worker thread; callers only enqueue. Block rather than drop on overflow.
+    spdlog::init_thread_pool(8192, 1);
     std::vector<spdlog::sink_ptr> sinks{console_sink, file_sink};
-    logger_ = std::make_shared<spdlog::logger>(name, sinks.begin(), sinks.end());
+    logger_ = std::make_shared<spdlog::async_logger>(name, sinks.begin(), sinks.end(), spdlog::thread_pool(),
+                                                     spdlog::async_overflow_policy::block);
     logger_->set_level(spdlog::level::info);
     logger_->flush_on(spdlog::level::info);
 }
@@ -36,4 +42,13 @@ std::shared_ptr<spdlog::logger> Logger::get() {
     return logger_;
 }
 
+void Logger::shutdown() {
+    if (!logger_) {
+        return;
+    }
+    logger_->flush();
+    logger_.reset();
+    spdlog::shutdown();  // Joins the worker once it has written everything queued
+}
+
 }  // namespace qfblotter
@@ -0,0 +1,118 @@
+#include "qfblotter/MarketDataConflator.hpp"
+
+#include <algorithm>
+
+namespace qfblotter {
+
+std::string MarketDataConflator::key(const std::string& subscriber, const std::string& mdReqId) {
+    return subscriber + '\x1f' + mdReqId;
+}
+
+bool MarketDataConflator::subscribe(const std::string& subscriber, const std::string& mdReqId,
+                                    const std::vector<std::string>& symbols) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::string subKey = key(subscriber, mdReqId);
+    if (subscriptions_.count(subKey) > 0) {
+        return false;
+    }
+    Subscription sub{subscriber, mdReqId, {}};
+    for (const auto& symbol : symbols) {
+        if (std::find(sub.symbols.begin(), sub.symbols.end(), symbol) != sub.symbols.end()) {
+            continue;
+        }
+        sub.symbols.push_back(symbol);
+        bySymbol_[symbol].push_back(subKey);
+    }
+    subscriptions_.emplace(std::move(subKey), std::move(sub));
+    return true;
+}
+
+bool MarketDataConflator::unsubscribe(const std::string& subscriber, const std::string& mdReqId) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::string subKey = key(subscriber, mdReqId);
+    if (subscriptions_.count(subKey) == 0) {
+        return false;
+    }
+    removeLocked(subKey);
+    return true;
+}
+
+void MarketDataConflator::removeSubscriber(const std::string& subscriber) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<std::string> keys;
+    for (const auto& [subKey, sub] : subscriptions_) {
+        if (sub.subscriber == subscriber) {
+            keys.push_back(subKey);
+        }
+    }
+    for (const auto& subKey : keys) {
+        removeLocked(subKey);
+    }
+}
+
+void MarketDataConflator::removeLocked(const std::string& subKey) {
+    auto it = subscriptions_.find(subKey);
+    for (const auto& symbol : it->second.symbols) {
+        auto symIt = bySymbol_.find(symbol);
+        if (symIt == bySymbol_.end()) {
+            continue;
+        }
+        auto& keys = symIt->second;
+        keys.erase(std::remove(keys.begin(), keys.end(), subKey), keys.end());
+        if (keys.empty()) {
+            bySymbol_.erase(symIt);
+            pending_.erase(symbol);
+        }
+    }
+    subscriptions_.erase(it);
+}
+
+void MarketDataConflator::onTick(const std::string& symbol, double price) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (bySymbol_.count(symbol) == 0) {
+        return;
+    }
+    pending_[symbol] = price;
+}
+
+size_t MarketDataConflator::drain(const Sink& sink) {
+    struct Batch {
+        std::string subscriber;
+        std::string mdReqId;
+        std::vector<MdUpdate> updates;
+    };
+    std::vector<Batch> batches;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (pending_.empty()) {
+            return 0;
+        }
+        std::unordered_map<std::string, size_t> batchIndex;
+        for (const auto& [symbol, price] : pending_) {
+            auto symIt = bySymbol_.find(symbol);
+            if (symIt == bySymbol_.end()) {
+                continue;
+            }
+            for (const auto& subKey : symIt->second) {
+                auto [it, inserted] = batchIndex.emplace(subKey, batches.size());
+                if (inserted) {
+                    const auto& sub = subscriptions_.at(subKey);
+                    batches.push_back({sub.subscriber, sub.mdReqId, {}});
+                }
+                batches[it->second].updates.push_back({symbol, price});
+            }
+        }
+        pending_.clear();
+    }
+    for (const auto& batch : batches) {
+        sink(batch.subscriber, batch.mdReqId, batch.updates);
+    }
+    return batches.size();
+}
+
+size_t MarketDataConflator::subscriptionCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return subscriptions_.size();
+}
+
+}  // namespace qfblotter
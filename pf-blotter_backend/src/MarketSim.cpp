@@ -32,6 +32,28 @@ double getRealisticPrice(const std::string& symbol, double defaultPrice) {
 MarketSim::MarketSim(unsigned int seed, double startPrice, double step)
     : rng_(seed), dist_(0.0, 1.0), startPrice_(startPrice), step_(step) {}
 
+void MarketSim::addTickListener(TickListener listener) {
+    tickListeners_.push_back(std::move(listener));
+}
+
+void MarketSim::setTickJournal(TickListener journal) {
+    tickJournal_ = std::move(journal);
+}
+
+void MarketSim::notifyTick(const std::string& symbol, double price) {
+    for (const auto& listener : tickListeners_) {
+        listener(symbol, price);
+    }
+}
+
+void MarketSim::initSymbols(const std::vector<std::string>& symbols) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    state_.reserve(state_.size() + symbols.size());
+    for (const auto& symbol : symbols) {
+        state_.try_emplace(symbol, State{getRealisticPrice(symbol, startPrice_)});
+    }
+}
+
 double MarketSim::mark(const std::string& symbol) {
     std::lock_guard<std::mutex> lock(mutex_);
     auto it = state_.find(symbol);
@@ -45,8 +67,16 @@ double MarketSim::mark(const std::string& symbol) {
 }
 
 double MarketSim::nextTick(const std::string& symbol) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return nextTickUnsafe(symbol);
+    double px;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        px = nextTickUnsafe(symbol);
+        if (tickJournal_) {
+            tickJournal_(symbol, px);
+        }
+    }
+    notifyTick(symbol, px);
+    return px;
 }
 
 // Internal helper - must be called with mutex held
@@ -65,8 +95,7 @@ double MarketSim::nextTickUnsafe(const std::string& symbol) {
 }
 
 bool MarketSim::shouldFill(const std::string& symbol, char side, double limitPx) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    double px = nextTickUnsafe(symbol);
+    double px = nextTick(symbol);
     if (side == '1') {  // Buy
         return px <= limitPx;
     }
@@ -77,14 +106,13 @@ bool MarketSim::shouldFill(const std::string& symbol, char side, double limitPx)
 }
 
 FillResult MarketSim::attemptFill(const std::string& symbol, char side, double limitPx, int leavesQty) {
-    std::lock_guard<std::mutex> lock(mutex_);
     FillResult result;
     
     if (leavesQty <= 0) {
         return result;  // Nothing to fill
     }
     
-    double px = nextTickUnsafe(symbol);
+    double px = nextTick(symbol);
     bool canFill = false;
     
     if (side == '1') {  // Buy - fill if market price <= limit
@@ -104,6 +132,7 @@ FillResult MarketSim::attemptFill(const std::string& symbol, char side, double l
         result.complete = true;
     } else {
         // Random fill ratio between 20-100%
+        std::lock_guard<std::mutex> lock(mutex_);
         double ratio = fillRatio_(rng_);
         result.fillQty = std::max(1, static_cast<int>(leavesQty * ratio));
     }
@@ -115,6 +144,43 @@ FillResult MarketSim::attemptFill(const std::string& symbol, char side, double l
     return result;
 }
 
+FillResult MarketSim::attemptFillAll(const std::string& symbol, char side, double limitPx, int qty) {
+    FillResult result;
+    if (qty <= 0) {
+        return result;
+    }
+    const double px = nextTick(symbol);
+    if ((side == '1' && px <= limitPx) || (side == '2' && px >= limitPx)) {
+        result.fillQty = qty;
+        result.fillPx = px;
+        result.complete = true;
+    }
+    return result;
+}
+
+std::vector<std::pair<std::string, double>> MarketSim::lastPrices() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<std::pair<std::string, double>> prices;
+    prices.reserve(state_.size());
+    for (const auto& [symbol, st] : state_) {
+        prices.emplace_back(symbol, st.last);
+    }
+    return prices;
+}
+
+void MarketSim::restorePrice(const std::string& symbol, double price) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    state_[symbol].last = price;
+}
+
+double MarketSim::midPrice(const std::string& symbol) {
+    const OrderBook book = getOrderBook(symbol, 1);
+    if (book.bids.empty() || book.asks.empty()) {
+        return book.lastPrice;
+    }
+    return (book.bids.front().price + book.asks.front().price) / 2.0;
+}
+
 OrderBook MarketSim::getOrderBook(const std::string& symbol, int depth) {
     std::lock_guard<std::mutex> lock(mutex_);
     OrderBook book;
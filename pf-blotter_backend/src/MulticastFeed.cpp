@@ -0,0 +1,437 @@
+#include "qfblotter/MulticastFeed.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace qfblotter {
+
+namespace {
+int64_t epoch_ns() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(system_clock::now().time_since_epoch()).count();
+}
+
+in_addr parseAddr(const std::string& addr) {
+    in_addr out{};
+    if (::inet_pton(AF_INET, addr.c_str(), &out) != 1) {
+        throw std::runtime_error("Invalid IPv4 address: " + addr);
+    }
+    return out;
+}
+
+sockaddr_in makeAddr(in_addr ip, uint16_t port) {
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr = ip;
+    addr.sin_port = htons(port);
+    return addr;
+}
+
+void setTimeouts(int fd, int ms) {
+    timeval tv{};
+    tv.tv_sec = ms / 1000;
+    tv.tv_usec = (ms % 1000) * 1000;
+    ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    ::setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+}
+
+bool writeAll(int fd, const uint8_t* data, size_t len) {
+    while (len > 0) {
+        ssize_t n = ::send(fd, data, len, MSG_NOSIGNAL);
+        if (n <= 0) {
+            if (n < 0 && errno == EINTR) continue;
+            return false;
+        }
+        data += n;
+        len -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+bool readAll(int fd, void* out, size_t len) {
+    auto* data = static_cast<uint8_t*>(out);
+    while (len > 0) {
+        ssize_t n = ::recv(fd, data, len, 0);
+        if (n <= 0) {
+            if (n < 0 && errno == EINTR) continue;
+            return false;
+        }
+        data += n;
+        len -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+size_t encodePacket(uint8_t* buf, FeedPacketType type, uint64_t firstSeq,
+                    const FeedEntry* entries, size_t count) {
+    FeedPacketHeader header{};
+    header.magic = FEED_MAGIC;
+    header.version = FEED_VERSION;
+    header.type = type;
+    header.firstSeq = firstSeq;
+    header.count = static_cast<uint16_t>(count);
+    header.sendTimeNs = epoch_ns();
+    std::memcpy(buf, &header, sizeof(header));
+    if (count > 0) {
+        std::memcpy(buf + sizeof(header), entries, count * sizeof(FeedEntry));
+    }
+    return sizeof(header) + count * sizeof(FeedEntry);
+}
+
+// INCREMENTAL entries advance the sequence per packet; SNAPSHOT packets all
+// carry the same sequence
+bool sendPackets(int fd, FeedPacketType type, uint64_t firstSeq, const std::vector<FeedEntry>& entries) {
+    uint8_t buf[FEED_MAX_PACKET];
+    for (size_t off = 0; off < entries.size(); off += FEED_MAX_ENTRIES) {
+        const size_t n = std::min(FEED_MAX_ENTRIES, entries.size() - off);
+        const uint64_t seq = type == FeedPacketType::INCREMENTAL ? firstSeq + off : firstSeq;
+        if (!writeAll(fd, buf, encodePacket(buf, type, seq, entries.data() + off, n))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+FeedEntry toEntry(const FeedTick& tick) {
+    FeedEntry entry{};
+    std::memcpy(entry.symbol, tick.symbol.data(), std::min(tick.symbol.size(), sizeof(entry.symbol)));
+    entry.price = tick.price;
+    entry.volume = tick.volume;
+    return entry;
+}
+
+std::string entrySymbol(const FeedEntry& entry) {
+    return std::string(entry.symbol, strnlen(entry.symbol, sizeof(entry.symbol)));
+}
+}  // namespace
+
+// --- Publisher ---
+
+MulticastPublisher::MulticastPublisher(const MulticastConfig& config)
+    : config_(config), journal_(std::max<size_t>(config.retain, 1)) {
+    const in_addr group = parseAddr(config_.group);
+    const in_addr iface = parseAddr(config_.interfaceAddr);
+    groupIp_ = group.s_addr;
+
+    udpFd_ = ::socket(AF_INET, SOCK_DGRAM, 0);
+    if (udpFd_ < 0) {
+        throw std::runtime_error("Failed to create multicast socket");
+    }
+    const unsigned char ttl = static_cast<unsigned char>(std::clamp(config_.ttl, 0, 255));
+    const unsigned char loop = config_.loopback ? 1 : 0;
+    if (::setsockopt(udpFd_, IPPROTO_IP, IP_MULTICAST_IF, &iface, sizeof(iface)) != 0 ||
+        ::setsockopt(udpFd_, IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl)) != 0 ||
+        ::setsockopt(udpFd_, IPPROTO_IP, IP_MULTICAST_LOOP, &loop, sizeof(loop)) != 0) {
+        ::close(udpFd_);
+        throw std::runtime_error("Failed to configure multicast on " + config_.interfaceAddr);
+    }
+
+    listenFd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+    int reuse = 1;
+    ::setsockopt(listenFd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    in_addr any{};
+    any.s_addr = htonl(INADDR_ANY);
+    sockaddr_in addr = makeAddr(any, config_.recoveryPort);
+    if (listenFd_ < 0 ||
+        ::bind(listenFd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+        ::listen(listenFd_, 16) != 0) {
+        ::close(udpFd_);
+        if (listenFd_ >= 0) ::close(listenFd_);
+        throw std::runtime_error("Failed to listen on recovery port " + std::to_string(config_.recoveryPort));
+    }
+}
+
+MulticastPublisher::~MulticastPublisher() {
+    stop();
+    ::close(udpFd_);
+    ::close(listenFd_);
+}
+
+void MulticastPublisher::start() {
+    if (running_.exchange(true)) {
+        return;
+    }
+    thread_ = std::thread([this]() { serve(); });
+}
+
+void MulticastPublisher::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void MulticastPublisher::publish(const std::vector<FeedTick>& ticks) {
+    if (ticks.empty()) {
+        return;
+    }
+    std::vector<FeedEntry> entries;
+    entries.reserve(ticks.size());
+    for (const auto& tick : ticks) {
+        entries.push_back(toEntry(tick));
+    }
+
+    in_addr group{};
+    group.s_addr = groupIp_;
+    const sockaddr_in dest = makeAddr(group, config_.port);
+    uint8_t buf[FEED_MAX_PACKET];
+
+    // Sequencing and sending share the lock so packets leave in order
+    std::lock_guard<std::mutex> lock(mutex_);
+    const uint64_t firstSeq = nextSeq_;
+    for (const auto& entry : entries) {
+        journal_[nextSeq_ % journal_.size()] = entry;
+        latest_[entrySymbol(entry)] = entry;
+        ++nextSeq_;
+    }
+    for (size_t off = 0; off < entries.size(); off += FEED_MAX_ENTRIES) {
+        const size_t n = std::min(FEED_MAX_ENTRIES, entries.size() - off);
+        const size_t len = encodePacket(buf, FeedPacketType::INCREMENTAL, firstSeq + off, entries.data() + off, n);
+        if (::sendto(udpFd_, buf, len, 0, reinterpret_cast<const sockaddr*>(&dest), sizeof(dest)) < 0) {
+            sendErrors_.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            packetsSent_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+uint64_t MulticastPublisher::lastSeq() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return nextSeq_ - 1;
+}
+
+void MulticastPublisher::serve() {
+    // Requests are served one at a time with short socket timeouts, so a
+    // stalled consumer delays recovery for others but never the publisher
+    while (running_) {
+        pollfd pfd{listenFd_, POLLIN, 0};
+        if (::poll(&pfd, 1, 200) <= 0) {
+            continue;
+        }
+        int fd = ::accept(listenFd_, nullptr, nullptr);
+        if (fd < 0) {
+            continue;
+        }
+        setTimeouts(fd, 1000);
+        handle(fd);
+        ::close(fd);
+    }
+}
+
+void MulticastPublisher::handle(int fd) {
+    FeedRecoveryRequest req{};
+    if (!readAll(fd, &req, sizeof(req)) || req.magic != FEED_MAGIC) {
+        return;
+    }
+    recoveryRequests_.fetch_add(1, std::memory_order_relaxed);
+
+    std::vector<FeedEntry> entries;
+    uint64_t firstSeq = 0;
+    uint64_t nextSeq = 0;
+    FeedPacketType type = FeedPacketType::INCREMENTAL;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        nextSeq = nextSeq_;
+        if (req.type == FeedRequestType::SNAPSHOT) {
+            type = FeedPacketType::SNAPSHOT;
+            firstSeq = nextSeq_ - 1;
+            entries.reserve(latest_.size());
+            for (const auto& [symbol, entry] : latest_) {
+                entries.push_back(entry);
+            }
+        } else if (req.type == FeedRequestType::RETRANSMIT) {
+            const uint64_t oldest = nextSeq_ > journal_.size() ? nextSeq_ - journal_.size() : 1;
+            const uint64_t count = std::min<uint64_t>(req.count, FEED_MAX_RETRANSMIT);
+            firstSeq = std::max(req.fromSeq, oldest);
+            const uint64_t end = std::min(req.fromSeq + count, nextSeq_);
+            for (uint64_t seq = firstSeq; seq < end; ++seq) {
+                entries.push_back(journal_[seq % journal_.size()]);
+            }
+        }
+    }
+
+    if (sendPackets(fd, type, firstSeq, entries)) {
+        uint8_t buf[sizeof(FeedPacketHeader)];
+        writeAll(fd, buf, encodePacket(buf, FeedPacketType::END, nextSeq, nullptr, 0));
+    }
+}
+
+// --- Sequencer ---
+
+FeedSequencer::Result FeedSequencer::onPacket(uint64_t firstSeq, uint16_t count) {
+    Result result;
+    if (expected_ == 0) {
+        expected_ = firstSeq;
+    }
+    if (firstSeq > expected_) {
+        result.gapFrom = expected_;
+        result.gapCount = firstSeq - expected_;
+    } else if (firstSeq < expected_) {
+        result.skip = static_cast<uint16_t>(std::min<uint64_t>(expected_ - firstSeq, count));
+    }
+    expected_ = std::max(expected_, firstSeq + count);
+    return result;
+}
+
+// --- Subscriber ---
+
+FeedSubscriber::FeedSubscriber(const MulticastConfig& config, Handler handler)
+    : config_(config), handler_(std::move(handler)) {
+    const in_addr group = parseAddr(config_.group);
+    const in_addr iface = parseAddr(config_.interfaceAddr);
+
+    fd_ = ::socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd_ < 0) {
+        throw std::runtime_error("Failed to create multicast socket");
+    }
+    int reuse = 1;
+    ::setsockopt(fd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    in_addr any{};
+    any.s_addr = htonl(INADDR_ANY);
+    sockaddr_in addr = makeAddr(any, config_.port);
+    ip_mreq membership{};
+    membership.imr_multiaddr = group;
+    membership.imr_interface = iface;
+    if (::bind(fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+        ::setsockopt(fd_, IPPROTO_IP, IP_ADD_MEMBERSHIP, &membership, sizeof(membership)) != 0) {
+        ::close(fd_);
+        throw std::runtime_error("Failed to join " + config_.group + " on " + config_.interfaceAddr);
+    }
+}
+
+FeedSubscriber::~FeedSubscriber() {
+    ::close(fd_);
+}
+
+size_t FeedSubscriber::poll(int timeoutMs) {
+    pollfd pfd{fd_, POLLIN, 0};
+    if (::poll(&pfd, 1, timeoutMs) <= 0) {
+        return 0;
+    }
+
+    size_t delivered = 0;
+    alignas(FeedPacketHeader) uint8_t buf[FEED_MAX_PACKET];
+    for (;;) {
+        ssize_t n = ::recv(fd_, buf, sizeof(buf), MSG_DONTWAIT);
+        if (n < static_cast<ssize_t>(sizeof(FeedPacketHeader))) {
+            if (n < 0) break;
+            continue;
+        }
+        FeedPacketHeader header;
+        std::memcpy(&header, buf, sizeof(header));
+        if (header.magic != FEED_MAGIC || header.version != FEED_VERSION ||
+            header.type != FeedPacketType::INCREMENTAL ||
+            static_cast<size_t>(n) != sizeof(header) + header.count * sizeof(FeedEntry)) {
+            continue;
+        }
+        std::vector<FeedEntry> entries(header.count);
+        std::memcpy(entries.data(), buf + sizeof(header), header.count * sizeof(FeedEntry));
+
+        auto result = sequencer_.onPacket(header.firstSeq, header.count);
+        size_t skip = result.skip;
+        if (result.gapCount > 0) {
+            std::vector<FeedEntry> missing;
+            if (result.gapCount <= FEED_MAX_RETRANSMIT &&
+                retransmit(result.gapFrom, static_cast<uint32_t>(result.gapCount), missing)) {
+                deliver(result.gapFrom, missing.data(), missing.size(), 0);
+                delivered += missing.size();
+                ++gapsRecovered_;
+            } else {
+                // Too old to retransmit: resynchronise from the latest state
+                entriesLost_ += result.gapCount;
+                const uint64_t packetEnd = header.firstSeq + header.count;
+                if (snapshot()) {
+                    const uint64_t resumeAt = sequencer_.expected();
+                    if (resumeAt > header.firstSeq) {
+                        skip = static_cast<size_t>(std::min<uint64_t>(resumeAt - header.firstSeq, header.count));
+                    }
+                }
+                sequencer_.reset(std::max(sequencer_.expected(), packetEnd));
+            }
+        }
+        deliver(header.firstSeq, entries.data(), entries.size(), skip);
+        delivered += entries.size() - skip;
+    }
+    return delivered;
+}
+
+void FeedSubscriber::deliver(uint64_t firstSeq, const FeedEntry* entries, size_t count, size_t skip) {
+    for (size_t i = skip; i < count; ++i) {
+        handler_(firstSeq + i, entries[i]);
+    }
+}
+
+bool FeedSubscriber::snapshot() {
+    FeedRecoveryRequest req{};
+    req.magic = FEED_MAGIC;
+    req.type = FeedRequestType::SNAPSHOT;
+    std::vector<FeedEntry> entries;
+    uint64_t firstSeq = 0;
+    uint64_t endSeq = 0;
+    if (!request(req, entries, firstSeq, endSeq)) {
+        return false;
+    }
+    for (const auto& entry : entries) {
+        handler_(0, entry);
+    }
+    sequencer_.reset(entries.empty() ? endSeq : firstSeq + 1);
+    return true;
+}
+
+bool FeedSubscriber::retransmit(uint64_t fromSeq, uint32_t count, std::vector<FeedEntry>& out) {
+    FeedRecoveryRequest req{};
+    req.magic = FEED_MAGIC;
+    req.type = FeedRequestType::RETRANSMIT;
+    req.fromSeq = fromSeq;
+    req.count = count;
+    uint64_t firstSeq = 0;
+    uint64_t endSeq = 0;
+    out.clear();
+    return request(req, out, firstSeq, endSeq) && firstSeq == fromSeq && out.size() == count;
+}
+
+bool FeedSubscriber::request(const FeedRecoveryRequest& req, std::vector<FeedEntry>& out,
+                             uint64_t& firstSeq, uint64_t& endSeq) {
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return false;
+    }
+    setTimeouts(fd, 2000);
+    sockaddr_in addr = makeAddr(parseAddr(config_.recoveryHost), config_.recoveryPort);
+    bool ok = ::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0 &&
+              writeAll(fd, reinterpret_cast<const uint8_t*>(&req), sizeof(req));
+    bool first = true;
+    while (ok) {
+        FeedPacketHeader header{};
+        if (!readAll(fd, &header, sizeof(header)) || header.magic != FEED_MAGIC) {
+            ok = false;
+            break;
+        }
+        if (header.type == FeedPacketType::END) {
+            endSeq = header.firstSeq;
+            break;
+        }
+        if (first) {
+            firstSeq = header.firstSeq;
+            first = false;
+        }
+        const size_t offset = out.size();
+        out.resize(offset + header.count);
+        ok = readAll(fd, out.data() + offset, header.count * sizeof(FeedEntry));
+    }
+    ::close(fd);
+    return ok;
+}
+
+}  // namespace qfblotter
@@ -0,0 +1,102 @@
+#include "qfblotter/OrderExpiry.hpp"
+
+#include <chrono>
+#include <cstdio>
+
+#include "qfblotter/SimClock.hpp"
+
+namespace qfblotter {
+
+namespace {
+int64_t now_ms() {
+    return SimClock::epochMs();
+}
+}  // namespace
+
+OrderExpiry::OrderExpiry(ExpiryHandler handler, int64_t tickMs)
+    : handler_(std::move(handler)), wheel_(tickMs, now_ms()) {}
+
+OrderExpiry::~OrderExpiry() {
+    stop();
+}
+
+void OrderExpiry::start() {
+    if (running_.exchange(true)) {
+        return;
+    }
+    thread_ = std::thread([this]() { run(); });
+}
+
+void OrderExpiry::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void OrderExpiry::schedule(const std::string& clOrdId, int64_t deadlineMs) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = timers_.find(clOrdId);
+    if (it != timers_.end()) {
+        wheel_.cancel(it->second);
+        it->second = wheel_.schedule(clOrdId, deadlineMs);
+    } else {
+        timers_.emplace(clOrdId, wheel_.schedule(clOrdId, deadlineMs));
+    }
+}
+
+void OrderExpiry::cancel(const std::string& clOrdId) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = timers_.find(clOrdId);
+    if (it == timers_.end()) {
+        return;
+    }
+    wheel_.cancel(it->second);
+    timers_.erase(it);
+}
+
+size_t OrderExpiry::pending() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return wheel_.size();
+}
+
+int64_t OrderExpiry::nextDailyCutoffMs(const std::string& hhmmss, int64_t nowMs) {
+    int h = 0, m = 0, s = 0;
+    if (std::sscanf(hhmmss.c_str(), "%d:%d:%d", &h, &m, &s) < 2) {
+        h = 23; m = 59; s = 59;
+    }
+    constexpr int64_t DAY_MS = 86'400'000;
+    const int64_t offsetMs = ((h * 60 + m) * 60 + s) * int64_t{1000};
+    int64_t cutoff = nowMs - (nowMs % DAY_MS) + offsetMs;
+    if (cutoff <= nowMs) {
+        cutoff += DAY_MS;
+    }
+    return cutoff;
+}
+
+void OrderExpiry::runDue(int64_t nowMs) {
+    std::vector<std::string> expired;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        wheel_.advance(nowMs, expired);
+        for (const auto& id : expired) {
+            timers_.erase(id);
+        }
+    }
+
+    if (!expired.empty() && handler_) {
+        handler_(expired);
+    }
+}
+
+void OrderExpiry::run() {
+    const auto tick = std::chrono::milliseconds(wheel_.tickMs());
+    while (running_) {
+        std::this_thread::sleep_for(tick);
+        runDue(now_ms());
+    }
+}
+
+}  // namespace qfblotter
@@ -2,17 +2,105 @@
 
 #include <algorithm>
 
+#include "qfblotter/RollingStats.hpp"
+
 namespace qfblotter {
 
-void OrderStore::upsert(const OrderRecord& record) {
-    // Exclusive lock for write operations
+void OrderStore::addChangeListener(ChangeListener listener) {
+    changeListeners_.push_back(std::move(listener));
+}
+
+void OrderStore::setFlowStats(RollingStats* stats) {
     std::unique_lock<std::shared_mutex> lock(mutex_);
+    flowStats_ = stats;
+}
+
+OrderStore::FlowState OrderStore::flowState(const OrderRecord& record) {
+    return FlowState{true, record.status == "REJECTED", record.status == "CANCELED",
+                     record.cumQty, record.avgPx, record.latencyUs};
+}
+
+void OrderStore::recordFlow(const FlowState& before, const OrderRecord& after) const {
+    if (flowStats_ == nullptr || !after.algo.empty()) {
+        return;
+    }
+    if (!before.exists) {
+        flowStats_->record(RollingStats::Flow::ORDER, after.price * after.quantity);
+    }
+    if (before.latencyUs <= 0 && after.latencyUs > 0) {
+        flowStats_->recordLatency(after.latencyUs);
+    }
+    if (after.cumQty > before.cumQty) {
+        flowStats_->record(RollingStats::Flow::FILL, after.avgPx * after.cumQty - before.avgPx * before.cumQty);
+    }
+    if (!before.rejected && after.status == "REJECTED") {
+        flowStats_->record(RollingStats::Flow::REJECT);
+    } else if (!before.canceled && after.status == "CANCELED") {
+        flowStats_->record(RollingStats::Flow::CANCEL);
+    }
+}
+
+void OrderStore::notifyChange(const OrderRecord& record) const {
+    for (const auto& listener : changeListeners_) {
+        listener(record);
+    }
+}
+
+template <typename Record>
+void OrderStore::upsertLocked(Record&& record) {
     auto it = orders_.find(record.clOrdId);
+    const FlowState before = it == orders_.end() ? FlowState{} : flowState(it->second);
     if (it == orders_.end()) {
-        orders_.emplace(record.clOrdId, record);
-        orderIndex_.push_back(record.clOrdId);
+        // Keyed by the caller's clOrdId for the hash, then re-pointed at the
+        // node's own copy
+        it = orders_.try_emplace(std::string_view(record.clOrdId), std::forward<Record>(record)).first;
+        orderIndex_.push_back(&it->second);
     } else {
-        it->second = record;
+        it->second = std::forward<Record>(record);  // Copy reuses the strings' capacity
+    }
+    rekey(it);
+    recordFlow(before, it->second);
+    notifyChange(it->second);
+}
+
+void OrderStore::rekey(OrderMap::iterator& it) {
+    if (it->first.data() == it->second.clOrdId.data()) {
+        return;
+    }
+    // Node handles relink the same node: no allocation, record address kept
+    auto node = orders_.extract(it);
+    node.key() = node.mapped().clOrdId;
+    it = orders_.insert(std::move(node)).position;
+}
+
+void OrderStore::upsert(const OrderRecord& record) {
+    // Exclusive lock for write operations
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    upsertLocked(record);
+}
+
+void OrderStore::upsert(OrderRecord&& record) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    upsertLocked(std::move(record));
+}
+
+void OrderStore::reserve(size_t orders) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    orders_.reserve(orders_.size() + orders);
+    orderIndex_.reserve(orderIndex_.size() + orders);
+
+    // Cycle placeholder nodes through the pool so it holds a free node
+    // block for every reserved order
+    std::vector<std::string> keys;
+    keys.reserve(orders);
+    for (size_t i = 0; i < orders; ++i) {
+        keys.push_back("\x01reserve:" + std::to_string(i));
+    }
+    for (const auto& key : keys) {
+        orders_.try_emplace(key);
+    }
+    for (const auto& key : keys) {
+        orders_.erase(key);
     }
 }
 
@@ -23,10 +111,13 @@ void OrderStore::updateStatus(const std::string& clOrdId, const std::string& sta
     if (it == orders_.end()) {
         return;
     }
+    const FlowState before = flowState(it->second);
     it->second.status = status;
     it->second.leavesQty = leavesQty;
     it->second.cumQty = cumQty;
     it->second.avgPx = avgPx;
+    recordFlow(before, it->second);
+    notifyChange(it->second);
 }
 
 void OrderStore::reject(const std::string& clOrdId, const std::string& reason) {
@@ -35,16 +126,44 @@ void OrderStore::reject(const std::string& clOrdId, const std::string& reason) {
     if (it == orders_.end()) {
         return;
     }
+    const FlowState before = flowState(it->second);
     it->second.status = "REJECTED";
     it->second.rejectReason = reason;
+    recordFlow(before, it->second);
+    notifyChange(it->second);
 }
 
 void OrderStore::remove(const std::string& clOrdId) {
     std::unique_lock<std::shared_mutex> lock(mutex_);
-    orders_.erase(clOrdId);
+    auto it = orders_.find(clOrdId);
+    if (it == orders_.end()) {
+        return;
+    }
     orderIndex_.erase(
-        std::remove(orderIndex_.begin(), orderIndex_.end(), clOrdId),
+        std::remove(orderIndex_.begin(), orderIndex_.end(), &it->second),
         orderIndex_.end());
+    orders_.erase(it);
+}
+
+std::vector<OrderRecord> OrderStore::expireOrders(const std::vector<std::string>& clOrdIds) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    std::vector<OrderRecord> expired;
+    expired.reserve(clOrdIds.size());
+    for (const auto& id : clOrdIds) {
+        auto it = orders_.find(id);
+        if (it == orders_.end()) {
+            continue;
+        }
+        auto& order = it->second;
+        if (order.status != "NEW" && order.status != "PARTIAL" && order.status != STATUS_PENDING_STOP) {
+            continue;
+        }
+        order.status = "EXPIRED";
+        order.leavesQty = 0;
+        notifyChange(order);
+        expired.push_back(order);
+    }
+    return expired;
 }
 
 std::optional<OrderRecord> OrderStore::get(const std::string& clOrdId) const {
@@ -74,6 +193,39 @@ std::vector<OrderRecord> OrderStore::getOpenOrders() const {
     return result;
 }
 
+std::vector<OrderRecord> OrderStore::getAll() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    std::vector<OrderRecord> result;
+    result.reserve(orderIndex_.size());
+    for (const OrderRecord* order : orderIndex_) {
+        result.push_back(*order);
+    }
+    return result;
+}
+
+std::vector<OrderRecord> OrderStore::getPendingStops() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    std::vector<OrderRecord> result;
+    for (const auto& [id, order] : orders_) {
+        if (order.status == STATUS_PENDING_STOP) {
+            result.push_back(order);
+        }
+    }
+    return result;
+}
+
+std::optional<OrderRecord> OrderStore::activateStop(const std::string& clOrdId) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto it = orders_.find(clOrdId);
+    if (it == orders_.end() || it->second.status != STATUS_PENDING_STOP) {
+        return std::nullopt;
+    }
+    it->second.status = "NEW";
+    it->second.orderType = (it->second.orderType == ORD_STOP_LIMIT) ? ORD_LIMIT : ORD_MARKET;
+    notifyChange(it->second);
+    return it->second;
+}
+
 OrderStats OrderStore::getStats() const {
     std::shared_lock<std::shared_mutex> lock(mutex_);
     OrderStats stats;
@@ -89,7 +241,19 @@ OrderStats OrderStore::getStats() const {
         else if (o.status == "FILLED") stats.filledOrders++;
         else if (o.status == "REJECTED") stats.rejectedOrders++;
         else if (o.status == "CANCELED") stats.canceledOrders++;
+        else if (o.status == "EXPIRED") stats.expiredOrders++;
+        else if (o.status == STATUS_PENDING_STOP) stats.pendingStopOrders++;
+        else if (o.status == STATUS_WORKING) stats.workingOrders++;
         
+        // Algo parents are represented by their children's notional
+        if (!o.algo.empty()) {
+            stats.algoParents++;
+            stats.algoQty += o.quantity;
+            stats.algoCumQty += o.cumQty;
+            stats.algoFilledNotional += o.avgPx * o.cumQty;
+            continue;
+        }
+
         // Notional calculations (safe: price and quantity are read together)
         stats.totalNotional += o.price * o.quantity;
         if (o.status == "FILLED" || o.status == "PARTIAL") {
@@ -125,27 +289,8 @@ OrderStats OrderStore::getStats() const {
 Json OrderStore::snapshotJson() const {
     std::shared_lock<std::shared_mutex> lock(mutex_);
     Json root = Json::array();
-    for (const auto& id : orderIndex_) {
-        auto it = orders_.find(id);
-        if (it == orders_.end()) {
-            continue;
-        }
-        const auto& o = it->second;
-        Json j;
-        j["clOrdId"] = o.clOrdId;
-        j["orderId"] = o.orderId;
-        j["symbol"] = o.symbol;
-        j["side"] = std::string(1, o.side);
-        j["price"] = o.price;
-        j["quantity"] = o.quantity;
-        j["leavesQty"] = o.leavesQty;
-        j["cumQty"] = o.cumQty;
-        j["avgPx"] = o.avgPx;
-        j["status"] = o.status;
-        j["rejectReason"] = o.rejectReason;
-        j["transactTime"] = o.transactTime;
-        j["latencyUs"] = o.latencyUs;
-        root.push_back(std::move(j));
+    for (const OrderRecord* order : orderIndex_) {
+        root.push_back(orderToJson(*order));
     }
     return root;
 }
@@ -154,4 +299,60 @@ std::string OrderStore::snapshotString() const {
     return dump(snapshotJson());
 }
 
+Json orderToJson(const OrderRecord& o) {
+    Json j;
+    j["clOrdId"] = o.clOrdId;
+    j["orderId"] = o.orderId;
+    j["symbol"] = o.symbol;
+    j["side"] = std::string(1, o.side);
+    j["price"] = o.price;
+    j["quantity"] = o.quantity;
+    j["leavesQty"] = o.leavesQty;
+    j["cumQty"] = o.cumQty;
+    j["avgPx"] = o.avgPx;
+    j["arrivalPx"] = o.arrivalPx;
+    j["status"] = o.status;
+    j["rejectReason"] = o.rejectReason;
+    j["transactTime"] = o.transactTime;
+    j["timeInForce"] = std::string(1, o.timeInForce);
+    j["expireTimeMs"] = o.expireTimeMs;
+    j["orderType"] = std::string(1, o.orderType);
+    j["stopPx"] = o.stopPx;
+    j["algo"] = o.algo;
+    j["parentId"] = o.parentId;
+    j["submitTimeUs"] = o.submitTimeUs;
+    j["ackTimeUs"] = o.ackTimeUs;
+    j["fillTimeUs"] = o.fillTimeUs;
+    j["latencyUs"] = o.latencyUs;
+    return j;
+}
+
+OrderRecord orderFromJson(const Json& j) {
+    OrderRecord record;
+    record.clOrdId = j.value("clOrdId", "");
+    record.orderId = j.value("orderId", "");
+    record.symbol = j.value("symbol", "");
+    record.side = j.value("side", "1")[0];
+    record.price = j.value("price", 0.0);
+    record.quantity = j.value("quantity", 0);
+    record.leavesQty = j.value("leavesQty", 0);
+    record.cumQty = j.value("cumQty", 0);
+    record.avgPx = j.value("avgPx", 0.0);
+    record.arrivalPx = j.value("arrivalPx", 0.0);
+    record.status = j.value("status", "NEW");
+    record.rejectReason = j.value("rejectReason", "");
+    record.transactTime = j.value("transactTime", "");
+    record.timeInForce = j.value("timeInForce", "0")[0];
+    record.expireTimeMs = j.value("expireTimeMs", int64_t(0));
+    record.orderType = j.value("orderType", "2")[0];
+    record.stopPx = j.value("stopPx", 0.0);
+    record.algo = j.value("algo", "");
+    record.parentId = j.value("parentId", "");
+    record.submitTimeUs = j.value("submitTimeUs", int64_t(0));
+    record.ackTimeUs = j.value("ackTimeUs", int64_t(0));
+    record.fillTimeUs = j.value("fillTimeUs", int64_t(0));
+    record.latencyUs = j.value("latencyUs", int64_t(0));
+    return record;
+}
+
 }  // namespace qfblotter
@@ -7,6 +7,8 @@
 
 #include <nlohmann/json.hpp>
 
+#include "qfblotter/AsyncFileWriter.hpp"
+
 namespace qfblotter {
 
 PersistenceManager::PersistenceManager(const std::string& filePath, int saveIntervalSeconds)
@@ -62,23 +64,7 @@ int PersistenceManager::load(OrderLoader loader) {
         
         int count = 0;
         for (const auto& orderJson : j["orders"]) {
-            OrderRecord record;
-            record.clOrdId = orderJson.value("clOrdId", "");
-            record.orderId = orderJson.value("orderId", "");
-            record.symbol = orderJson.value("symbol", "");
-            record.side = orderJson.value("side", "1")[0];
-            record.price = orderJson.value("price", 0.0);
-            record.quantity = orderJson.value("quantity", 0);
-            record.leavesQty = orderJson.value("leavesQty", 0);
-            record.cumQty = orderJson.value("cumQty", 0);
-            record.avgPx = orderJson.value("avgPx", 0.0);
-            record.status = orderJson.value("status", "NEW");
-            record.rejectReason = orderJson.value("rejectReason", "");
-            record.transactTime = orderJson.value("transactTime", "");
-            record.submitTimeUs = orderJson.value("submitTimeUs", int64_t(0));
-            record.ackTimeUs = orderJson.value("ackTimeUs", int64_t(0));
-            record.fillTimeUs = orderJson.value("fillTimeUs", int64_t(0));
-            record.latencyUs = orderJson.value("latencyUs", int64_t(0));
+            OrderRecord record = orderFromJson(orderJson);
             
             if (!record.clOrdId.empty()) {
                 loader(record);
@@ -137,20 +123,25 @@ void PersistenceManager::doSave(const OrderStore& store) {
         j["savedAt"] = std::chrono::duration_cast<std::chrono::seconds>(
             std::chrono::system_clock::now().time_since_epoch()).count();
         
-        auto snapshot = store.snapshotJson();
-        j["orders"] = snapshot["orders"];
-        
-        // Write to temp file first, then rename (atomic)
+        j["orders"] = store.snapshotJson();
+
+        // Write to temp file first, then rename (atomic). The writer syncs
+        // before flush() returns, so the rename never exposes a torn file.
+        // One writer (and thread) serves every save: each starts a fresh
+        // temp file, leaving the previous one renamed into place.
         std::string tempPath = filePath_ + ".tmp";
-        std::ofstream file(tempPath);
-        if (!file.is_open()) {
-            std::cerr << "[PERSISTENCE] Failed to open " << tempPath << std::endl;
-            return;
+        if (writer_) {
+            writer_->reopen();
+        } else {
+            AsyncFileWriter::Options options;
+            options.truncate = true;
+            options.bufferSize = 256 * 1024;
+            options.bufferCount = 4;
+            writer_ = std::make_unique<AsyncFileWriter>(tempPath, options);
         }
-        
-        file << j.dump(2);
-        file.close();
-        
+        writer_->append(j.dump(2));
+        writer_->flush();
+
         // Atomic rename
         std::filesystem::rename(tempPath, filePath_);
         
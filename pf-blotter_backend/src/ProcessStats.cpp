@@ -0,0 +1,60 @@
+#include "qfblotter/ProcessStats.hpp"
+
+#include <fstream>
+#include <string>
+
+#if defined(__linux__)
+#include <dirent.h>
+#endif
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+namespace qfblotter {
+
+namespace {
+#if defined(__linux__)
+// "VmRSS:    1234 kB" and "Threads:  7" from /proc/self/status
+void readStatus(ProcessStats& stats) {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.rfind("VmRSS:", 0) == 0) {
+            stats.rssKB = std::stoll(line.substr(6));
+        } else if (line.rfind("Threads:", 0) == 0) {
+            stats.threads = std::stoll(line.substr(8));
+        }
+    }
+}
+
+int64_t countOpenFds() {
+    DIR* dir = opendir("/proc/self/fd");
+    if (dir == nullptr) {
+        return -1;
+    }
+    int64_t count = 0;
+    while (const dirent* entry = readdir(dir)) {
+        if (entry->d_name[0] != '.') {
+            ++count;
+        }
+    }
+    closedir(dir);
+    return count - 1;  // The directory stream's own descriptor
+}
+#endif
+}  // namespace
+
+ProcessStats sampleProcessStats() {
+    ProcessStats stats;
+#if defined(__linux__)
+    readStatus(stats);
+    stats.openFds = countOpenFds();
+#endif
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    const struct mallinfo2 info = mallinfo2();
+    stats.heapUsedKB = static_cast<int64_t>((info.uordblks + info.hblkhd) / 1024);
+#endif
+    return stats;
+}
+
+}  // namespace qfblotter
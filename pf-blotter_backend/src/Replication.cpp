@@ -0,0 +1,399 @@
+#include "qfblotter/Replication.hpp"
+
+#include <cerrno>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace qfblotter {
+
+namespace {
+int64_t epoch_ns() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(system_clock::now().time_since_epoch()).count();
+}
+
+constexpr auto SEND_STALL_TIMEOUT = std::chrono::seconds(3);  // No send progress before dropping a follower
+
+// On a socket with SO_SNDTIMEO set, so a full send buffer returns EAGAIN
+// instead of blocking: gives up once `running` clears or the peer has
+// accepted nothing for SEND_STALL_TIMEOUT
+bool writeAll(int fd, const std::string& data, const std::atomic<bool>& running) {
+    const char* p = data.data();
+    size_t len = data.size();
+    auto lastProgress = std::chrono::steady_clock::now();
+    while (len > 0) {
+        ssize_t n = ::send(fd, p, len, MSG_NOSIGNAL);
+        if (n <= 0) {
+            if (n < 0 && errno == EINTR) continue;
+            if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK) && running &&
+                std::chrono::steady_clock::now() - lastProgress < SEND_STALL_TIMEOUT) {
+                continue;
+            }
+            return false;
+        }
+        p += n;
+        len -= static_cast<size_t>(n);
+        lastProgress = std::chrono::steady_clock::now();
+    }
+    return true;
+}
+
+void setRecvTimeout(int fd, int ms) {
+    timeval tv{};
+    tv.tv_sec = ms / 1000;
+    tv.tv_usec = (ms % 1000) * 1000;
+    ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+}
+
+void setSendTimeout(int fd, int ms) {
+    timeval tv{};
+    tv.tv_sec = ms / 1000;
+    tv.tv_usec = (ms % 1000) * 1000;
+    ::setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+}
+
+void setNoDelay(int fd) {
+    int one = 1;
+    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+}
+
+constexpr auto HEARTBEAT_INTERVAL = std::chrono::seconds(1);
+constexpr auto PRIMARY_TIMEOUT = std::chrono::seconds(3);  // Missed heartbeats before reconnecting
+constexpr size_t MAX_BATCH = 256;                           // Events per send() call
+}  // namespace
+
+// --- Primary ---
+
+ReplicationPrimary::ReplicationPrimary(uint16_t port, SnapshotProvider snapshot, size_t queueCapacity,
+                                       size_t maxFollowers)
+    : port_(port), snapshot_(std::move(snapshot)), queueCapacity_(queueCapacity),
+      maxFollowers_(maxFollowers == 0 ? 1 : maxFollowers) {}
+
+ReplicationPrimary::~ReplicationPrimary() {
+    stop();
+}
+
+void ReplicationPrimary::start() {
+    if (running_) {
+        return;
+    }
+    listenFd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+    int reuse = 1;
+    ::setsockopt(listenFd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(port_);
+    if (listenFd_ < 0 ||
+        ::bind(listenFd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+        ::listen(listenFd_, 4) != 0) {
+        if (listenFd_ >= 0) ::close(listenFd_);
+        listenFd_ = -1;
+        throw std::runtime_error("Failed to listen for followers on port " + std::to_string(port_));
+    }
+    running_ = true;
+    thread_ = std::thread([this]() { run(); });
+}
+
+void ReplicationPrimary::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    reap(true);
+    ::close(listenFd_);
+    listenFd_ = -1;
+}
+
+void ReplicationPrimary::publishOrder(const OrderRecord& record) {
+    if (followerCount_.load(std::memory_order_relaxed) == 0) {
+        return;
+    }
+    enqueue({{"t", "order"}, {"order", orderToJson(record)}});
+}
+
+void ReplicationPrimary::publishTick(const std::string& symbol, double price) {
+    if (followerCount_.load(std::memory_order_relaxed) == 0) {
+        return;
+    }
+    enqueue({{"t", "tick"}, {"symbol", symbol}, {"price", price}});
+}
+
+void ReplicationPrimary::publishFixSeq(const FixSeqState& state) {
+    if (followerCount_.load(std::memory_order_relaxed) == 0) {
+        return;
+    }
+    enqueue({{"t", "fixseq"}, {"session", state.session}, {"sender", state.senderSeq}, {"target", state.targetSeq}});
+}
+
+void ReplicationPrimary::publishMarketData(const Json& ticks) {
+    if (followerCount_.load(std::memory_order_relaxed) == 0) {
+        return;
+    }
+    enqueue({{"t", "md"}, {"ticks", ticks}});
+}
+
+void ReplicationPrimary::enqueue(Json event) {
+    event["ts"] = epoch_ns();
+    std::lock_guard<std::mutex> lock(followersMutex_);
+    event["seq"] = seq_.fetch_add(1, std::memory_order_relaxed) + 1;
+    const std::string line = event.dump() + "\n";
+    for (auto& follower : followers_) {
+        if (!follower->done && !follower->queue.tryPush(line)) {
+            follower->overflowed.store(true, std::memory_order_relaxed);
+        }
+    }
+}
+
+void ReplicationPrimary::run() {
+    while (running_) {
+        reap(false);
+        pollfd pfd{listenFd_, POLLIN, 0};
+        if (::poll(&pfd, 1, 200) <= 0) {
+            continue;
+        }
+        int fd = ::accept(listenFd_, nullptr, nullptr);
+        if (fd < 0) {
+            continue;
+        }
+        if (followerCount_.load() >= maxFollowers_) {
+            ::close(fd);  // The follower retries later
+            continue;
+        }
+        setNoDelay(fd);
+        setSendTimeout(fd, 100);  // Lets a stalled follower's writer see stop() and its stall deadline
+        auto follower = std::make_unique<Follower>(queueCapacity_);
+        follower->fd = fd;
+        Follower* raw = follower.get();
+        {
+            // Journalling to the new follower starts before its snapshot is
+            // taken, so nothing between the two is lost
+            std::lock_guard<std::mutex> lock(followersMutex_);
+            followers_.push_back(std::move(follower));
+            followerCount_.store(followers_.size(), std::memory_order_relaxed);
+        }
+        raw->thread = std::thread([this, raw]() {
+            stream(*raw);
+            ::close(raw->fd);
+            raw->done = true;
+        });
+    }
+}
+
+void ReplicationPrimary::reap(bool all) {
+    std::vector<std::unique_ptr<Follower>> finished;
+    {
+        std::lock_guard<std::mutex> lock(followersMutex_);
+        for (auto it = followers_.begin(); it != followers_.end();) {
+            if (all || (*it)->done) {
+                finished.push_back(std::move(*it));
+                it = followers_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        followerCount_.store(followers_.size(), std::memory_order_relaxed);
+    }
+    for (auto& follower : finished) {
+        if (follower->thread.joinable()) {
+            follower->thread.join();  // Exits within one poll interval once running_ is false
+        }
+    }
+}
+
+void ReplicationPrimary::stream(Follower& follower) {
+    resyncs_.fetch_add(1, std::memory_order_relaxed);
+
+    ReplicationSnapshot snap = snapshot_();
+    std::string out;
+    for (const auto& order : snap.orders) {
+        out += Json{{"t", "order"}, {"order", orderToJson(order)}}.dump() + "\n";
+    }
+    for (const auto& [symbol, price] : snap.prices) {
+        out += Json{{"t", "tick"}, {"symbol", symbol}, {"price", price}}.dump() + "\n";
+    }
+    for (const auto& fix : snap.fixSeqs) {
+        out += Json{{"t", "fixseq"}, {"session", fix.session}, {"sender", fix.senderSeq},
+                    {"target", fix.targetSeq}}.dump() + "\n";
+    }
+    out += Json{{"t", "synced"}, {"ts", epoch_ns()}}.dump() + "\n";
+    bool ok = writeAll(follower.fd, out, running_);
+
+    std::string line;
+    auto lastSend = std::chrono::steady_clock::now();
+    while (ok && running_ && !follower.overflowed) {
+        out.clear();
+        if (follower.queue.popWait(line, std::chrono::milliseconds(100))) {
+            out += line;
+            for (size_t i = 1; i < MAX_BATCH && follower.queue.popWait(line, std::chrono::milliseconds(0)); ++i) {
+                out += line;
+            }
+        }
+        const auto now = std::chrono::steady_clock::now();
+        if (out.empty() && now - lastSend >= HEARTBEAT_INTERVAL) {
+            out = Json{{"t", "hb"}, {"ts", epoch_ns()}}.dump() + "\n";
+        }
+        if (!out.empty()) {
+            ok = writeAll(follower.fd, out, running_);
+            lastSend = now;
+        }
+    }
+}
+
+// --- Standby ---
+
+ReplicationStandby::ReplicationStandby(std::string host, uint16_t port, Handlers handlers)
+    : host_(std::move(host)), port_(port), handlers_(std::move(handlers)) {}
+
+ReplicationStandby::~ReplicationStandby() {
+    promote();
+}
+
+void ReplicationStandby::start() {
+    if (running_.exchange(true)) {
+        return;
+    }
+    thread_ = std::thread([this]() { run(); });
+}
+
+void ReplicationStandby::promote() {
+    running_ = false;
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+std::vector<FixSeqState> ReplicationStandby::fixSeqs() const {
+    std::lock_guard<std::mutex> lock(fixSeqMutex_);
+    return fixSeqs_;
+}
+
+void ReplicationStandby::run() {
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port_);
+    if (::inet_pton(AF_INET, host_.c_str(), &addr.sin_addr) != 1) {
+        running_ = false;
+        return;
+    }
+    while (running_) {
+        int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        if (fd >= 0 && ::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0) {
+            connected_ = true;
+            synced_ = false;
+            session(fd);
+            connected_ = false;
+        }
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        // Retry until the primary is reachable, staying responsive to promote()
+        for (int i = 0; i < 10 && running_; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        }
+    }
+}
+
+void ReplicationStandby::session(int fd) {
+    setRecvTimeout(fd, 100);
+    std::string buffer;
+    char chunk[16384];
+    auto lastData = std::chrono::steady_clock::now();
+    while (running_) {
+        ssize_t n = ::recv(fd, chunk, sizeof(chunk), 0);
+        if (n == 0) {
+            return;  // Primary closed the stream
+        }
+        if (n < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                return;
+            }
+            if (std::chrono::steady_clock::now() - lastData > PRIMARY_TIMEOUT) {
+                return;
+            }
+            continue;
+        }
+        lastData = std::chrono::steady_clock::now();
+        buffer.append(chunk, static_cast<size_t>(n));
+        size_t start = 0;
+        for (size_t nl = buffer.find('\n', start); nl != std::string::npos; nl = buffer.find('\n', start)) {
+            try {
+                apply(buffer.substr(start, nl - start));
+            } catch (const std::exception& e) {
+                // The stream can no longer be trusted: reconnect for a fresh snapshot
+                std::cerr << "[REPLICATION] Bad event from primary (" << e.what() << "); resyncing" << std::endl;
+                return;
+            }
+            start = nl + 1;
+        }
+        buffer.erase(0, start);
+    }
+}
+
+void ReplicationStandby::apply(const std::string& line) {
+    Json j = Json::parse(line, nullptr, false);
+    if (j.is_discarded() || !j.is_object() || !j.contains("t") || !j["t"].is_string()) {
+        throw std::runtime_error("malformed line");
+    }
+    const std::string type = j["t"].get<std::string>();
+    if (type == "order") {
+        if (!j.contains("order") || !j["order"].is_object()) {
+            throw std::runtime_error("order event without an order");
+        }
+        if (handlers_.onOrder) {
+            handlers_.onOrder(orderFromJson(j["order"]));
+        }
+    } else if (type == "tick") {
+        if (handlers_.onTick) {
+            handlers_.onTick(j.value("symbol", ""), j.value("price", 0.0));
+        }
+    } else if (type == "fixseq") {
+        FixSeqState state{j.value("session", ""), j.value("sender", 0), j.value("target", 0)};
+        {
+            std::lock_guard<std::mutex> lock(fixSeqMutex_);
+            bool found = false;
+            for (auto& existing : fixSeqs_) {
+                if (existing.session == state.session) {
+                    existing = state;
+                    found = true;
+                    break;
+                }
+            }
+            if (!found) {
+                fixSeqs_.push_back(state);
+            }
+        }
+        if (handlers_.onFixSeq) {
+            handlers_.onFixSeq(state);
+        }
+    } else if (type == "md") {
+        if (handlers_.onMarketData) {
+            handlers_.onMarketData(j["ticks"]);
+        }
+    } else if (type == "synced") {
+        synced_ = true;
+    }
+
+    if (j.contains("seq")) {
+        if (!j["seq"].is_number_unsigned()) {
+            throw std::runtime_error("bad seq");
+        }
+        lastSeq_.store(j["seq"].get<uint64_t>(), std::memory_order_relaxed);
+        applied_.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (j.contains("ts") && j["ts"].is_number_integer()) {
+        lagUs_.store((epoch_ns() - j["ts"].get<int64_t>()) / 1000, std::memory_order_relaxed);
+    }
+}
+
+}  // namespace qfblotter
@@ -0,0 +1,190 @@
+#include "qfblotter/RollingStats.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+#include "qfblotter/CoarseClock.hpp"
+
+namespace qfblotter {
+
+namespace {
+int64_t currentSecond() {
+    return CoarseClock::nowMs() / 1000;
+}
+}  // namespace
+
+RollingStats::RollingStats() : RollingStats(currentSecond()) {}
+
+RollingStats::RollingStats(int64_t startSec)
+    : startSec_(startSec), ring_(static_cast<size_t>(MAX_WINDOW_SEC)) {}
+
+size_t RollingStats::latencyBin(int64_t us) {
+    if (us < 16) {
+        return static_cast<size_t>(std::max<int64_t>(us, 0));
+    }
+    const int exponent = static_cast<int>(std::bit_width(static_cast<uint64_t>(us))) - 1;
+    if (exponent > 35) {
+        return LATENCY_BINS - 1;
+    }
+    const auto sub = static_cast<size_t>((us >> (exponent - 3)) & 7);
+    return 16 + static_cast<size_t>(exponent - 4) * 8 + sub;
+}
+
+int64_t RollingStats::binUpperUs(size_t bin) {
+    if (bin < 16) {
+        return static_cast<int64_t>(bin);
+    }
+    const int exponent = static_cast<int>((bin - 16) / 8) + 4;
+    const int64_t width = int64_t{1} << (exponent - 3);
+    return (int64_t{1} << exponent) + static_cast<int64_t>((bin - 16) % 8) * width + width - 1;
+}
+
+RollingStats::Bucket& RollingStats::bucketLocked(int64_t nowSec) {
+    Bucket& bucket = ring_[static_cast<size_t>(nowSec % MAX_WINDOW_SEC)];
+    if (bucket.second != nowSec) {
+        bucket = Bucket{};  // Reused once per second, so clearing it is amortised
+        bucket.second = nowSec;
+    }
+    return bucket;
+}
+
+void RollingStats::record(Flow flow, double notional, int64_t nowSec) {
+    const auto index = static_cast<size_t>(flow);
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (Bucket* bucket : {&bucketLocked(nowSec), &session_}) {
+        ++bucket->flows[index];
+        if (flow == Flow::ORDER) {
+            bucket->notional += notional;
+        } else if (flow == Flow::FILL) {
+            bucket->filledNotional += notional;
+        }
+    }
+}
+
+void RollingStats::record(Flow flow, double notional) {
+    record(flow, notional, currentSecond());
+}
+
+void RollingStats::recordLatency(int64_t latencyUs, int64_t nowSec) {
+    const size_t bin = latencyBin(latencyUs);
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (Bucket* bucket : {&bucketLocked(nowSec), &session_}) {
+        ++bucket->latencyCount;
+        bucket->latencySumUs += latencyUs;
+        bucket->latencyMaxUs = std::max(bucket->latencyMaxUs, latencyUs);
+        ++bucket->latency[bin];
+    }
+}
+
+void RollingStats::recordLatency(int64_t latencyUs) {
+    recordLatency(latencyUs, currentSecond());
+}
+
+void RollingStats::merge(Window& out, const Bucket& bucket, std::array<uint64_t, LATENCY_BINS>& histogram) {
+    out.orders += bucket.flows[static_cast<size_t>(Flow::ORDER)];
+    out.fills += bucket.flows[static_cast<size_t>(Flow::FILL)];
+    out.rejects += bucket.flows[static_cast<size_t>(Flow::REJECT)];
+    out.cancels += bucket.flows[static_cast<size_t>(Flow::CANCEL)];
+    out.notional += bucket.notional;
+    out.filledNotional += bucket.filledNotional;
+    out.latencySamples += bucket.latencyCount;
+    out.avgLatencyUs += bucket.latencySumUs;  // Sum until finish()
+    out.maxLatencyUs = std::max(out.maxLatencyUs, bucket.latencyMaxUs);
+    for (size_t i = 0; i < LATENCY_BINS; ++i) {
+        histogram[i] += bucket.latency[i];
+    }
+}
+
+void RollingStats::finish(Window& out, const std::array<uint64_t, LATENCY_BINS>& histogram) {
+    if (out.latencySamples == 0) {
+        return;
+    }
+    out.avgLatencyUs /= static_cast<int64_t>(out.latencySamples);
+    const auto rank = [&out](double q) {
+        return std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(q * static_cast<double>(out.latencySamples))));
+    };
+    const uint64_t ranks[] = {rank(0.50), rank(0.90), rank(0.99)};
+    int64_t* targets[] = {&out.p50LatencyUs, &out.p90LatencyUs, &out.p99LatencyUs};
+    uint64_t seen = 0;
+    size_t next = 0;
+    for (size_t bin = 0; bin < LATENCY_BINS && next < 3; ++bin) {
+        seen += histogram[bin];
+        while (next < 3 && seen >= ranks[next]) {
+            *targets[next++] = std::min(binUpperUs(bin), out.maxLatencyUs);
+        }
+    }
+}
+
+RollingStats::Window RollingStats::window(int64_t seconds, int64_t nowSec) const {
+    Window out;
+    std::array<uint64_t, LATENCY_BINS> histogram{};
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (seconds <= 0) {
+        out.seconds = std::max<int64_t>(1, nowSec - startSec_ + 1);
+        merge(out, session_, histogram);
+    } else {
+        out.seconds = std::min(seconds, MAX_WINDOW_SEC);
+        for (int64_t second = nowSec - out.seconds + 1; second <= nowSec; ++second) {
+            const Bucket& bucket = ring_[static_cast<size_t>(((second % MAX_WINDOW_SEC) + MAX_WINDOW_SEC) % MAX_WINDOW_SEC)];
+            if (bucket.second == second) {
+                merge(out, bucket, histogram);
+            }
+        }
+    }
+    finish(out, histogram);
+    return out;
+}
+
+RollingStats::Window RollingStats::window(int64_t seconds) const {
+    return window(seconds, currentSecond());
+}
+
+Json RollingStats::windowJson(int64_t seconds) const {
+    const Window w = window(seconds);
+    const auto perSec = [&w](uint64_t count) { return static_cast<double>(count) / static_cast<double>(w.seconds); };
+    Json j;
+    j["window"] = seconds <= 0 ? "session" : std::to_string(w.seconds) + "s";
+    j["seconds"] = w.seconds;
+    j["orders"] = w.orders;
+    j["fills"] = w.fills;
+    j["rejects"] = w.rejects;
+    j["cancels"] = w.cancels;
+    j["ordersPerSec"] = perSec(w.orders);
+    j["fillsPerSec"] = perSec(w.fills);
+    j["rejectsPerSec"] = perSec(w.rejects);
+    j["cancelsPerSec"] = perSec(w.cancels);
+    j["notional"] = w.notional;
+    j["filledNotional"] = w.filledNotional;
+    j["latency"] = {{"samples", w.latencySamples},
+                    {"avgUs", w.avgLatencyUs},
+                    {"p50Us", w.p50LatencyUs},
+                    {"p90Us", w.p90LatencyUs},
+                    {"p99Us", w.p99LatencyUs},
+                    {"maxUs", w.maxLatencyUs}};
+    return j;
+}
+
+int64_t RollingStats::parseWindow(const std::string& text) {
+    if (text == "session") {
+        return 0;
+    }
+    if (text.empty() || text.size() > 6) {
+        return -1;
+    }
+    int64_t multiplier = 1;
+    std::string digits = text;
+    if (digits.back() == 's') {
+        digits.pop_back();
+    } else if (digits.back() == 'm') {
+        digits.pop_back();
+        multiplier = 60;
+    }
+    if (digits.empty() || !std::all_of(digits.begin(), digits.end(), [](char c) { return c >= '0' && c <= '9'; })) {
+        return -1;
+    }
+    const int64_t seconds = std::stoll(digits) * multiplier;
+    return seconds >= 1 && seconds <= MAX_WINDOW_SEC ? seconds : -1;
+}
+
+}  // namespace qfblotter
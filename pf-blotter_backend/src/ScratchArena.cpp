@@ -0,0 +1,33 @@
+#include "qfblotter/ScratchArena.hpp"
+
+namespace qfblotter {
+
+namespace {
+struct ThreadArena {
+    alignas(std::max_align_t) std::byte buffer[ScratchArena::CAPACITY];
+    std::pmr::monotonic_buffer_resource resource{buffer, sizeof(buffer), std::pmr::new_delete_resource()};
+    int depth{0};
+};
+
+ThreadArena& threadArena() {
+    thread_local ThreadArena arena;
+    return arena;
+}
+}  // namespace
+
+std::pmr::memory_resource* ScratchArena::resource() {
+    return &threadArena().resource;
+}
+
+ScratchArena::Scope::Scope() {
+    ++threadArena().depth;
+}
+
+ScratchArena::Scope::~Scope() {
+    ThreadArena& arena = threadArena();
+    if (--arena.depth == 0) {
+        arena.resource.release();  // Back to the start of the inline buffer
+    }
+}
+
+}  // namespace qfblotter
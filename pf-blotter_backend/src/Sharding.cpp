@@ -0,0 +1,271 @@
+#include "qfblotter/Sharding.hpp"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+
+namespace qfblotter {
+
+namespace {
+// splitmix64 finalizer: FNV-1a alone clusters similar short keys on the ring
+uint64_t mix(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+// /stats counters that add up across shards, at any depth (the "algo"
+// object's too). Every other number is a gauge: queue depths, EWMAs,
+// sequence numbers, lags.
+constexpr std::array<std::string_view, 37> ADDITIVE_COUNTERS = {
+    "totalOrders", "newOrders", "partialOrders", "filledOrders", "rejectedOrders", "canceledOrders",
+    "expiredOrders", "pendingStopOrders", "workingOrders", "totalNotional", "filledNotional",
+    "parents", "quantity", "cumQty",
+    "dropCopyPublished", "dropCopyDropped", "dropCopyResynced", "dropCopyQueued",
+    "mdSubscriptions", "mdSnapshotsSent", "mdIncrementalsSent", "shmPublished",
+    "internalCrosses", "internalCrossedQty", "internalCrossResting", "executions",
+    "admissionAdmitted", "admissionShedOrders", "admissionShedCancels", "admissionInFlight", "admissionQueued",
+    "rssKB", "heapUsedKB", "openFds", "threads", "sseBacklog", "replicationFollowers",
+};
+
+// Top-level gauges averaged over shards, weighted by a counter
+constexpr std::array<std::pair<std::string_view, std::string_view>, 2> WEIGHTED_GAUGES = {{
+    {"avgLatencyUs", "totalOrders"},
+    {"admissionLatencyUs", "admissionAdmitted"},
+}};
+
+bool isAdditive(const std::string& key) {
+    return std::find(ADDITIVE_COUNTERS.begin(), ADDITIVE_COUNTERS.end(), key) != ADDITIVE_COUNTERS.end();
+}
+
+// Merged in mergeStats rather than field by field
+bool isMergedSeparately(const std::string& key) {
+    if (key == "minLatencyUs" || key == "maxLatencyUs" || key == "p99LatencyUs") {
+        return true;
+    }
+    return std::any_of(WEIGHTED_GAUGES.begin(), WEIGHTED_GAUGES.end(),
+                       [&key](const auto& gauge) { return gauge.first == key; });
+}
+
+// Counters summed into `merged`, other numbers (gauges) taken as the max
+// over shards, nested objects merged the same way; a key whose type differs
+// between shards keeps the first shard's
+void mergeNumbers(Json& merged, const Json& shard, bool top) {
+    for (const auto& [key, value] : shard.items()) {
+        if (value.is_object()) {
+            Json& slot = merged[key];
+            if (slot.is_null()) {
+                slot = Json::object();
+            }
+            if (slot.is_object()) {
+                mergeNumbers(slot, value, false);
+            }
+            continue;
+        }
+        if (!value.is_number() || (top && isMergedSeparately(key))) {
+            continue;
+        }
+        auto slot = merged.find(key);
+        if (slot == merged.end()) {
+            merged[key] = value;
+        } else if (!slot->is_number()) {
+            continue;
+        } else if (isAdditive(key)) {
+            if (value.is_number_float() || slot->is_number_float()) {
+                *slot = slot->get<double>() + value.get<double>();
+            } else {
+                *slot = slot->get<int64_t>() + value.get<int64_t>();
+            }
+        } else if (value.get<double>() > slot->get<double>()) {
+            *slot = value;
+        }
+    }
+}
+}  // namespace
+
+ShardRing::ShardRing(std::vector<std::string> shards, int virtualNodes)
+    : shards_(std::move(shards)) {
+    if (shards_.empty() || virtualNodes <= 0) {
+        throw std::invalid_argument("ShardRing needs at least one shard and one virtual node");
+    }
+    ring_.reserve(shards_.size() * static_cast<size_t>(virtualNodes));
+    for (uint32_t shard = 0; shard < shards_.size(); ++shard) {
+        for (int v = 0; v < virtualNodes; ++v) {
+            ring_.emplace_back(hash(shards_[shard] + "#" + std::to_string(v)), shard);
+        }
+    }
+    std::sort(ring_.begin(), ring_.end());
+}
+
+size_t ShardRing::shardFor(std::string_view symbol) const {
+    const uint64_t h = hash(symbol);
+    auto it = std::lower_bound(ring_.begin(), ring_.end(), std::make_pair(h, uint32_t{0}));
+    if (it == ring_.end()) {
+        it = ring_.begin();  // Wrap around
+    }
+    return it->second;
+}
+
+uint64_t ShardRing::hash(std::string_view key) {
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for (unsigned char c : key) {
+        h ^= c;
+        h *= 0x100000001b3ULL;
+    }
+    return mix(h);
+}
+
+std::vector<std::string> defaultShardNames(size_t count) {
+    std::vector<std::string> names;
+    names.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        names.push_back("shard" + std::to_string(i));
+    }
+    return names;
+}
+
+Json mergeSnapshots(const std::vector<Json>& shards) {
+    Json merged = Json::array();
+    for (const auto& shard : shards) {
+        if (!shard.is_array()) {
+            continue;
+        }
+        for (const auto& order : shard) {
+            merged.push_back(order);
+        }
+    }
+    return merged;
+}
+
+Json mergeStats(const std::vector<Json>& shards) {
+    Json merged = Json::object();
+    std::array<double, WEIGHTED_GAUGES.size()> weightedSum{};
+    std::array<double, WEIGHTED_GAUGES.size()> weightTotal{};
+    std::array<bool, WEIGHTED_GAUGES.size()> seen{};
+    double minLatency = std::numeric_limits<double>::max();
+    double maxLatency = 0.0;
+    double p99Latency = 0.0;
+    int64_t latencyOrders = 0;
+    size_t up = 0;
+    Json byShard = Json::array();
+
+    for (const auto& shard : shards) {
+        if (!shard.is_object()) {
+            byShard.push_back(nullptr);
+            continue;
+        }
+        ++up;
+        mergeNumbers(merged, shard, true);
+        Json own = Json::object();
+        for (const auto& [key, value] : shard.items()) {
+            if (!value.is_object() && !(value.is_number() && isAdditive(key))) {
+                own[key] = value;
+            }
+        }
+        byShard.push_back(std::move(own));
+        for (size_t g = 0; g < WEIGHTED_GAUGES.size(); ++g) {
+            const std::string key(WEIGHTED_GAUGES[g].first);
+            if (!shard.contains(key) || !shard[key].is_number()) {
+                continue;
+            }
+            const double weight = shard.value(std::string(WEIGHTED_GAUGES[g].second), 0.0);
+            seen[g] = true;
+            weightedSum[g] += shard[key].get<double>() * weight;
+            weightTotal[g] += weight;
+        }
+        const int64_t orders = shard.value("totalOrders", int64_t{0});
+        if (orders > 0) {
+            minLatency = std::min(minLatency, shard.value("minLatencyUs", 0.0));
+            maxLatency = std::max(maxLatency, shard.value("maxLatencyUs", 0.0));
+            p99Latency = std::max(p99Latency, shard.value("p99LatencyUs", 0.0));
+            latencyOrders += orders;
+        }
+    }
+
+    for (size_t g = 0; g < WEIGHTED_GAUGES.size(); ++g) {
+        if (seen[g]) {
+            merged[std::string(WEIGHTED_GAUGES[g].first)] =
+                weightTotal[g] > 0.0 ? weightedSum[g] / weightTotal[g] : 0.0;
+        }
+    }
+    merged["minLatencyUs"] = latencyOrders > 0 ? minLatency : 0.0;
+    merged["maxLatencyUs"] = maxLatency;
+    merged["p99LatencyUs"] = p99Latency;
+    merged["shards"] = shards.size();
+    merged["shardsUp"] = up;
+    merged["byShard"] = std::move(byShard);
+    return merged;
+}
+
+Json mergeWindowStats(const std::vector<Json>& shards) {
+    Json merged;
+    Json latency = Json::object();
+    double latencySum = 0.0;
+    int64_t samples = 0;
+    for (const auto& shard : shards) {
+        if (!shard.is_object()) {
+            continue;
+        }
+        if (merged.is_null()) {
+            merged = shard;  // window, seconds and the first shard's numbers
+            merged.erase("latency");
+        } else {
+            for (const char* key : {"orders", "fills", "rejects", "cancels"}) {
+                merged[key] = merged.value(key, int64_t{0}) + shard.value(key, int64_t{0});
+            }
+            for (const char* key : {"ordersPerSec", "fillsPerSec", "rejectsPerSec", "cancelsPerSec",
+                                    "notional", "filledNotional"}) {
+                merged[key] = merged.value(key, 0.0) + shard.value(key, 0.0);
+            }
+        }
+        const Json own = shard.value("latency", Json::object());
+        const int64_t n = own.value("samples", int64_t{0});
+        samples += n;
+        latencySum += own.value("avgUs", 0.0) * static_cast<double>(n);
+        for (const char* key : {"p50Us", "p90Us", "p99Us", "maxUs"}) {
+            if (own.contains(key) && own[key].is_number() &&
+                (!latency.contains(key) || own[key].get<double>() > latency[key].get<double>())) {
+                latency[key] = own[key];
+            }
+        }
+    }
+    if (merged.is_null()) {
+        return Json::object();
+    }
+    latency["samples"] = samples;
+    latency["avgUs"] = samples > 0 ? latencySum / static_cast<double>(samples) : 0.0;
+    merged["latency"] = std::move(latency);
+    return merged;
+}
+
+Json mergeTcaSummaries(const std::vector<Json>& shards) {
+    Json buckets = Json::array();
+    double totalShortfall = 0.0;
+    double arrivalNotional = 0.0;
+    for (const auto& shard : shards) {
+        if (!shard.is_object()) {
+            continue;
+        }
+        for (const auto& bucket : shard.value("buckets", Json::array())) {
+            buckets.push_back(bucket);
+        }
+        const double cost = shard.value("totalShortfallCost", 0.0);
+        const double bps = shard.value("totalShortfallBps", 0.0);
+        totalShortfall += cost;
+        if (bps != 0.0) {
+            arrivalNotional += cost * 10000.0 / bps;  // Recover each shard's denominator
+        }
+    }
+    Json j;
+    j["buckets"] = std::move(buckets);
+    j["totalShortfallCost"] = totalShortfall;
+    j["totalShortfallBps"] = arrivalNotional != 0.0 ? totalShortfall / arrivalNotional * 10000.0 : 0.0;
+    return j;
+}
+
+}  // namespace qfblotter
@@ -0,0 +1,107 @@
+#include "qfblotter/ShmPublisher.hpp"
+
+#include <cerrno>
+#include <chrono>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "qfblotter/OrderStore.hpp"
+
+namespace qfblotter {
+
+namespace {
+uint32_t roundUpPow2(uint32_t n) {
+    uint32_t p = 2;
+    while (p < n && p < (1u << 30)) {
+        p <<= 1;
+    }
+    return p;
+}
+
+int64_t epoch_ns() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(system_clock::now().time_since_epoch()).count();
+}
+}  // namespace
+
+ShmPublisher::ShmPublisher(const std::string& name, uint32_t slotCount)
+    : name_(name), slotCount_(roundUpPow2(slotCount)), size_(shmSegmentSize(slotCount_)) {
+    // Start from a fresh object: readers still mapping a previous gateway's
+    // segment keep it alive and simply see no further records
+    ::shm_unlink(name_.c_str());
+    int fd = ::shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to create shared memory " + name_ + ": errno " + std::to_string(errno));
+    }
+    if (::ftruncate(fd, static_cast<off_t>(size_)) != 0) {
+        ::close(fd);
+        ::shm_unlink(name_.c_str());
+        throw std::runtime_error("Failed to size shared memory " + name_);
+    }
+    void* addr = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED) {
+        ::shm_unlink(name_.c_str());
+        throw std::runtime_error("Failed to map shared memory " + name_);
+    }
+
+    // ftruncate zero-fills, which is a valid initial state for every atomic
+    header_ = static_cast<ShmHeader*>(addr);
+    slots_ = reinterpret_cast<ShmSlot*>(static_cast<char*>(addr) + sizeof(ShmHeader));
+    header_->version = SHM_VERSION;
+    header_->slotCount = slotCount_;
+    header_->slotSize = static_cast<uint32_t>(sizeof(ShmSlot));
+    header_->magic.store(SHM_MAGIC, std::memory_order_release);
+}
+
+ShmPublisher::~ShmPublisher() {
+    if (header_) {
+        ::munmap(header_, size_);
+        ::shm_unlink(name_.c_str());
+    }
+}
+
+void ShmPublisher::publishTick(const std::string& symbol, double price) {
+    ShmRecord record{};
+    record.type = ShmRecordType::TICK;
+    shmCopyField(record.tick.symbol, symbol);
+    record.tick.price = price;
+    write(record);
+}
+
+void ShmPublisher::publishOrder(const OrderRecord& order) {
+    ShmRecord record{};
+    record.type = ShmRecordType::ORDER;
+    auto& event = record.order;
+    shmCopyField(event.clOrdId, order.clOrdId);
+    shmCopyField(event.symbol, order.symbol);
+    shmCopyField(event.status, order.status);
+    event.side = order.side;
+    event.orderType = order.orderType;
+    event.timeInForce = order.timeInForce;
+    event.price = order.price;
+    event.avgPx = order.avgPx;
+    event.quantity = order.quantity;
+    event.leavesQty = order.leavesQty;
+    event.cumQty = order.cumQty;
+    write(record);
+}
+
+void ShmPublisher::write(ShmRecord& record) {
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    const uint64_t seq = nextSeq_++;
+    ShmSlot& slot = slots_[seq & (slotCount_ - 1)];
+    record.timestampNs = epoch_ns();
+
+    slot.seq.store(2 * seq - 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(&slot.record, &record, sizeof(ShmRecord));
+    slot.seq.store(2 * seq, std::memory_order_release);
+    header_->writeSeq.store(seq, std::memory_order_release);
+    published_.fetch_add(1, std::memory_order_relaxed);
+}
+
+}  // namespace qfblotter
@@ -0,0 +1,85 @@
+#include "qfblotter/ShmReader.hpp"
+
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace qfblotter {
+
+ShmReader::ShmReader(const std::string& name, bool replay) {
+    int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        throw std::runtime_error("Shared memory not found: " + name);
+    }
+    struct stat st{};
+    if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(ShmHeader)) {
+        ::close(fd);
+        throw std::runtime_error("Shared memory too small: " + name);
+    }
+    size_ = static_cast<size_t>(st.st_size);
+    void* addr = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED) {
+        throw std::runtime_error("Failed to map shared memory: " + name);
+    }
+    header_ = static_cast<const ShmHeader*>(addr);
+
+    if (header_->magic.load(std::memory_order_acquire) != SHM_MAGIC ||
+        header_->version != SHM_VERSION ||
+        header_->slotSize != sizeof(ShmSlot) ||
+        shmSegmentSize(header_->slotCount) > size_) {
+        ::munmap(addr, size_);
+        throw std::runtime_error("Incompatible shared memory feed: " + name);
+    }
+    slots_ = reinterpret_cast<const ShmSlot*>(static_cast<const char*>(addr) + sizeof(ShmHeader));
+    mask_ = header_->slotCount - 1;
+
+    const uint64_t last = header_->writeSeq.load(std::memory_order_acquire);
+    if (!replay) {
+        nextSeq_ = last + 1;
+    } else {
+        nextSeq_ = last > mask_ ? last - mask_ : 1;
+    }
+}
+
+ShmReader::~ShmReader() {
+    if (header_) {
+        ::munmap(const_cast<ShmHeader*>(header_), size_);
+    }
+}
+
+ShmReader::Poll ShmReader::poll(ShmRecord& out) {
+    const ShmSlot& slot = slots_[nextSeq_ & mask_];
+    const uint64_t expected = 2 * nextSeq_;
+
+    const uint64_t before = slot.seq.load(std::memory_order_acquire);
+    if (before < expected) {
+        return Poll::EMPTY;  // Not written yet, or still being written
+    }
+    if (before == expected) {
+        std::memcpy(&out, &slot.record, sizeof(ShmRecord));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.seq.load(std::memory_order_relaxed) == expected) {
+            ++nextSeq_;
+            return Poll::RECORD;
+        }
+    }
+    // The writer has lapped us, before or during the copy
+    resync();
+    return Poll::OVERRUN;
+}
+
+void ShmReader::resync() {
+    const uint64_t last = header_->writeSeq.load(std::memory_order_acquire);
+    // Skip to the oldest slot the writer is not about to reuse
+    const uint64_t oldest = last > mask_ ? last - mask_ + 1 : 1;
+    if (oldest > nextSeq_) {
+        lost_ += oldest - nextSeq_;
+        nextSeq_ = oldest;
+    }
+}
+
+}  // namespace qfblotter
@@ -0,0 +1,59 @@
+#include "qfblotter/SimClock.hpp"
+
+#include <atomic>
+#include <chrono>
+
+namespace qfblotter {
+
+namespace {
+std::atomic<bool> g_virtual{false};
+std::atomic<int64_t> g_virtualUs{0};
+}  // namespace
+
+void SimClock::setVirtual(int64_t startEpochMs) {
+    g_virtualUs.store(startEpochMs * 1000, std::memory_order_relaxed);
+    g_virtual.store(true, std::memory_order_release);
+}
+
+void SimClock::setReal() {
+    g_virtual.store(false, std::memory_order_release);
+}
+
+bool SimClock::isVirtual() {
+    return g_virtual.load(std::memory_order_acquire);
+}
+
+int64_t SimClock::epochMs() {
+    return epochUs() / 1000;
+}
+
+int64_t SimClock::epochUs() {
+    if (isVirtual()) {
+        return g_virtualUs.load(std::memory_order_acquire);
+    }
+    using namespace std::chrono;
+    return duration_cast<microseconds>(system_clock::now().time_since_epoch()).count();
+}
+
+int64_t SimClock::steadyUs() {
+    if (isVirtual()) {
+        return g_virtualUs.load(std::memory_order_acquire);
+    }
+    using namespace std::chrono;
+    return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+void SimClock::advanceTo(int64_t epochUs) {
+    int64_t current = g_virtualUs.load(std::memory_order_relaxed);
+    while (current < epochUs &&
+           !g_virtualUs.compare_exchange_weak(current, epochUs, std::memory_order_release, std::memory_order_relaxed)) {
+    }
+}
+
+void SimClock::advanceBy(int64_t us) {
+    if (us > 0) {
+        g_virtualUs.fetch_add(us, std::memory_order_release);
+    }
+}
+
+}  // namespace qfblotter
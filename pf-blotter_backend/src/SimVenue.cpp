@@ -0,0 +1,89 @@
+#include "qfblotter/SimVenue.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+namespace qfblotter {
+
+std::vector<VenueConfig> parseVenues(const std::string& spec) {
+    std::vector<VenueConfig> venues;
+    std::stringstream entries(spec);
+    std::string entry;
+    while (std::getline(entries, entry, ',')) {
+        if (entry.empty()) {
+            continue;
+        }
+        std::vector<std::string> fields;
+        std::stringstream parts(entry);
+        std::string field;
+        while (std::getline(parts, field, ':')) {
+            fields.push_back(field);
+        }
+        if (fields.size() != 4 || fields[0].empty()) {
+            throw std::runtime_error("Venue must be NAME:latencyUs:jitterUs:feePerShare: " + entry);
+        }
+        VenueConfig venue;
+        venue.name = fields[0];
+        try {
+            venue.latencyUs = std::stoll(fields[1]);
+            venue.jitterUs = std::stoll(fields[2]);
+            venue.feePerShare = std::stod(fields[3]);
+        } catch (const std::exception&) {
+            throw std::runtime_error("Invalid venue: " + entry);
+        }
+        if (venue.latencyUs < 0 || venue.jitterUs < 0) {
+            throw std::runtime_error("Venue latency must not be negative: " + entry);
+        }
+        venue.seed = static_cast<unsigned>(venues.size() + 1) * 7919u;  // Distinct books per venue
+        venues.push_back(venue);
+    }
+    if (venues.empty()) {
+        throw std::runtime_error("No venues configured");
+    }
+    return venues;
+}
+
+SimVenue::SimVenue(VenueConfig config)
+    : config_(std::move(config)), book_(config_.seed), rng_(config_.seed + 1) {}
+
+OrderBook SimVenue::quote(const std::string& symbol, double referencePx, int depth) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const double dislocation = unit_(rng_) * config_.dislocationBps / 10000.0;
+    book_.restorePrice(symbol, referencePx * (1.0 + dislocation));
+    return book_.getOrderBook(symbol, depth);
+}
+
+VenueFill SimVenue::execute(const std::string& symbol, char side, double limitPx, int qty, double referencePx) {
+    const OrderBook book = quote(symbol, referencePx, 10);
+    const bool buy = side == '1';
+    const auto& levels = buy ? book.asks : book.bids;
+    VenueFill fill;
+    double notional = 0.0;
+    for (const auto& level : levels) {
+        if (fill.qty >= qty) {
+            break;
+        }
+        if (limitPx > 0.0 && (buy ? level.price > limitPx : level.price < limitPx)) {
+            break;  // Levels only get worse from here
+        }
+        const int take = std::min(qty - fill.qty, level.quantity);
+        fill.qty += take;
+        notional += take * level.price;
+    }
+    if (fill.qty > 0) {
+        fill.avgPx = notional / fill.qty;
+        fill.fee = fill.qty * config_.feePerShare;
+    }
+    return fill;
+}
+
+int64_t SimVenue::sampleLatencyUs() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const double draw = static_cast<double>(config_.latencyUs) + unit_(rng_) * static_cast<double>(config_.jitterUs);
+    return std::max(config_.latencyUs / 4, static_cast<int64_t>(std::llround(draw)));
+}
+
+}  // namespace qfblotter
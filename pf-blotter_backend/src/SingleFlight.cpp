@@ -0,0 +1,83 @@
+#include "qfblotter/SingleFlight.hpp"
+
+#include <exception>
+#include <utility>
+
+namespace qfblotter {
+
+SingleFlight::SingleFlight(size_t maxEntries) : maxEntries_(maxEntries == 0 ? 1 : maxEntries) {}
+
+SingleFlight::Result SingleFlight::get(const std::string& key, std::chrono::milliseconds ttl,
+                                       const std::function<std::string()>& compute) {
+    std::promise<Result> promise;
+    uint64_t id = 0;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        const auto now = Clock::now();
+        auto it = entries_.find(key);
+        if (it != entries_.end()) {
+            if (!it->second.done) {
+                auto pending = it->second.result;
+                coalesced_.fetch_add(1, std::memory_order_relaxed);
+                lock.unlock();
+                return pending.get();
+            }
+            if (now < it->second.expires) {
+                cacheHits_.fetch_add(1, std::memory_order_relaxed);
+                return it->second.result.get();
+            }
+            entries_.erase(it);
+        }
+        if (entries_.size() >= maxEntries_) {
+            pruneLocked(now);
+        }
+        id = ++nextId_;
+        entries_[key] = Entry{promise.get_future().share(), false, {}, id};
+    }
+
+    // Leader: compute outside the lock, then publish to waiters and the cache
+    computed_.fetch_add(1, std::memory_order_relaxed);
+    Result result;
+    try {
+        result = std::make_shared<const std::string>(compute());
+    } catch (...) {
+        promise.set_exception(std::current_exception());
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(key);
+        if (it != entries_.end() && it->second.id == id) {
+            entries_.erase(it);
+        }
+        throw;
+    }
+    promise.set_value(result);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(key);
+        if (it != entries_.end() && it->second.id == id) {
+            if (ttl.count() > 0 && !result->empty()) {
+                it->second.done = true;
+                it->second.expires = Clock::now() + ttl;
+            } else {
+                entries_.erase(it);
+            }
+        }
+    }
+    return result;
+}
+
+void SingleFlight::invalidate(const std::string& key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.erase(key);  // Waiters hold their own copy of a pending result
+}
+
+void SingleFlight::pruneLocked(Clock::time_point now) {
+    for (auto it = entries_.begin(); it != entries_.end();) {
+        if (it->second.done && it->second.expires <= now) {
+            it = entries_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+}  // namespace qfblotter
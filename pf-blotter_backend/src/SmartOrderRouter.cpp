@@ -0,0 +1,145 @@
+#include "qfblotter/SmartOrderRouter.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace qfblotter {
+
+SmartOrderRouter::SmartOrderRouter(const std::vector<VenueConfig>& venues, EventScheduler& scheduler,
+                                   ReferencePrice reference, double latencyPenaltyBpsPerMs)
+    : scheduler_(scheduler), reference_(std::move(reference)), latencyPenaltyBpsPerMs_(latencyPenaltyBpsPerMs) {
+    for (const auto& config : venues) {
+        venues_.push_back(std::make_unique<SimVenue>(config));
+        VenueStats stats;
+        stats.name = config.name;
+        stats_.push_back(stats);
+    }
+    latencySumUs_.assign(venues_.size(), 0);
+}
+
+std::vector<RouteSlice> SmartOrderRouter::plan(char side, double limitPx, int qty,
+                                               const std::vector<OrderBook>& books) const {
+    struct Candidate {
+        size_t venue;
+        double price;
+        int qty;
+        double cost;  // Per share, after fee and latency drift
+    };
+    const bool buy = side == '1';
+    std::vector<Candidate> candidates;
+    for (size_t v = 0; v < books.size() && v < venues_.size(); ++v) {
+        const VenueConfig& config = venues_[v]->config();
+        const double latencyMs = static_cast<double>(config.latencyUs) / 1000.0;
+        for (const auto& level : buy ? books[v].asks : books[v].bids) {
+            if (limitPx > 0.0 && (buy ? level.price > limitPx : level.price < limitPx)) {
+                break;
+            }
+            const double drift = level.price * latencyPenaltyBpsPerMs_ * latencyMs / 10000.0;
+            const double cost = buy ? level.price + config.feePerShare + drift
+                                    : level.price - config.feePerShare - drift;
+            candidates.push_back({v, level.price, level.quantity, cost});
+        }
+    }
+    // Cheapest to buy, richest to sell; ties keep venue order
+    std::stable_sort(candidates.begin(), candidates.end(), [buy](const Candidate& a, const Candidate& b) {
+        return buy ? a.cost < b.cost : a.cost > b.cost;
+    });
+
+    std::vector<int> venueQty(venues_.size(), 0);
+    std::vector<double> venueNotional(venues_.size(), 0.0);
+    int remaining = qty;
+    for (const auto& candidate : candidates) {
+        if (remaining <= 0) {
+            break;
+        }
+        const int take = std::min(remaining, candidate.qty);
+        venueQty[candidate.venue] += take;
+        venueNotional[candidate.venue] += take * candidate.price;
+        remaining -= take;
+    }
+
+    std::vector<RouteSlice> slices;
+    for (size_t v = 0; v < venueQty.size(); ++v) {
+        if (venueQty[v] > 0) {
+            slices.push_back({v, venueQty[v], venueNotional[v] / venueQty[v]});
+        }
+    }
+    return slices;
+}
+
+int SmartOrderRouter::route(const std::string& clOrdId, const std::string& symbol, char side, double limitPx,
+                            int qty, ExecutionHandler onExecution) {
+    if (qty <= 0 || inFlight(clOrdId)) {
+        return 0;
+    }
+    const double reference = reference_(symbol);
+    std::vector<OrderBook> books;
+    books.reserve(venues_.size());
+    for (auto& venue : venues_) {
+        books.push_back(venue->quote(symbol, reference));
+    }
+    const auto slices = plan(side, limitPx, qty, books);
+    if (slices.empty()) {
+        return 0;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!inFlight_.emplace(clOrdId, static_cast<int>(slices.size())).second) {
+            return 0;
+        }
+    }
+
+    int sent = 0;
+    for (const auto& slice : slices) {
+        SimVenue& venue = *venues_[slice.venue];
+        const int64_t outUs = venue.sampleLatencyUs();
+        const int64_t backUs = venue.sampleLatencyUs();
+        sent += slice.qty;
+        scheduler_.after(outUs, [this, clOrdId, symbol, side, limitPx, slice, outUs, backUs, onExecution]() {
+            // Arrived: take what the venue's book offers now
+            SimVenue& target = *venues_[slice.venue];
+            const VenueFill fill = target.execute(symbol, side, limitPx, slice.qty, reference_(symbol));
+            VenueExecution execution{clOrdId, target.config().name, slice.qty, fill.qty, fill.avgPx,
+                                     slice.expectedPx, fill.fee, outUs + backUs};
+            scheduler_.after(backUs, [this, execution, venueIndex = slice.venue, onExecution]() {
+                const int booked = onExecution(execution);
+                complete(execution.clOrdId, venueIndex, execution, booked);
+            });
+        });
+    }
+    return sent;
+}
+
+void SmartOrderRouter::complete(const std::string& clOrdId, size_t venue, const VenueExecution& execution,
+                                int booked) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    VenueStats& stats = stats_[venue];
+    ++stats.slices;
+    stats.sentQty += static_cast<uint64_t>(execution.sentQty);
+    stats.filledQty += static_cast<uint64_t>(execution.fillQty);
+    stats.bustedQty += static_cast<uint64_t>(std::max(0, execution.fillQty - booked));
+    stats.fees += execution.fee;
+    latencySumUs_[venue] += execution.latencyUs;
+    auto it = inFlight_.find(clOrdId);
+    if (it != inFlight_.end() && --it->second <= 0) {
+        inFlight_.erase(it);
+    }
+}
+
+bool SmartOrderRouter::inFlight(const std::string& clOrdId) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return inFlight_.count(clOrdId) > 0;
+}
+
+std::vector<VenueStats> SmartOrderRouter::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<VenueStats> out = stats_;
+    for (size_t v = 0; v < out.size(); ++v) {
+        if (out[v].slices > 0) {
+            out[v].avgLatencyUs = latencySumUs_[v] / static_cast<int64_t>(out[v].slices);
+        }
+    }
+    return out;
+}
+
+}  // namespace qfblotter
@@ -0,0 +1,68 @@
+#include "qfblotter/StopOrderIndex.hpp"
+
+namespace qfblotter {
+
+void StopOrderIndex::add(const std::string& clOrdId, const std::string& symbol, char side, double stopPx) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (locations_.count(clOrdId)) {
+        return;
+    }
+    auto& book = books_[symbol];
+    Location loc;
+    loc.symbol = symbol;
+    loc.side = side;
+    if (side == '1') {
+        loc.buyIt = book.buys.emplace(stopPx, clOrdId);
+    } else {
+        loc.sellIt = book.sells.emplace(stopPx, clOrdId);
+    }
+    locations_.emplace(clOrdId, std::move(loc));
+}
+
+bool StopOrderIndex::remove(const std::string& clOrdId) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = locations_.find(clOrdId);
+    if (it == locations_.end()) {
+        return false;
+    }
+    auto& book = books_[it->second.symbol];
+    if (it->second.side == '1') {
+        book.buys.erase(it->second.buyIt);
+    } else {
+        book.sells.erase(it->second.sellIt);
+    }
+    locations_.erase(it);
+    return true;
+}
+
+void StopOrderIndex::onTick(const std::string& symbol, double price, std::vector<StopTrigger>& triggered) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto bookIt = books_.find(symbol);
+    if (bookIt == books_.end()) {
+        return;
+    }
+    auto& book = bookIt->second;
+
+    // Buy stops: every stop <= price has been reached
+    auto buyEnd = book.buys.upper_bound(price);
+    for (auto it = book.buys.begin(); it != buyEnd; ++it) {
+        triggered.push_back(StopTrigger{it->second, symbol, '1', it->first, price});
+        locations_.erase(it->second);
+    }
+    book.buys.erase(book.buys.begin(), buyEnd);
+
+    // Sell stops: every stop >= price has been reached
+    auto sellEnd = book.sells.upper_bound(price);
+    for (auto it = book.sells.begin(); it != sellEnd; ++it) {
+        triggered.push_back(StopTrigger{it->second, symbol, '2', it->first, price});
+        locations_.erase(it->second);
+    }
+    book.sells.erase(book.sells.begin(), sellEnd);
+}
+
+size_t StopOrderIndex::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return locations_.size();
+}
+
+}  // namespace qfblotter
@@ -0,0 +1,213 @@
+#include "qfblotter/TcaEngine.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include "qfblotter/OrderStore.hpp"
+
+namespace qfblotter {
+
+void TcaEngine::onArrival(const std::string& clOrdId, const std::string& symbol, char side, double arrivalPx) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    registerUnlocked(clOrdId, symbol, side, arrivalPx);
+}
+
+OrderTca& TcaEngine::registerUnlocked(const std::string& clOrdId, const std::string& symbol,
+                                      char side, double arrivalPx) {
+    auto& sym = symbols_[symbol];
+    auto [it, inserted] = orders_.try_emplace(clOrdId);
+    if (inserted) {
+        auto& tca = it->second;
+        tca.symbol = symbol;
+        tca.side = side;
+        tca.arrivalPx = arrivalPx;
+        tca.mktNotionalAtArrival = sym.mktNotional;
+        tca.mktVolumeAtArrival = sym.mktVolume;
+        sym.sides[sideIndex(side)].orders++;
+    }
+    return it->second;
+}
+
+void TcaEngine::onFill(const OrderRecord& order, int fillQty, double fillPx) {
+    if (fillQty <= 0) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = orders_.find(order.clOrdId);
+    OrderTca& tca = (it != orders_.end())
+        ? it->second
+        : registerUnlocked(order.clOrdId, order.symbol, order.side,
+                           order.arrivalPx > 0.0 ? order.arrivalPx : fillPx);
+
+    auto& sym = symbols_[tca.symbol];
+    const double qty = static_cast<double>(fillQty);
+    const double notional = fillPx * qty;
+    const double sign = sideSign(tca.side);
+
+    const double shortfall = sign * (fillPx - tca.arrivalPx) * qty;
+    tca.filledQty += fillQty;
+    tca.filledNotional += notional;
+    tca.shortfallCost += shortfall;
+
+    auto& bucket = sym.sides[sideIndex(tca.side)];
+    bucket.fills++;
+    bucket.filledQty += fillQty;
+    bucket.filledNotional += notional;
+    bucket.arrivalNotional += tca.arrivalPx * qty;
+    bucket.shortfallCost += shortfall;
+    if (sym.mktVolume > 0) {  // No benchmark before the first market print
+        const double vwap = sym.mktNotional / static_cast<double>(sym.mktVolume);
+        bucket.vwapNotional += vwap * qty;
+        bucket.vwapCost += sign * (fillPx - vwap) * qty;
+    }
+
+    if (order.quantity > 0 && order.cumQty + fillQty >= order.quantity) {
+        retireUnlocked(order.clOrdId);
+    }
+}
+
+void TcaEngine::onMarketPrint(const std::string& symbol, double price, int64_t qty) {
+    if (qty <= 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& sym = symbols_[symbol];
+    sym.mktNotional += price * static_cast<double>(qty);
+    sym.mktVolume += qty;
+}
+
+void TcaEngine::onTerminal(const std::string& clOrdId) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    retireUnlocked(clOrdId);
+}
+
+void TcaEngine::retireUnlocked(const std::string& clOrdId) {
+    auto node = orders_.extract(clOrdId);
+    if (node.empty()) {
+        return;
+    }
+    OrderTca& tca = node.mapped();
+    const auto& sym = symbols_[tca.symbol];
+    tca.mktNotionalAtEnd = sym.mktNotional;  // Interval VWAP stops here
+    tca.mktVolumeAtEnd = sym.mktVolume;
+    tca.done = true;
+    finished_[clOrdId] = std::move(tca);
+    finishedOrder_.push_back(clOrdId);
+    while (finishedOrder_.size() > finishedCapacity_) {
+        finished_.erase(finishedOrder_.front());
+        finishedOrder_.pop_front();
+    }
+}
+
+void TcaEngine::rename(const std::string& oldClOrdId, const std::string& newClOrdId) {
+    if (oldClOrdId == newClOrdId) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto node = orders_.extract(oldClOrdId);
+    if (!node.empty()) {
+        node.key() = newClOrdId;
+        orders_.insert(std::move(node));
+    }
+}
+
+double TcaEngine::marketVwap(const std::string& symbol) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = symbols_.find(symbol);
+    if (it == symbols_.end() || it->second.mktVolume == 0) {
+        return 0.0;
+    }
+    return it->second.mktNotional / static_cast<double>(it->second.mktVolume);
+}
+
+size_t TcaEngine::liveOrders() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return orders_.size();
+}
+
+std::optional<Json> TcaEngine::orderJson(const std::string& clOrdId) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = orders_.find(clOrdId);
+    if (it == orders_.end()) {
+        it = finished_.find(clOrdId);
+        if (it == finished_.end()) {
+            return std::nullopt;
+        }
+    }
+    const auto& tca = it->second;
+    const auto& sym = symbols_.at(tca.symbol);
+
+    Json j;
+    j["clOrdId"] = clOrdId;
+    j["symbol"] = tca.symbol;
+    j["side"] = std::string(1, tca.side);
+    j["arrivalPx"] = tca.arrivalPx;
+    j["filledQty"] = tca.filledQty;
+
+    const double filledQty = static_cast<double>(tca.filledQty);
+    const double avgPx = tca.filledQty > 0 ? tca.filledNotional / filledQty : 0.0;
+    j["avgPx"] = avgPx;
+    j["shortfallCost"] = tca.shortfallCost;
+    j["shortfallBps"] = bps(tca.shortfallCost, tca.arrivalPx * filledQty);
+
+    // Market VWAP over the order's lifetime, up to now for a live order
+    const double endNotional = tca.done ? tca.mktNotionalAtEnd : sym.mktNotional;
+    const int64_t intervalVolume = (tca.done ? tca.mktVolumeAtEnd : sym.mktVolume) - tca.mktVolumeAtArrival;
+    const double intervalVwap = intervalVolume > 0
+        ? (endNotional - tca.mktNotionalAtArrival) / static_cast<double>(intervalVolume)
+        : 0.0;
+    j["intervalVwap"] = intervalVwap;
+    j["vwapSlippageBps"] = (tca.filledQty > 0 && intervalVwap > 0.0)
+        ? sideSign(tca.side) * (avgPx - intervalVwap) / intervalVwap * 10'000.0
+        : 0.0;
+    return j;
+}
+
+Json TcaEngine::summaryJson() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::vector<const std::pair<const std::string, SymbolTca>*> sorted;
+    sorted.reserve(symbols_.size());
+    for (const auto& entry : symbols_) {
+        sorted.push_back(&entry);
+    }
+    std::sort(sorted.begin(), sorted.end(),
+              [](const auto* a, const auto* b) { return a->first < b->first; });
+
+    Json rows = Json::array();
+    double totalShortfall = 0.0;
+    double totalArrivalNotional = 0.0;
+    for (const auto* entry : sorted) {
+        const auto& sym = entry->second;
+        for (size_t i = 0; i < sym.sides.size(); ++i) {
+            const auto& b = sym.sides[i];
+            if (b.orders == 0 && b.fills == 0) {
+                continue;
+            }
+            Json row;
+            row["symbol"] = entry->first;
+            row["side"] = i == 0 ? "1" : "2";
+            row["orders"] = b.orders;
+            row["fills"] = b.fills;
+            row["filledQty"] = b.filledQty;
+            row["filledNotional"] = b.filledNotional;
+            row["avgPx"] = b.filledQty > 0 ? b.filledNotional / static_cast<double>(b.filledQty) : 0.0;
+            row["shortfallCost"] = b.shortfallCost;
+            row["shortfallBps"] = bps(b.shortfallCost, b.arrivalNotional);
+            row["vwapCost"] = b.vwapCost;
+            row["vwapSlippageBps"] = bps(b.vwapCost, b.vwapNotional);
+            rows.push_back(std::move(row));
+            totalShortfall += b.shortfallCost;
+            totalArrivalNotional += b.arrivalNotional;
+        }
+    }
+
+    Json j;
+    j["buckets"] = std::move(rows);
+    j["totalShortfallCost"] = totalShortfall;
+    j["totalShortfallBps"] = bps(totalShortfall, totalArrivalNotional);
+    return j;
+}
+
+}  // namespace qfblotter
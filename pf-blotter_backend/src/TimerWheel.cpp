@@ -0,0 +1,149 @@
+#include "qfblotter/TimerWheel.hpp"
+
+#include <algorithm>
+
+namespace qfblotter {
+
+TimerWheel::TimerWheel(int64_t tickMs, int64_t startMs)
+    : tickMs_(std::max<int64_t>(1, tickMs)), startMs_(startMs) {
+    for (auto& level : heads_) {
+        level.fill(NIL);
+    }
+}
+
+TimerWheel::TimerId TimerWheel::schedule(const std::string& key, int64_t deadlineMs) {
+    uint32_t index;
+    if (!freeList_.empty()) {
+        index = freeList_.back();
+        freeList_.pop_back();
+    } else {
+        index = static_cast<uint32_t>(nodes_.size());
+        nodes_.emplace_back();
+    }
+
+    // Round up so a timer never fires before its deadline
+    const int64_t offset = deadlineMs - startMs_;
+    const uint64_t tick = offset <= 0 ? 0 : static_cast<uint64_t>((offset + tickMs_ - 1) / tickMs_);
+
+    auto& node = nodes_[index];
+    node.key = key;
+    node.deadlineTick = std::max(tick, currentTick_ + 1);
+    node.generation++;
+    place(index);
+    active_++;
+    return (static_cast<uint64_t>(node.generation) << 32) | index;
+}
+
+bool TimerWheel::cancel(TimerId id) {
+    const auto index = static_cast<uint32_t>(id & 0xFFFFFFFFu);
+    const auto generation = static_cast<uint32_t>(id >> 32);
+    if (index >= nodes_.size()) {
+        return false;
+    }
+    auto& node = nodes_[index];
+    if (node.level < 0 || node.generation != generation) {
+        return false;
+    }
+    unlink(index);
+    release(index);
+    return true;
+}
+
+size_t TimerWheel::advance(int64_t nowMs, std::vector<std::string>& expired) {
+    if (nowMs < startMs_) {
+        return 0;
+    }
+    const auto target = static_cast<uint64_t>((nowMs - startMs_) / tickMs_);
+    const size_t before = expired.size();
+
+    while (currentTick_ < target) {
+        // Nothing pending: jump straight to the target tick
+        if (active_ == 0) {
+            currentTick_ = target;
+            break;
+        }
+
+        currentTick_++;
+
+        // Cascade higher levels whose slot boundary we just crossed, top down
+        int cascadeTop = 0;
+        for (int level = 1; level < LEVELS; ++level) {
+            if ((currentTick_ & ((uint64_t{1} << (SLOT_BITS * level)) - 1)) != 0) {
+                break;
+            }
+            cascadeTop = level;
+        }
+        for (int level = cascadeTop; level >= 1; --level) {
+            cascade(level);
+        }
+
+        auto& head = heads_[0][currentTick_ & SLOT_MASK];
+        while (head != NIL) {
+            const uint32_t index = head;
+            unlink(index);
+            expired.push_back(std::move(nodes_[index].key));
+            release(index);
+        }
+    }
+    return expired.size() - before;
+}
+
+void TimerWheel::place(uint32_t index) {
+    auto& node = nodes_[index];
+    const uint64_t delta = node.deadlineTick > currentTick_ ? node.deadlineTick - currentTick_ : 0;
+
+    int level = 0;
+    while (level < LEVELS - 1 && delta >= (uint64_t{1} << (SLOT_BITS * (level + 1)))) {
+        level++;
+    }
+
+    // Beyond the wheel's span: park at the far edge and re-place on cascade
+    uint64_t tick = node.deadlineTick;
+    if (delta >= (uint64_t{1} << (SLOT_BITS * LEVELS))) {
+        tick = currentTick_ + (uint64_t{1} << (SLOT_BITS * LEVELS)) - 1;
+    }
+
+    node.level = level;
+    node.slot = static_cast<uint32_t>((tick >> (SLOT_BITS * level)) & SLOT_MASK);
+    node.prev = NIL;
+    node.next = heads_[static_cast<size_t>(level)][node.slot];
+    if (node.next != NIL) {
+        nodes_[node.next].prev = index;
+    }
+    heads_[static_cast<size_t>(level)][node.slot] = index;
+}
+
+void TimerWheel::unlink(uint32_t index) {
+    auto& node = nodes_[index];
+    if (node.prev != NIL) {
+        nodes_[node.prev].next = node.next;
+    } else {
+        heads_[static_cast<size_t>(node.level)][node.slot] = node.next;
+    }
+    if (node.next != NIL) {
+        nodes_[node.next].prev = node.prev;
+    }
+    node.prev = NIL;
+    node.next = NIL;
+}
+
+void TimerWheel::release(uint32_t index) {
+    auto& node = nodes_[index];
+    node.level = -1;
+    node.key.clear();
+    freeList_.push_back(index);
+    active_--;
+}
+
+void TimerWheel::cascade(int level) {
+    const auto slot = static_cast<uint32_t>((currentTick_ >> (SLOT_BITS * level)) & SLOT_MASK);
+    uint32_t index = heads_[static_cast<size_t>(level)][slot];
+    heads_[static_cast<size_t>(level)][slot] = NIL;
+    while (index != NIL) {
+        const uint32_t next = nodes_[index].next;
+        place(index);
+        index = next;
+    }
+}
+
+}  // namespace qfblotter
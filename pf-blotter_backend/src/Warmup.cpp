@@ -0,0 +1,167 @@
+#include "qfblotter/Warmup.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+
+#include "qfblotter/BarAggregator.hpp"
+#include "qfblotter/MarketSim.hpp"
+#include "qfblotter/OrderStore.hpp"
+#include "qfblotter/StopOrderIndex.hpp"
+#include "qfblotter/TcaEngine.hpp"
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+namespace qfblotter {
+
+namespace {
+constexpr size_t PAGE = 4096;
+constexpr size_t PREFAULT_CHUNK = 16 * 1024 * 1024;  // Below glibc's largest mmap threshold
+
+int64_t nowMs() {
+    using namespace std::chrono;
+    return duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
+}
+
+// Fault in `bytes` of heap and hand it back to malloc without returning it
+// to the kernel, so later allocations land on resident pages. Applies to
+// the calling thread's malloc arena (the main arena at startup).
+size_t prefaultHeap(size_t bytes, bool hugePages, WarmupReport& report) {
+#if defined(__GLIBC__)
+    // Serve chunk-sized requests from the heap rather than mmap, and never
+    // trim the freed top of the heap back to the kernel
+    mallopt(M_MMAP_THRESHOLD, static_cast<int>(PREFAULT_CHUNK * 2));
+    mallopt(M_TRIM_THRESHOLD, static_cast<int>(std::min<size_t>(bytes * 2, INT32_MAX)));
+#else
+    report.warnings.push_back("heap prefault needs glibc malloc tuning; pages are faulted but may be returned");
+#endif
+    std::vector<std::unique_ptr<char, void (*)(void*)>> chunks;
+    size_t faulted = 0;
+    while (faulted < bytes) {
+        const size_t size = std::min(PREFAULT_CHUNK, bytes - faulted);
+        char* chunk = static_cast<char*>(std::malloc(size));
+        if (chunk == nullptr) {
+            report.warnings.push_back("heap prefault stopped at " + std::to_string(faulted) + " bytes");
+            break;
+        }
+        chunks.emplace_back(chunk, std::free);
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+        if (hugePages) {
+            const auto begin = (reinterpret_cast<uintptr_t>(chunk) + PAGE - 1) / PAGE * PAGE;
+            const auto end = (reinterpret_cast<uintptr_t>(chunk) + size) / PAGE * PAGE;
+            if (end > begin && ::madvise(reinterpret_cast<void*>(begin), end - begin, MADV_HUGEPAGE) == 0) {
+                report.hugePages = true;
+            }
+        }
+#endif
+        for (size_t offset = 0; offset < size; offset += PAGE) {
+            static_cast<volatile char*>(chunk)[offset] = 0;
+        }
+        faulted += size;
+    }
+    if (hugePages && !report.hugePages) {
+        report.warnings.push_back("transparent huge pages unavailable");
+    }
+    return faulted;  // Chunks are freed here, into the heap
+}
+
+// One synthetic order lifecycle per iteration on shadow objects: arrival
+// mark, insert, fill attempt, status update, TCA and bars, stop index, with
+// periodic snapshots and stats as the HTTP side would request them
+size_t runSyntheticOrders(const std::vector<std::string>& symbols, size_t count) {
+    if (symbols.empty() || count == 0) {
+        return 0;
+    }
+    OrderStore store;
+    store.reserve(count);
+    MarketSim market(7);
+    market.initSymbols(symbols);
+    TcaEngine tca;
+    BarAggregator bars(symbols);
+    StopOrderIndex stops;
+    std::vector<StopTrigger> triggered;
+
+    size_t fills = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const std::string& symbol = symbols[i % symbols.size()];
+        const char side = (i % 2 == 0) ? '1' : '2';
+        const double mark = market.mark(symbol);
+
+        OrderRecord record;
+        record.clOrdId = "WARMUP-" + std::to_string(i);
+        record.orderId = "W" + std::to_string(i);
+        record.symbol = symbol;
+        record.side = side;
+        record.price = side == '1' ? mark * 1.001 : mark * 0.999;
+        record.quantity = 100;
+        record.leavesQty = 100;
+        record.arrivalPx = mark;
+        record.status = "NEW";
+        record.transactTime = "1970-01-01T00:00:00Z";
+        tca.onArrival(record.clOrdId, symbol, side, mark);
+        store.upsert(record);
+
+        const FillResult fill = market.attemptFill(symbol, side, record.price, record.leavesQty);
+        if (fill.fillQty > 0) {
+            const int leaves = record.quantity - fill.fillQty;
+            store.updateStatus(record.clOrdId, leaves == 0 ? "FILLED" : "PARTIAL", leaves, fill.fillQty, fill.fillPx);
+            tca.onFill(record, fill.fillQty, fill.fillPx);
+            bars.onFill(symbol, fill.fillPx, fill.fillQty, nowMs());
+            ++fills;
+        } else {
+            store.updateStatus(record.clOrdId, "CANCELED", 0, 0, 0.0);
+        }
+
+        stops.add(record.clOrdId, symbol, side, side == '1' ? mark * 1.01 : mark * 0.99);
+        stops.onTick(symbol, mark, triggered);
+        stops.remove(record.clOrdId);
+        triggered.clear();
+
+        if (i % 256 == 255) {
+            (void)store.snapshotString();
+            (void)store.getStats();
+            (void)market.getOrderBook(symbol);
+            (void)tca.summaryJson();
+        }
+    }
+    return fills;
+}
+}  // namespace
+
+WarmupReport runWarmup(const WarmupOptions& options) {
+    const auto start = std::chrono::steady_clock::now();
+    WarmupReport report;
+
+    if (options.lockMemory) {
+#if defined(__linux__)
+        if (::mlockall(MCL_CURRENT | MCL_FUTURE) == 0) {
+            report.memoryLocked = true;
+        } else {
+            report.warnings.push_back(std::string("mlockall failed: ") + std::strerror(errno));
+        }
+#else
+        report.warnings.push_back("mlockall not supported on this platform");
+#endif
+    }
+
+    if (options.prefaultBytes > 0) {
+        report.prefaultedBytes = prefaultHeap(options.prefaultBytes, options.hugePages, report);
+    }
+
+    report.fills = runSyntheticOrders(options.symbols, options.syntheticOrders);
+    report.syntheticOrders = options.symbols.empty() ? 0 : options.syntheticOrders;
+
+    report.elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return report;
+}
+
+}  // namespace qfblotter
@@ -0,0 +1,125 @@
+// Internal crossing benchmark: throughput of resting orders into the
+// per-symbol books, of a matching pass with nothing to cross, and of the
+// matching loop under a stream of overlapping orders (crosses per second
+// and per-pass latency).
+// Usage: qf_crossing_bench [--orders N] [--symbols N] [--batch N]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "qfblotter/CrossingEngine.hpp"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+double elapsedNs(Clock::time_point start) {
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+}
+
+int64_t percentile(std::vector<int64_t>& sorted, double p) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    const auto idx = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1));
+    return sorted[idx];
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+    size_t orders = 200000;
+    size_t symbols = 50;
+    size_t batch = 100;  // Orders arriving between two matching passes
+    for (int i = 1; i + 1 < argc; i += 2) {
+        const std::string arg = argv[i];
+        const auto value = static_cast<size_t>(std::stoul(argv[i + 1]));
+        if (arg == "--orders") orders = value;
+        else if (arg == "--symbols") symbols = value;
+        else if (arg == "--batch") batch = value;
+        else {
+            std::cerr << "Usage: qf_crossing_bench [--orders N] [--symbols N] [--batch N]" << std::endl;
+            return 1;
+        }
+    }
+    if (orders == 0 || symbols == 0 || batch == 0) {
+        std::cerr << "--orders, --symbols and --batch must be positive" << std::endl;
+        return 1;
+    }
+
+    std::vector<std::string> names;
+    for (size_t s = 0; s < symbols; ++s) {
+        names.push_back("SYM" + std::to_string(s));
+    }
+    std::vector<std::string> ids;
+    ids.reserve(orders * 2);
+    for (size_t i = 0; i < orders * 2; ++i) {
+        ids.push_back("ORD" + std::to_string(i));
+    }
+    const auto mid = [](const std::string&) { return 100.0; };
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> ticks(0, 100);  // Limits in cents away from 100
+    std::uniform_int_distribution<int> qty(1, 500);
+
+    // 1. Resting: buys below and sells above 100, so nothing crosses
+    qfblotter::CrossingEngine engine;
+    auto start = Clock::now();
+    for (size_t i = 0; i < orders; ++i) {
+        const bool buy = (i / symbols) % 2 == 0;  // Both sides on every symbol
+        const double px = buy ? 99.99 - ticks(rng) * 0.01 : 100.01 + ticks(rng) * 0.01;
+        engine.upsert(ids[i], names[i % symbols], buy ? '1' : '2', px, qty(rng));
+    }
+    const double restNs = elapsedNs(start) / static_cast<double>(orders);
+
+    // 2. A matching pass over books that all changed but do not overlap, then
+    // one with nothing changed
+    std::vector<qfblotter::Cross> crosses;
+    start = Clock::now();
+    engine.match(mid, crosses);
+    const double dirtyPassNs = elapsedNs(start);
+    constexpr int IDLE_PASSES = 100000;
+    start = Clock::now();
+    for (int i = 0; i < IDLE_PASSES; ++i) {
+        engine.match(mid, crosses);
+    }
+    const double idlePassNs = elapsedNs(start) / IDLE_PASSES;
+
+    // 3. Crossing flow: every arriving order overlaps the far side of the
+    // resting book, matched every `batch` orders
+    std::vector<int64_t> passNs;
+    size_t crossCount = 0;
+    start = Clock::now();
+    for (size_t i = orders; i < orders * 2; ++i) {
+        const bool buy = (i / symbols) % 2 == 0;  // Both sides on every symbol
+        const double px = buy ? 100.01 + ticks(rng) * 0.01 : 99.99 - ticks(rng) * 0.01;
+        engine.upsert(ids[i], names[i % symbols], buy ? '1' : '2', px, qty(rng));
+        if ((i + 1) % batch == 0) {
+            crosses.clear();
+            const auto passStart = Clock::now();
+            engine.match(mid, crosses);
+            passNs.push_back(static_cast<int64_t>(elapsedNs(passStart)));
+            crossCount += crosses.size();
+        }
+    }
+    const double flowNs = elapsedNs(start);
+    std::sort(passNs.begin(), passNs.end());
+
+    std::printf("Crossing engine: %zu resting orders over %zu symbols, matching every %zu arrivals\n",
+                orders, symbols, batch);
+    std::printf("  rest (upsert)          %8.0f ns/order\n", restNs);
+    std::printf("  match, %4zu books dirty %8.0f ns (no overlap)\n", symbols, dirtyPassNs);
+    std::printf("  match, nothing changed %8.1f ns\n", idlePassNs);
+    std::printf("  crossing flow          %8.0f orders/s, %zu crosses (%.0f crosses/s, %llu qty)\n",
+                static_cast<double>(orders) * 1e9 / flowNs, crossCount,
+                static_cast<double>(crossCount) * 1e9 / flowNs,
+                static_cast<unsigned long long>(engine.crossedQty()));
+    std::printf("  match pass             p50 %lld ns, p99 %lld ns, max %lld ns\n",
+                static_cast<long long>(percentile(passNs, 0.50)), static_cast<long long>(percentile(passNs, 0.99)),
+                static_cast<long long>(passNs.empty() ? 0 : passNs.back()));
+    std::printf("  market ticks avoided   %zu (one per crossed leg)\n", crossCount * 2);
+    return 0;
+}
@@ -0,0 +1,117 @@
+// FIX data dictionary benchmark: XML DataDictionary versus the dictionary
+// compiled at build time, for startup (building the dictionary) and for
+// validating inbound messages.
+// Usage: qf_fix_dict_bench [--xml fix/FIX44.xml] [--loads N] [--messages N]
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <quickfix/DataDictionary.h>
+#include <quickfix/Message.h>
+
+#include "qfblotter/FixDictionary.hpp"
+#include "qfblotter/FixValidator.hpp"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+using Fields = std::vector<std::pair<int, std::string>>;
+
+// Wire-format FIX 4.4 message with a valid BodyLength and CheckSum
+std::string buildMessage(const std::string& msgType, const Fields& body) {
+    std::string inner = "35=" + msgType + "\x01" "49=TRADER\x01" "56=SIM\x01" "34=2\x01" "52=20240102-10:11:12.345\x01";
+    for (const auto& [tag, value] : body) {
+        inner += std::to_string(tag) + "=" + value + "\x01";
+    }
+    std::string out = "8=FIX.4.4\x01" "9=" + std::to_string(inner.size()) + "\x01" + inner;
+    unsigned sum = 0;
+    for (const unsigned char c : out) {
+        sum += c;
+    }
+    char checksum[8];
+    std::snprintf(checksum, sizeof(checksum), "%03u", sum % 256);
+    return out + "10=" + checksum + "\x01";
+}
+
+std::vector<std::pair<std::string, std::string>> sampleMessages() {
+    return {
+        {"NewOrderSingle", buildMessage("D", {{11, "ORD-1"}, {1, "ACC"}, {55, "AAPL"}, {54, "1"},
+                                              {60, "20240102-10:11:12.345"}, {38, "100"}, {40, "2"},
+                                              {44, "187.25"}, {59, "0"}})},
+        {"OrderCancelRequest", buildMessage("F", {{41, "ORD-1"}, {11, "CXL-1"}, {55, "AAPL"}, {54, "1"},
+                                                  {60, "20240102-10:11:12.345"}, {38, "100"}})},
+        {"MarketDataRequest", buildMessage("V", {{262, "MD-1"}, {263, "1"}, {264, "1"}, {265, "1"},
+                                                 {267, "3"}, {269, "0"}, {269, "1"}, {269, "2"},
+                                                 {146, "3"}, {55, "AAPL"}, {55, "MSFT"}, {55, "GOOG"}})},
+        {"ExecutionReport", buildMessage("8", {{37, "O-1"}, {11, "ORD-1"}, {17, "E-1"}, {150, "F"},
+                                               {39, "1"}, {55, "AAPL"}, {54, "1"}, {38, "100"},
+                                               {44, "187.25"}, {32, "40"}, {31, "187.20"}, {151, "60"},
+                                               {14, "40"}, {6, "187.20"}, {60, "20240102-10:11:12.345"}})},
+    };
+}
+
+template <typename Fn>
+double nsPerOp(size_t iterations, Fn&& fn) {
+    const auto start = Clock::now();
+    for (size_t i = 0; i < iterations; ++i) {
+        fn();
+    }
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / static_cast<double>(iterations);
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::string xmlPath = "fix/FIX44.xml";
+    size_t loads = 20;
+    size_t messages = 200000;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        const std::string arg = argv[i];
+        if (arg == "--xml") {
+            xmlPath = argv[i + 1];
+        } else if (arg == "--loads") {
+            loads = std::stoul(argv[i + 1]);
+        } else if (arg == "--messages") {
+            messages = std::stoul(argv[i + 1]);
+        }
+    }
+
+    try {
+        std::unique_ptr<FIX::DataDictionary> xml;
+        const double xmlLoadUs = nsPerOp(loads, [&] { xml = std::make_unique<FIX::DataDictionary>(xmlPath); }) / 1000.0;
+        std::shared_ptr<FIX::DataDictionary> compiled;
+        const double compiledLoadUs = nsPerOp(loads, [&] { compiled = qfblotter::buildCompiledDataDictionary(); }) / 1000.0;
+        std::printf("dictionary load (avg of %zu): xml %.0fus, compiled %.0fus (%.1fx)\n", loads, xmlLoadUs,
+                    compiledLoadUs, xmlLoadUs / compiledLoadUs);
+
+        std::printf("%-20s %14s %14s %14s\n", "validate (ns/msg)", "xml", "compiled", "compiled raw");
+        for (const auto& [name, raw] : sampleMessages()) {
+            const FIX::Message xmlParsed(raw, *xml, false);
+            const FIX::Message compiledParsed(raw, *compiled, false);
+            // Check both accept the sample before timing them
+            FIX::DataDictionary::validate(xmlParsed, xml.get(), xml.get());
+            qfblotter::validateCompiled(compiledParsed);
+            if (!qfblotter::validateFixMessage(raw).ok()) {
+                std::cerr << name << " rejected by the compiled validator" << std::endl;
+                return 1;
+            }
+
+            const double xmlNs =
+                nsPerOp(messages, [&] { FIX::DataDictionary::validate(xmlParsed, xml.get(), xml.get()); });
+            const double compiledNs = nsPerOp(messages, [&] { qfblotter::validateCompiled(compiledParsed); });
+            size_t failures = 0;
+            const double rawNs = nsPerOp(messages, [&] { failures += qfblotter::validateFixMessage(raw).ok() ? 0 : 1; });
+            std::printf("%-20s %14.0f %14.0f %14.0f\n", name.c_str(), xmlNs, compiledNs, rawNs);
+            if (failures != 0) {
+                return 1;
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "benchmark failed: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -1,12 +1,21 @@
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <csignal>
+#include <deque>
+#include <functional>
+#include <ctime>
 #include <iomanip>
 #include <iostream>
+#include <memory>
 #include <mutex>
+#include <optional>
+#include <random>
 #include <sstream>
 #include <string>
 #include <thread>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <nlohmann/json.hpp>
@@ -14,24 +23,53 @@
 // Global shutdown flag for signal handling
 namespace {
 std::atomic<bool> g_shutdown{false};
+std::atomic<bool> g_promote{false};  // SIGUSR1 or POST /promote on a standby
 
 void signalHandler(int signum) {
     (void)signum;  // Unused
     g_shutdown.store(true);
 }
+
+void promoteSignalHandler(int signum) {
+    (void)signum;  // Unused
+    g_promote.store(true);
+}
 }  // namespace
-#include <quickfix/FileLog.h>
 #include <quickfix/FileStore.h>
+#include <quickfix/Session.h>
 #include <quickfix/SessionSettings.h>
 #include <quickfix/SocketAcceptor.h>
+#include <quickfix/Values.h>
 
+#include "qfblotter/AdmissionControl.hpp"
+#include "qfblotter/AlgoEngine.hpp"
+#include "qfblotter/AsyncFileLog.hpp"
 #include "qfblotter/AuditLog.hpp"
+#include "qfblotter/BarAggregator.hpp"
+#include "qfblotter/CoarseClock.hpp"
+#include "qfblotter/CrossingEngine.hpp"
+#include "qfblotter/DropCopy.hpp"
+#include "qfblotter/EventScheduler.hpp"
+#include "qfblotter/ExecutionLedger.hpp"
 #include "qfblotter/FixApplication.hpp"
+#include "qfblotter/FixMarketData.hpp"
 #include "qfblotter/HttpServer.hpp"
 #include "qfblotter/Logger.hpp"
 #include "qfblotter/MarketSim.hpp"
+#include "qfblotter/MulticastFeed.hpp"
+#include "qfblotter/OrderExpiry.hpp"
 #include "qfblotter/OrderStore.hpp"
 #include "qfblotter/Persistence.hpp"
+#include "qfblotter/ProcessStats.hpp"
+#include "qfblotter/Replication.hpp"
+#include "qfblotter/RollingStats.hpp"
+#include "qfblotter/Sharding.hpp"
+#include "qfblotter/ShmPublisher.hpp"
+#include "qfblotter/SimClock.hpp"
+#include "qfblotter/SmartOrderRouter.hpp"
+#include "qfblotter/StopOrderIndex.hpp"
+#include "qfblotter/TcaEngine.hpp"
+#include "qfblotter/Warmup.hpp"
 
 namespace {
 
@@ -39,27 +77,80 @@ namespace {
 constexpr int MAX_ORDER_QTY = 10000;
 constexpr double MAX_NOTIONAL = 1'000'000.0;
 
-std::string utc_now_iso() {
-    using namespace std::chrono;
-    auto now = system_clock::now();
-    std::time_t t = system_clock::to_time_t(now);
-    std::tm tm{};
-#if defined(_WIN32)
-    gmtime_s(&tm, &t);
-#else
-    gmtime_r(&t, &tm);
-#endif
-    std::ostringstream oss;
-    oss << std::put_time(&tm, "%Y-%m-%dT%H:%M:%SZ");
-    return oss.str();
+int64_t epoch_ms() {
+    return qfblotter::SimClock::epochMs();
 }
 
-// Fill simulator - runs partial fills in background
+// Blotter snapshots to /events subscribers. In virtual time a snapshot per
+// event would make a simulated day quadratic in its order count, so events
+// only mark the blotter stale and the driver flushes it on a real-time cadence.
+class BlotterPublisher {
+public:
+    BlotterPublisher(qfblotter::OrderStore& store, qfblotter::HttpServer& http, bool conflate)
+        : store_(store), http_(http), conflate_(conflate) {}
+
+    void publish() {
+        if (conflate_) {
+            stale_.store(true, std::memory_order_relaxed);
+            return;
+        }
+        publishTerminal();
+        http_.publishEvent(store_.snapshotString());
+    }
+
+    // Leave the change for the next flush (algo children: one snapshot per
+    // slicing pass, not one per child)
+    void defer() {
+        stale_.store(true, std::memory_order_relaxed);
+    }
+
+    void flush() {
+        if (stale_.exchange(false, std::memory_order_relaxed)) {
+            publishTerminal();
+            http_.publishEvent(store_.snapshotString());
+        }
+    }
+
+    // An order reached a terminal status: named in the `terminal` event
+    // ahead of the next snapshot, so a router evicts its route without
+    // scanning the book. Called under the store lock; only appends.
+    void onTerminal(const std::string& clOrdId) {
+        std::lock_guard<std::mutex> lock(terminalMutex_);
+        terminal_.push_back(clOrdId);
+    }
+
+private:
+    void publishTerminal() {
+        std::vector<std::string> ids;
+        {
+            std::lock_guard<std::mutex> lock(terminalMutex_);
+            ids.swap(terminal_);
+        }
+        if (!ids.empty()) {
+            http_.publishTerminal(nlohmann::json(ids).dump());
+        }
+    }
+
+    qfblotter::OrderStore& store_;
+    qfblotter::HttpServer& http_;
+    const bool conflate_;
+    std::atomic<bool> stale_{false};
+    std::mutex terminalMutex_;
+    std::vector<std::string> terminal_;
+};
+
+// Fill simulator - runs partial fills in background. Resting orders that
+// overlap are first crossed against each other (at mid, no market tick);
+// what is left is offered to the simulated market.
 class FillSimulator {
 public:
+    using FillListener = qfblotter::FixApplication::FillListener;
+
     FillSimulator(qfblotter::OrderStore& store, qfblotter::MarketSim& market,
-                  qfblotter::HttpServer& http)
-        : store_(store), market_(market), http_(http), running_(false) {}
+                  BlotterPublisher& blotter, qfblotter::FixApplication& app, FillListener onFill,
+                  qfblotter::CrossingEngine* crossing, qfblotter::SmartOrderRouter* router)
+        : store_(store), market_(market), blotter_(blotter), app_(app), onFill_(std::move(onFill)),
+          crossing_(crossing), router_(router), running_(false) {}
 
     void start() {
         running_ = true;
@@ -73,40 +164,122 @@ public:
         }
     }
 
+    // One pass: internal crosses, then every open order against the market
+    // (or out to the venues). The thread runs one every 500ms; in virtual
+    // time the simulation driver does.
+    void pass() {
+        bool anyFilled = false;
+
+        if (crossing_) {
+            crosses_.clear();
+            crossing_->match([this](const std::string& symbol) { return market_.midPrice(symbol); }, crosses_);
+            for (const auto& cross : crosses_) {
+                anyFilled |= applyCross(cross);
+            }
+        }
+
+        // Get all open orders
+        auto openOrders = store_.getOpenOrders();
+        
+        for (const auto& order : openOrders) {
+            if (router_) {
+                routeOrder(order);  // Fills come back from the venues
+                continue;
+            }
+            auto result = market_.attemptFill(order.symbol, order.side, order.price, order.leavesQty);
+            
+            if (result.fillQty > 0) {
+                applyFill(order, result.fillQty, result.fillPx, qfblotter::VENUE_MARKET);
+                anyFilled = true;
+            }
+        }
+        
+        anyFilled |= venueFilled_.exchange(false);
+        if (anyFilled) {
+            blotter_.publish();
+        }
+    }
+
 private:
     void run() {
         while (running_) {
             std::this_thread::sleep_for(std::chrono::milliseconds(500));  // Check every 500ms
-            
-            // Get all open orders
-            auto openOrders = store_.getOpenOrders();
-            bool anyFilled = false;
-            
-            for (const auto& order : openOrders) {
-                auto result = market_.attemptFill(order.symbol, order.side, order.price, order.leavesQty);
-                
-                if (result.fillQty > 0) {
-                    int newCumQty = order.cumQty + result.fillQty;
-                    int newLeavesQty = order.quantity - newCumQty;
-                    
-                    // Calculate VWAP (volume-weighted average price)
-                    double newAvgPx = (order.avgPx * order.cumQty + result.fillPx * result.fillQty) / newCumQty;
-                    
-                    std::string newStatus = (newLeavesQty <= 0) ? "FILLED" : "PARTIAL";
-                    store_.updateStatus(order.clOrdId, newStatus, newLeavesQty, newCumQty, newAvgPx);
-                    anyFilled = true;
-                }
+            pass();
+        }
+    }
+
+    // Orders with slices still out at a venue wait for them to return
+    void routeOrder(const qfblotter::OrderRecord& order) {
+        router_->route(order.clOrdId, order.symbol, order.side, order.price, order.leavesQty,
+                       [this](const qfblotter::VenueExecution& execution) { return onVenueExecution(execution); });
+    }
+
+    // Runs on the scheduler thread. The order may have been canceled or
+    // crossed while the slice was out: a fill beyond its remaining quantity
+    // is not booked, as a venue execution that lost the race would be busted.
+    int onVenueExecution(const qfblotter::VenueExecution& execution) {
+        if (execution.fillQty <= 0) {
+            return 0;
+        }
+        std::lock_guard<std::mutex> lock(fillMutex_);
+        auto order = store_.get(execution.clOrdId);
+        if (!order || (order->status != "NEW" && order->status != "PARTIAL")) {
+            return 0;
+        }
+        const int qty = std::min(execution.fillQty, order->leavesQty);
+        applyFill(*order, qty, execution.fillPx, execution.venue);
+        venueFilled_ = true;  // Published with the next pass
+        return qty;
+    }
+
+    // Both legs must still be open: one canceled since the match voids the
+    // cross, and the other's quantity goes back into the book
+    bool applyCross(const qfblotter::Cross& cross) {
+        std::lock_guard<std::mutex> lock(fillMutex_);  // Venue fills land concurrently
+        auto buy = store_.get(cross.buyClOrdId);
+        auto sell = store_.get(cross.sellClOrdId);
+        const auto open = [](const std::optional<qfblotter::OrderRecord>& order) {
+            return order && (order->status == "NEW" || order->status == "PARTIAL");
+        };
+        if (!open(buy) || !open(sell)) {
+            // The survivor goes back at its original time priority
+            if (buy) {
+                crossing_->restore(*buy, cross.buySeq);
             }
-            
-            if (anyFilled) {
-                http_.publishEvent(store_.snapshotString());
+            if (sell) {
+                crossing_->restore(*sell, cross.sellSeq);
             }
+            return false;
         }
+        const int qty = std::min({cross.qty, buy->leavesQty, sell->leavesQty});
+        applyFill(*buy, qty, cross.price, qfblotter::VENUE_INTERNAL);
+        applyFill(*sell, qty, cross.price, qfblotter::VENUE_INTERNAL);
+        return true;
+    }
+
+    void applyFill(const qfblotter::OrderRecord& order, int fillQty, double fillPx, const std::string& venue) {
+        int newCumQty = order.cumQty + fillQty;
+        int newLeavesQty = order.quantity - newCumQty;
+
+        // Calculate VWAP (volume-weighted average price)
+        double newAvgPx = (order.avgPx * order.cumQty + fillPx * fillQty) / newCumQty;
+
+        std::string newStatus = (newLeavesQty <= 0) ? "FILLED" : "PARTIAL";
+        store_.updateStatus(order.clOrdId, newStatus, newLeavesQty, newCumQty, newAvgPx);
+        onFill_(order, fillQty, fillPx, venue);
+        app_.reportFill(order, fillQty, fillPx);
     }
 
     qfblotter::OrderStore& store_;
     qfblotter::MarketSim& market_;
-    qfblotter::HttpServer& http_;
+    BlotterPublisher& blotter_;
+    qfblotter::FixApplication& app_;
+    FillListener onFill_;
+    qfblotter::CrossingEngine* crossing_;  // nullptr: every order fills against the market
+    qfblotter::SmartOrderRouter* router_;  // Set: resting orders route to the simulated venues
+    std::mutex fillMutex_;                 // Read-modify-write of an order's fill state
+    std::atomic<bool> venueFilled_{false};
+    std::vector<qfblotter::Cross> crosses_;
     std::atomic<bool> running_;
     std::thread thread_;
 };
@@ -115,8 +288,11 @@ private:
 class MarketDataFeed {
 public:
     MarketDataFeed(qfblotter::MarketSim& market, qfblotter::HttpServer& http,
+                   qfblotter::BarAggregator& bars, qfblotter::AlgoEngine& algo, qfblotter::TcaEngine& tca,
+                   qfblotter::MulticastPublisher* multicast, qfblotter::ReplicationPrimary* replication,
                    const std::vector<std::string>& symbols)
-        : market_(market), http_(http), symbols_(symbols), running_(false) {}
+        : market_(market), http_(http), bars_(bars), algo_(algo), tca_(tca), multicast_(multicast),
+          replication_(replication), symbols_(symbols), running_(false) {}
 
     void start() {
         running_ = true;
@@ -130,33 +306,147 @@ public:
         }
     }
 
+    // One tick on every symbol, published as a batch; the thread runs one
+    // every 250ms, the simulation driver does in virtual time
+    void tick() {
+        nlohmann::json ticks = nlohmann::json::array();
+        std::vector<qfblotter::FeedTick> batch;
+        const int64_t nowMs = epoch_ms();
+        const std::string timestamp = qfblotter::CoarseClock::isoSeconds();  // One per batch
+        
+        for (const auto& symbol : symbols_) {
+            double price = market_.nextTick(symbol);
+            int volume = 100 * lots_(rng_);  // Simulated print size, the POV and VWAP benchmarks
+            bars_.onTick(symbol, price, nowMs);
+            algo_.onMarketVolume(symbol, volume);
+            tca_.onMarketPrint(symbol, price, volume);
+            nlohmann::json tick;
+            tick["symbol"] = symbol;
+            tick["price"] = std::round(price * 100.0) / 100.0;
+            tick["volume"] = volume;
+            tick["timestamp"] = timestamp;
+            ticks.push_back(tick);
+            batch.push_back({symbol, price, volume});
+        }
+        
+        http_.publishMarketData(ticks.dump());
+        if (multicast_) {
+            multicast_->publish(batch);  // Every symbol in one or a few packets
+        }
+        if (replication_) {
+            replication_->publishMarketData(ticks);  // Read replicas fan out the same batch
+        }
+    }
+
 private:
     void run() {
         while (running_) {
             std::this_thread::sleep_for(std::chrono::milliseconds(250));  // 4 ticks per second
-            
-            nlohmann::json ticks = nlohmann::json::array();
-            
-            for (const auto& symbol : symbols_) {
-                double price = market_.nextTick(symbol);
-                nlohmann::json tick;
-                tick["symbol"] = symbol;
-                tick["price"] = std::round(price * 100.0) / 100.0;
-                tick["timestamp"] = utc_now_iso();
-                ticks.push_back(tick);
-            }
-            
-            http_.publishMarketData(ticks.dump());
+            tick();
         }
     }
 
     qfblotter::MarketSim& market_;
     qfblotter::HttpServer& http_;
+    qfblotter::BarAggregator& bars_;
+    qfblotter::AlgoEngine& algo_;
+    qfblotter::TcaEngine& tca_;
+    qfblotter::MulticastPublisher* multicast_;
+    qfblotter::ReplicationPrimary* replication_;
     std::vector<std::string> symbols_;
+    std::mt19937 rng_{7};
+    std::uniform_int_distribution<int> lots_{1, 20};
     std::atomic<bool> running_;
     std::thread thread_;
 };
 
+// Stop activation - driven by every MarketSim tick. Triggered stops become
+// market orders (filled at once) and stop-limits become resting limit orders.
+// The market fill ticks again; ticks raised while this thread is already
+// draining only enqueue, so cascading triggers never recurse.
+class StopActivator {
+public:
+    using FillListener = qfblotter::FixApplication::FillListener;
+
+    StopActivator(qfblotter::OrderStore& store, qfblotter::MarketSim& market,
+                  qfblotter::StopOrderIndex& index, qfblotter::AuditLog& audit,
+                  qfblotter::FixApplication& app, BlotterPublisher& blotter, FillListener onFill)
+        : store_(store), market_(market), index_(index), audit_(audit), app_(app), blotter_(blotter),
+          onFill_(std::move(onFill)) {}
+
+    void onTick(const std::string& symbol, double price) {
+        std::vector<qfblotter::StopTrigger> triggered;
+        index_.onTick(symbol, price, triggered);
+        if (triggered.empty()) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (auto& trigger : triggered) {
+                pending_.push_back(std::move(trigger));
+            }
+        }
+        if (draining_) {
+            return;
+        }
+        draining_ = true;
+        drain();
+        draining_ = false;
+        blotter_.publish();
+    }
+
+private:
+    void drain() {
+        while (true) {
+            qfblotter::StopTrigger trigger;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (pending_.empty()) {
+                    return;
+                }
+                trigger = std::move(pending_.front());
+                pending_.pop_front();
+            }
+            activate(trigger);
+        }
+    }
+
+    void activate(const qfblotter::StopTrigger& trigger) {
+        // Canceled or expired since it was indexed
+        auto activated = store_.activateStop(trigger.clOrdId);
+        if (!activated.has_value()) {
+            return;
+        }
+        const auto& order = activated.value();
+
+        audit_.log(qfblotter::AuditLog::EventType::ORDER_TRIGGERED, order.clOrdId,
+            "stopPx=" + std::to_string(order.stopPx) + ",triggerPx=" + std::to_string(trigger.triggerPx));
+        app_.onStopTriggered(order);
+
+        if (order.orderType == qfblotter::ORD_MARKET) {
+            double fillPrice = market_.nextTick(order.symbol);
+            store_.updateStatus(order.clOrdId, "FILLED", 0, order.leavesQty, fillPrice);
+            onFill_(order, order.leavesQty, fillPrice, qfblotter::VENUE_MARKET);
+            app_.reportFill(order, order.leavesQty, fillPrice);
+            audit_.log(qfblotter::AuditLog::EventType::ORDER_FILLED, order.clOrdId,
+                "fillPx=" + std::to_string(fillPrice) + ",fillQty=" + std::to_string(order.leavesQty));
+        }
+        // Stop-limit: now a NEW limit order, worked by the FillSimulator
+    }
+
+    inline static thread_local bool draining_ = false;
+
+    qfblotter::OrderStore& store_;
+    qfblotter::MarketSim& market_;
+    qfblotter::StopOrderIndex& index_;
+    qfblotter::AuditLog& audit_;
+    qfblotter::FixApplication& app_;
+    BlotterPublisher& blotter_;
+    FillListener onFill_;
+    std::mutex mutex_;
+    std::deque<qfblotter::StopTrigger> pending_;
+};
+
 }  // namespace
 
 int main(int argc, char** argv) {
@@ -170,27 +460,387 @@ int main(int argc, char** argv) {
         httpPort = std::stoi(argv[2]);
     }
 
+    qfblotter::Logger::ShutdownGuard logShutdown;  // Flushes the async logger however main exits
     try {
         qfblotter::Logger::init("qf_gateway", "config/log/gateway.log");
         auto log = qfblotter::Logger::get();
+        qfblotter::CoarseClock::start();  // Audit, FIX log and tick timestamps
 
         FIX::SessionSettings settings(cfgPath);
+
+        // Virtual time (VirtualTime=Y): market ticks, fill passes, venue
+        // latency, expiry and algo timers and all timestamps run on SimClock,
+        // driven from one thread as fast as the work allows, for
+        // VirtualSessionHours of simulated time from VirtualStartTime (UTC
+        // today, default now). Set before anything reads the clock.
+        const bool virtualTime = settings.get().has("VirtualTime") && settings.get().getBool("VirtualTime");
+        int64_t virtualEndUs = 0;
+        if (virtualTime) {
+            const auto& dict = settings.get();
+            if (dict.has("ReplicationPrimaryHost")) {
+                throw std::runtime_error("VirtualTime cannot run as a replication standby");
+            }
+            int64_t startMs = epoch_ms();
+            if (dict.has("VirtualStartTime")) {
+                constexpr int64_t DAY_MS = 86'400'000;
+                startMs = qfblotter::OrderExpiry::nextDailyCutoffMs(dict.getString("VirtualStartTime"),
+                                                                    startMs - startMs % DAY_MS - 1);
+            }
+            const int64_t hours = dict.has("VirtualSessionHours") ? dict.getInt("VirtualSessionHours") : 8;
+            qfblotter::SimClock::setVirtual(startMs);
+            virtualEndUs = qfblotter::SimClock::steadyUs() + hours * 3'600'000'000LL;
+            std::cout << "[GATEWAY] Virtual time: " << hours << "h from "
+                      << qfblotter::CoarseClock::isoSeconds() << std::endl;
+        }
         qfblotter::OrderStore store;
+        // Pre-size the order pool so a session's orders never grow the map
+        store.reserve(static_cast<size_t>(
+            settings.get().has("OrderStoreReserve") ? settings.get().getInt("OrderStoreReserve") : 100000));
         qfblotter::MarketSim market(42);
         qfblotter::AuditLog audit("config/log/audit.log");
+
+        // Symbols with a live market data feed and intraday bar history
+        std::vector<std::string> defaultSymbols = {"AAPL", "GOOGL", "MSFT", "NVDA", "TSLA", "AMZN"};
+
+        // One of ShardCount gateways behind qf_router: only the symbols the
+        // ring assigns to ShardIndex are simulated and accepted over HTTP
+        std::optional<qfblotter::ShardRing> shardRing;
+        size_t shardIndex = 0;
+        if (settings.get().has("ShardCount") && settings.get().getInt("ShardCount") > 1) {
+            const auto shardCount = static_cast<size_t>(settings.get().getInt("ShardCount"));
+            shardIndex = settings.get().has("ShardIndex") ? static_cast<size_t>(settings.get().getInt("ShardIndex")) : 0;
+            if (shardIndex >= shardCount) {
+                throw std::runtime_error("ShardIndex must be below ShardCount");
+            }
+            shardRing.emplace(qfblotter::defaultShardNames(shardCount));
+            std::erase_if(defaultSymbols, [&](const std::string& symbol) {
+                return shardRing->shardFor(symbol) != shardIndex;
+            });
+            std::cout << "[GATEWAY] Shard " << shardIndex << " of " << shardCount << " ("
+                      << defaultSymbols.size() << " simulated symbols)" << std::endl;
+        }
+        auto ownsSymbol = [&shardRing, shardIndex](const std::string& symbol) {
+            return !shardRing || shardRing->shardFor(symbol) == shardIndex;
+        };
+        qfblotter::BarAggregator bars(defaultSymbols);
+        qfblotter::TcaEngine tca;
+        qfblotter::StopOrderIndex stops;
+        qfblotter::AlgoEngine algo;
+
+        // Orders leave the live TCA table when they end without filling
+        // completely (a completing fill retires them in onFill)
+        store.addChangeListener([&tca](const qfblotter::OrderRecord& record) {
+            if (record.status == "CANCELED" || record.status == "EXPIRED" || record.status == "REJECTED") {
+                tca.onTerminal(record.clOrdId);
+            }
+        });
+
+        // Algo children that end without filling hand the unfilled quantity
+        // back to their parent's schedule
+        store.addChangeListener([&algo](const qfblotter::OrderRecord& record) {
+            if (!record.parentId.empty() &&
+                (record.status == "CANCELED" || record.status == "EXPIRED" || record.status == "REJECTED")) {
+                algo.onChildDone(record.clOrdId, record.quantity - record.cumQty);
+            }
+        });
+
+        // Overlapping resting limit orders cross internally before reaching the
+        // simulated market (InternalCrossing=N disables). Registered before
+        // recovery, so recovered open orders rest in its books too.
+        const bool crossingEnabled = !settings.get().has("InternalCrossing") ||
+                                     settings.get().getBool("InternalCrossing");
+        qfblotter::CrossingEngine crossing;
+        if (crossingEnabled) {
+            store.addChangeListener([&crossing](const qfblotter::OrderRecord& record) {
+                crossing.onOrderChange(record);
+            });
+        }
+
+        // Simulated delays: venue latency, and in virtual time every periodic
+        // simulation step too
+        qfblotter::EventScheduler scheduler;
+
+        // Smart order routing (SmartOrderRouting=Y): resting orders are split
+        // across simulated Venues by price, fee and latency instead of filling
+        // against MarketSim in-process. Slices in flight are scheduler events,
+        // so venue latency costs one dispatcher thread however many are out.
+        std::unique_ptr<qfblotter::SmartOrderRouter> router;
+        if (settings.get().has("SmartOrderRouting") && settings.get().getBool("SmartOrderRouting")) {
+            const auto& dict = settings.get();
+            const std::string venues = dict.has("Venues") ? dict.getString("Venues")
+                                                          : "ARCA:400:80:0.0030,BATS:900:250:-0.0020,IEX:650:40:0.0009";
+            const double penalty = dict.has("SorLatencyPenaltyBpsPerMs") ? dict.getDouble("SorLatencyPenaltyBpsPerMs") : 0.5;
+            router = std::make_unique<qfblotter::SmartOrderRouter>(
+                qfblotter::parseVenues(venues), scheduler,
+                [&market](const std::string& symbol) { return market.mark(symbol); }, penalty);
+            std::cout << "[GATEWAY] Smart order routing across " << router->venueCount() << " venues" << std::endl;
+        }
+
+        // Every execution is appended to the ledger as it happens: the order
+        // record only keeps the running cumQty/avgPx
+        qfblotter::ExecutionLedger executions;
+
+        // Every execution, whichever path produced it, passes through here.
+        // Child fills roll up into their algo parent in O(1).
+        auto onFill = [&bars, &tca, &algo, &store, &executions](const qfblotter::OrderRecord& order, int fillQty,
+                                                                double fillPx, const std::string& venue) {
+            executions.append(order, fillQty, fillPx, qfblotter::SimClock::epochUs(), venue);
+            bars.onFill(order.symbol, fillPx, fillQty, epoch_ms());
+            tca.onFill(order, fillQty, fillPx);
+            if (auto parent = algo.onChildFill(order.clOrdId, fillQty, fillPx)) {
+                store.updateStatus(parent->parentId, parent->complete ? "FILLED" : qfblotter::STATUS_WORKING,
+                                   parent->leavesQty, parent->cumQty, parent->avgPx);
+            }
+        };
         
+        // A hot standby or read replica (ReplicationPrimaryHost=...) mirrors
+        // the primary's journal instead of recovering from disk. A standby is
+        // read-only until promoted; a replica (ReadReplica=Y) only serves reads.
+        const bool standbyMode = settings.get().has("ReplicationPrimaryHost");
+        const bool readReplica = standbyMode && settings.get().has("ReadReplica") &&
+                                 settings.get().getBool("ReadReplica");
+
         // Persistence layer - saves orders every 5 seconds and on shutdown
-        qfblotter::PersistenceManager persistence("data/orders.json", 5);
+        const std::string persistencePath = settings.get().has("PersistencePath")
+            ? settings.get().getString("PersistencePath") : "data/orders.json";
+        qfblotter::PersistenceManager persistence(persistencePath, 5);
         
         // Load existing orders from last session
-        int loadedOrders = persistence.load([&store](const qfblotter::OrderRecord& record) {
+        int loadedOrders = standbyMode ? 0 : persistence.load([&store](qfblotter::OrderRecord record) {
+            // Algo schedules are not persisted; parents from the last session stop working
+            if (record.status == qfblotter::STATUS_WORKING) {
+                record.status = "CANCELED";
+                record.leavesQty = 0;
+            }
             store.upsert(record);
         });
         if (loadedOrders > 0) {
             std::cout << "[GATEWAY] Recovered " << loadedOrders << " orders from previous session" << std::endl;
         }
+
+        // Rolling 1m/5m/session flow and latency (/stats?window=60s). Fed by
+        // live changes only: attached after recovery, or on promotion.
+        qfblotter::RollingStats flowStats;
+        if (!standbyMode) {
+            store.setFlowStats(&flowStats);
+        }
+
+        // Shared-memory feed for co-located consumers (SharedMemoryName=/name).
+        // Attached after recovery so the ring only carries live changes.
+        std::unique_ptr<qfblotter::ShmPublisher> shmFeed;
+        if (settings.get().has("SharedMemoryName")) {
+            const uint32_t shmSlots = settings.get().has("SharedMemorySlots")
+                ? static_cast<uint32_t>(settings.get().getInt("SharedMemorySlots")) : 65536;
+            try {
+                shmFeed = std::make_unique<qfblotter::ShmPublisher>(
+                    settings.get().getString("SharedMemoryName"), shmSlots);
+                store.addChangeListener([feed = shmFeed.get()](const qfblotter::OrderRecord& record) {
+                    feed->publishOrder(record);
+                });
+                market.addTickListener([feed = shmFeed.get()](const std::string& symbol, double price) {
+                    feed->publishTick(symbol, price);
+                });
+                std::cout << "[GATEWAY] Shared-memory feed on " << settings.get().getString("SharedMemoryName")
+                          << " (" << shmFeed->slotCount() << " slots)" << std::endl;
+            } catch (const std::exception& ex) {
+                std::cerr << "[GATEWAY] Shared-memory feed disabled: " << ex.what() << std::endl;
+            }
+        }
+
+        // Next expected sequence numbers of every FIX session that exists yet
+        auto fixSeqStates = [&settings]() {
+            std::vector<qfblotter::FixSeqState> states;
+            for (const auto& sessionID : settings.getSessions()) {
+                if (auto* session = FIX::Session::lookupSession(sessionID)) {
+                    states.push_back({sessionID.toString(), session->getExpectedSenderNum(),
+                                      session->getExpectedTargetNum()});
+                }
+            }
+            return states;
+        };
+
+        // Journal shipping to a hot standby (ReplicationListenPort=...). Every
+        // order change and tick is streamed; FIX sequence numbers are polled.
+        std::unique_ptr<qfblotter::ReplicationPrimary> replicationPrimary;
+        if (settings.get().has("ReplicationListenPort")) {
+            replicationPrimary = std::make_unique<qfblotter::ReplicationPrimary>(
+                static_cast<uint16_t>(settings.get().getInt("ReplicationListenPort")),
+                [&store, &market, &fixSeqStates]() {
+                    qfblotter::ReplicationSnapshot snap;
+                    snap.orders = store.getAll();
+                    snap.prices = market.lastPrices();
+                    snap.fixSeqs = fixSeqStates();
+                    return snap;
+                });
+            store.addChangeListener([primary = replicationPrimary.get()](const qfblotter::OrderRecord& record) {
+                primary->publishOrder(record);
+            });
+            // Journalled under the market lock, like order changes under the
+            // store lock, so ticks replicate in price order and ahead of the
+            // fills priced off them
+            market.setTickJournal([primary = replicationPrimary.get()](const std::string& symbol, double price) {
+                primary->publishTick(symbol, price);
+            });
+        }
+
+        std::unique_ptr<qfblotter::ReplicationStandby> replicationStandby;
+        std::atomic<bool> promoted{false};
         
         qfblotter::HttpServer http(httpPort, [&store]() { return store.snapshotString(); });
+        BlotterPublisher blotter(store, http, virtualTime);
+        // A cached /snapshot must not hide an order the client just wrote
+        store.addChangeListener([&http](const qfblotter::OrderRecord&) { http.invalidateCache("/snapshot"); });
+        if (shardRing) {
+            store.addChangeListener([&blotter](const qfblotter::OrderRecord& record) {
+                if (record.status == "FILLED" || record.status == "CANCELED" || record.status == "EXPIRED" ||
+                    record.status == "REJECTED") {
+                    blotter.onTerminal(record.clOrdId);
+                }
+            });
+        }
+        http.setRateLimits(
+            settings.get().has("HttpOrderRateLimit") ? settings.get().getInt("HttpOrderRateLimit") : 60,
+            settings.get().has("HttpCancelRateLimit") ? settings.get().getInt("HttpCancelRateLimit") : 30);
+        // Read endpoints coalesce concurrent requests; HttpCache<Endpoint>Ms
+        // also caches the result (e.g. HttpCacheStatsMs=250). A cached
+        // /snapshot is dropped on every order change
+        for (const auto& [key, path] : {std::pair<const char*, const char*>{"HttpCacheSnapshotMs", "/snapshot"},
+                                        {"HttpCacheStatsMs", "/stats"},
+                                        {"HttpCacheOrderBookMs", "/orderbook"},
+                                        {"HttpCacheHistoryMs", "/history"},
+                                        {"HttpCacheTcaMs", "/tca"}}) {
+            if (settings.get().has(key)) {
+                http.setCacheTtl(path, std::chrono::milliseconds(settings.get().getInt(key)));
+            }
+        }
+
+        // DAY orders expire at the FIX session end time (UTC)
+        const std::string sessionEndTime = settings.get().has("EndTime")
+            ? settings.get().getString("EndTime") : "23:59:59";
+
+        qfblotter::FixApplication app(store, market, [&http](const std::string& payload) {
+            http.publishEvent(payload);
+        });
+        app.setFillListener(onFill);
+        app.setSessionEndTime(sessionEndTime);
+        if (shardRing) {
+            app.setSymbolFilter(ownsSymbol);
+        }
+        // FIX 4.4 dictionary compiled at build time instead of the XML
+        // DataDictionary (which UseDataDictionary=Y would load)
+        app.setCompiledDictionary(settings.get().has("CompiledDataDictionary") &&
+                                  settings.get().getBool("CompiledDataDictionary"));
+
+        // Drop-copy sessions are marked DropCopy=Y in the FIX settings
+        const size_t dropCopyCapacity = settings.get().has("DropCopyQueueSize")
+            ? static_cast<size_t>(settings.get().getInt("DropCopyQueueSize")) : 16384;
+        qfblotter::DropCopy dropCopy(dropCopyCapacity);
+        for (const auto& sessionID : settings.getSessions()) {
+            const auto& dict = settings.get(sessionID);
+            if (dict.has("DropCopy") && dict.getBool("DropCopy")) {
+                dropCopy.addSession(sessionID);
+            }
+        }
+        app.setDropCopy(&dropCopy);
+
+        // Admission control for HTTP and FIX order entry (AdmissionControl=N
+        // to disable): bounded concurrency, cancels first, and new orders shed
+        // with a retry hint while the event stream, drop copy or audit log
+        // falls behind
+        qfblotter::AdmissionControl::Options admissionOptions;
+        if (settings.get().has("AdmissionMaxInFlight")) {
+            admissionOptions.maxInFlight = static_cast<size_t>(settings.get().getInt("AdmissionMaxInFlight"));
+        }
+        if (settings.get().has("AdmissionMaxQueued")) {
+            admissionOptions.maxQueued = static_cast<size_t>(settings.get().getInt("AdmissionMaxQueued"));
+        }
+        if (settings.get().has("AdmissionMaxQueueWaitMs")) {
+            admissionOptions.maxQueueWait = std::chrono::milliseconds(settings.get().getInt("AdmissionMaxQueueWaitMs"));
+        }
+        if (settings.get().has("AdmissionMaxCancelWaitMs")) {
+            admissionOptions.maxCancelWait = std::chrono::milliseconds(settings.get().getInt("AdmissionMaxCancelWaitMs"));
+        }
+        const size_t eventBacklogLimit = settings.get().has("AdmissionEventBacklog")
+            ? static_cast<size_t>(settings.get().getInt("AdmissionEventBacklog")) : 1024;
+        const size_t auditBacklogBytes = (settings.get().has("AdmissionAuditBacklogKB")
+            ? static_cast<size_t>(settings.get().getInt("AdmissionAuditBacklogKB")) : 256) * 1024;
+        qfblotter::AdmissionControl admission(admissionOptions);
+        admission.addQueue("events", [&http]() { return http.eventBacklog(); }, eventBacklogLimit);
+        admission.addQueue("dropCopy", [&dropCopy]() { return dropCopy.queued(); }, dropCopyCapacity / 2);
+        admission.addQueue("audit", [&audit]() { return static_cast<size_t>(audit.writer().backlog()); },
+                           auditBacklogBytes);
+        if (!settings.get().has("AdmissionControl") || settings.get().getBool("AdmissionControl")) {
+            http.setAdmissionControl(&admission);
+            app.setAdmissionControl(&admission);
+        }
+
+        // Stop triggers are checked on every tick, whichever path produced it
+        StopActivator stopActivator(store, market, stops, audit, app, blotter, onFill);
+        market.addTickListener([&stopActivator](const std::string& symbol, double price) {
+            stopActivator.onTick(symbol, price);
+        });
+
+        // FIX market data: W on request, then conflated X per subscription
+        const int64_t mdConflationMs = settings.get().has("MarketDataConflationMs")
+            ? settings.get().getInt("MarketDataConflationMs") : 100;
+        qfblotter::FixMarketData fixMarketData(market, mdConflationMs);
+        app.setMarketData(&fixMarketData);
+        market.addTickListener([&fixMarketData](const std::string& symbol, double price) {
+            fixMarketData.onTick(symbol, price);
+        });
+
+        // DAY/GTD expiry - each due batch is one store update and one publish
+        qfblotter::OrderExpiry expiry([&](const std::vector<std::string>& clOrdIds) {
+            auto expired = store.expireOrders(clOrdIds);
+            if (expired.empty()) {
+                return;
+            }
+            std::vector<std::string> expiredIds;
+            expiredIds.reserve(expired.size());
+            for (const auto& record : expired) {
+                expiredIds.push_back(record.clOrdId);
+                if (record.stopPx > 0.0) {
+                    stops.remove(record.clOrdId);
+                }
+            }
+            audit.logBatch(qfblotter::AuditLog::EventType::ORDER_EXPIRED, expiredIds, "reason=timeInForce");
+            app.onOrdersExpired(expired);
+            blotter.publish();
+        });
+
+        // A FIX cancel drops the order's expiry timer and stop trigger now,
+        // not when they come due
+        app.setCancelListener([&expiry, &stops](const qfblotter::OrderRecord& record) {
+            expiry.cancel(record.clOrdId);
+            stops.remove(record.clOrdId);
+        });
+
+        app.setNewOrderListener([&tca, &expiry, &stops](const qfblotter::OrderRecord& record) {
+            tca.onArrival(record.clOrdId, record.symbol, record.side, record.arrivalPx);
+            if (record.status == qfblotter::STATUS_PENDING_STOP) {
+                stops.add(record.clOrdId, record.symbol, record.side, record.stopPx);
+            }
+            if (record.expireTimeMs > 0) {
+                expiry.schedule(record.clOrdId, record.expireTimeMs);
+            }
+        });
+
+        // Re-arm expiries and stop triggers for orders recovered from the
+        // previous session, or replicated from the primary on promotion
+        auto rearmOpenOrders = [&store, &expiry, &stops]() {
+            for (const auto& order : store.getOpenOrders()) {
+                if (order.expireTimeMs > 0) {
+                    expiry.schedule(order.clOrdId, order.expireTimeMs);
+                }
+            }
+            for (const auto& order : store.getPendingStops()) {
+                stops.add(order.clOrdId, order.symbol, order.side, order.stopPx);
+                if (order.expireTimeMs > 0) {
+                    expiry.schedule(order.clOrdId, order.expireTimeMs);
+                }
+            }
+        };
+        rearmOpenOrders();
         
         audit.logSystemEvent("GATEWAY_START", "Gateway starting on port " + std::to_string(httpPort));
 
@@ -202,8 +852,9 @@ int main(int argc, char** argv) {
             return "UI_ORD" + std::to_string(uiOrderCounter.fetch_add(1));
         };
 
-        // Order handler for UI submissions
-        http.setOrderHandler([&](const qfblotter::OrderRequest& req, std::string& errorMsg) -> bool {
+        // Order handler for UI submissions and algo child orders
+        auto submitOrder = [&](const qfblotter::OrderRequest& req, std::string& errorMsg,
+                               bool publish = true) -> bool {
             // Validation
             if (req.symbol.empty()) {
                 errorMsg = "Symbol is required";
@@ -217,19 +868,37 @@ int main(int argc, char** argv) {
                 errorMsg = "Quantity must be positive";
                 return false;
             }
-            // Price check - only for limit orders (orderType '2')
-            if (req.orderType != '1' && req.price <= 0.0) {
+            // Price check - only for limit and stop-limit orders
+            const bool isStopOrder = (req.orderType == qfblotter::ORD_STOP ||
+                                      req.orderType == qfblotter::ORD_STOP_LIMIT);
+            if ((req.orderType == qfblotter::ORD_LIMIT || req.orderType == qfblotter::ORD_STOP_LIMIT) &&
+                req.price <= 0.0) {
                 errorMsg = "Price must be positive for Limit orders";
                 return false;
             }
+            if (isStopOrder && req.stopPrice <= 0.0) {
+                errorMsg = "Stop price must be positive for Stop orders";
+                return false;
+            }
+            if (isStopOrder && (req.timeInForce == qfblotter::TIF_IOC || req.timeInForce == qfblotter::TIF_FOK)) {
+                errorMsg = "IOC/FOK not supported for Stop orders";
+                return false;
+            }
             if (req.quantity > MAX_ORDER_QTY) {
                 errorMsg = "Order quantity exceeds limit (" + std::to_string(MAX_ORDER_QTY) + ")";
                 return false;
             }
+            if (req.timeInForce == qfblotter::TIF_GTD && req.expireTimeMs <= epoch_ms()) {
+                errorMsg = "GTD order requires a future expireTimeMs";
+                return false;
+            }
             
-            // For market orders, get current market price for notional check
-            bool isMarketOrder = (req.orderType == '1');
-            double orderPrice = isMarketOrder ? market.mark(req.symbol) : req.price;
+            // Arrival mark doubles as the notional reference for market orders,
+            // the stop price for stop (market) orders
+            bool isMarketOrder = (req.orderType == qfblotter::ORD_MARKET);
+            double arrivalPx = market.mark(req.symbol);
+            double orderPrice = isMarketOrder ? arrivalPx
+                              : req.orderType == qfblotter::ORD_STOP ? req.stopPrice : req.price;
             
             double notional = req.quantity * orderPrice;
             if (notional > MAX_NOTIONAL) {
@@ -257,8 +926,18 @@ int main(int argc, char** argv) {
             record.leavesQty = req.quantity;
             record.cumQty = 0;
             record.avgPx = 0.0;
-            record.status = "NEW";
-            record.transactTime = utc_now_iso();
+            record.arrivalPx = arrivalPx;
+            record.status = isStopOrder ? qfblotter::STATUS_PENDING_STOP : "NEW";
+            record.transactTime = qfblotter::CoarseClock::isoSeconds();
+            record.timeInForce = req.timeInForce;
+            record.orderType = req.orderType;
+            record.stopPx = isStopOrder ? req.stopPrice : 0.0;
+            record.parentId = req.parentId;
+            if (req.timeInForce == qfblotter::TIF_DAY) {
+                record.expireTimeMs = qfblotter::OrderExpiry::nextDailyCutoffMs(sessionEndTime, epoch_ms());
+            } else if (req.timeInForce == qfblotter::TIF_GTD) {
+                record.expireTimeMs = req.expireTimeMs;
+            }
             record.submitTimeUs = submitTimeUs;
             
             // Calculate latency (time from submit to ack)
@@ -268,26 +947,176 @@ int main(int argc, char** argv) {
             record.latencyUs = record.ackTimeUs - record.submitTimeUs;
             
             store.upsert(record);
+            tca.onArrival(record.clOrdId, record.symbol, record.side, arrivalPx);
+            app.reportExecution(record, FIX::ExecType_NEW);
             
             // Audit log entry
-            std::string orderTypeStr = isMarketOrder ? "MARKET" : "LIMIT";
+            std::string orderTypeStr = isMarketOrder ? "MARKET"
+                                     : req.orderType == qfblotter::ORD_STOP ? "STOP"
+                                     : req.orderType == qfblotter::ORD_STOP_LIMIT ? "STOP_LIMIT" : "LIMIT";
             audit.log(qfblotter::AuditLog::EventType::ORDER_NEW, req.clOrdId,
                 "type=" + orderTypeStr + ",symbol=" + req.symbol + ",side=" + std::string(1, req.side) +
-                ",qty=" + std::to_string(req.quantity) + ",px=" + std::to_string(orderPrice));
+                ",qty=" + std::to_string(req.quantity) + ",px=" + std::to_string(orderPrice) +
+                (isStopOrder ? ",stopPx=" + std::to_string(req.stopPrice) : std::string()));
 
-            // For market orders, fill immediately at market price
-            if (isMarketOrder) {
+            if (isStopOrder) {
+                // Rests in the trigger index until the market reaches the stop price
+                stops.add(record.clOrdId, record.symbol, record.side, record.stopPx);
+                if (record.expireTimeMs > 0) {
+                    expiry.schedule(record.clOrdId, record.expireTimeMs);
+                }
+            } else if (isMarketOrder) {
+                // For market orders, fill immediately at market price
                 double fillPrice = market.nextTick(req.symbol);
                 store.updateStatus(req.clOrdId, "FILLED", 0, req.quantity, fillPrice);
+                onFill(record, req.quantity, fillPrice, qfblotter::VENUE_MARKET);
+                app.reportFill(record, req.quantity, fillPrice);
                 record.fillTimeUs = std::chrono::duration_cast<std::chrono::microseconds>(
                     std::chrono::steady_clock::now().time_since_epoch()).count();
                 
                 audit.log(qfblotter::AuditLog::EventType::ORDER_FILLED, req.clOrdId,
                     "fillPx=" + std::to_string(fillPrice) + ",fillQty=" + std::to_string(req.quantity));
+            } else if (req.timeInForce == qfblotter::TIF_IOC || req.timeInForce == qfblotter::TIF_FOK) {
+                // One matching attempt; the order never rests
+                auto result = req.timeInForce == qfblotter::TIF_FOK
+                    ? market.attemptFillAll(req.symbol, req.side, orderPrice, req.quantity)
+                    : market.attemptFill(req.symbol, req.side, orderPrice, req.quantity);
+                if (result.fillQty > 0) {
+                    store.updateStatus(req.clOrdId, result.complete ? "FILLED" : "PARTIAL",
+                                       req.quantity - result.fillQty, result.fillQty, result.fillPx);
+                    onFill(record, result.fillQty, result.fillPx, qfblotter::VENUE_MARKET);
+                    app.reportFill(record, result.fillQty, result.fillPx);
+                    audit.log(result.complete ? qfblotter::AuditLog::EventType::ORDER_FILLED
+                                              : qfblotter::AuditLog::EventType::ORDER_PARTIAL_FILL,
+                        req.clOrdId,
+                        "fillPx=" + std::to_string(result.fillPx) + ",fillQty=" + std::to_string(result.fillQty));
+                }
+                if (!result.complete) {
+                    store.updateStatus(req.clOrdId, "CANCELED", 0, result.fillQty, result.fillPx);
+                    if (auto canceled = store.get(req.clOrdId)) {
+                        app.reportExecution(*canceled, FIX::ExecType_CANCELED);
+                    }
+                    audit.log(qfblotter::AuditLog::EventType::ORDER_EXPIRED, req.clOrdId,
+                        std::string(req.timeInForce == qfblotter::TIF_FOK ? "tif=FOK" : "tif=IOC") +
+                        ",unfilledQty=" + std::to_string(req.quantity - result.fillQty));
+                }
+            } else if (record.expireTimeMs > 0) {
+                expiry.schedule(record.clOrdId, record.expireTimeMs);
             }
             
             // Publish update
-            http.publishEvent(store.snapshotString());
+            if (publish) {
+                blotter.publish();
+            } else {
+                blotter.defer();
+            }
+            return true;
+        };
+        http.setOrderHandler([&](const qfblotter::OrderRequest& req, std::string& errorMsg) -> bool {
+            if (!ownsSymbol(req.symbol)) {
+                errorMsg = req.symbol + " is not owned by this shard";
+                return false;
+            }
+            return submitOrder(req, errorMsg);
+        });
+
+        // Algo children go through the same order path as UI orders
+        algo.setChildRouter([&](const qfblotter::ChildOrder& child) -> bool {
+            qfblotter::OrderRequest req;
+            req.clOrdId = child.clOrdId;
+            req.symbol = child.symbol;
+            req.side = child.side;
+            req.quantity = child.quantity;
+            req.price = child.limitPx;
+            req.orderType = child.limitPx > 0.0 ? qfblotter::ORD_LIMIT : qfblotter::ORD_MARKET;
+            req.parentId = child.parentId;
+            std::string errorMsg;
+            if (!submitOrder(req, errorMsg, false)) {
+                audit.log(qfblotter::AuditLog::EventType::ORDER_REJECTED, child.clOrdId,
+                    "parentId=" + child.parentId + ",reason=" + errorMsg);
+                return false;
+            }
+            return true;
+        });
+
+        // Parents whose schedule ended with quantity unfilled (POV short of
+        // the tape, children canceled, expired or rejected) expire
+        algo.setParentListener([&](const qfblotter::ParentFill& parent) {
+            store.updateStatus(parent.parentId, "EXPIRED", 0, parent.cumQty, parent.avgPx);
+            if (auto expired = store.get(parent.parentId)) {
+                app.reportExecution(*expired, FIX::ExecType_EXPIRED);
+            }
+            audit.log(qfblotter::AuditLog::EventType::ORDER_EXPIRED, parent.parentId,
+                "reason=scheduleEnd,unfilledQty=" + std::to_string(parent.leavesQty));
+            blotter.defer();
+        });
+        // One snapshot per slicing pass covers every child and parent it
+        // touched; in virtual time the driver's flush cadence does
+        if (!virtualTime) {
+            algo.setPassListener([&blotter]() { blotter.flush(); });
+        }
+
+        // Algo handler - parent orders sliced by the AlgoEngine
+        http.setAlgoHandler([&](const qfblotter::AlgoRequest& req, std::string& errorMsg) -> bool {
+            if (!ownsSymbol(req.symbol)) {
+                errorMsg = req.symbol + " is not owned by this shard";
+                return false;
+            }
+            auto strategy = qfblotter::AlgoEngine::parseStrategy(req.strategy);
+            if (!strategy) {
+                errorMsg = "Unknown strategy: " + req.strategy;
+                return false;
+            }
+            if (store.exists(req.clOrdId)) {
+                errorMsg = "Duplicate ClOrdID";
+                return false;
+            }
+            const int slices = std::max(1, req.durationSec / req.sliceSec);
+            if ((req.quantity + slices - 1) / slices > MAX_ORDER_QTY) {
+                errorMsg = "Slice size exceeds order limit (" + std::to_string(MAX_ORDER_QTY) + "); use more slices";
+                return false;
+            }
+
+            const int64_t nowMs = epoch_ms();
+            qfblotter::AlgoParams params;
+            params.parentId = req.clOrdId;
+            params.symbol = req.symbol;
+            params.side = req.side;
+            params.quantity = req.quantity;
+            params.limitPx = req.price;
+            params.strategy = *strategy;
+            params.startMs = nowMs;
+            params.endMs = nowMs + req.durationSec * int64_t{1000};
+            params.sliceMs = req.sliceSec * int64_t{1000};
+            params.participation = req.participation;
+
+            double arrivalPx = market.mark(req.symbol);
+            qfblotter::OrderRecord record;
+            record.clOrdId = req.clOrdId;
+            record.orderId = nextUiOrderId();
+            record.symbol = req.symbol;
+            record.side = req.side;
+            record.price = req.price > 0.0 ? req.price : arrivalPx;
+            record.quantity = req.quantity;
+            record.leavesQty = req.quantity;
+            record.arrivalPx = arrivalPx;
+            record.status = qfblotter::STATUS_WORKING;
+            record.transactTime = qfblotter::CoarseClock::isoSeconds();
+            record.orderType = req.price > 0.0 ? qfblotter::ORD_LIMIT : qfblotter::ORD_MARKET;
+            record.algo = qfblotter::AlgoEngine::strategyName(*strategy);
+
+            // Parent must exist before its first child can fill
+            store.upsert(record);
+            if (!algo.submit(params, errorMsg)) {
+                store.remove(req.clOrdId);
+                return false;
+            }
+
+            app.reportExecution(record, FIX::ExecType_NEW);
+            audit.log(qfblotter::AuditLog::EventType::ORDER_NEW, req.clOrdId,
+                "type=ALGO,strategy=" + record.algo + ",symbol=" + req.symbol + ",side=" + std::string(1, req.side) +
+                ",qty=" + std::to_string(req.quantity) + ",durationSec=" + std::to_string(req.durationSec));
+            blotter.publish();
             return true;
         });
 
@@ -313,13 +1142,43 @@ int main(int argc, char** argv) {
                 return false;
             }
 
-            store.updateStatus(req.origClOrdId, "CANCELED", 0, 0, 0.0);
+            // Algo parent: stop slicing and cancel its open children
+            std::vector<std::string> children;
+            if (record.status == qfblotter::STATUS_WORKING && algo.cancel(req.origClOrdId, children)) {
+                for (const auto& childId : children) {
+                    auto child = store.get(childId);
+                    if (!child || (child->status != "NEW" && child->status != "PARTIAL" &&
+                                   child->status != qfblotter::STATUS_PENDING_STOP)) {
+                        continue;
+                    }
+                    store.updateStatus(childId, "CANCELED", 0, child->cumQty, child->avgPx);
+                    expiry.cancel(childId);
+                    if (auto canceled = store.get(childId)) {
+                        app.reportExecution(*canceled, FIX::ExecType_CANCELED);
+                    }
+                }
+                store.updateStatus(req.origClOrdId, "CANCELED", 0, record.cumQty, record.avgPx);
+                if (auto canceled = store.get(req.origClOrdId)) {
+                    app.reportExecution(*canceled, FIX::ExecType_CANCELED);
+                }
+                audit.log(qfblotter::AuditLog::EventType::ORDER_CANCELED, req.origClOrdId,
+                    "cancelClOrdId=" + req.clOrdId + ",children=" + std::to_string(children.size()));
+                blotter.publish();
+                return true;
+            }
+
+            store.updateStatus(req.origClOrdId, "CANCELED", 0, record.cumQty, record.avgPx);
+            expiry.cancel(req.origClOrdId);
+            stops.remove(req.origClOrdId);
+            if (auto canceled = store.get(req.origClOrdId)) {
+                app.reportExecution(*canceled, FIX::ExecType_CANCELED);
+            }
             
             // Audit log entry
             audit.log(qfblotter::AuditLog::EventType::ORDER_CANCELED, req.origClOrdId,
                 "cancelClOrdId=" + req.clOrdId);
             
-            http.publishEvent(store.snapshotString());
+            blotter.publish();
             return true;
         });
 
@@ -332,6 +1191,7 @@ int main(int argc, char** argv) {
             }
 
             auto record = existing.value();
+            const int originalQty = record.quantity;
             
             // Validate order state
             if (record.status == "FILLED") {
@@ -346,6 +1206,10 @@ int main(int argc, char** argv) {
                 errorMsg = "Cannot amend rejected order";
                 return false;
             }
+            if (record.status == qfblotter::STATUS_WORKING) {
+                errorMsg = "Cannot amend algo parent order";
+                return false;
+            }
 
             // Apply amendments
             bool amended = false;
@@ -387,23 +1251,39 @@ int main(int argc, char** argv) {
 
             // Update the order with new clOrdId
             record.clOrdId = req.clOrdId;
-            record.transactTime = utc_now_iso();
+            record.transactTime = qfblotter::CoarseClock::isoSeconds();
             store.upsert(record);
+            if (record.quantity < originalQty) {
+                algo.onChildReduced(req.origClOrdId, originalQty - record.quantity);
+            }
             
             // Remove old order reference and add new
             if (req.clOrdId != req.origClOrdId) {
                 store.remove(req.origClOrdId);
+                tca.rename(req.origClOrdId, req.clOrdId);
+                algo.renameChild(req.origClOrdId, req.clOrdId);
+                expiry.cancel(req.origClOrdId);
+                if (record.expireTimeMs > 0) {
+                    expiry.schedule(req.clOrdId, record.expireTimeMs);
+                }
+                stops.remove(req.origClOrdId);
+                if (record.status == qfblotter::STATUS_PENDING_STOP) {
+                    stops.add(req.clOrdId, record.symbol, record.side, record.stopPx);
+                }
             }
             
+            app.reportExecution(record, FIX::ExecType_REPLACED);
             audit.log(qfblotter::AuditLog::EventType::ORDER_REPLACED, req.origClOrdId,
                 "newClOrdId=" + req.clOrdId + "," + amendDetails);
             
-            http.publishEvent(store.snapshotString());
+            blotter.publish();
             return true;
         });
 
         // Stats provider - returns JSON performance metrics
-        http.setStatsProvider([&store]() -> std::string {
+        http.setStatsProvider([&store, &dropCopy, &fixMarketData, &shmFeed, &replicationPrimary,
+                               &replicationStandby, &promoted, readReplica, &admission, &http, &crossing,
+                               &router, &executions]() -> std::string {
             auto stats = store.getStats();
             nlohmann::json j;
             j["totalOrders"] = stats.totalOrders;
@@ -412,6 +1292,71 @@ int main(int argc, char** argv) {
             j["filledOrders"] = stats.filledOrders;
             j["rejectedOrders"] = stats.rejectedOrders;
             j["canceledOrders"] = stats.canceledOrders;
+            j["expiredOrders"] = stats.expiredOrders;
+            j["pendingStopOrders"] = stats.pendingStopOrders;
+            j["workingOrders"] = stats.workingOrders;
+            j["algo"] = {{"parents", stats.algoParents},
+                         {"quantity", stats.algoQty},
+                         {"cumQty", stats.algoCumQty},
+                         {"filledNotional", stats.algoFilledNotional}};
+            j["dropCopyPublished"] = dropCopy.published();
+            j["dropCopyDropped"] = dropCopy.dropped();
+            j["dropCopyResynced"] = dropCopy.resynced();
+            j["dropCopyQueued"] = dropCopy.queued();
+            j["mdSubscriptions"] = fixMarketData.subscriptions();
+            j["mdSnapshotsSent"] = fixMarketData.snapshotsSent();
+            j["mdIncrementalsSent"] = fixMarketData.incrementalsSent();
+            j["shmPublished"] = shmFeed ? shmFeed->published() : uint64_t{0};
+            j["internalCrosses"] = crossing.crosses();
+            j["internalCrossedQty"] = crossing.crossedQty();
+            j["internalCrossResting"] = crossing.size();
+            j["executions"] = executions.size();
+            nlohmann::json executionVenues = nlohmann::json::array();
+            for (const auto& totals : executions.venueTotals()) {
+                executionVenues.push_back({{"venue", totals.venue},
+                                           {"executions", totals.executions},
+                                           {"qty", totals.qty},
+                                           {"notional", totals.notional}});
+            }
+            j["executionVenues"] = executionVenues;
+            if (router) {
+                nlohmann::json venues = nlohmann::json::array();
+                for (const auto& venue : router->stats()) {
+                    venues.push_back({{"name", venue.name},
+                                      {"slices", venue.slices},
+                                      {"sentQty", venue.sentQty},
+                                      {"filledQty", venue.filledQty},
+                                      {"bustedQty", venue.bustedQty},
+                                      {"fees", venue.fees},
+                                      {"avgLatencyUs", venue.avgLatencyUs}});
+                }
+                j["venues"] = venues;
+            }
+            const auto admitted = admission.stats();
+            j["admissionAdmitted"] = admitted.admitted;
+            j["admissionShedOrders"] = admitted.shedNewOrders;
+            j["admissionShedCancels"] = admitted.shedCancels;
+            j["admissionInFlight"] = admitted.inFlight;
+            j["admissionQueued"] = admitted.queued;
+            j["admissionLatencyUs"] = admitted.latencyEwmaUs;
+            j["admissionSaturatedQueue"] = admitted.saturatedQueue;
+            // Process resources, sampled by qf_soak to catch growth over long runs
+            const auto process = qfblotter::sampleProcessStats();
+            j["rssKB"] = process.rssKB;
+            j["heapUsedKB"] = process.heapUsedKB;
+            j["openFds"] = process.openFds;
+            j["threads"] = process.threads;
+            j["sseBacklog"] = http.eventBacklog();
+            if (replicationStandby && !promoted.load()) {
+                j["replicationRole"] = readReplica ? "replica" : "standby";
+                j["replicationConnected"] = replicationStandby->connected();
+                j["replicationSeq"] = replicationStandby->lastSeq();
+                j["replicationLagUs"] = replicationStandby->lagUs();
+            } else if (replicationPrimary) {
+                j["replicationRole"] = "primary";
+                j["replicationFollowers"] = replicationPrimary->followers();
+                j["replicationSeq"] = replicationPrimary->lastSeq();
+            }
             j["avgLatencyUs"] = stats.avgLatencyUs;
             j["minLatencyUs"] = stats.minLatencyUs;
             j["maxLatencyUs"] = stats.maxLatencyUs;
@@ -421,6 +1366,10 @@ int main(int argc, char** argv) {
             return j.dump();
         });
 
+        http.setWindowStatsProvider([&flowStats](int64_t windowSec) {
+            return flowStats.windowJson(windowSec).dump();
+        });
+
         // Order book provider - returns JSON for a symbol
         http.setOrderBookProvider([&market](const std::string& symbol) -> std::string {
             auto book = market.getOrderBook(symbol, 5);
@@ -442,29 +1391,341 @@ int main(int argc, char** argv) {
             return j.dump();
         });
 
-        qfblotter::FixApplication app(store, market, [&http](const std::string& payload) {
-            http.publishEvent(payload);
+        // History provider - OHLCV bars served from the aggregator rings
+        http.setHistoryProvider([&bars](const std::string& symbol, const std::string& interval,
+                                        int count) -> std::string {
+            auto parsed = qfblotter::BarAggregator::parseInterval(interval);
+            return bars.historyJson(symbol, parsed.value_or(qfblotter::BarInterval::Min1),
+                                    static_cast<size_t>(count));
+        });
+
+        // TCA provider - per-symbol/side summary, or a single order's costs
+        http.setTcaProvider([&tca](const std::string& clOrdId) -> std::string {
+            if (clOrdId.empty()) {
+                return tca.summaryJson().dump();
+            }
+            auto j = tca.orderJson(clOrdId);
+            return j ? j->dump() : std::string();
+        });
+
+        // Executions provider - the ledger after a cursor, or one order's executions
+        http.setExecutionsProvider([&executions, &store](uint64_t since, size_t limit,
+                                                         const std::string& clOrdId) -> std::string {
+            if (clOrdId.empty()) {
+                return executions.sinceJson(since, limit).dump();
+            }
+            // A known order with no executions yet is an empty list, not a 404
+            return store.get(clOrdId) ? executions.orderJson(clOrdId).dump() : std::string();
         });
 
         FIX::FileStoreFactory storeFactory(settings);
-        FIX::FileLogFactory logFactory(settings);
+        qfblotter::AsyncFileLogFactory logFactory(settings);
         FIX::SocketAcceptor acceptor(app, storeFactory, settings, logFactory);
 
         // Start fill simulator for partial fills
-        FillSimulator fillSim(store, market, http);
+        FillSimulator fillSim(store, market, blotter, app, onFill, crossingEnabled ? &crossing : nullptr, router.get());
+
+        // Optional UDP multicast feed (MulticastGroup=...) with TCP gap recovery
+        std::unique_ptr<qfblotter::MulticastPublisher> multicast;
+        if (settings.get().has("MulticastGroup")) {
+            const auto& dict = settings.get();
+            qfblotter::MulticastConfig mcast;
+            mcast.group = dict.getString("MulticastGroup");
+            if (dict.has("MulticastPort")) mcast.port = static_cast<uint16_t>(dict.getInt("MulticastPort"));
+            if (dict.has("MulticastInterface")) mcast.interfaceAddr = dict.getString("MulticastInterface");
+            if (dict.has("MulticastTTL")) mcast.ttl = dict.getInt("MulticastTTL");
+            if (dict.has("MulticastRecoveryPort")) {
+                mcast.recoveryPort = static_cast<uint16_t>(dict.getInt("MulticastRecoveryPort"));
+            }
+            if (dict.has("MulticastRetain")) mcast.retain = static_cast<size_t>(dict.getInt("MulticastRetain"));
+            try {
+                multicast = std::make_unique<qfblotter::MulticastPublisher>(mcast);
+                multicast->start();
+                std::cout << "[GATEWAY] Multicast feed on " << mcast.group << ":" << mcast.port
+                          << " (recovery port " << mcast.recoveryPort << ")" << std::endl;
+            } catch (const std::exception& ex) {
+                std::cerr << "[GATEWAY] Multicast feed disabled: " << ex.what() << std::endl;
+            }
+        }
 
         // Start market data feed for common symbols
-        std::vector<std::string> defaultSymbols = {"AAPL", "GOOGL", "MSFT", "NVDA", "TSLA", "AMZN"};
-        MarketDataFeed marketFeed(market, http, defaultSymbols);
+        MarketDataFeed marketFeed(market, http, bars, algo, tca, multicast.get(), replicationPrimary.get(), defaultSymbols);
 
-        http.start();
-        fillSim.start();
-        marketFeed.start();
-        persistence.start(store);  // Start background persistence
-        acceptor.start();
         // Register signal handlers for graceful shutdown
         std::signal(SIGINT, signalHandler);
         std::signal(SIGTERM, signalHandler);
+
+        // Warm up before any port opens: live symbols get their state now,
+        // and synthetic orders run through shadow copies of the order path
+        market.initSymbols(defaultSymbols);
+        if (!settings.get().has("Warmup") || settings.get().getBool("Warmup")) {
+            const auto& dict = settings.get();
+            qfblotter::WarmupOptions warmup;
+            warmup.symbols = defaultSymbols;
+            warmup.syntheticOrders = static_cast<size_t>(dict.has("WarmupOrders") ? dict.getInt("WarmupOrders") : 5000);
+            warmup.prefaultBytes = static_cast<size_t>(dict.has("WarmupPrefaultMB") ? dict.getInt("WarmupPrefaultMB") : 64)
+                * 1024 * 1024;
+            warmup.hugePages = dict.has("WarmupHugePages") && dict.getBool("WarmupHugePages");
+            warmup.lockMemory = dict.has("WarmupLockMemory") && dict.getBool("WarmupLockMemory");
+            const auto report = qfblotter::runWarmup(warmup);
+            for (const auto& warning : report.warnings) {
+                std::cerr << "[GATEWAY] Warmup: " << warning << std::endl;
+            }
+            std::cout << "[GATEWAY] Warmup: " << report.syntheticOrders << " synthetic orders ("
+                      << report.fills << " fills), " << report.prefaultedBytes / (1024 * 1024) << "MB prefaulted"
+                      << (report.hugePages ? " on huge pages" : "") << (report.memoryLocked ? ", memory locked" : "")
+                      << " in " << static_cast<int64_t>(report.elapsedMs) << "ms" << std::endl;
+        }
+
+        if (standbyMode) {
+            const auto primaryPort = settings.get().has("ReplicationPrimaryPort")
+                ? static_cast<uint16_t>(settings.get().getInt("ReplicationPrimaryPort")) : uint16_t{7001};
+            qfblotter::ReplicationStandby::Handlers handlers;
+            // Executions are recovered from cumQty/avgPx deltas, so bars and TCA
+            // follow the primary's. Events queued while a snapshot is taken can
+            // replay older states after it (cumQty 100, 50, 100), so each live
+            // order keeps a high-water mark: a state below it is skipped rather
+            // than applied, and a fill is only what rises above it. The mark
+            // survives a resync: fills made while disconnected are booked from
+            // the new snapshot, as one execution at their average price. Orders
+            // first seen in a (re)sync snapshot or under a new ClOrdID after an
+            // amend only seed the mark. A terminal state books its last fill and
+            // drops the mark; from then on the store's terminal record is the
+            // mark, so late replays cannot reopen the order. Replication thread only.
+            struct BookedFills {
+                int cumQty{0};
+                double notional{0.0};
+            };
+            auto booked = std::make_shared<std::unordered_map<std::string, BookedFills>>();
+            handlers.onOrder = [&store, &bars, &tca, &executions, booked](const qfblotter::OrderRecord& record) {
+                auto is_terminal = [](const std::string& status) {
+                    return status == "FILLED" || status == "CANCELED" || status == "EXPIRED" || status == "REJECTED";
+                };
+                auto previous = store.get(record.clOrdId);
+                auto it = booked->find(record.clOrdId);
+                if (it == booked->end() ? previous && is_terminal(previous->status)
+                                        : record.cumQty < it->second.cumQty) {
+                    return;  // Replay of an older state
+                }
+                store.upsert(record);
+                const bool terminal = is_terminal(record.status);
+                if (it == booked->end()) {
+                    if (!terminal) {
+                        booked->emplace(record.clOrdId, BookedFills{record.cumQty, record.avgPx * record.cumQty});
+                    }
+                    return;
+                }
+                const int fillQty = record.cumQty - it->second.cumQty;
+                if (fillQty > 0) {
+                    const double notional = record.avgPx * record.cumQty;
+                    const double fillPx = (notional - it->second.notional) / fillQty;
+                    it->second = BookedFills{record.cumQty, notional};
+                    const qfblotter::OrderRecord& order = previous ? *previous : record;
+                    executions.append(order, fillQty, fillPx, qfblotter::SimClock::epochUs(), "");  // Venue not replicated
+                    bars.onFill(record.symbol, fillPx, fillQty, epoch_ms());
+                    tca.onFill(order, fillQty, fillPx);
+                }
+                if (terminal) {
+                    booked->erase(it);
+                }
+            };
+            // restorePrice does not notify tick listeners, so nothing triggers on a follower
+            handlers.onTick = [&market](const std::string& symbol, double price) {
+                market.restorePrice(symbol, price);
+            };
+            handlers.onMarketData = [&http, &bars, &tca](const nlohmann::json& ticks) {
+                http.publishMarketData(ticks.dump());
+                const int64_t nowMs = epoch_ms();
+                for (const auto& tick : ticks) {
+                    bars.onTick(tick.value("symbol", ""), tick.value("price", 0.0), nowMs);
+                    tca.onMarketPrint(tick.value("symbol", ""), tick.value("price", 0.0),
+                                      tick.value("volume", int64_t{0}));
+                }
+            };
+            replicationStandby = std::make_unique<qfblotter::ReplicationStandby>(
+                settings.get().getString("ReplicationPrimaryHost"), primaryPort, std::move(handlers));
+
+            if (readReplica) {
+                http.setReadOnly(true, "Read replica: submit orders to the primary gateway");
+            } else {
+                std::signal(SIGUSR1, promoteSignalHandler);
+                http.setPromoteHandler([]() {
+                    g_promote.store(true);
+                    return std::string(R"({"status":"promoting"})");
+                });
+                http.setReadOnly(true);
+            }
+            http.start();
+            replicationStandby->start();
+            std::cout << "[GATEWAY] " << (readReplica ? "Read replica" : "Standby") << " of "
+                      << settings.get().getString("ReplicationPrimaryHost") << ":" << primaryPort
+                      << (readReplica ? "" : "; POST /promote or SIGUSR1 to take over") << std::endl;
+
+            // SSE/WebSocket fan-out of the replicated store, at most one
+            // snapshot per 50ms however fast the primary's events arrive
+            std::thread fanout([&http, &store, &replicationStandby]() {
+                uint64_t published = 0;
+                while (!g_shutdown.load() && !g_promote.load()) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                    const uint64_t applied = replicationStandby->eventsApplied();
+                    if (applied != published) {
+                        published = applied;
+                        http.publishEvent(store.snapshotString());
+                    }
+                }
+            });
+
+            while (!g_shutdown.load() && !g_promote.load()) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            }
+            fanout.join();
+            if (g_shutdown.load()) {
+                std::cout << "[GATEWAY] Shutdown signal received." << std::endl;
+                replicationStandby->promote();
+                http.stop();
+                return 0;
+            }
+
+            const int senderSeqGap = settings.get().has("ReplicationSenderSeqGap")
+                ? settings.get().getInt("ReplicationSenderSeqGap") : 100;
+
+            const auto promoteStart = std::chrono::steady_clock::now();
+            replicationStandby->promote();
+            // Sessions resume where the primary left off. The sender side skips
+            // ahead because messages sent after the last poll were not shipped;
+            // the counterparty's resend request is answered with a gap fill.
+            for (const auto& state : replicationStandby->fixSeqs()) {
+                for (const auto& sessionID : settings.getSessions()) {
+                    auto* session = FIX::Session::lookupSession(sessionID);
+                    if (session == nullptr || sessionID.toString() != state.session) {
+                        continue;
+                    }
+                    try {
+                        session->setNextSenderMsgSeqNum(state.senderSeq + senderSeqGap);
+                        session->setNextTargetMsgSeqNum(state.targetSeq);
+                    } catch (const std::exception& ex) {
+                        std::cerr << "[GATEWAY] Could not restore sequence numbers for "
+                                  << state.session << ": " << ex.what() << std::endl;
+                    }
+                }
+            }
+            // Algo schedules are not replicated; parents stop working, as on a restart
+            for (const auto& order : store.getAll()) {
+                if (order.status == qfblotter::STATUS_WORKING) {
+                    store.updateStatus(order.clOrdId, "CANCELED", 0, order.cumQty, order.avgPx);
+                }
+            }
+            rearmOpenOrders();
+            store.setFlowStats(&flowStats);
+            promoted.store(true);
+            http.setReadOnly(false);
+
+            const auto promoteMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - promoteStart).count();
+            audit.logSystemEvent("GATEWAY_PROMOTED", "Standby promoted at replication seq " +
+                std::to_string(replicationStandby->lastSeq()));
+            std::cout << "[GATEWAY] Promoted to primary in " << promoteMs << "ms ("
+                      << store.getAll().size() << " orders, replication seq "
+                      << replicationStandby->lastSeq() << ")" << std::endl;
+        } else {
+            http.start();
+        }
+
+        // FIX sequence numbers are shipped when they change, not per message
+        std::thread fixSeqShipper;
+        if (replicationPrimary) {
+            try {
+                replicationPrimary->start();
+                fixSeqShipper = std::thread([&replicationPrimary, &fixSeqStates]() {
+                    std::vector<qfblotter::FixSeqState> shipped;
+                    while (!g_shutdown.load()) {
+                        for (const auto& state : fixSeqStates()) {
+                            auto it = std::find_if(shipped.begin(), shipped.end(), [&state](const auto& s) {
+                                return s.session == state.session;
+                            });
+                            if (it == shipped.end()) {
+                                shipped.push_back(state);
+                            } else if (it->senderSeq != state.senderSeq || it->targetSeq != state.targetSeq) {
+                                *it = state;
+                            } else {
+                                continue;  // A reconnecting standby gets it in the snapshot
+                            }
+                            replicationPrimary->publishFixSeq(state);
+                        }
+                        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                    }
+                });
+                std::cout << "[GATEWAY] Replicating to standby on port "
+                          << settings.get().getInt("ReplicationListenPort") << std::endl;
+            } catch (const std::exception& ex) {
+                std::cerr << "[GATEWAY] Replication disabled: " << ex.what() << std::endl;
+            }
+        }
+
+        // Rolling stats to /events subscribers, once a (possibly simulated) second
+        auto publishRollingStats = [&flowStats, &http]() {
+            nlohmann::json rolling;
+            rolling["1m"] = flowStats.windowJson(60);
+            rolling["5m"] = flowStats.windowJson(300);
+            rolling["session"] = flowStats.windowJson(0);
+            http.publishStats(rolling.dump());
+        };
+
+        // Synthetic flow for virtual sessions: VirtualOrderRate DAY limit
+        // orders per simulated second (Poisson arrivals, seeded by
+        // VirtualSeed), priced within a few bps of the mark on either side
+        // of it, so some rest and some cross
+        const double orderRate = !virtualTime ? 0.0
+                               : settings.get().has("VirtualOrderRate") ? settings.get().getDouble("VirtualOrderRate")
+                                                                        : 2.0;
+        std::mt19937 flowRng(static_cast<unsigned>(
+            settings.get().has("VirtualSeed") ? settings.get().getInt("VirtualSeed") : 1));
+        uint64_t flowOrders = 0;
+        std::function<void()> nextArrival = [&]() {
+            std::uniform_int_distribution<size_t> pick(0, defaultSymbols.size() - 1);
+            std::uniform_int_distribution<int> lots(1, 10);
+            std::uniform_real_distribution<double> offsetBps(-20.0, 10.0);  // Positive crosses the spread
+            qfblotter::OrderRequest req;
+            req.clOrdId = "SIM" + std::to_string(++flowOrders);
+            req.symbol = defaultSymbols[pick(flowRng)];
+            req.side = flowRng() % 2 == 0 ? '1' : '2';
+            req.quantity = 100 * lots(flowRng);
+            req.orderType = qfblotter::ORD_LIMIT;
+            req.timeInForce = qfblotter::TIF_DAY;
+            const double offset = offsetBps(flowRng) / 10000.0 * (req.side == '1' ? 1.0 : -1.0);
+            req.price = std::round(market.mark(req.symbol) * (1.0 + offset) * 100.0) / 100.0;
+            std::string error;
+            submitOrder(req, error);
+            std::exponential_distribution<double> gapSec(orderRate);
+            scheduler.after(static_cast<int64_t>(gapSec(flowRng) * 1e6), nextArrival);
+        };
+
+        if (virtualTime) {
+            // Everything simulated runs on the driver below, in due order
+            scheduler.every(250'000, [&marketFeed]() { marketFeed.tick(); });
+            scheduler.every(500'000, [&fillSim]() { fillSim.pass(); });
+            scheduler.every(100'000, [&expiry, &algo]() {
+                const int64_t nowMs = epoch_ms();
+                expiry.runDue(nowMs);
+                algo.runDue(nowMs);
+            });
+            scheduler.every(1'000'000, publishRollingStats);
+            if (orderRate > 0.0 && !defaultSymbols.empty()) {
+                scheduler.after(0, nextArrival);
+            }
+        } else {
+            if (router) {
+                scheduler.start();
+            }
+            fillSim.start();
+            marketFeed.start();
+            expiry.start();
+            algo.start();
+        }
+        persistence.start(store);  // Start background persistence
+        dropCopy.start();
+        fixMarketData.start();
+        acceptor.start();
         
         if (log) {
             log->info("gateway started (fix_cfg={}, http_port={})", cfgPath, httpPort);
@@ -473,18 +1734,54 @@ int main(int argc, char** argv) {
                   << ", HTTP port: " << httpPort << ")" << std::endl;
         std::cout << "[GATEWAY] Send SIGINT or SIGTERM to stop." << std::endl;
         
-        // Wait for shutdown signal (container-friendly)
-        while (!g_shutdown.load()) {
-            std::this_thread::sleep_for(std::chrono::seconds(1));
+        if (virtualTime) {
+            // A simulated minute per step, so a signal still stops the run
+            const auto realStart = std::chrono::steady_clock::now();
+            const int64_t startUs = qfblotter::SimClock::steadyUs();
+            auto lastFlush = realStart;
+            while (!g_shutdown.load() && qfblotter::SimClock::steadyUs() < virtualEndUs) {
+                scheduler.runUntil(std::min(virtualEndUs, qfblotter::SimClock::steadyUs() + 60'000'000));
+                if (std::chrono::steady_clock::now() - lastFlush >= std::chrono::milliseconds(250)) {
+                    blotter.flush();
+                    lastFlush = std::chrono::steady_clock::now();
+                }
+            }
+            blotter.flush();
+            const double realSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - realStart).count();
+            const double simSec = static_cast<double>(qfblotter::SimClock::steadyUs() - startUs) / 1e6;
+            const auto stats = store.getStats();
+            std::cout << "[GATEWAY] Virtual session: " << simSec / 3600.0 << "h simulated in " << realSec << "s ("
+                      << (realSec > 0.0 ? simSec / realSec : 0.0) << "x), " << scheduler.executed() << " events, "
+                      << stats.totalOrders << " orders, " << stats.filledOrders << " filled" << std::endl;
+        } else {
+            // Wait for shutdown signal (container-friendly), streaming the
+            // rolling stats to /events subscribers once a second meanwhile
+            while (!g_shutdown.load()) {
+                std::this_thread::sleep_for(std::chrono::seconds(1));
+                publishRollingStats();
+            }
         }
         
-        std::cout << "[GATEWAY] Shutdown signal received." << std::endl;
+        std::cout << (g_shutdown.load() ? "[GATEWAY] Shutdown signal received." : "[GATEWAY] Virtual session complete.")
+                  << std::endl;
         audit.logSystemEvent("GATEWAY_STOP", "Gateway shutting down");
         persistence.stop();  // Save orders before shutdown
+        dropCopy.stop();  // Flush queued copies while the sessions are still up
         acceptor.stop();
+        fixMarketData.stop();
+        algo.stop();
+        expiry.stop();
         marketFeed.stop();
         fillSim.stop();
+        scheduler.stop();  // Slices still out are dropped
         http.stop();
+        if (fixSeqShipper.joinable()) {
+            fixSeqShipper.join();
+        }
+        if (replicationPrimary) {
+            replicationPrimary->stop();
+        }
+        qfblotter::CoarseClock::stop();
     } catch (const FIX::ConfigError& e) {
         std::cerr << "[GATEWAY] ConfigError: " << e.what() << std::endl;
         return 1;
@@ -0,0 +1,115 @@
+// HTTP order throughput benchmark against a gateway or a qf_router front.
+// Each thread keeps one keep-alive connection and submits market orders
+// round-robin over synthetic symbols, so a router spreads them over shards.
+// Usage: qf_order_bench <url> [--threads N] [--seconds S] [--symbols N]
+// The target must have HttpOrderRateLimit=0 (gateway) or --rate-limit 0 (router).
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <httplib.h>
+#include <nlohmann/json.hpp>
+
+namespace {
+struct ThreadResult {
+    uint64_t accepted{0};
+    uint64_t rejected{0};
+    uint64_t failed{0};
+    std::vector<int64_t> latenciesUs;
+};
+
+int64_t percentile(std::vector<int64_t>& sorted, double p) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    const auto idx = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1));
+    return sorted[idx];
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: qf_order_bench <url> [--threads N] [--seconds S] [--symbols N]" << std::endl;
+        return 1;
+    }
+    const std::string url = argv[1];
+    int threads = 8;
+    int seconds = 10;
+    int symbols = 64;
+    for (int i = 2; i + 1 < argc; i += 2) {
+        std::string arg = argv[i];
+        if (arg == "--threads") {
+            threads = std::stoi(argv[i + 1]);
+        } else if (arg == "--seconds") {
+            seconds = std::stoi(argv[i + 1]);
+        } else if (arg == "--symbols") {
+            symbols = std::stoi(argv[i + 1]);
+        }
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(seconds);
+    std::vector<ThreadResult> results(static_cast<size_t>(threads));
+    std::vector<std::thread> workers;
+    const auto runId = std::chrono::system_clock::now().time_since_epoch().count() % 1000000;
+
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            auto& result = results[static_cast<size_t>(t)];
+            httplib::Client client(url);
+            client.set_keep_alive(true);
+            client.set_tcp_nodelay(true);
+            for (uint64_t n = 0; std::chrono::steady_clock::now() < deadline; ++n) {
+                nlohmann::json order;
+                order["clOrdId"] = "B" + std::to_string(runId) + "T" + std::to_string(t) + "N" + std::to_string(n);
+                order["symbol"] = "SYM" + std::to_string((n * static_cast<uint64_t>(threads) +
+                                                          static_cast<uint64_t>(t)) % static_cast<uint64_t>(symbols));
+                order["side"] = n % 2 == 0 ? "1" : "2";
+                order["quantity"] = 10;
+                order["price"] = 0.0;
+                order["orderType"] = "Market";
+
+                const auto start = std::chrono::steady_clock::now();
+                auto res = client.Post("/order", order.dump(), "application/json");
+                const auto elapsed = std::chrono::steady_clock::now() - start;
+                if (!res) {
+                    ++result.failed;
+                    continue;
+                }
+                result.latenciesUs.push_back(
+                    std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+                if (res->status == 200) {
+                    ++result.accepted;
+                } else {
+                    ++result.rejected;
+                }
+            }
+        });
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+
+    ThreadResult total;
+    for (auto& r : results) {
+        total.accepted += r.accepted;
+        total.rejected += r.rejected;
+        total.failed += r.failed;
+        total.latenciesUs.insert(total.latenciesUs.end(), r.latenciesUs.begin(), r.latenciesUs.end());
+    }
+    std::sort(total.latenciesUs.begin(), total.latenciesUs.end());
+    std::printf("%d threads, %ds: %.0f orders/s accepted (%llu ok, %llu rejected, %llu failed), "
+                "latency p50=%lldus p99=%lldus max=%lldus\n",
+                threads, seconds, static_cast<double>(total.accepted) / seconds,
+                static_cast<unsigned long long>(total.accepted), static_cast<unsigned long long>(total.rejected),
+                static_cast<unsigned long long>(total.failed),
+                static_cast<long long>(percentile(total.latenciesUs, 0.50)),
+                static_cast<long long>(percentile(total.latenciesUs, 0.99)),
+                static_cast<long long>(total.latenciesUs.empty() ? 0 : total.latenciesUs.back()));
+    return 0;
+}
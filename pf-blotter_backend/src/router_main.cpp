@@ -0,0 +1,457 @@
+// Front router for symbol-sharded gateways. Orders go to the gateway that
+// owns their symbol on the ShardRing; /snapshot, /stats (and ?window), /tca,
+// /executions and the SSE streams are merged from every shard. Shards are reached over keep-alive
+// loopback HTTP, one connection per shard per router worker thread.
+//
+// Usage: qf_router <http_port> <shard_url>... [--rate-limit N]
+//   e.g. qf_router 8080 http://127.0.0.1:8081 http://127.0.0.1:8082
+// The i-th shard must run with ShardIndex=i and ShardCount=<number of shards>
+// (and HttpOrderRateLimit=0, since the router limits per client). Shards are
+// named by position, so append new ones to keep most symbols in place.
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <httplib.h>
+
+#include "qfblotter/ExecutionLedger.hpp"
+#include "qfblotter/HttpServer.hpp"
+#include "qfblotter/OrderStore.hpp"
+#include "qfblotter/Sharding.hpp"
+
+namespace {
+std::atomic<bool> g_shutdown{false};
+
+void signalHandler(int) {
+    g_shutdown.store(true);
+}
+
+using qfblotter::Json;
+
+constexpr size_t EXECUTIONS_PAGE = 10000;  // The shards' largest /executions page
+
+// Keep-alive clients to every shard. httplib clients are not shared across
+// threads, so each router worker thread gets its own set.
+class ShardPool {
+public:
+    explicit ShardPool(std::vector<std::string> urls) : urls_(std::move(urls)) {}
+
+    size_t size() const { return urls_.size(); }
+    const std::string& url(size_t shard) const { return urls_[shard]; }
+
+    // Body of a 200 response, nullopt on any failure
+    std::optional<std::string> get(size_t shard, const std::string& path) {
+        auto res = client(shard).Get(path);
+        if (!res || res->status != 200) {
+            return std::nullopt;
+        }
+        return res->body;
+    }
+
+    Json getJson(size_t shard, const std::string& path) {
+        auto body = get(shard, path);
+        return body ? Json::parse(*body, nullptr, false) : Json();
+    }
+
+    // Status 0 if the shard could not be reached
+    std::pair<int, std::string> post(size_t shard, const std::string& path, const std::string& body) {
+        auto res = client(shard).Post(path, body, "application/json");
+        if (!res) {
+            return {0, std::string()};
+        }
+        return {res->status, res->body};
+    }
+
+private:
+    httplib::Client& client(size_t shard) {
+        thread_local std::vector<std::unique_ptr<httplib::Client>> clients;
+        if (clients.empty()) {
+            for (const auto& url : urls_) {
+                auto c = std::make_unique<httplib::Client>(url);
+                c->set_keep_alive(true);
+                c->set_tcp_nodelay(true);
+                c->set_connection_timeout(1);
+                c->set_read_timeout(5);
+                clients.push_back(std::move(c));
+            }
+        }
+        return *clients[shard];
+    }
+
+    std::vector<std::string> urls_;
+};
+
+// Follows one SSE stream per shard, reconnecting while running; every
+// frame's event type and data are handed to the callback with the shard index
+class StreamMerger {
+public:
+    using OnData = std::function<void(size_t shard, const std::string& event, const std::string& data)>;
+
+    StreamMerger(std::vector<std::string> urls, std::string path, OnData onData)
+        : urls_(std::move(urls)), path_(std::move(path)), onData_(std::move(onData)) {}
+
+    ~StreamMerger() { stop(); }
+
+    void start() {
+        running_ = true;
+        for (size_t shard = 0; shard < urls_.size(); ++shard) {
+            threads_.emplace_back([this, shard]() { follow(shard); });
+        }
+    }
+
+    // Returns once every stream has delivered its next frame or keep-alive ping
+    void stop() {
+        running_ = false;
+        for (auto& t : threads_) {
+            if (t.joinable()) {
+                t.join();
+            }
+        }
+        threads_.clear();
+    }
+
+private:
+    void follow(size_t shard) {
+        while (running_) {
+            httplib::Client client(urls_[shard]);
+            client.set_connection_timeout(1);
+            client.set_read_timeout(10);  // Shards ping at least every 5s
+            std::string buffer;
+            client.Get(path_, [this, shard, &buffer](const char* data, size_t len) {
+                buffer.append(data, len);
+                for (size_t end = buffer.find("\n\n"); end != std::string::npos; end = buffer.find("\n\n")) {
+                    const std::string frame = buffer.substr(0, end);
+                    buffer.erase(0, end + 2);
+                    const size_t pos = frame.find("data: ");
+                    if (pos == std::string::npos || frame.compare(0, 7, "event: ") != 0) {
+                        continue;  // Keep-alive comment
+                    }
+                    onData_(shard, frame.substr(7, frame.find('\n') - 7),
+                            frame.substr(pos + 6, frame.find('\n', pos) - pos - 6));
+                }
+                return running_.load();
+            });
+            for (int i = 0; i < 10 && running_; ++i) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            }
+        }
+    }
+
+    std::vector<std::string> urls_;
+    std::string path_;
+    OnData onData_;
+    std::atomic<bool> running_{false};
+    std::vector<std::thread> threads_;
+};
+}  // namespace
+
+int main(int argc, char** argv) {
+    int httpPort = 8080;
+    int rateLimit = 60;
+    std::vector<std::string> shardUrls;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--rate-limit" && i + 1 < argc) {
+            rateLimit = std::stoi(argv[++i]);
+        } else if (i == 1) {
+            httpPort = std::stoi(arg);
+        } else {
+            shardUrls.push_back(arg);
+        }
+    }
+    if (shardUrls.empty()) {
+        std::cerr << "Usage: qf_router <http_port> <shard_url>... [--rate-limit N]" << std::endl;
+        return 1;
+    }
+
+    try {
+        const qfblotter::ShardRing ring(qfblotter::defaultShardNames(shardUrls.size()));
+        ShardPool pool(shardUrls);
+
+        // ClOrdID -> shard for cancels, amends and TCA lookups. Orders placed
+        // before the router started, or evicted once the shard's `terminal`
+        // event names them, are found by asking every shard.
+        std::mutex routesMutex;
+        std::unordered_map<std::string, size_t> routes;
+        auto remember = [&](const std::string& clOrdId, size_t shard) {
+            std::lock_guard<std::mutex> lock(routesMutex);
+            routes[clOrdId] = shard;
+        };
+        auto routeOf = [&](const std::string& clOrdId) -> std::optional<size_t> {
+            std::lock_guard<std::mutex> lock(routesMutex);
+            auto it = routes.find(clOrdId);
+            return it == routes.end() ? std::nullopt : std::optional<size_t>(it->second);
+        };
+        auto forgetTerminal = [&](const Json& clOrdIds) {
+            std::lock_guard<std::mutex> lock(routesMutex);
+            for (const auto& id : clOrdIds) {
+                if (id.is_string()) {
+                    routes.erase(id.get_ref<const std::string&>());
+                }
+            }
+        };
+
+        auto forward = [&pool](size_t shard, const std::string& path, const Json& body, std::string& errorMsg) {
+            auto [status, response] = pool.post(shard, path, body.dump());
+            if (status == 200) {
+                return true;
+            }
+            if (status == 0) {
+                errorMsg = "Shard " + pool.url(shard) + " unavailable";
+                return false;
+            }
+            auto j = Json::parse(response, nullptr, false);
+            errorMsg = j.is_object() && j.contains("error") ? j["error"].get<std::string>()
+                                                            : "Shard returned HTTP " + std::to_string(status);
+            return false;
+        };
+
+        // Known route first, otherwise each shard in turn until one accepts
+        auto forwardByOrder = [&](const std::string& origClOrdId, const std::string& path, const Json& body,
+                                  std::string& errorMsg) -> std::optional<size_t> {
+            if (auto shard = routeOf(origClOrdId)) {
+                return forward(*shard, path, body, errorMsg) ? shard : std::nullopt;
+            }
+            for (size_t shard = 0; shard < pool.size(); ++shard) {
+                if (forward(shard, path, body, errorMsg)) {
+                    remember(origClOrdId, shard);
+                    return shard;
+                }
+            }
+            return std::nullopt;
+        };
+
+        auto fetchAll = [&pool](const std::string& path) {
+            std::vector<Json> responses;
+            responses.reserve(pool.size());
+            for (size_t shard = 0; shard < pool.size(); ++shard) {
+                responses.push_back(pool.getJson(shard, path));
+            }
+            return responses;
+        };
+
+        qfblotter::HttpServer http(httpPort, [&fetchAll]() {
+            return qfblotter::mergeSnapshots(fetchAll("/snapshot")).dump();
+        });
+        http.setRateLimits(rateLimit, rateLimit > 0 ? rateLimit / 2 : 0);
+
+        http.setOrderHandler([&](const qfblotter::OrderRequest& req, std::string& errorMsg) {
+            const size_t shard = ring.shardFor(req.symbol);
+            Json body{{"clOrdId", req.clOrdId}, {"symbol", req.symbol}, {"side", std::string(1, req.side)},
+                      {"quantity", req.quantity}, {"price", req.price},
+                      {"orderType", std::string(1, req.orderType)}, {"stopPrice", req.stopPrice},
+                      {"timeInForce", std::string(1, req.timeInForce)}, {"expireTimeMs", req.expireTimeMs}};
+            if (!forward(shard, "/order", body, errorMsg)) {
+                return false;
+            }
+            remember(req.clOrdId, shard);
+            return true;
+        });
+
+        http.setAlgoHandler([&](const qfblotter::AlgoRequest& req, std::string& errorMsg) {
+            const size_t shard = ring.shardFor(req.symbol);
+            Json body{{"clOrdId", req.clOrdId}, {"symbol", req.symbol}, {"side", std::string(1, req.side)},
+                      {"quantity", req.quantity}, {"price", req.price}, {"strategy", req.strategy},
+                      {"durationSec", req.durationSec}, {"sliceSec", req.sliceSec},
+                      {"participation", req.participation}};
+            if (!forward(shard, "/algo", body, errorMsg)) {
+                return false;
+            }
+            remember(req.clOrdId, shard);
+            return true;
+        });
+
+        http.setCancelHandler([&](const qfblotter::CancelRequest& req, std::string& errorMsg) {
+            Json body{{"origClOrdId", req.origClOrdId}, {"clOrdId", req.clOrdId}};
+            return forwardByOrder(req.origClOrdId, "/cancel", body, errorMsg).has_value();
+        });
+
+        http.setAmendHandler([&](const qfblotter::AmendRequest& req, std::string& errorMsg) {
+            Json body{{"origClOrdId", req.origClOrdId}, {"clOrdId", req.clOrdId},
+                      {"quantity", req.newQuantity}, {"price", req.newPrice}};
+            auto shard = forwardByOrder(req.origClOrdId, "/amend", body, errorMsg);
+            if (shard) {
+                remember(req.clOrdId, *shard);
+            }
+            return shard.has_value();
+        });
+
+        http.setStatsProvider([&fetchAll]() {
+            return qfblotter::mergeStats(fetchAll("/stats")).dump();
+        });
+
+        http.setWindowStatsProvider([&fetchAll](int64_t windowSec) {
+            const std::string window = windowSec <= 0 ? "session" : std::to_string(windowSec) + "s";
+            return qfblotter::mergeWindowStats(fetchAll("/stats?window=" + window)).dump();
+        });
+
+        http.setOrderBookProvider([&](const std::string& symbol) {
+            return pool.get(ring.shardFor(symbol), "/orderbook?symbol=" + symbol).value_or("{}");
+        });
+
+        http.setHistoryProvider([&](const std::string& symbol, const std::string& interval, int count) {
+            return pool.get(ring.shardFor(symbol), "/history?symbol=" + symbol + "&interval=" + interval +
+                                                       "&n=" + std::to_string(count)).value_or(std::string());
+        });
+
+        http.setTcaProvider([&](const std::string& clOrdId) -> std::string {
+            if (clOrdId.empty()) {
+                return qfblotter::mergeTcaSummaries(fetchAll("/tca")).dump();
+            }
+            const std::string path = "/tca?clOrdId=" + clOrdId;
+            if (auto shard = routeOf(clOrdId)) {
+                return pool.get(*shard, path).value_or(std::string());
+            }
+            for (size_t shard = 0; shard < pool.size(); ++shard) {
+                if (auto body = pool.get(shard, path)) {
+                    return *body;
+                }
+            }
+            return std::string();
+        });
+
+        // /executions?since=N pages through the router's own ledger, which
+        // each request first tops up from every shard's cursor: router execIds
+        // are dense across shards, in the order the router collected them.
+        // ?clOrdId=X goes to the owning shard and carries its execIds.
+        std::mutex collectMutex;
+        qfblotter::ExecutionLedger executions;
+        std::vector<uint64_t> shardCursors(pool.size(), 0);
+        auto collectExecutions = [&]() {
+            std::lock_guard<std::mutex> lock(collectMutex);
+            for (size_t shard = 0; shard < pool.size(); ++shard) {
+                uint64_t& cursor = shardCursors[shard];
+                while (true) {
+                    Json page = pool.getJson(shard, "/executions?since=" + std::to_string(cursor) +
+                                                        "&limit=" + std::to_string(EXECUTIONS_PAGE));
+                    if (!page.is_object() || !page["executions"].is_array()) {
+                        break;  // Down: caught up on its next answer
+                    }
+                    if (page.value("total", uint64_t{0}) < cursor) {
+                        cursor = 0;  // Restarted with a new ledger
+                        continue;
+                    }
+                    for (const auto& row : page["executions"]) {
+                        qfblotter::OrderRecord order;
+                        order.clOrdId = row.value("clOrdId", "");
+                        order.orderId = row.value("orderId", "");
+                        order.symbol = row.value("symbol", "");
+                        const std::string side = row.value("side", "1");
+                        order.side = side.empty() ? '1' : side.front();
+                        executions.append(order, row.value("qty", 0), row.value("px", 0.0),
+                                          row.value("timeUs", int64_t{0}), row.value("venue", ""));
+                    }
+                    cursor = page.value("next", cursor);
+                    if (page["executions"].size() < EXECUTIONS_PAGE) {
+                        break;
+                    }
+                }
+            }
+        };
+        http.setExecutionsProvider([&](uint64_t since, size_t limit, const std::string& clOrdId) -> std::string {
+            if (clOrdId.empty()) {
+                collectExecutions();
+                return executions.sinceJson(since, limit).dump();
+            }
+            const std::string path = "/executions?clOrdId=" + clOrdId;
+            if (auto shard = routeOf(clOrdId)) {
+                return pool.get(*shard, path).value_or(std::string());
+            }
+            for (size_t shard = 0; shard < pool.size(); ++shard) {
+                if (auto body = pool.get(shard, path)) {
+                    return *body;
+                }
+            }
+            return std::string();
+        });
+
+        // Each shard's update event is its full snapshot: keep the latest per
+        // shard and publish the union. Its terminal event names the orders
+        // whose routes can go, and is passed on; stats events carry rolling
+        // windows, merged across shards window by window. Ticks are disjoint
+        // by symbol and pass through.
+        std::mutex eventsMutex;
+        std::vector<Json> latestSnapshots(pool.size());
+        std::vector<Json> latestStats(pool.size());
+        StreamMerger events(shardUrls, "/events", [&](size_t shard, const std::string& event, const std::string& data) {
+            Json parsed = Json::parse(data, nullptr, false);
+            if (event == "terminal" && parsed.is_array()) {
+                forgetTerminal(parsed);
+                http.publishTerminal(data);
+                return;
+            }
+            if (event == "stats" && parsed.is_object()) {
+                Json merged = Json::object();
+                {
+                    std::lock_guard<std::mutex> lock(eventsMutex);
+                    latestStats[shard] = std::move(parsed);
+                    for (const auto& item : latestStats[shard].items()) {
+                        const std::string& window = item.key();
+                        std::vector<Json> windows;
+                        windows.reserve(latestStats.size());
+                        for (const auto& shardStats : latestStats) {
+                            windows.push_back(shardStats.is_object() ? shardStats.value(window, Json()) : Json());
+                        }
+                        merged[window] = qfblotter::mergeWindowStats(windows);
+                    }
+                }
+                http.publishStats(merged.dump());
+                return;
+            }
+            if (event != "update" || !parsed.is_array()) {
+                return;
+            }
+            std::string merged;
+            {
+                std::lock_guard<std::mutex> lock(eventsMutex);
+                latestSnapshots[shard] = std::move(parsed);
+                merged = qfblotter::mergeSnapshots(latestSnapshots).dump();
+            }
+            http.publishEvent(merged);
+        });
+        StreamMerger marketData(shardUrls, "/marketdata", [&http](size_t, const std::string& event,
+                                                                  const std::string& data) {
+            if (event == "marketdata") {
+                http.publishMarketData(data);
+            }
+        });
+
+        http.start();
+        events.start();
+        marketData.start();
+        std::signal(SIGINT, signalHandler);
+        std::signal(SIGTERM, signalHandler);
+
+        std::cout << "[ROUTER] HTTP port " << httpPort << ", " << shardUrls.size() << " shard(s)" << std::endl;
+        for (size_t shard = 0; shard < shardUrls.size(); ++shard) {
+            std::cout << "[ROUTER]   " << ring.name(shard) << " -> " << shardUrls[shard] << std::endl;
+        }
+        for (const char* symbol : {"AAPL", "GOOGL", "MSFT", "NVDA", "TSLA", "AMZN"}) {
+            std::cout << "[ROUTER]   " << symbol << " on " << ring.name(ring.shardFor(symbol)) << std::endl;
+        }
+
+        while (!g_shutdown.load()) {
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+        }
+
+        std::cout << "[ROUTER] Shutdown signal received." << std::endl;
+        events.stop();
+        marketData.stop();
+        http.stop();
+    } catch (const std::exception& e) {
+        std::cerr << "[ROUTER] Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
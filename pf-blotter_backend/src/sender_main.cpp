@@ -4,7 +4,6 @@
 #include <unordered_map>
 
 #include <quickfix/Application.h>
-#include <quickfix/FileLog.h>
 #include <quickfix/FileStore.h>
 #include <quickfix/MessageCracker.h>
 #include <quickfix/Session.h>
@@ -13,6 +12,8 @@
 #include <quickfix/fix44/NewOrderSingle.h>
 #include <quickfix/fix44/OrderCancelRequest.h>
 
+#include "qfblotter/AsyncFileLog.hpp"
+#include "qfblotter/FixDictionary.hpp"
 #include "qfblotter/Logger.hpp"
 
 namespace {
@@ -30,12 +31,25 @@ char parse_side(const std::string& token) {
     }
     return '0';
 }
+
+char parse_tif(const std::string& token) {
+    if (token.empty() || token == "DAY") return FIX::TimeInForce_DAY;
+    if (token == "GTC") return FIX::TimeInForce_GOOD_TILL_CANCEL;
+    if (token == "IOC") return FIX::TimeInForce_IMMEDIATE_OR_CANCEL;
+    if (token == "FOK") return FIX::TimeInForce_FILL_OR_KILL;
+    return '\0';
+}
 }  // namespace
 
 class SenderApp final : public FIX::Application, public FIX::MessageCracker {
 public:
+    explicit SenderApp(bool compiledDictionary) : compiledDictionary_(compiledDictionary) {}
+
     void onCreate(const FIX::SessionID& sessionID) override {
         std::cout << "[SENDER] onCreate " << sessionID.toString() << std::endl;
+        if (compiledDictionary_) {
+            qfblotter::useCompiledDataDictionary(sessionID);
+        }
     }
 
     void onLogon(const FIX::SessionID& sessionID) override {
@@ -55,6 +69,9 @@ public:
 
     void fromAdmin(const FIX::Message& message, const FIX::SessionID& sessionID) override {
         std::cout << "[SENDER] fromAdmin " << sessionID.toString() << " " << message.toString() << std::endl;
+        if (compiledDictionary_) {
+            qfblotter::validateCompiled(message);
+        }
     }
 
     void toApp(FIX::Message& message, const FIX::SessionID& sessionID) override {
@@ -63,13 +80,16 @@ public:
 
     void fromApp(const FIX::Message& message, const FIX::SessionID& sessionID) override {
         std::cout << "[SENDER] fromApp " << sessionID.toString() << " " << message.toString() << std::endl;
+        if (compiledDictionary_) {
+            qfblotter::validateCompiled(message);
+        }
         crack(message, sessionID);
     }
 
     bool isReady() const { return loggedOn_; }
 
     bool sendNewOrder(const std::string& clOrdId, const std::string& symbol, char side,
-                      int qty, double price) {
+                      int qty, double price, char tif = FIX::TimeInForce_DAY) {
         if (!loggedOn_) {
             std::cerr << "[SENDER] not logged on\n";
             return false;
@@ -84,7 +104,7 @@ public:
         nos.set(FIX::OrdType(FIX::OrdType_LIMIT));
         nos.set(FIX::OrderQty(qty));
         nos.set(FIX::Price(price));
-        nos.set(FIX::TimeInForce(FIX::TimeInForce_DAY));
+        nos.set(FIX::TimeInForce(tif));
 
         try {
             FIX::Session::sendToTarget(nos, sessionId_);
@@ -149,6 +169,7 @@ public:
     }
 
 private:
+    bool compiledDictionary_;
     bool loggedOn_{false};
     FIX::SessionID sessionId_;
     std::unordered_map<std::string, OrderMeta> orders_;
@@ -160,14 +181,15 @@ int main(int argc, char** argv) {
         cfgPath = argv[1];
     }
 
+    qfblotter::Logger::ShutdownGuard logShutdown;  // Flushes the async logger however main exits
     try {
         qfblotter::Logger::init("qf_sender", "config/log/sender.log");
         auto log = qfblotter::Logger::get();
 
         FIX::SessionSettings settings(cfgPath);
-        SenderApp app;
+        SenderApp app(settings.get().has("CompiledDataDictionary") && settings.get().getBool("CompiledDataDictionary"));
         FIX::FileStoreFactory storeFactory(settings);
-        FIX::FileLogFactory logFactory(settings);
+        qfblotter::AsyncFileLogFactory logFactory(settings);
         FIX::SocketInitiator initiator(app, storeFactory, settings, logFactory);
 
         initiator.start();
@@ -176,7 +198,7 @@ int main(int argc, char** argv) {
         }
         std::cout << "[SENDER] running with " << cfgPath << "\n"
                   << "Commands:\n"
-                  << "  nos <clOrdId> <symbol> <side(Buy|Sell)> <qty> <price>\n"
+                  << "  nos <clOrdId> <symbol> <side(Buy|Sell)> <qty> <price> [DAY|GTC|IOC|FOK]\n"
                   << "  cancel <origClOrdId> <clOrdId> [symbol] [side]\n"
                   << "  help\n"
                   << "  quit\n" << std::endl;
@@ -193,7 +215,7 @@ int main(int argc, char** argv) {
                 break;
             }
             if (cmd == "help") {
-                std::cout << "nos <clOrdId> <symbol> <side(Buy|Sell)> <qty> <price>\n"
+                std::cout << "nos <clOrdId> <symbol> <side(Buy|Sell)> <qty> <price> [DAY|GTC|IOC|FOK]\n"
                           << "cancel <origClOrdId> <clOrdId> [symbol] [side]\n"
                           << "quit\n";
                 continue;
@@ -211,7 +233,14 @@ int main(int argc, char** argv) {
                     std::cerr << "[SENDER] side must be Buy/Sell or 1/2\n";
                     continue;
                 }
-                app.sendNewOrder(clOrdId, symbol, side, qty, price);
+                std::string tifToken;
+                iss >> tifToken;
+                char tif = parse_tif(tifToken);
+                if (tif == '\0') {
+                    std::cerr << "[SENDER] time in force must be DAY, GTC, IOC or FOK\n";
+                    continue;
+                }
+                app.sendNewOrder(clOrdId, symbol, side, qty, price, tif);
                 continue;
             }
             if (cmd == "cancel") {
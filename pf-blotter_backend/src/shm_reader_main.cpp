@@ -0,0 +1,93 @@
+// Example co-located consumer of the gateway's shared-memory feed.
+// Busy-polls the ring, prints every record and a per-second summary of
+// publish-to-read latency. Usage: qf_shm_reader [/shm_name] [--replay] [--quiet]
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+#include "qfblotter/ShmReader.hpp"
+
+namespace {
+std::atomic<bool> g_stop{false};
+
+void signalHandler(int) {
+    g_stop.store(true);
+}
+
+int64_t epoch_ns() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(system_clock::now().time_since_epoch()).count();
+}
+
+void print(const qfblotter::ShmRecord& record) {
+    using qfblotter::shmFieldString;
+    if (record.type == qfblotter::ShmRecordType::TICK) {
+        std::printf("TICK  %-8s %.2f\n", shmFieldString(record.tick.symbol).c_str(), record.tick.price);
+    } else if (record.type == qfblotter::ShmRecordType::ORDER) {
+        const auto& o = record.order;
+        std::printf("ORDER %-16s %-8s %c %-12s qty=%d cum=%d leaves=%d px=%.2f avg=%.2f\n",
+                    shmFieldString(o.clOrdId).c_str(), shmFieldString(o.symbol).c_str(), o.side,
+                    shmFieldString(o.status).c_str(), o.quantity, o.cumQty, o.leavesQty, o.price, o.avgPx);
+    }
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::string name = "/qfblotter_feed";
+    bool replay = false;
+    bool quiet = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--replay") {
+            replay = true;
+        } else if (arg == "--quiet") {
+            quiet = true;
+        } else {
+            name = arg;
+        }
+    }
+
+    std::signal(SIGINT, signalHandler);
+    std::signal(SIGTERM, signalHandler);
+
+    try {
+        qfblotter::ShmReader reader(name, replay);
+        std::cout << "[SHM_READER] attached to " << name << " at seq " << reader.nextSeq() << std::endl;
+
+        qfblotter::ShmRecord record{};
+        uint64_t count = 0;
+        int64_t latencySumNs = 0;
+        auto lastReport = std::chrono::steady_clock::now();
+        while (!g_stop.load(std::memory_order_relaxed)) {
+            auto result = reader.poll(record);
+            if (result == qfblotter::ShmReader::Poll::RECORD) {
+                latencySumNs += epoch_ns() - record.timestampNs;
+                ++count;
+                if (!quiet) {
+                    print(record);
+                }
+            } else if (result == qfblotter::ShmReader::Poll::OVERRUN) {
+                std::cerr << "[SHM_READER] overrun, lost " << reader.lost() << " records so far" << std::endl;
+            }
+
+            auto now = std::chrono::steady_clock::now();
+            if (now - lastReport >= std::chrono::seconds(1)) {
+                if (count > 0) {
+                    std::cerr << "[SHM_READER] " << count << " records/s, avg latency "
+                              << latencySumNs / static_cast<int64_t>(count) << " ns" << std::endl;
+                }
+                count = 0;
+                latencySumNs = 0;
+                lastReport = now;
+            }
+        }
+    } catch (const std::exception& ex) {
+        std::cerr << "[SHM_READER] fatal: " << ex.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
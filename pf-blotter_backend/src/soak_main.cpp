@@ -0,0 +1,744 @@
+// Long-running soak test against a gateway. Drives mixed load for hours:
+// FIX new orders and cancels, HTTP orders, cancels and reads, and SSE
+// subscribers that reconnect periodically. Every interval it samples the
+// gateway's resources (/stats: RSS, heap, fds, threads, SSE backlog, store
+// size) and the latency percentiles seen by the clients into a CSV, and
+// fails once growth since the warmup baseline passes a threshold. The
+// gateway keeps every order for the session by design, so RSS and heap
+// limits grow by --per-order-bytes for each order added since the baseline;
+// only growth beyond that counts as a leak.
+//
+// Usage: qf_soak [--http URL] [--fix-cfg FILE|none] [--duration 4h] [--interval 10s]
+//                [--warmup 2m] [--csv soak.csv] [--fix-rate N] [--http-rate N]
+//                [--read-rate N] [--sse-clients N] [--sse-reconnect 5m]
+//                [--max-rss-growth-mb N] [--max-heap-growth-mb N] [--max-fd-growth N]
+//                [--max-thread-growth N] [--max-backlog N] [--max-p99-ms N]
+//                [--per-order-bytes N]
+// The gateway must run with HttpOrderRateLimit=0 and HttpCancelRateLimit=0.
+// Exits 1 on a threshold breach, listing what grew.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <httplib.h>
+#include <nlohmann/json.hpp>
+
+#include <quickfix/Application.h>
+#include <quickfix/FileStore.h>
+#include <quickfix/MessageCracker.h>
+#include <quickfix/Session.h>
+#include <quickfix/SessionSettings.h>
+#include <quickfix/SocketInitiator.h>
+#include <quickfix/fix44/BusinessMessageReject.h>
+#include <quickfix/fix44/ExecutionReport.h>
+#include <quickfix/fix44/NewOrderSingle.h>
+#include <quickfix/fix44/OrderCancelReject.h>
+#include <quickfix/fix44/OrderCancelRequest.h>
+
+#include "qfblotter/AsyncFileLog.hpp"
+#include "qfblotter/FixDictionary.hpp"
+
+namespace {
+std::atomic<bool> g_shutdown{false};
+
+void signalHandler(int) {
+    g_shutdown.store(true);
+}
+
+using Clock = std::chrono::steady_clock;
+using nlohmann::json;
+
+const std::vector<std::string> SYMBOLS = {"AAPL", "GOOGL", "MSFT", "NVDA", "TSLA", "AMZN"};
+constexpr auto ACK_TIMEOUT = std::chrono::seconds(30);
+constexpr size_t MAX_OPEN_TRACKED = 1000;  // Cancel candidates kept per channel
+constexpr int P99_BREACHES_TO_FAIL = 3;    // Consecutive intervals, so one GC-like spike passes
+constexpr int MISSED_SAMPLES_TO_FAIL = 3;
+
+struct Options {
+    std::string httpUrl{"http://127.0.0.1:8080"};
+    std::string fixCfg{"config/initiator.cfg"};
+    int64_t durationSec{4 * 3600};
+    int64_t intervalSec{10};
+    int64_t warmupSec{120};
+    std::string csvPath{"soak.csv"};
+    double fixRate{20.0};   // New orders per second; every 4th is followed by a cancel
+    double httpRate{5.0};
+    double readRate{20.0};  // /snapshot, /stats, /orderbook and /history, round-robin
+    int sseClients{4};      // Alternating /events and /marketdata
+    int64_t sseReconnectSec{300};
+    int64_t maxRssGrowthKB{256 * 1024};
+    int64_t maxHeapGrowthKB{256 * 1024};
+    int64_t maxFdGrowth{32};
+    int64_t maxThreadGrowth{8};
+    int64_t maxBacklog{4096};
+    int64_t maxP99Us{250'000};
+    int64_t perOrderBytes{2048};  // Store, ledger and TCA state retained per order
+};
+
+// "90", "90s", "15m" or "4h" in seconds; -1 if malformed
+int64_t parseDuration(const std::string& text) {
+    if (text.empty()) {
+        return -1;
+    }
+    int64_t unit = 1;
+    std::string digits = text;
+    switch (digits.back()) {
+        case 's': digits.pop_back(); break;
+        case 'm': digits.pop_back(); unit = 60; break;
+        case 'h': digits.pop_back(); unit = 3600; break;
+        default: break;
+    }
+    if (digits.empty() || !std::all_of(digits.begin(), digits.end(), [](char c) { return c >= '0' && c <= '9'; })) {
+        return -1;
+    }
+    return std::stoll(digits) * unit;
+}
+
+int64_t percentile(std::vector<int64_t>& sorted, double p) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    const auto idx = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1));
+    return sorted[idx];
+}
+
+int64_t elapsedUs(Clock::time_point since) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - since).count();
+}
+
+// Latencies collected between two samples
+class LatencySeries {
+public:
+    void add(int64_t us) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        samples_.push_back(us);
+    }
+
+    // p50 and p99 of the interval; starts the next one
+    std::pair<int64_t, int64_t> drain() {
+        std::vector<int64_t> interval;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            interval.swap(samples_);
+        }
+        std::sort(interval.begin(), interval.end());
+        return {percentile(interval, 0.50), percentile(interval, 0.99)};
+    }
+
+private:
+    std::mutex mutex_;
+    std::vector<int64_t> samples_;
+};
+
+struct Counters {
+    std::atomic<uint64_t> fixSent{0};
+    std::atomic<uint64_t> fixRejected{0};  // Order, cancel and business rejects
+    std::atomic<uint64_t> fixTimeouts{0};
+    std::atomic<uint64_t> httpSent{0};
+    std::atomic<uint64_t> httpRejected{0};
+    std::atomic<uint64_t> httpShed{0};     // 503 from admission control
+    std::atomic<uint64_t> reads{0};
+    std::atomic<uint64_t> sseEvents{0};
+    std::atomic<uint64_t> sseReconnects{0};
+    std::atomic<uint64_t> errors{0};       // Transport failures
+};
+
+// Latest price per symbol from the /marketdata stream, to price orders near
+// the market
+class Marks {
+public:
+    void update(const std::string& symbol, double price) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        prices_[symbol] = price;
+    }
+
+    double get(const std::string& symbol) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = prices_.find(symbol);
+        return it == prices_.end() ? 100.0 : it->second;
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, double> prices_;
+};
+
+// Fixed-rate loop: runs `step` `rate` times a second until shutdown
+template <typename Step>
+void paced(double rate, Step&& step) {
+    if (rate <= 0.0) {
+        return;
+    }
+    const auto period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / rate));
+    auto next = Clock::now();
+    while (!g_shutdown.load()) {
+        step();
+        next += period;
+        const auto now = Clock::now();
+        if (next < now) {
+            next = now;  // Fell behind: do not burst to catch up
+        }
+        std::this_thread::sleep_until(next);
+    }
+}
+
+class SoakFixApp final : public FIX::Application, public FIX::MessageCracker {
+public:
+    SoakFixApp(bool compiledDictionary, Counters& counters, LatencySeries& ackLatency)
+        : compiledDictionary_(compiledDictionary), counters_(counters), ackLatency_(ackLatency) {}
+
+    void onCreate(const FIX::SessionID& sessionID) override {
+        if (compiledDictionary_) {
+            qfblotter::useCompiledDataDictionary(sessionID);
+        }
+    }
+
+    void onLogon(const FIX::SessionID& sessionID) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        sessionId_ = sessionID;
+        loggedOn_ = true;
+    }
+
+    void onLogout(const FIX::SessionID&) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        loggedOn_ = false;
+    }
+
+    void toAdmin(FIX::Message&, const FIX::SessionID&) override {}
+    void fromAdmin(const FIX::Message&, const FIX::SessionID&) override {}
+    void toApp(FIX::Message&, const FIX::SessionID&) override {}
+
+    void fromApp(const FIX::Message& message, const FIX::SessionID& sessionID) override {
+        crack(message, sessionID);
+    }
+
+    void onMessage(const FIX44::ExecutionReport& report, const FIX::SessionID&) override {
+        FIX::ClOrdID clOrdId;
+        FIX::ExecType execType;
+        report.get(clOrdId);
+        report.get(execType);
+        const char type = execType.getValue();
+        if (type != FIX::ExecType_NEW && type != FIX::ExecType_REJECTED) {
+            return;
+        }
+        if (type == FIX::ExecType_REJECTED) {
+            counters_.fixRejected.fetch_add(1, std::memory_order_relaxed);
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = pending_.find(clOrdId.getValue());
+        if (it == pending_.end()) {
+            return;  // Not ours (another session's order on a shared stream) or already timed out
+        }
+        ackLatency_.add(elapsedUs(it->second.sentAt));
+        if (type == FIX::ExecType_NEW) {
+            open_.push_back({it->first, it->second.symbol, it->second.side});
+            if (open_.size() > MAX_OPEN_TRACKED) {
+                open_.pop_front();
+            }
+        }
+        pending_.erase(it);
+    }
+
+    void onMessage(const FIX44::OrderCancelReject&, const FIX::SessionID&) override {
+        counters_.fixRejected.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void onMessage(const FIX44::BusinessMessageReject& reject, const FIX::SessionID&) override {
+        counters_.fixRejected.fetch_add(1, std::memory_order_relaxed);
+        FIX::BusinessRejectRefID refId;
+        if (reject.isSetField(refId)) {
+            reject.get(refId);
+            std::lock_guard<std::mutex> lock(mutex_);
+            pending_.erase(refId.getValue());  // Shed by admission control
+        }
+    }
+
+    // One new order near the market; every 4th call also cancels the oldest
+    // acknowledged order
+    void step(std::mt19937& rng, const Marks& marks) {
+        FIX::SessionID session;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!loggedOn_) {
+                return;
+            }
+            session = sessionId_;
+        }
+        const std::string& symbol = SYMBOLS[rng() % SYMBOLS.size()];
+        const char side = rng() % 2 == 0 ? FIX::Side_BUY : FIX::Side_SELL;
+        const double offset = std::uniform_real_distribution<double>(-0.01, 0.01)(rng);
+        const double price = std::round(marks.get(symbol) * (1.0 + offset) * 100.0) / 100.0;
+        const std::string clOrdId = "SOAK_F" + std::to_string(++sequence_);
+
+        FIX44::NewOrderSingle nos;
+        nos.set(FIX::ClOrdID(clOrdId));
+        nos.set(FIX::HandlInst(FIX::HandlInst_AUTOMATED_EXECUTION_ORDER_PRIVATE_NO_BROKER_INTERVENTION));
+        nos.set(FIX::Symbol(symbol));
+        nos.set(FIX::Side(side));
+        nos.set(FIX::TransactTime());
+        nos.set(FIX::OrdType(FIX::OrdType_LIMIT));
+        nos.set(FIX::OrderQty(static_cast<double>(1 + rng() % 100)));
+        nos.set(FIX::Price(price));
+        nos.set(FIX::TimeInForce(sequence_ % 5 == 0 ? FIX::TimeInForce_IMMEDIATE_OR_CANCEL : FIX::TimeInForce_DAY));
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            pending_[clOrdId] = Pending{Clock::now(), symbol, side};
+        }
+        send(nos, session);
+
+        if (sequence_ % 4 != 0) {
+            return;
+        }
+        OpenOrder target;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (open_.empty()) {
+                return;
+            }
+            target = std::move(open_.front());
+            open_.pop_front();
+        }
+        FIX44::OrderCancelRequest cancel;
+        cancel.set(FIX::OrigClOrdID(target.clOrdId));
+        cancel.set(FIX::ClOrdID(target.clOrdId + "_CXL"));
+        cancel.set(FIX::Side(target.side));
+        cancel.set(FIX::TransactTime());
+        cancel.set(FIX::Symbol(target.symbol));
+        send(cancel, session);
+    }
+
+    // Drops orders never acknowledged, so a lost ack cannot grow the client
+    void expirePending() {
+        const auto cutoff = Clock::now() - ACK_TIMEOUT;
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto it = pending_.begin(); it != pending_.end();) {
+            if (it->second.sentAt < cutoff) {
+                counters_.fixTimeouts.fetch_add(1, std::memory_order_relaxed);
+                it = pending_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+private:
+    struct Pending {
+        Clock::time_point sentAt;
+        std::string symbol;
+        char side{'1'};
+    };
+    struct OpenOrder {
+        std::string clOrdId;
+        std::string symbol;
+        char side{'1'};
+    };
+
+    void send(FIX::Message& message, const FIX::SessionID& session) {
+        try {
+            FIX::Session::sendToTarget(message, session);
+            counters_.fixSent.fetch_add(1, std::memory_order_relaxed);
+        } catch (const FIX::SessionNotFound&) {
+            counters_.errors.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    const bool compiledDictionary_;
+    Counters& counters_;
+    LatencySeries& ackLatency_;
+    std::mutex mutex_;
+    bool loggedOn_{false};
+    FIX::SessionID sessionId_;
+    uint64_t sequence_{0};  // Only the FIX load thread sends
+    std::unordered_map<std::string, Pending> pending_;
+    std::deque<OpenOrder> open_;
+};
+
+// HTTP orders near the market; every 4th is followed by a cancel of an
+// earlier one (which may already be filled: a reject, not an error)
+void httpOrderLoop(const Options& options, const Marks& marks, Counters& counters, LatencySeries& latency) {
+    httplib::Client client(options.httpUrl);
+    client.set_keep_alive(true);
+    client.set_read_timeout(5);
+    std::mt19937 rng(7);
+    std::deque<std::string> recent;
+    uint64_t sequence = 0;
+    paced(options.httpRate, [&]() {
+        const std::string& symbol = SYMBOLS[rng() % SYMBOLS.size()];
+        const double offset = std::uniform_real_distribution<double>(-0.01, 0.01)(rng);
+        json order;
+        order["clOrdId"] = "SOAK_H" + std::to_string(++sequence);
+        order["symbol"] = symbol;
+        order["side"] = rng() % 2 == 0 ? "Buy" : "Sell";
+        order["quantity"] = static_cast<int>(1 + rng() % 100);
+        order["price"] = std::round(marks.get(symbol) * (1.0 + offset) * 100.0) / 100.0;
+        order["timeInForce"] = sequence % 5 == 0 ? "IOC" : "DAY";
+
+        const auto sentAt = Clock::now();
+        auto res = client.Post("/order", order.dump(), "application/json");
+        if (!res) {
+            counters.errors.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        latency.add(elapsedUs(sentAt));
+        counters.httpSent.fetch_add(1, std::memory_order_relaxed);
+        if (res->status == 503) {
+            counters.httpShed.fetch_add(1, std::memory_order_relaxed);
+        } else if (res->status != 200) {
+            counters.httpRejected.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            recent.push_back(order["clOrdId"].get<std::string>());
+            if (recent.size() > MAX_OPEN_TRACKED) {
+                recent.pop_front();
+            }
+        }
+
+        if (sequence % 4 == 0 && !recent.empty()) {
+            json cancel;
+            cancel["origClOrdId"] = recent.front();
+            recent.pop_front();
+            auto cancelRes = client.Post("/cancel", cancel.dump(), "application/json");
+            if (!cancelRes) {
+                counters.errors.fetch_add(1, std::memory_order_relaxed);
+            } else if (cancelRes->status != 200) {
+                counters.httpRejected.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    });
+}
+
+void readLoop(const Options& options, Counters& counters, LatencySeries& latency) {
+    httplib::Client client(options.httpUrl);
+    client.set_keep_alive(true);
+    client.set_read_timeout(5);
+    size_t next = 0;
+    paced(options.readRate, [&]() {
+        const std::string& symbol = SYMBOLS[next % SYMBOLS.size()];
+        const std::string paths[] = {"/snapshot", "/stats", "/orderbook?symbol=" + symbol,
+                                     "/history?symbol=" + symbol + "&interval=1m&n=100"};
+        const auto sentAt = Clock::now();
+        auto res = client.Get(paths[next++ % 4]);
+        if (!res) {
+            counters.errors.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        latency.add(elapsedUs(sentAt));
+        counters.reads.fetch_add(1, std::memory_order_relaxed);
+    });
+}
+
+// Follows one SSE stream, reconnecting every `sseReconnectSec` so subscriber
+// setup and teardown are exercised too. The /marketdata stream feeds `marks`.
+void sseLoop(const Options& options, const std::string& path, Marks* marks, Counters& counters) {
+    while (!g_shutdown.load()) {
+        httplib::Client client(options.httpUrl);
+        client.set_connection_timeout(2);
+        client.set_read_timeout(10);  // The gateway pings at least every 5s
+        const auto reconnectAt = Clock::now() + std::chrono::seconds(options.sseReconnectSec);
+        std::string buffer;
+        client.Get(path, [&](const char* data, size_t len) {
+            buffer.append(data, len);
+            for (size_t end = buffer.find("\n\n"); end != std::string::npos; end = buffer.find("\n\n")) {
+                const std::string frame = buffer.substr(0, end);
+                buffer.erase(0, end + 2);
+                const size_t pos = frame.find("data: ");
+                if (pos == std::string::npos) {
+                    continue;  // Keep-alive ping
+                }
+                counters.sseEvents.fetch_add(1, std::memory_order_relaxed);
+                if (marks != nullptr && frame.rfind("event: marketdata\n", 0) == 0) {
+                    json ticks = json::parse(frame.substr(pos + 6), nullptr, false);
+                    if (ticks.is_array()) {
+                        for (const auto& tick : ticks) {
+                            marks->update(tick.value("symbol", ""), tick.value("price", 100.0));
+                        }
+                    }
+                }
+            }
+            return !g_shutdown.load() && Clock::now() < reconnectAt;
+        });
+        counters.sseReconnects.fetch_add(1, std::memory_order_relaxed);
+        for (int i = 0; i < 10 && !g_shutdown.load(); ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        }
+    }
+}
+
+// One CSV row: the gateway's /stats plus the clients' view of the interval
+struct Sample {
+    int64_t elapsedSec{0};
+    int64_t rssKB{-1};
+    int64_t heapUsedKB{-1};
+    int64_t openFds{-1};
+    int64_t threads{-1};
+    int64_t totalOrders{0};
+    int64_t sseBacklog{0};
+    int64_t gatewayAckP50Us{0};
+    int64_t gatewayAckP99Us{0};
+    std::pair<int64_t, int64_t> fixAck;
+    std::pair<int64_t, int64_t> httpOrder;
+    std::pair<int64_t, int64_t> httpRead;
+};
+
+std::optional<json> getJson(httplib::Client& client, const std::string& path) {
+    auto res = client.Get(path);
+    if (!res || res->status != 200) {
+        return std::nullopt;
+    }
+    json j = json::parse(res->body, nullptr, false);
+    if (j.is_discarded()) {
+        return std::nullopt;
+    }
+    return j;
+}
+
+const char* CSV_HEADER =
+    "elapsed_s,rss_kb,heap_used_kb,open_fds,threads,total_orders,sse_backlog,"
+    "gw_ack_p50_us,gw_ack_p99_us,fix_ack_p50_us,fix_ack_p99_us,http_order_p50_us,http_order_p99_us,"
+    "http_read_p50_us,http_read_p99_us,fix_sent,fix_rejected,fix_timeouts,http_sent,http_rejected,"
+    "http_shed,reads,sse_events,sse_reconnects,errors";
+
+void writeRow(std::ofstream& csv, const Sample& s, const Counters& c) {
+    csv << s.elapsedSec << ',' << s.rssKB << ',' << s.heapUsedKB << ',' << s.openFds << ',' << s.threads << ','
+        << s.totalOrders << ',' << s.sseBacklog << ',' << s.gatewayAckP50Us << ',' << s.gatewayAckP99Us << ','
+        << s.fixAck.first << ',' << s.fixAck.second << ',' << s.httpOrder.first << ',' << s.httpOrder.second << ','
+        << s.httpRead.first << ',' << s.httpRead.second << ',' << c.fixSent.load() << ',' << c.fixRejected.load()
+        << ',' << c.fixTimeouts.load() << ',' << c.httpSent.load() << ',' << c.httpRejected.load() << ','
+        << c.httpShed.load() << ',' << c.reads.load() << ',' << c.sseEvents.load() << ','
+        << c.sseReconnects.load() << ',' << c.errors.load() << '\n';
+    csv.flush();  // A killed run still leaves its samples
+}
+
+// Threshold breaches of `s` against the warmup `baseline`
+std::vector<std::string> checkGrowth(const Options& o, const Sample& baseline, const Sample& s) {
+    std::vector<std::string> breaches;
+    auto grew = [&breaches](const char* what, int64_t from, int64_t to, int64_t limit, const char* unit) {
+        if (from >= 0 && to >= 0 && to - from > limit) {
+            breaches.push_back(std::string(what) + " grew " + std::to_string(to - from) + unit + " (" +
+                               std::to_string(from) + " -> " + std::to_string(to) + ", limit " +
+                               std::to_string(limit) + unit + ")");
+        }
+    };
+    // Orders are retained for the session, so memory may grow with them
+    const int64_t orderAllowanceKB = std::max<int64_t>(0, s.totalOrders - baseline.totalOrders) * o.perOrderBytes / 1024;
+    grew("RSS", baseline.rssKB, s.rssKB, o.maxRssGrowthKB + orderAllowanceKB, "KB");
+    grew("heap", baseline.heapUsedKB, s.heapUsedKB, o.maxHeapGrowthKB + orderAllowanceKB, "KB");
+    grew("open fds", baseline.openFds, s.openFds, o.maxFdGrowth, "");
+    grew("threads", baseline.threads, s.threads, o.maxThreadGrowth, "");
+    if (s.sseBacklog > o.maxBacklog) {
+        breaches.push_back("SSE backlog " + std::to_string(s.sseBacklog) + " events (limit " +
+                           std::to_string(o.maxBacklog) + ")");
+    }
+    return breaches;
+}
+
+bool parseArgs(int argc, char** argv, Options& o) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            return false;
+        }
+        const std::string value = argv[++i];
+        auto duration = [&value]() { return parseDuration(value); };
+        if (arg == "--http") o.httpUrl = value;
+        else if (arg == "--fix-cfg") o.fixCfg = value;
+        else if (arg == "--duration") o.durationSec = duration();
+        else if (arg == "--interval") o.intervalSec = duration();
+        else if (arg == "--warmup") o.warmupSec = duration();
+        else if (arg == "--csv") o.csvPath = value;
+        else if (arg == "--fix-rate") o.fixRate = std::stod(value);
+        else if (arg == "--http-rate") o.httpRate = std::stod(value);
+        else if (arg == "--read-rate") o.readRate = std::stod(value);
+        else if (arg == "--sse-clients") o.sseClients = std::stoi(value);
+        else if (arg == "--sse-reconnect") o.sseReconnectSec = duration();
+        else if (arg == "--max-rss-growth-mb") o.maxRssGrowthKB = std::stoll(value) * 1024;
+        else if (arg == "--max-heap-growth-mb") o.maxHeapGrowthKB = std::stoll(value) * 1024;
+        else if (arg == "--max-fd-growth") o.maxFdGrowth = std::stoll(value);
+        else if (arg == "--max-thread-growth") o.maxThreadGrowth = std::stoll(value);
+        else if (arg == "--max-backlog") o.maxBacklog = std::stoll(value);
+        else if (arg == "--max-p99-ms") o.maxP99Us = std::stoll(value) * 1000;
+        else if (arg == "--per-order-bytes") o.perOrderBytes = std::stoll(value);
+        else return false;
+    }
+    return o.durationSec > 0 && o.intervalSec > 0 && o.warmupSec >= 0 && o.sseReconnectSec > 0 &&
+           o.perOrderBytes >= 0;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    try {
+        if (!parseArgs(argc, argv, options)) {
+            std::cerr << "Usage: qf_soak [--http URL] [--fix-cfg FILE|none] [--duration 4h] [--interval 10s]\n"
+                         "               [--warmup 2m] [--csv soak.csv] [--fix-rate N] [--http-rate N]\n"
+                         "               [--read-rate N] [--sse-clients N] [--sse-reconnect 5m]\n"
+                         "               [--max-rss-growth-mb N] [--max-heap-growth-mb N] [--max-fd-growth N]\n"
+                         "               [--max-thread-growth N] [--max-backlog N] [--max-p99-ms N]\n"
+                         "               [--per-order-bytes N]"
+                      << std::endl;
+            return 1;
+        }
+    } catch (const std::exception&) {
+        std::cerr << "[SOAK] Invalid numeric argument" << std::endl;
+        return 1;
+    }
+
+    std::signal(SIGINT, signalHandler);
+    std::signal(SIGTERM, signalHandler);
+
+    std::ofstream csv(options.csvPath);
+    if (!csv) {
+        std::cerr << "[SOAK] Cannot write " << options.csvPath << std::endl;
+        return 1;
+    }
+    csv << CSV_HEADER << '\n';
+
+    Counters counters;
+    Marks marks;
+    LatencySeries fixAck, httpOrder, httpRead;
+
+    try {
+        std::unique_ptr<FIX::SessionSettings> fixSettings;
+        std::unique_ptr<SoakFixApp> fixApp;
+        std::unique_ptr<FIX::FileStoreFactory> storeFactory;
+        std::unique_ptr<qfblotter::AsyncFileLogFactory> logFactory;
+        std::unique_ptr<FIX::SocketInitiator> initiator;
+        if (options.fixCfg != "none") {
+            fixSettings = std::make_unique<FIX::SessionSettings>(options.fixCfg);
+            const bool compiled = fixSettings->get().has("CompiledDataDictionary") &&
+                                  fixSettings->get().getBool("CompiledDataDictionary");
+            fixApp = std::make_unique<SoakFixApp>(compiled, counters, fixAck);
+            storeFactory = std::make_unique<FIX::FileStoreFactory>(*fixSettings);
+            logFactory = std::make_unique<qfblotter::AsyncFileLogFactory>(*fixSettings);
+            initiator = std::make_unique<FIX::SocketInitiator>(*fixApp, *storeFactory, *fixSettings, *logFactory);
+            initiator->start();
+        }
+
+        std::vector<std::thread> workers;
+        for (int i = 0; i < options.sseClients; ++i) {
+            const bool market = i % 2 == 1;
+            workers.emplace_back(sseLoop, std::cref(options), market ? "/marketdata" : "/events",
+                                 market && i == 1 ? &marks : nullptr, std::ref(counters));
+        }
+        if (fixApp) {
+            workers.emplace_back([&]() {
+                std::mt19937 rng(42);
+                paced(options.fixRate, [&]() { fixApp->step(rng, marks); });
+            });
+        }
+        workers.emplace_back(httpOrderLoop, std::cref(options), std::cref(marks), std::ref(counters),
+                             std::ref(httpOrder));
+        workers.emplace_back(readLoop, std::cref(options), std::ref(counters), std::ref(httpRead));
+
+        std::cout << "[SOAK] " << options.httpUrl << (fixApp ? " + FIX " + options.fixCfg : std::string())
+                  << " for " << options.durationSec << "s, sampling every " << options.intervalSec << "s into "
+                  << options.csvPath << std::endl;
+
+        httplib::Client statsClient(options.httpUrl);
+        statsClient.set_read_timeout(5);
+        const auto start = Clock::now();
+        const auto end = start + std::chrono::seconds(options.durationSec);
+        auto nextSample = start;
+        std::optional<Sample> baseline;
+        std::vector<std::string> failures;
+        int p99Breaches = 0;
+        int missedSamples = 0;
+        while (!g_shutdown.load() && Clock::now() < end && failures.empty()) {
+            nextSample += std::chrono::seconds(options.intervalSec);
+            while (!g_shutdown.load() && Clock::now() < nextSample) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            }
+            if (fixApp) {
+                fixApp->expirePending();
+            }
+
+            Sample sample;
+            sample.elapsedSec = std::chrono::duration_cast<std::chrono::seconds>(Clock::now() - start).count();
+            sample.fixAck = fixAck.drain();
+            sample.httpOrder = httpOrder.drain();
+            sample.httpRead = httpRead.drain();
+            const auto stats = getJson(statsClient, "/stats");
+            if (!stats) {
+                if (++missedSamples >= MISSED_SAMPLES_TO_FAIL) {
+                    failures.push_back("gateway /stats unreachable for " + std::to_string(missedSamples) + " samples");
+                }
+                continue;
+            }
+            missedSamples = 0;
+            sample.rssKB = stats->value("rssKB", int64_t{-1});
+            sample.heapUsedKB = stats->value("heapUsedKB", int64_t{-1});
+            sample.openFds = stats->value("openFds", int64_t{-1});
+            sample.threads = stats->value("threads", int64_t{-1});
+            sample.totalOrders = stats->value("totalOrders", int64_t{0});
+            sample.sseBacklog = stats->value("sseBacklog", int64_t{0});
+            if (const auto window = getJson(statsClient, "/stats?window=60s"); window && window->contains("latency")) {
+                sample.gatewayAckP50Us = (*window)["latency"].value("p50Us", int64_t{0});
+                sample.gatewayAckP99Us = (*window)["latency"].value("p99Us", int64_t{0});
+            }
+            writeRow(csv, sample, counters);
+
+            if (sample.elapsedSec < options.warmupSec) {
+                continue;
+            }
+            if (!baseline) {
+                baseline = sample;  // Growth is measured from the first post-warmup sample
+                std::cout << "[SOAK] Baseline at " << sample.elapsedSec << "s: RSS " << sample.rssKB << "KB, heap "
+                          << sample.heapUsedKB << "KB, " << sample.openFds << " fds, " << sample.threads
+                          << " threads" << std::endl;
+                continue;
+            }
+            failures = checkGrowth(options, *baseline, sample);
+            const int64_t p99 = std::max(sample.fixAck.second, sample.httpOrder.second);
+            p99Breaches = p99 > options.maxP99Us ? p99Breaches + 1 : 0;
+            if (p99Breaches >= P99_BREACHES_TO_FAIL) {
+                failures.push_back("order p99 " + std::to_string(p99) + "us over " +
+                                   std::to_string(options.maxP99Us) + "us for " + std::to_string(p99Breaches) +
+                                   " intervals");
+            }
+            std::cout << "[SOAK] " << sample.elapsedSec << "s: RSS " << sample.rssKB << "KB, " << sample.totalOrders
+                      << " orders, p99 FIX " << sample.fixAck.second << "us / HTTP " << sample.httpOrder.second
+                      << "us, " << counters.errors.load() << " errors" << std::endl;
+        }
+
+        g_shutdown.store(true);
+        for (auto& t : workers) {
+            t.join();
+        }
+        if (initiator) {
+            initiator->stop();
+        }
+
+        if (!failures.empty()) {
+            for (const auto& failure : failures) {
+                std::cerr << "[SOAK] FAIL: " << failure << std::endl;
+            }
+            return 1;
+        }
+        std::cout << "[SOAK] PASS: " << counters.fixSent.load() << " FIX and " << counters.httpSent.load()
+                  << " HTTP orders, " << counters.reads.load() << " reads, " << counters.sseEvents.load()
+                  << " SSE events, " << counters.errors.load() << " transport errors" << std::endl;
+    } catch (const FIX::ConfigError& e) {
+        std::cerr << "[SOAK] ConfigError: " << e.what() << std::endl;
+        return 1;
+    } catch (const std::exception& e) {
+        std::cerr << "[SOAK] Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,184 @@
+#include <gtest/gtest.h>
+#include "qfblotter/AdmissionControl.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace qfblotter;
+using Priority = AdmissionControl::Priority;
+
+namespace {
+int64_t percentile(std::vector<int64_t> samples, size_t pct) {
+    if (samples.empty()) {
+        return 0;
+    }
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() * pct / 100];
+}
+}  // namespace
+
+// Test: A backed-up downstream queue sheds new orders; cancels pass until the headroom
+TEST(AdmissionControlTest, ShedsOnQueueDepth) {
+    AdmissionControl::Options options;
+    options.cancelHeadroom = 2.0;
+    AdmissionControl admission(options);
+    std::atomic<size_t> depth{0};
+    admission.addQueue("events", [&depth]() { return depth.load(); }, 100);
+
+    EXPECT_TRUE(admission.admit(Priority::NEW_ORDER));
+
+    depth = 100;
+    auto shed = admission.admit(Priority::NEW_ORDER);
+    EXPECT_FALSE(shed);
+    EXPECT_GE(shed.retryAfterMs(), options.minRetryAfter.count());
+    EXPECT_TRUE(admission.admit(Priority::CANCEL));
+    EXPECT_EQ(admission.stats().saturatedQueue, "events");
+
+    depth = 200;
+    EXPECT_FALSE(admission.admit(Priority::CANCEL));
+
+    depth = 0;
+    EXPECT_TRUE(admission.admit(Priority::NEW_ORDER));
+    const auto stats = admission.stats();
+    EXPECT_EQ(stats.admitted, 3u);
+    EXPECT_EQ(stats.shedNewOrders, 1u);
+    EXPECT_EQ(stats.shedCancels, 1u);
+    EXPECT_EQ(stats.inFlight, 0u);
+    EXPECT_TRUE(stats.saturatedQueue.empty());
+}
+
+// Test: A freed slot goes to a waiting cancel before an earlier waiting new order
+TEST(AdmissionControlTest, CancelsTakeSlotsFirst) {
+    AdmissionControl::Options options;
+    options.maxInFlight = 1;
+    options.maxQueueWait = std::chrono::milliseconds(2000);
+    AdmissionControl admission(options);
+
+    auto holder = admission.admit(Priority::NEW_ORDER);
+    ASSERT_TRUE(holder);
+
+    std::mutex mutex;
+    std::vector<std::string> order;
+    std::thread newOrder([&] {
+        auto ticket = admission.admit(Priority::NEW_ORDER);
+        std::lock_guard<std::mutex> lock(mutex);
+        order.push_back(ticket ? "new" : "shed");
+    });
+    while (admission.stats().queued < 1) {
+        std::this_thread::yield();
+    }
+    std::thread cancel([&] {
+        auto ticket = admission.admit(Priority::CANCEL);
+        std::lock_guard<std::mutex> lock(mutex);
+        order.push_back("cancel");
+    });
+    while (admission.stats().queued < 2) {
+        std::this_thread::yield();
+    }
+
+    holder.release();
+    newOrder.join();
+    cancel.join();
+    EXPECT_EQ(order, (std::vector<std::string>{"cancel", "new"}));
+}
+
+// Test: tryAdmit sheds at once when every slot is taken, and a waiting
+// cancel gives up after maxCancelWait instead of blocking forever
+TEST(AdmissionControlTest, NonBlockingAndBoundedCancelWait) {
+    AdmissionControl::Options options;
+    options.maxInFlight = 1;
+    options.maxQueueWait = std::chrono::milliseconds(2000);
+    options.maxCancelWait = std::chrono::milliseconds(20);
+    AdmissionControl admission(options);
+
+    auto holder = admission.tryAdmit(Priority::NEW_ORDER);
+    ASSERT_TRUE(holder);
+
+    auto order = admission.tryAdmit(Priority::NEW_ORDER);
+    EXPECT_FALSE(order);
+    EXPECT_GE(order.retryAfterMs(), options.minRetryAfter.count());
+    EXPECT_FALSE(admission.tryAdmit(Priority::CANCEL));
+    EXPECT_EQ(admission.stats().queued, 0u);
+
+    EXPECT_FALSE(admission.admit(Priority::CANCEL));
+    auto stats = admission.stats();
+    EXPECT_EQ(stats.shedNewOrders, 1u);
+    EXPECT_EQ(stats.shedCancels, 2u);
+    EXPECT_EQ(stats.queued, 0u);
+
+    holder.release();
+    EXPECT_TRUE(admission.tryAdmit(Priority::CANCEL));
+}
+
+// Test: With far more offered load than capacity, shed orders get a retry
+// hint, cancels all get through ahead of the queued orders, and admitted
+// waits stay bounded. Wall-clock bounds are loose, for loaded CI runners;
+// the priority check is relative.
+TEST(AdmissionControlTest, BoundedLatencyUnderOverload) {
+    using Clock = std::chrono::steady_clock;
+    constexpr auto WORK = std::chrono::milliseconds(1);
+    AdmissionControl::Options options;
+    options.maxInFlight = 2;
+    options.maxQueueWait = std::chrono::milliseconds(10);
+    AdmissionControl admission(options);
+
+    std::mutex mutex;
+    std::vector<int64_t> orderWaitUs;
+    std::vector<int64_t> cancelWaitUs;
+    std::atomic<uint64_t> shedOrders{0};
+    std::atomic<uint64_t> retryHints{0};
+    std::atomic<bool> running{true};
+
+    // 48 clients submitting back to back: ~24x what two 1ms slots can serve,
+    // so without shedding each would queue ~24ms and growing with the load
+    auto client = [&](Priority priority) {
+        while (running.load()) {
+            const auto start = Clock::now();
+            auto ticket = admission.admit(priority);
+            const auto waitUs = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+            if (!ticket) {
+                ++shedOrders;
+                if (ticket.retryAfterMs() > 0) {
+                    ++retryHints;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));  // Impatient client
+                continue;
+            }
+            std::this_thread::sleep_for(WORK);  // Processing
+            ticket.release();
+            std::lock_guard<std::mutex> lock(mutex);
+            (priority == Priority::CANCEL ? cancelWaitUs : orderWaitUs).push_back(waitUs);
+        }
+    };
+    std::vector<std::thread> clients;
+    for (int i = 0; i < 46; ++i) {
+        clients.emplace_back(client, Priority::NEW_ORDER);
+    }
+    for (int i = 0; i < 2; ++i) {
+        clients.emplace_back(client, Priority::CANCEL);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(400));
+    running = false;
+    for (auto& t : clients) {
+        t.join();
+    }
+
+    const auto stats = admission.stats();
+    EXPECT_GT(shedOrders.load(), 0u);
+    EXPECT_EQ(retryHints.load(), shedOrders.load());
+    EXPECT_EQ(stats.shedCancels, 0u);
+    EXPECT_EQ(stats.inFlight, 0u);
+    ASSERT_FALSE(orderWaitUs.empty());
+    ASSERT_FALSE(cancelWaitUs.empty());
+    // Cancels take freed slots first, so they wait well below queued orders
+    EXPECT_LT(percentile(cancelWaitUs, 50) * 2, percentile(orderWaitUs, 50));
+    // maxQueueWait plus generous scheduling slack: without shedding the
+    // queue would grow for the whole run
+    EXPECT_LT(percentile(orderWaitUs, 99), 100000);
+    EXPECT_LT(percentile(cancelWaitUs, 99), 100000);
+}
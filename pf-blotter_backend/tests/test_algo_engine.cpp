@@ -0,0 +1,284 @@
+#include <gtest/gtest.h>
+#include "qfblotter/AlgoEngine.hpp"
+
+#include <chrono>
+
+using namespace qfblotter;
+
+class AlgoEngineTest : public ::testing::Test {
+protected:
+    AlgoEngine engine;
+    std::vector<ChildOrder> routed;
+    int64_t start{0};
+
+    void SetUp() override {
+        using namespace std::chrono;
+        start = duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
+        engine.setChildRouter([this](const ChildOrder& child) {
+            routed.push_back(child);
+            return true;
+        });
+    }
+
+    AlgoParams params(const std::string& id, AlgoStrategy strategy, int qty, int slices) {
+        AlgoParams p;
+        p.parentId = id;
+        p.symbol = "AAPL";
+        p.side = '1';
+        p.quantity = qty;
+        p.strategy = strategy;
+        p.startMs = start;
+        p.sliceMs = 1'000;
+        p.endMs = start + slices * p.sliceMs;
+        return p;
+    }
+
+    int routedQty() const {
+        int total = 0;
+        for (const auto& child : routed) {
+            total += child.quantity;
+        }
+        return total;
+    }
+};
+
+// Test: TWAP releases evenly and the final slice takes the remainder
+TEST_F(AlgoEngineTest, TwapTargets) {
+    auto p = params("T", AlgoStrategy::TWAP, 1000, 3);
+    EXPECT_EQ(AlgoEngine::targetQty(p, 0, 3, 0), 333);
+    EXPECT_EQ(AlgoEngine::targetQty(p, 1, 3, 0), 666);
+    EXPECT_EQ(AlgoEngine::targetQty(p, 2, 3, 0), 1000);
+}
+
+// Test: VWAP curve is monotonic, front- and back-loaded
+TEST_F(AlgoEngineTest, VwapCurveShape) {
+    EXPECT_DOUBLE_EQ(AlgoEngine::vwapCurve(0.0), 0.0);
+    EXPECT_DOUBLE_EQ(AlgoEngine::vwapCurve(1.0), 1.0);
+    double prev = 0.0;
+    for (int i = 1; i <= 100; ++i) {
+        double v = AlgoEngine::vwapCurve(i / 100.0);
+        EXPECT_GE(v, prev);
+        prev = v;
+    }
+    // First and last tenth of the window trade more than a middle tenth
+    double first = AlgoEngine::vwapCurve(0.1);
+    double middle = AlgoEngine::vwapCurve(0.55) - AlgoEngine::vwapCurve(0.45);
+    double last = 1.0 - AlgoEngine::vwapCurve(0.9);
+    EXPECT_GT(first, middle);
+    EXPECT_GT(last, middle);
+}
+
+// Test: POV follows printed volume and never exceeds the parent
+TEST_F(AlgoEngineTest, PovTargets) {
+    auto p = params("P", AlgoStrategy::POV, 500, 10);
+    p.participation = 0.2;
+    EXPECT_EQ(AlgoEngine::targetQty(p, 0, 10, 1000), 200);
+    EXPECT_EQ(AlgoEngine::targetQty(p, 9, 10, 1000), 200);  // No end-of-window catch-up
+    EXPECT_EQ(AlgoEngine::targetQty(p, 3, 10, 10'000), 500);
+}
+
+// Test: Slices are routed on schedule and fills roll up into the parent
+TEST_F(AlgoEngineTest, SlicesAndAggregation) {
+    std::string error;
+    ASSERT_TRUE(engine.submit(params("PAR", AlgoStrategy::TWAP, 300, 3), error)) << error;
+
+    engine.runDue(start + 150);
+    ASSERT_EQ(routed.size(), 1);
+    EXPECT_EQ(routed[0].clOrdId, "PAR-1");
+    EXPECT_EQ(routed[0].parentId, "PAR");
+    EXPECT_EQ(routed[0].quantity, 100);
+
+    engine.runDue(start + 1'150);
+    engine.runDue(start + 2'150);
+    ASSERT_EQ(routed.size(), 3);
+    EXPECT_EQ(routedQty(), 300);
+
+    auto fill = engine.onChildFill("PAR-1", 100, 10.0);
+    ASSERT_TRUE(fill.has_value());
+    EXPECT_EQ(fill->cumQty, 100);
+    EXPECT_EQ(fill->leavesQty, 200);
+    EXPECT_FALSE(fill->complete);
+
+    engine.renameChild("PAR-2", "PAR-2A");
+    EXPECT_FALSE(engine.onChildFill("PAR-2", 1, 1.0).has_value());
+    engine.onChildFill("PAR-2A", 100, 11.0);
+    fill = engine.onChildFill("PAR-3", 100, 12.0);
+    ASSERT_TRUE(fill.has_value());
+    EXPECT_TRUE(fill->complete);
+    EXPECT_DOUBLE_EQ(fill->avgPx, 11.0);
+    EXPECT_FALSE(engine.isParent("PAR"));
+    EXPECT_FALSE(engine.onChildFill("UNRELATED", 10, 1.0).has_value());
+}
+
+// Test: Rejected children are re-released on the next slice
+TEST_F(AlgoEngineTest, RejectedChildRolledForward) {
+    bool reject = true;
+    engine.setChildRouter([&](const ChildOrder& child) {
+        if (reject) {
+            reject = false;
+            return false;
+        }
+        routed.push_back(child);
+        return true;
+    });
+    std::string error;
+    ASSERT_TRUE(engine.submit(params("REJ", AlgoStrategy::TWAP, 200, 2), error));
+
+    engine.runDue(start + 150);
+    EXPECT_TRUE(routed.empty());
+    engine.runDue(start + 1'150);
+    ASSERT_EQ(routed.size(), 1);
+    EXPECT_EQ(routed[0].quantity, 200);
+}
+
+// Test: Cancel stops slicing and reports the children routed so far
+TEST_F(AlgoEngineTest, CancelStopsSlicing) {
+    std::string error;
+    ASSERT_TRUE(engine.submit(params("CXL", AlgoStrategy::VWAP, 1000, 10), error));
+    engine.runDue(start + 150);
+    engine.runDue(start + 1'150);
+    ASSERT_EQ(routed.size(), 2);
+
+    std::vector<std::string> children;
+    EXPECT_TRUE(engine.cancel("CXL", children));
+    EXPECT_EQ(children.size(), 2);
+    EXPECT_FALSE(engine.cancel("CXL", children));
+
+    engine.runDue(start + 20'000);
+    EXPECT_EQ(routed.size(), 2);
+    EXPECT_EQ(engine.activeParents(), 0);
+}
+
+// Test: Invalid parents are rejected
+TEST_F(AlgoEngineTest, SubmitValidation) {
+    std::string error;
+    auto dup = params("DUP", AlgoStrategy::TWAP, 100, 2);
+    EXPECT_TRUE(engine.submit(dup, error));
+    EXPECT_FALSE(engine.submit(dup, error));
+
+    auto pov = params("POV", AlgoStrategy::POV, 100, 2);
+    pov.participation = 0.0;
+    EXPECT_FALSE(engine.submit(pov, error));
+
+    auto window = params("WIN", AlgoStrategy::TWAP, 100, 2);
+    window.endMs = window.startMs;
+    EXPECT_FALSE(engine.submit(window, error));
+}
+
+// Test: Thousands of parents share one wheel
+TEST_F(AlgoEngineTest, ManyParents) {
+    std::string error;
+    constexpr int PARENTS = 5000;
+    for (int i = 0; i < PARENTS; ++i) {
+        ASSERT_TRUE(engine.submit(params("M" + std::to_string(i), AlgoStrategy::TWAP, 100, 4), error));
+    }
+    for (int64_t t = 150; t < 4'000; t += 1'000) {
+        engine.runDue(start + t);
+    }
+    EXPECT_EQ(routed.size(), PARENTS * 4u);
+    EXPECT_EQ(routedQty(), PARENTS * 100);
+}
+
+// Test: A late wakeup releases all overdue slices as one child
+TEST_F(AlgoEngineTest, LateWakeupCatchesUp) {
+    std::string error;
+    ASSERT_TRUE(engine.submit(params("LATE", AlgoStrategy::TWAP, 400, 4), error));
+    engine.runDue(start + 2'150);
+    ASSERT_EQ(routed.size(), 1);
+    EXPECT_EQ(routed[0].quantity, 300);
+    engine.runDue(start + 3'150);
+    EXPECT_EQ(routedQty(), 400);
+}
+
+// Test: A POV parent short of the tape ends when its window closes
+TEST_F(AlgoEngineTest, PovUnderParticipationEnds) {
+    std::vector<ParentFill> ended;
+    engine.setParentListener([&](const ParentFill& parent) { ended.push_back(parent); });
+    std::string error;
+    auto p = params("POVS", AlgoStrategy::POV, 1000, 2);
+    p.participation = 0.1;
+    ASSERT_TRUE(engine.submit(p, error)) << error;
+
+    engine.onMarketVolume("AAPL", 500);
+    engine.runDue(start + 150);
+    ASSERT_EQ(routed.size(), 1);
+    EXPECT_EQ(routed[0].quantity, 50);
+    engine.onChildFill("POVS-1", 50, 10.0);
+
+    engine.runDue(start + 1'150);
+    EXPECT_EQ(routed.size(), 1);
+    ASSERT_EQ(ended.size(), 1);
+    EXPECT_EQ(ended[0].parentId, "POVS");
+    EXPECT_EQ(ended[0].cumQty, 50);
+    EXPECT_EQ(ended[0].leavesQty, 950);
+    EXPECT_FALSE(ended[0].complete);
+    EXPECT_EQ(engine.activeParents(), 0);
+}
+
+// Test: A rejected final-slice child ends the parent instead of stranding it
+TEST_F(AlgoEngineTest, RejectedFinalChildEnds) {
+    std::vector<ParentFill> ended;
+    engine.setParentListener([&](const ParentFill& parent) { ended.push_back(parent); });
+    std::string error;
+    ASSERT_TRUE(engine.submit(params("FIN", AlgoStrategy::TWAP, 200, 2), error));
+    engine.runDue(start + 150);
+    engine.onChildFill("FIN-1", 100, 10.0);
+
+    engine.setChildRouter([](const ChildOrder&) { return false; });
+    engine.runDue(start + 1'150);
+    ASSERT_EQ(ended.size(), 1);
+    EXPECT_EQ(ended[0].cumQty, 100);
+    EXPECT_EQ(ended[0].leavesQty, 100);
+    EXPECT_EQ(engine.activeParents(), 0);
+    EXPECT_FALSE(engine.onChildFill("FIN-1", 1, 1.0).has_value());
+}
+
+// Test: Canceled or expired children return their quantity to the schedule,
+// and the parent ends once the last one is done
+TEST_F(AlgoEngineTest, ChildDoneReturnsQuantity) {
+    std::vector<ParentFill> ended;
+    engine.setParentListener([&](const ParentFill& parent) { ended.push_back(parent); });
+    std::string error;
+    ASSERT_TRUE(engine.submit(params("RET", AlgoStrategy::TWAP, 300, 3), error));
+    engine.runDue(start + 150);
+    engine.onChildFill("RET-1", 40, 10.0);
+    engine.onChildDone("RET-1", 60);
+    engine.onChildDone("RET-1", 60);  // Repeated terminal update: no-op
+
+    engine.runDue(start + 1'150);
+    ASSERT_EQ(routed.size(), 2);
+    EXPECT_EQ(routed[1].quantity, 160);  // This slice's 100 plus the 60 returned
+
+    engine.onChildReduced("RET-2", 10);
+    engine.runDue(start + 2'150);
+    ASSERT_EQ(routed.size(), 3);
+    EXPECT_EQ(routed[2].quantity, 110);
+    EXPECT_TRUE(ended.empty());
+
+    engine.onChildFill("RET-2", 150, 10.0);
+    engine.onChildDone("RET-3", 110);  // Expired after the last slice
+    EXPECT_TRUE(ended.empty());        // Reported from runDue, outside the caller's locks
+    engine.runDue(start + 3'150);
+    ASSERT_EQ(ended.size(), 1);
+    EXPECT_EQ(ended[0].cumQty, 190);
+    EXPECT_EQ(ended[0].leavesQty, 110);
+    EXPECT_EQ(engine.activeParents(), 0);
+}
+
+// Test: The pass listener runs once per pass that routed anything, however
+// many children it routed
+TEST_F(AlgoEngineTest, PassListenerOncePerPass) {
+    int passes = 0;
+    engine.setPassListener([&]() { ++passes; });
+    std::string error;
+    for (int i = 0; i < 50; ++i) {
+        ASSERT_TRUE(engine.submit(params("PL" + std::to_string(i), AlgoStrategy::TWAP, 100, 2), error));
+    }
+    engine.runDue(start + 150);
+    EXPECT_EQ(routed.size(), 50u);
+    EXPECT_EQ(passes, 1);
+    engine.runDue(start + 500);  // Nothing due
+    EXPECT_EQ(passes, 1);
+    engine.runDue(start + 1'150);
+    EXPECT_EQ(passes, 2);
+}
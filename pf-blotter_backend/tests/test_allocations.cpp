@@ -0,0 +1,210 @@
+#include <gtest/gtest.h>
+#include "qfblotter/AuditLog.hpp"
+#include "qfblotter/BoundedQueue.hpp"
+#include "qfblotter/OrderStore.hpp"
+#include "qfblotter/ScratchArena.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <new>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+// GCC pairs the replaced operators below with malloc/free after inlining
+// and warns about a mismatch that cannot happen
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+// Counts global heap allocations made by the current thread while a
+// HeapCounter is alive. Replacing operator new applies to the whole test
+// binary; other tests are unaffected apart from the (uncounted) bookkeeping.
+namespace {
+thread_local bool t_counting = false;
+thread_local size_t t_allocations = 0;
+
+void* countedAlloc(size_t size, size_t alignment = 0) {
+    if (t_counting) {
+        ++t_allocations;
+    }
+    if (size == 0) {
+        size = 1;
+    }
+    void* p = alignment > alignof(std::max_align_t)
+                  ? std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment)
+                  : std::malloc(size);
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+class HeapCounter {
+public:
+    HeapCounter() {
+        t_allocations = 0;
+        t_counting = true;
+    }
+    ~HeapCounter() { t_counting = false; }
+    size_t count() const { return t_allocations; }
+};
+}  // namespace
+
+void* operator new(size_t size) { return countedAlloc(size); }
+void* operator new[](size_t size) { return countedAlloc(size); }
+void* operator new(size_t size, std::align_val_t al) { return countedAlloc(size, static_cast<size_t>(al)); }
+void* operator new[](size_t size, std::align_val_t al) { return countedAlloc(size, static_cast<size_t>(al)); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t, std::align_val_t) noexcept { std::free(p); }
+
+using namespace qfblotter;
+
+namespace {
+// Ids longer than the small-string buffer, as the gateway generates them
+std::string orderId(int i) {
+    return "CLIENT-ORDER-" + std::to_string(1'000'000 + i) + "-AAPL";
+}
+
+OrderRecord incomingOrder(const std::string& clOrdId) {
+    OrderRecord record;
+    record.clOrdId = clOrdId;
+    record.orderId = "ORD-" + clOrdId;
+    record.symbol = "AAPL";
+    record.side = '1';
+    record.price = 150.25;
+    record.quantity = 100;
+    record.leavesQty = 100;
+    record.status = "NEW";
+    record.transactTime = "2024-01-15T10:30:00.000Z";
+    return record;
+}
+}  // namespace
+
+TEST(Allocations, CounterSeesHeapAllocations) {
+    HeapCounter counter;
+    auto* p = new std::string(64, 'x');
+    delete p;
+    EXPECT_GE(counter.count(), 2u);
+}
+
+// The store on its own, with no change listeners: decoded requests are
+// built outside the window, and inserting them (by move), acking, filling,
+// amending and looking them up must not touch the heap. This covers the
+// store's pooled nodes and in-place updates only; the gateway's wired path
+// still allocates in its listeners (event JSON, replication, TCA, ...)
+TEST(Allocations, BareOrderStoreIsAllocationFree) {
+    constexpr int N = 2000;
+    OrderStore store;
+    store.reserve(N);
+
+    std::vector<std::string> ids;
+    std::vector<OrderRecord> incoming;
+    std::vector<OrderRecord> amendments;
+    for (int i = 0; i < N; ++i) {
+        ids.push_back(orderId(i));
+        incoming.push_back(incomingOrder(ids.back()));
+        amendments.push_back(incomingOrder(ids.back()));
+        amendments.back().quantity = 200;
+    }
+
+    size_t allocations = 0;
+    {
+        HeapCounter counter;
+        for (auto& record : incoming) {
+            store.upsert(std::move(record));
+        }
+        for (const auto& amended : amendments) {
+            store.upsert(amended);  // Same-sized strings: assigned in place
+        }
+        for (const auto& id : ids) {
+            store.updateStatus(id, "PARTIAL", 150, 50, 150.25);
+        }
+        for (const auto& id : ids) {
+            store.updateStatus(id, "FILLED", 0, 200, 150.30);
+        }
+        for (const auto& id : ids) {
+            EXPECT_TRUE(store.exists(id));
+        }
+        allocations = counter.count();
+    }
+    EXPECT_EQ(allocations, 0u);
+
+    auto all = store.getAll();
+    ASSERT_EQ(all.size(), static_cast<size_t>(N));
+    EXPECT_EQ(all.front().clOrdId, ids.front());
+    EXPECT_EQ(all.back().status, "FILLED");
+    EXPECT_EQ(all.back().quantity, 200);
+}
+
+TEST(Allocations, AuditLogIsAllocationFreeAfterWarmup) {
+    const auto path = std::filesystem::temp_directory_path() /
+                      ("qf_alloc_audit_" + std::to_string(::getpid()) + ".log");
+    {
+        AuditLog audit(path.string());
+        const std::string id = orderId(7);
+        const std::string details = "symbol=AAPL side=BUY qty=100 px=150.25 reason=partial fill";
+        audit.log(AuditLog::EventType::ORDER_NEW, id, details);  // Warm up the thread arena
+
+        size_t allocations = 0;
+        {
+            HeapCounter counter;
+            for (int i = 0; i < 500; ++i) {
+                audit.log(AuditLog::EventType::ORDER_PARTIAL_FILL, id, details);
+                audit.log(AuditLog::EventType::ORDER_REPLACE_REJECTED, id, details);
+            }
+            allocations = counter.count();
+        }
+        EXPECT_EQ(allocations, 0u);
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(Allocations, BoundedQueueReusesSlots) {
+    BoundedQueue<int> queue(1024);
+    for (int i = 0; i < 64; ++i) {
+        queue.tryPush(i);  // Grow to the working depth once
+    }
+    int out = 0;
+    while (queue.popWait(out, std::chrono::milliseconds(0))) {
+    }
+
+    size_t allocations = 0;
+    {
+        HeapCounter counter;
+        for (int round = 0; round < 100; ++round) {
+            for (int i = 0; i < 64; ++i) {
+                queue.tryPush(i);
+            }
+            while (queue.popWait(out, std::chrono::milliseconds(0))) {
+            }
+        }
+        allocations = counter.count();
+    }
+    EXPECT_EQ(allocations, 0u);
+}
+
+TEST(Allocations, ScratchArenaRewindsPerScope) {
+    size_t allocations = 0;
+    {
+        HeapCounter counter;
+        for (int request = 0; request < 1000; ++request) {
+            ScratchArena::Scope scope;
+            std::pmr::vector<std::pmr::string> fields{ScratchArena::resource()};
+            for (int i = 0; i < 16; ++i) {
+                fields.emplace_back("a field value longer than the small-string buffer");
+            }
+            ASSERT_EQ(fields.size(), 16u);
+        }
+        allocations = counter.count();
+    }
+    EXPECT_EQ(allocations, 0u);
+}
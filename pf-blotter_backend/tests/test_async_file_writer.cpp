@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+#include "qfblotter/AsyncFileWriter.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+using namespace qfblotter;
+
+namespace {
+std::string readFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    std::ostringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+}
+}  // namespace
+
+class AsyncFileWriterTest : public ::testing::TestWithParam<bool> {
+protected:
+    void SetUp() override {
+        std::string name = ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        std::replace(name.begin(), name.end(), '/', '_');  // Parameterized names contain '/'
+        path = (std::filesystem::temp_directory_path() /
+                ("qf_async_writer_" + std::to_string(::getpid()) + "_" + name))
+                   .string();
+        std::filesystem::remove(path);
+    }
+    void TearDown() override { std::filesystem::remove(path); }
+
+    AsyncFileWriter::Options options() const {
+        AsyncFileWriter::Options opts;
+        opts.useIoUring = GetParam();
+        opts.bufferSize = 4096;
+        opts.bufferCount = 4;
+        return opts;
+    }
+
+    std::string path;
+};
+
+TEST_P(AsyncFileWriterTest, ConcurrentAppendsKeepLinesWhole) {
+    constexpr int THREADS = 4;
+    constexpr int LINES = 2000;
+    {
+        AsyncFileWriter writer(path, options());
+        if (!GetParam()) {
+            EXPECT_EQ(writer.backend(), AsyncFileWriter::Backend::BLOCKING);
+        }
+        std::vector<std::thread> threads;
+        for (int t = 0; t < THREADS; ++t) {
+            threads.emplace_back([&writer, t]() {
+                for (int i = 0; i < LINES; ++i) {
+                    writer.append("T" + std::to_string(t) + "|" + std::to_string(i) + "|payload\n");
+                }
+            });
+        }
+        for (auto& th : threads) {
+            th.join();
+        }
+        writer.flush();
+        EXPECT_EQ(writer.bytesWritten(), std::filesystem::file_size(path));
+        EXPECT_EQ(writer.backlog(), 0u);
+        EXPECT_GT(writer.batches(), 0u);
+    }
+
+    std::istringstream in(readFile(path));
+    std::set<std::string> lines;
+    std::string line;
+    while (std::getline(in, line)) {
+        lines.insert(line);
+    }
+    EXPECT_EQ(lines.size(), static_cast<size_t>(THREADS * LINES));
+    EXPECT_TRUE(lines.count("T3|1999|payload"));
+}
+
+TEST_P(AsyncFileWriterTest, AppendSpanningBuffersIsWrittenInOrder) {
+    std::string big;
+    for (int i = 0; big.size() < 3 * 4096 + 100; ++i) {
+        big += std::to_string(i) + ",";
+    }
+    AsyncFileWriter writer(path, options());
+    writer.append("head:");
+    writer.append(big);
+    writer.flush();
+    EXPECT_EQ(readFile(path), "head:" + big);
+}
+
+TEST_P(AsyncFileWriterTest, AppendModeContinuesAndTruncateStartsEmpty) {
+    {
+        AsyncFileWriter writer(path, options());
+        writer.append("first\n");
+    }  // Destructor drains
+    {
+        AsyncFileWriter writer(path, options());
+        writer.append("second\n");
+    }
+    EXPECT_EQ(readFile(path), "first\nsecond\n");
+
+    auto opts = options();
+    opts.truncate = true;
+    {
+        AsyncFileWriter writer(path, opts);
+        writer.append("only\n");
+        writer.flush();
+        EXPECT_EQ(readFile(path), "only\n");
+    }
+}
+
+TEST_P(AsyncFileWriterTest, ReopenStartsAFreshFileAndLeavesTheOldOne) {
+    const std::string saved = path + ".saved";
+    {
+        AsyncFileWriter writer(path, options());
+        writer.append("first snapshot\n");
+        writer.flush();
+        std::filesystem::rename(path, saved);
+
+        writer.reopen();
+        writer.append("second\n");
+        writer.flush();
+        EXPECT_EQ(readFile(path), "second\n");
+    }
+    EXPECT_EQ(readFile(saved), "first snapshot\n");
+    std::filesystem::remove(saved);
+}
+
+TEST(AsyncFileWriter, ThrowsWhenPathCannotBeOpened) {
+    EXPECT_THROW(AsyncFileWriter("/nonexistent-dir/qf/audit.log"), std::runtime_error);
+}
+
+INSTANTIATE_TEST_SUITE_P(Backends, AsyncFileWriterTest, ::testing::Values(true, false),
+                         [](const ::testing::TestParamInfo<bool>& param) {
+                             return param.param ? std::string("IoUring") : std::string("Blocking");
+                         });
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "qfblotter/BarAggregator.hpp"
+#include "qfblotter/Json.hpp"
+
+using namespace qfblotter;
+
+class BarAggregatorTest : public ::testing::Test {
+protected:
+    BarAggregator bars{{"AAPL", "MSFT"}};
+
+    std::vector<Bar> collect(const std::string& symbol, BarInterval interval, size_t n) {
+        std::vector<Bar> out;
+        bars.visit(symbol, interval, n, [&out](const Bar* data, size_t count) {
+            out.insert(out.end(), data, data + count);
+        });
+        return out;
+    }
+};
+
+// Test: Ticks within one second build a single OHLC bar
+TEST_F(BarAggregatorTest, TicksBuildOhlc) {
+    bars.onTick("AAPL", 100.0, 10'000);
+    bars.onTick("AAPL", 102.0, 10'250);
+    bars.onTick("AAPL", 99.0, 10'500);
+    bars.onTick("AAPL", 101.0, 10'750);
+
+    auto result = collect("AAPL", BarInterval::Sec1, 10);
+    ASSERT_EQ(result.size(), 1);
+    EXPECT_EQ(result[0].startMs, 10'000);
+    EXPECT_DOUBLE_EQ(result[0].open, 100.0);
+    EXPECT_DOUBLE_EQ(result[0].high, 102.0);
+    EXPECT_DOUBLE_EQ(result[0].low, 99.0);
+    EXPECT_DOUBLE_EQ(result[0].close, 101.0);
+    EXPECT_EQ(result[0].volume, 0);
+}
+
+// Test: Fills add volume and trade count
+TEST_F(BarAggregatorTest, FillsAddVolume) {
+    bars.onTick("AAPL", 100.0, 60'000);
+    bars.onFill("AAPL", 100.5, 200, 61'000);
+    bars.onFill("AAPL", 100.7, 300, 62'000);
+
+    auto minute = collect("AAPL", BarInterval::Min1, 1);
+    ASSERT_EQ(minute.size(), 1);
+    EXPECT_EQ(minute[0].volume, 500);
+    EXPECT_EQ(minute[0].trades, 2);
+    EXPECT_DOUBLE_EQ(minute[0].close, 100.7);
+
+    // Same updates span three 1s buckets
+    EXPECT_EQ(collect("AAPL", BarInterval::Sec1, 10).size(), 3);
+}
+
+// Test: Ring keeps only the most recent bars, oldest first
+TEST_F(BarAggregatorTest, RingWrapsAtCapacity) {
+    const size_t cap = BarAggregator::CAPACITY[static_cast<size_t>(BarInterval::Sec1)];
+    const size_t total = cap + 25;
+    for (size_t i = 0; i < total; ++i) {
+        bars.onTick("MSFT", 400.0 + static_cast<double>(i), static_cast<int64_t>(i) * 1'000);
+    }
+
+    auto all = collect("MSFT", BarInterval::Sec1, cap * 2);
+    ASSERT_EQ(all.size(), cap);
+    EXPECT_EQ(all.front().startMs, 25'000);
+    EXPECT_EQ(all.back().startMs, static_cast<int64_t>(total - 1) * 1'000);
+    for (size_t i = 1; i < all.size(); ++i) {
+        EXPECT_LT(all[i - 1].startMs, all[i].startMs);
+    }
+
+    auto last3 = collect("MSFT", BarInterval::Sec1, 3);
+    ASSERT_EQ(last3.size(), 3);
+    EXPECT_EQ(last3.back().startMs, all.back().startMs);
+}
+
+// Test: Unknown symbols are ignored, keeping memory bounded
+TEST_F(BarAggregatorTest, UnknownSymbolIgnored) {
+    bars.onTick("NOPE", 10.0, 1'000);
+    EXPECT_FALSE(bars.hasSymbol("NOPE"));
+    EXPECT_EQ(collect("NOPE", BarInterval::Min1, 10).size(), 0);
+    EXPECT_TRUE(bars.historyJson("NOPE", BarInterval::Min1, 10).empty());
+    EXPECT_EQ(bars.symbolCount(), 2);
+}
+
+// Test: Interval parsing and JSON output
+TEST_F(BarAggregatorTest, HistoryJson) {
+    EXPECT_EQ(BarAggregator::parseInterval("5m"), BarInterval::Min5);
+    EXPECT_FALSE(BarAggregator::parseInterval("2h").has_value());
+
+    bars.onFill("AAPL", 185.25, 100, 120'000);
+    auto json = Json::parse(bars.historyJson("AAPL", BarInterval::Min5, 5));
+    EXPECT_EQ(json["symbol"], "AAPL");
+    EXPECT_EQ(json["interval"], "5m");
+    ASSERT_EQ(json["bars"].size(), 1);
+    EXPECT_EQ(json["bars"][0]["volume"], 100);
+    EXPECT_DOUBLE_EQ(json["bars"][0]["close"].get<double>(), 185.25);
+}
@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include "qfblotter/BoundedQueue.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace qfblotter;
+
+// Test: Items come out in order and a full queue rejects without blocking
+TEST(BoundedQueueTest, FifoAndCapacity) {
+    BoundedQueue<int> queue(3);
+    EXPECT_TRUE(queue.tryPush(1));
+    EXPECT_TRUE(queue.tryPush(2));
+    EXPECT_TRUE(queue.tryPush(3));
+    EXPECT_FALSE(queue.tryPush(4));
+    EXPECT_EQ(queue.size(), 3);
+
+    int value = 0;
+    ASSERT_TRUE(queue.popWait(value, std::chrono::milliseconds(0)));
+    EXPECT_EQ(value, 1);
+    EXPECT_TRUE(queue.tryPush(4));
+
+    std::vector<int> rest;
+    while (queue.popWait(value, std::chrono::milliseconds(0))) {
+        rest.push_back(value);
+    }
+    EXPECT_EQ(rest, (std::vector<int>{2, 3, 4}));
+}
+
+// Test: popWait times out on an empty queue
+TEST(BoundedQueueTest, PopTimesOut) {
+    BoundedQueue<int> queue(1);
+    int value = 0;
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(queue.popWait(value, std::chrono::milliseconds(20)));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(20));
+}
+
+// Test: Producers are never held up by a slow consumer
+TEST(BoundedQueueTest, SlowConsumerDropsInsteadOfBlocking) {
+    constexpr size_t CAPACITY = 64;
+    BoundedQueue<int> queue(CAPACITY);
+    // The consumer is stalled until every producer has returned, so the
+    // producers can only finish if tryPush never waits for space
+    std::atomic<bool> release{false};
+    std::atomic<int> consumed{0};
+    std::thread consumer([&]() {
+        while (!release) {
+            std::this_thread::yield();
+        }
+        int value = 0;
+        while (queue.popWait(value, std::chrono::milliseconds(0))) {
+            consumed++;
+        }
+    });
+
+    constexpr int PRODUCERS = 4;
+    constexpr int PER_PRODUCER = 2000;
+    std::atomic<int> accepted{0};
+    std::atomic<int> rejected{0};
+    std::vector<std::thread> producers;
+    for (int p = 0; p < PRODUCERS; ++p) {
+        producers.emplace_back([&]() {
+            for (int i = 0; i < PER_PRODUCER; ++i) {
+                if (queue.tryPush(i)) {
+                    accepted++;
+                } else {
+                    rejected++;
+                }
+            }
+        });
+    }
+    for (auto& t : producers) {
+        t.join();
+    }
+
+    EXPECT_EQ(accepted.load(), static_cast<int>(CAPACITY));
+    EXPECT_EQ(rejected.load(), PRODUCERS * PER_PRODUCER - static_cast<int>(CAPACITY));
+    EXPECT_EQ(queue.size(), CAPACITY);
+
+    release = true;
+    consumer.join();
+    EXPECT_EQ(consumed.load(), accepted.load());
+    EXPECT_EQ(queue.size(), 0u);
+}
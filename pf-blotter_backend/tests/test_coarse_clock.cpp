@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+#include "qfblotter/CoarseClock.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <regex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace qfblotter;
+
+namespace {
+int64_t systemMs() {
+    using namespace std::chrono;
+    return duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
+}
+
+// Epoch ms of a YYYY-MM-DDTHH:MM:SS.mmmZ timestamp
+int64_t parseIsoMillis(const std::string& ts) {
+    std::tm tm{};
+    tm.tm_year = std::stoi(ts.substr(0, 4)) - 1900;
+    tm.tm_mon = std::stoi(ts.substr(5, 2)) - 1;
+    tm.tm_mday = std::stoi(ts.substr(8, 2));
+    tm.tm_hour = std::stoi(ts.substr(11, 2));
+    tm.tm_min = std::stoi(ts.substr(14, 2));
+    tm.tm_sec = std::stoi(ts.substr(17, 2));
+    return static_cast<int64_t>(timegm(&tm)) * 1000 + std::stoi(ts.substr(20, 3));
+}
+}  // namespace
+
+// Test: Formats match the ISO-8601 and FIX log layouts, with or without the refresher
+TEST(CoarseClockTest, Formats) {
+    const std::regex iso(R"(\d{4}-\d{2}-\d{2}T\d{2}:\d{2}:\d{2}\.\d{3}Z)");
+    const std::regex isoSeconds(R"(\d{4}-\d{2}-\d{2}T\d{2}:\d{2}:\d{2}Z)");
+    const std::regex fix(R"(\d{8}-\d{2}:\d{2}:\d{2}\.\d{3})");
+    for (const bool refresher : {false, true}) {
+        if (refresher) {
+            CoarseClock::start();
+        }
+        char buf[CoarseClock::ISO_MILLIS_SIZE];
+        const std::string millis(CoarseClock::isoMillis(buf));
+        EXPECT_TRUE(std::regex_match(millis, iso)) << millis;
+        EXPECT_TRUE(std::regex_match(CoarseClock::isoSeconds(), isoSeconds));
+        char fixBuf[CoarseClock::FIX_MILLIS_SIZE];
+        const std::string fixTs(CoarseClock::fixMillis(fixBuf));
+        EXPECT_TRUE(std::regex_match(fixTs, fix)) << fixTs;
+        EXPECT_EQ(fixTs.substr(0, 4), millis.substr(0, 4));
+        EXPECT_NEAR(static_cast<double>(parseIsoMillis(millis)), static_cast<double>(systemMs()), 1000.0);
+    }
+    CoarseClock::stop();
+}
+
+// Test: The refresher keeps the cached time current, and reads fall back once stopped
+TEST(CoarseClockTest, RefresherTracksSystemClock) {
+    CoarseClock::start(std::chrono::milliseconds(1));
+    EXPECT_TRUE(CoarseClock::running());
+    const int64_t first = CoarseClock::nowMs();
+    EXPECT_NEAR(static_cast<double>(first), static_cast<double>(systemMs()), 100.0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_GT(CoarseClock::nowMs(), first);
+
+    CoarseClock::stop();
+    EXPECT_FALSE(CoarseClock::running());
+    EXPECT_NEAR(static_cast<double>(CoarseClock::nowMs()), static_cast<double>(systemMs()), 5.0);
+}
+
+// Test: Concurrent readers never see a torn snapshot while the refresher runs
+TEST(CoarseClockTest, ConsistentUnderConcurrentReads) {
+    CoarseClock::start(std::chrono::milliseconds(1));
+    std::atomic<int> bad{0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&bad] {
+            int64_t last = 0;
+            const auto until = std::chrono::steady_clock::now() + std::chrono::milliseconds(300);
+            while (std::chrono::steady_clock::now() < until) {
+                char buf[CoarseClock::ISO_MILLIS_SIZE];
+                const int64_t ms = parseIsoMillis(std::string(CoarseClock::isoMillis(buf)));
+                // Prefix and milliseconds come from one snapshot, so time never steps back
+                if (ms < last || ms > systemMs() + 5) {
+                    ++bad;
+                }
+                last = ms;
+            }
+        });
+    }
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    CoarseClock::stop();
+    EXPECT_EQ(bad.load(), 0);
+}
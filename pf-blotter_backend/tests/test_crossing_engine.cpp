@@ -0,0 +1,173 @@
+#include <gtest/gtest.h>
+#include "qfblotter/CrossingEngine.hpp"
+#include "qfblotter/OrderStore.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace qfblotter;
+
+class CrossingEngineTest : public ::testing::Test {
+protected:
+    CrossingEngine engine;
+    std::vector<Cross> crosses;
+    int midCalls = 0;
+
+    void match(double mid) {
+        engine.match([this, mid](const std::string&) {
+            ++midCalls;
+            return mid;
+        }, crosses);
+    }
+};
+
+// Test: Overlapping limits cross at the mid, best price first, then earliest
+TEST_F(CrossingEngineTest, PriceTimePriorityAtMid) {
+    engine.upsert("B1", "AAPL", '1', 100.0, 100);
+    engine.upsert("B2", "AAPL", '1', 101.0, 100);
+    engine.upsert("B3", "AAPL", '1', 101.0, 100);  // Same price as B2, later
+    engine.upsert("S1", "AAPL", '2', 100.5, 150);
+
+    match(100.8);
+    ASSERT_EQ(crosses.size(), 2u);
+    EXPECT_EQ(crosses[0].buyClOrdId, "B2");
+    EXPECT_EQ(crosses[0].sellClOrdId, "S1");
+    EXPECT_EQ(crosses[0].qty, 100);
+    EXPECT_DOUBLE_EQ(crosses[0].price, 100.8);
+    EXPECT_EQ(crosses[1].buyClOrdId, "B3");
+    EXPECT_EQ(crosses[1].qty, 50);
+
+    // B1 at 100.0 does not reach the sells; B3 keeps its remaining 50
+    EXPECT_EQ(engine.size(), 2u);
+    EXPECT_EQ(engine.crosses(), 2u);
+    EXPECT_EQ(engine.crossedQty(), 150u);
+    crosses.clear();
+    engine.upsert("S2", "AAPL", '2', 99.0, 50);
+    match(98.0);
+    ASSERT_EQ(crosses.size(), 1u);
+    EXPECT_EQ(crosses[0].buyClOrdId, "B3");
+    EXPECT_DOUBLE_EQ(crosses[0].price, 99.0);  // Mid clamped to the sell limit
+}
+
+// Test: Books that have not changed are not examined
+TEST_F(CrossingEngineTest, OnlyChangedBooksAreMatched) {
+    engine.upsert("B1", "AAPL", '1', 99.0, 10);
+    engine.upsert("S1", "AAPL", '2', 100.0, 10);
+    engine.upsert("B2", "MSFT", '1', 300.0, 10);
+    match(99.5);
+    EXPECT_TRUE(crosses.empty());
+    EXPECT_EQ(midCalls, 0);  // No book overlapped, so no mid was needed
+
+    match(99.5);
+    engine.upsert("S2", "MSFT", '2', 299.0, 10);
+    match(299.5);
+    ASSERT_EQ(crosses.size(), 1u);
+    EXPECT_EQ(crosses[0].symbol, "MSFT");
+    EXPECT_EQ(midCalls, 1);
+}
+
+// Test: Removed orders and reduced quantities are respected
+TEST_F(CrossingEngineTest, RemoveAndReduce) {
+    engine.upsert("B1", "AAPL", '1', 101.0, 100);
+    engine.upsert("B2", "AAPL", '1', 101.0, 100);
+    engine.upsert("B1", "AAPL", '1', 101.0, 40);  // Partly filled at market: keeps priority
+    EXPECT_TRUE(engine.remove("B2"));
+    EXPECT_FALSE(engine.remove("B2"));
+    engine.upsert("S1", "AAPL", '2', 100.0, 100);
+
+    match(100.5);
+    ASSERT_EQ(crosses.size(), 1u);
+    EXPECT_EQ(crosses[0].buyClOrdId, "B1");
+    EXPECT_EQ(crosses[0].qty, 40);
+    EXPECT_EQ(engine.size(), 1u);  // S1's remaining 60
+}
+
+// Test: Only open, resting, non-algo limit orders take part
+TEST_F(CrossingEngineTest, FollowsOrderChanges) {
+    OrderRecord buy;
+    buy.clOrdId = "B1";
+    buy.symbol = "AAPL";
+    buy.side = '1';
+    buy.price = 101.0;
+    buy.quantity = 100;
+    buy.leavesQty = 100;
+    buy.status = "NEW";
+    buy.orderType = ORD_LIMIT;
+    buy.timeInForce = TIF_DAY;
+    engine.onOrderChange(buy);
+    EXPECT_EQ(engine.size(), 1u);
+
+    OrderRecord ioc = buy;
+    ioc.clOrdId = "B2";
+    ioc.timeInForce = TIF_IOC;
+    OrderRecord stop = buy;
+    stop.clOrdId = "B3";
+    stop.status = STATUS_PENDING_STOP;
+    stop.orderType = ORD_STOP_LIMIT;
+    OrderRecord parent = buy;
+    parent.clOrdId = "B4";
+    parent.algo = "TWAP";
+    for (const auto* record : {&ioc, &stop, &parent}) {
+        engine.onOrderChange(*record);
+    }
+    EXPECT_EQ(engine.size(), 1u);
+
+    buy.status = "CANCELED";
+    buy.leavesQty = 0;
+    engine.onOrderChange(buy);
+    EXPECT_EQ(engine.size(), 0u);
+}
+
+// Test: A voided cross puts the surviving leg back at its original time
+// priority, whether it was crossed out in full or in part
+TEST_F(CrossingEngineTest, RestoreKeepsTimePriority) {
+    OrderRecord b1;
+    b1.clOrdId = "B1";
+    b1.symbol = "AAPL";
+    b1.side = '1';
+    b1.price = 101.0;
+    b1.quantity = 100;
+    b1.leavesQty = 100;
+    b1.status = "NEW";
+    b1.orderType = ORD_LIMIT;
+    b1.timeInForce = TIF_DAY;
+    OrderRecord b2 = b1;
+    b2.clOrdId = "B2";
+    engine.onOrderChange(b1);
+    engine.onOrderChange(b2);  // Same price, behind B1
+    engine.upsert("S1", "AAPL", '2', 100.0, 100);
+
+    match(100.5);
+    ASSERT_EQ(crosses.size(), 1u);
+    ASSERT_EQ(crosses[0].buyClOrdId, "B1");
+    // S1 was canceled before the cross applied: B1 goes back ahead of B2
+    engine.restore(b1, crosses[0].buySeq);
+    EXPECT_EQ(engine.size(), 2u);
+    crosses.clear();
+    engine.upsert("S2", "AAPL", '2', 100.0, 60);
+    match(100.5);
+    ASSERT_EQ(crosses.size(), 1u);
+    EXPECT_EQ(crosses[0].buyClOrdId, "B1");
+    EXPECT_EQ(crosses[0].qty, 60);
+
+    // Partly crossed and voided: the full quantity is back, still first
+    const uint64_t seq = crosses[0].buySeq;
+    crosses.clear();
+    engine.restore(b1, seq);
+    engine.upsert("S3", "AAPL", '2', 100.0, 100);
+    match(100.5);
+    ASSERT_EQ(crosses.size(), 1u);
+    EXPECT_EQ(crosses[0].buyClOrdId, "B1");
+    EXPECT_EQ(crosses[0].qty, 100);
+
+    // A leg re-placed since the match keeps its new place
+    crosses.clear();
+    b2.price = 102.0;
+    engine.onOrderChange(b2);
+    engine.restore(b2, 2);
+    engine.upsert("S4", "AAPL", '2', 100.0, 100);
+    match(100.5);
+    ASSERT_EQ(crosses.size(), 1u);
+    EXPECT_EQ(crosses[0].buyClOrdId, "B2");
+    EXPECT_DOUBLE_EQ(crosses[0].price, 100.5);
+}
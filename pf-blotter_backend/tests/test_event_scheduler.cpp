@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+#include "qfblotter/EventScheduler.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace qfblotter;
+
+// Test: Events run in due order, FIFO among equal times, and only once due
+TEST(EventSchedulerTest, RunsInDueOrder) {
+    EventScheduler scheduler;
+    std::vector<std::string> ran;
+    scheduler.at(300, [&] { ran.push_back("c"); });
+    scheduler.at(100, [&] { ran.push_back("a"); });
+    scheduler.at(200, [&] { ran.push_back("b1"); });
+    scheduler.at(200, [&] { ran.push_back("b2"); });
+
+    EXPECT_EQ(scheduler.runDue(50), 0u);
+    EXPECT_EQ(scheduler.runDue(200), 3u);
+    EXPECT_EQ(ran, (std::vector<std::string>{"a", "b1", "b2"}));
+    EXPECT_EQ(scheduler.pending(), 1u);
+    EXPECT_EQ(scheduler.runDue(1000), 1u);
+    EXPECT_EQ(ran.back(), "c");
+    EXPECT_EQ(scheduler.executed(), 4u);
+}
+
+// Test: A callback can schedule a follow-up, which runs in the same pass if due
+TEST(EventSchedulerTest, CallbacksCanSchedule) {
+    EventScheduler scheduler;
+    std::vector<int> ran;
+    scheduler.at(100, [&] {
+        ran.push_back(1);
+        scheduler.at(150, [&] { ran.push_back(2); });
+        scheduler.at(500, [&] { ran.push_back(3); });
+    });
+    EXPECT_EQ(scheduler.runDue(200), 2u);
+    EXPECT_EQ(ran, (std::vector<int>{1, 2}));
+    EXPECT_EQ(scheduler.pending(), 1u);
+}
+
+// Test: The dispatcher thread runs delayed events on time, earliest first,
+// even when scheduled after a later one
+TEST(EventSchedulerTest, DispatcherRunsDelayedEvents) {
+    EventScheduler scheduler;
+    scheduler.start();
+    std::atomic<int> order{0};
+    std::atomic<int> slow{0};
+    std::atomic<int> fast{0};
+    const int64_t start = EventScheduler::nowUs();
+    scheduler.after(200000, [&] { slow = ++order; });
+    scheduler.after(2000, [&] { fast = ++order; });
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (slow.load() == 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(fast.load(), 1);
+    EXPECT_EQ(slow.load(), 2);
+    EXPECT_GE(EventScheduler::nowUs() - start, 200000);
+
+    // Pending events are dropped on stop
+    scheduler.after(60000000, [] {});
+    scheduler.stop();
+    EXPECT_EQ(scheduler.pending(), 0u);
+}
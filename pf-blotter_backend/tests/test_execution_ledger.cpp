@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include "qfblotter/ExecutionLedger.hpp"
+#include "qfblotter/OrderStore.hpp"
+
+#include <cstdint>
+#include <string>
+
+using namespace qfblotter;
+
+namespace {
+OrderRecord order(const std::string& clOrdId, char side = '1', const std::string& symbol = "AAPL") {
+    OrderRecord record;
+    record.clOrdId = clOrdId;
+    record.orderId = "ORD-" + clOrdId;
+    record.symbol = symbol;
+    record.side = side;
+    record.quantity = 1000;
+    return record;
+}
+}  // namespace
+
+// Test: Each execution is kept, even after the order's cumQty/avgPx has
+// moved on, and one order's executions come back in order
+TEST(ExecutionLedgerTest, KeepsEveryExecution) {
+    ExecutionLedger ledger;
+    EXPECT_EQ(ledger.append(order("B1"), 100, 150.10, 1'000, VENUE_MARKET), 1u);
+    EXPECT_EQ(ledger.append(order("S1", '2'), 50, 150.12, 2'000, VENUE_INTERNAL), 2u);
+    EXPECT_EQ(ledger.append(order("B1"), 200, 150.20, 3'000, "ARCA"), 3u);
+    EXPECT_EQ(ledger.size(), 3u);
+
+    const auto b1 = ledger.forOrder("B1");
+    ASSERT_EQ(b1.size(), 2u);
+    EXPECT_EQ(b1[0].execId, 1u);
+    EXPECT_EQ(b1[0].qty, 100);
+    EXPECT_EQ(b1[0].venue, VENUE_MARKET);
+    EXPECT_EQ(b1[1].execId, 3u);
+    EXPECT_DOUBLE_EQ(b1[1].px, 150.20);
+    EXPECT_EQ(b1[1].timeUs, 3'000);
+    EXPECT_EQ(b1[1].venue, "ARCA");
+    EXPECT_EQ(b1[1].orderId, "ORD-B1");
+    EXPECT_TRUE(ledger.forOrder("NONE").empty());
+
+    const auto j = ledger.orderJson("B1");
+    EXPECT_EQ(j["cumQty"], 300);
+    EXPECT_NEAR(j["avgPx"].get<double>(), (100 * 150.10 + 200 * 150.20) / 300, 1e-9);
+}
+
+// Test: since() pages through the ledger by execId across chunk boundaries
+TEST(ExecutionLedgerTest, StreamsFromCursorAcrossChunks) {
+    ExecutionLedger ledger;
+    const size_t rows = ExecutionLedger::CHUNK_ROWS * 2 + 10;
+    for (size_t i = 0; i < rows; ++i) {
+        ledger.append(order("O" + std::to_string(i % 7)), static_cast<int>(i % 100) + 1, 100.0,
+                      static_cast<int64_t>(i), i % 2 ? "ARCA" : "BATS");
+    }
+    EXPECT_EQ(ledger.chunks(), 3u);
+
+    uint64_t cursor = 0;
+    size_t seen = 0;
+    while (true) {
+        const auto j = ledger.sinceJson(cursor, 1000);
+        if (j["executions"].empty()) {
+            EXPECT_EQ(j["next"], cursor);
+            break;
+        }
+        for (const auto& execution : j["executions"]) {
+            EXPECT_EQ(execution["execId"], cursor + 1);
+            EXPECT_EQ(execution["timeUs"], static_cast<int64_t>(cursor));
+            cursor = execution["execId"];
+            ++seen;
+        }
+        EXPECT_EQ(j["next"], cursor);
+    }
+    EXPECT_EQ(seen, rows);
+    EXPECT_TRUE(ledger.since(UINT64_MAX, 1000).empty());
+    EXPECT_TRUE(ledger.since(rows + 5, SIZE_MAX).empty());
+    EXPECT_EQ(ledger.since(rows - 2, SIZE_MAX).size(), 2u);
+    EXPECT_EQ(ledger.forOrder("O3").size(), (rows + 3) / 7);
+
+    uint64_t executions = 0;
+    for (const auto& totals : ledger.venueTotals()) {
+        executions += totals.executions;
+        EXPECT_EQ(totals.executions, rows / 2);
+    }
+    EXPECT_EQ(executions, rows);
+}
@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+#include "qfblotter/FixValidator.hpp"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace qfblotter;
+
+namespace {
+using Fields = std::vector<std::pair<int, std::string>>;
+
+// Wire-format message with a standard header and trailer around `body`
+std::string message(const std::string& msgType, const Fields& body, const Fields& extraHeader = {}) {
+    std::string inner = "35=" + msgType + "\x01" "49=TRADER\x01" "56=SIM\x01" "34=2\x01" "52=20240102-10:11:12.345\x01";
+    for (const auto& [tag, value] : extraHeader) {
+        inner += std::to_string(tag) + "=" + value + "\x01";
+    }
+    for (const auto& [tag, value] : body) {
+        inner += std::to_string(tag) + "=" + value + "\x01";
+    }
+    std::string out = "8=FIX.4.4\x01" "9=" + std::to_string(inner.size()) + "\x01" + inner;
+    unsigned sum = 0;
+    for (const unsigned char c : out) {
+        sum += c;
+    }
+    const std::string checksum = std::to_string(sum % 256);
+    return out + "10=" + std::string(3 - checksum.size(), '0') + checksum + "\x01";
+}
+
+Fields newOrder() {
+    return {{11, "ORD-1"}, {55, "AAPL"}, {54, "1"}, {60, "20240102-10:11:12"}, {38, "100"}, {40, "2"}, {44, "187.25"}};
+}
+
+Fields marketDataRequest(const std::string& relatedSymCount) {
+    return {{262, "MD-1"}, {263, "1"},  {264, "1"},   {267, "2"}, {269, "0"},
+            {269, "1"},    {146, relatedSymCount}, {55, "AAPL"}, {55, "MSFT"}};
+}
+}  // namespace
+
+// Test: Well-formed messages, including repeating groups, pass
+TEST(FixValidatorTest, AcceptsValidMessages) {
+    EXPECT_TRUE(validateFixMessage(message("D", newOrder())).ok());
+    EXPECT_TRUE(validateFixMessage(message("V", marketDataRequest("2"))).ok());
+    EXPECT_TRUE(validateFixMessage(message("0", {})).ok());
+    EXPECT_TRUE(validateFixMessage(message("A", {{98, "0"}, {108, "30"}})).ok());
+}
+
+// Test: A missing required field is reported by tag, in the body or header
+TEST(FixValidatorTest, RequiredTagMissing) {
+    Fields order = newOrder();
+    order.erase(order.begin());  // ClOrdID
+    FixValidation result = validateFixMessage(message("D", order));
+    EXPECT_EQ(result.reject, FixReject::REQUIRED_TAG_MISSING);
+    EXPECT_EQ(result.tag, 11);
+
+    result = validateFixMessage(message("1", {}));  // TestRequest needs TestReqID
+    EXPECT_EQ(result.reject, FixReject::REQUIRED_TAG_MISSING);
+    EXPECT_EQ(result.tag, 112);
+}
+
+// Test: Enumerated values and value syntax are checked per field type
+TEST(FixValidatorTest, IncorrectValueAndFormat) {
+    Fields order = newOrder();
+    order[2].second = "Z";  // Side
+    FixValidation result = validateFixMessage(message("D", order));
+    EXPECT_EQ(result.reject, FixReject::INCORRECT_VALUE);
+    EXPECT_EQ(result.tag, 54);
+
+    order = newOrder();
+    order[4].second = "1O0";  // OrderQty
+    result = validateFixMessage(message("D", order));
+    EXPECT_EQ(result.reject, FixReject::INCORRECT_FORMAT);
+    EXPECT_EQ(result.tag, 38);
+
+    order = newOrder();
+    order[3].second = "20241302-10:11:12";  // TransactTime, month 13
+    EXPECT_EQ(validateFixMessage(message("D", order)).reject, FixReject::INCORRECT_FORMAT);
+
+    order = newOrder();
+    order.push_back({18, "1 G"});  // ExecInst takes a list of values
+    EXPECT_TRUE(validateFixMessage(message("D", order)).ok());
+    order.back().second = "1 ?";
+    EXPECT_EQ(validateFixMessage(message("D", order)).reject, FixReject::INCORRECT_VALUE);
+
+    order = newOrder();
+    order[0].second = "";
+    EXPECT_EQ(validateFixMessage(message("D", order)).reject, FixReject::EMPTY_VALUE);
+}
+
+// Test: Unknown tags, tags from other messages, repeats and misplaced header fields
+TEST(FixValidatorTest, TagPlacement) {
+    Fields order = newOrder();
+    order.push_back({9999, "x"});
+    FixValidation result = validateFixMessage(message("D", order));
+    EXPECT_EQ(result.reject, FixReject::INVALID_TAG);
+    EXPECT_EQ(result.tag, 9999);
+
+    order = newOrder();
+    order.insert(order.begin() + 1, {262, "MD-1"});  // MDReqID belongs to V
+    result = validateFixMessage(message("D", order));
+    EXPECT_EQ(result.reject, FixReject::TAG_NOT_DEFINED_FOR_MESSAGE);
+    EXPECT_EQ(result.tag, 262);
+
+    order = newOrder();
+    order.push_back({55, "MSFT"});
+    result = validateFixMessage(message("D", order));
+    EXPECT_EQ(result.reject, FixReject::REPEATED_TAG);
+    EXPECT_EQ(result.tag, 55);
+
+    order = newOrder();
+    order.push_back({97, "Y"});  // PossResend is a header field
+    result = validateFixMessage(message("D", order));
+    EXPECT_EQ(result.reject, FixReject::TAG_OUT_OF_ORDER);
+    EXPECT_EQ(result.tag, 97);
+
+    EXPECT_TRUE(validateFixMessage(message("D", newOrder(), {{97, "Y"}})).ok());
+}
+
+// Test: Group counts must match the entries present
+TEST(FixValidatorTest, GroupCountMismatch) {
+    FixValidation result = validateFixMessage(message("V", marketDataRequest("3")));
+    EXPECT_EQ(result.reject, FixReject::GROUP_COUNT_MISMATCH);
+    EXPECT_EQ(result.tag, 146);
+
+    result = validateFixMessage(message("V", marketDataRequest("1")));
+    EXPECT_EQ(result.reject, FixReject::GROUP_COUNT_MISMATCH);
+}
+
+// Test: MsgTypes outside FIX 4.4 are invalid; FIX 4.4 types not compiled in are unsupported
+TEST(FixValidatorTest, MessageTypes) {
+    EXPECT_EQ(validateFixMessage(message("ZZ", {})).reject, FixReject::INVALID_MSG_TYPE);
+    EXPECT_EQ(validateFixMessage(message("H", {{11, "ORD-1"}, {54, "1"}})).reject, FixReject::UNSUPPORTED_MSG_TYPE);
+
+    std::string noChecksum = message("0", {});
+    noChecksum.resize(noChecksum.rfind("10="));
+    FixValidation result = validateFixMessage(noChecksum);
+    EXPECT_EQ(result.reject, FixReject::REQUIRED_TAG_MISSING);
+    EXPECT_EQ(result.tag, 10);
+}
@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include "qfblotter/MarketDataConflator.hpp"
+
+#include <map>
+
+using namespace qfblotter;
+
+namespace {
+
+using Delivered = std::map<std::string, std::vector<MdUpdate>>;
+
+Delivered drainAll(MarketDataConflator& conflator) {
+    Delivered out;
+    conflator.drain([&](const std::string& subscriber, const std::string& mdReqId,
+                        const std::vector<MdUpdate>& updates) {
+        out[subscriber + "/" + mdReqId] = updates;
+    });
+    return out;
+}
+
+}  // namespace
+
+// Test: Ticks between drains collapse to the latest price
+TEST(MarketDataConflatorTest, ConflatesToLatest) {
+    MarketDataConflator conflator;
+    ASSERT_TRUE(conflator.subscribe("S1", "R1", {"AAPL"}));
+    conflator.onTick("AAPL", 100.0);
+    conflator.onTick("AAPL", 101.0);
+    conflator.onTick("AAPL", 102.5);
+
+    auto out = drainAll(conflator);
+    ASSERT_EQ(out.size(), 1u);
+    ASSERT_EQ(out["S1/R1"].size(), 1u);
+    EXPECT_DOUBLE_EQ(out["S1/R1"][0].price, 102.5);
+
+    // Nothing changed since the last drain
+    EXPECT_TRUE(drainAll(conflator).empty());
+}
+
+// Test: Each subscription only sees its own symbols
+TEST(MarketDataConflatorTest, RoutesBySymbol) {
+    MarketDataConflator conflator;
+    conflator.subscribe("S1", "R1", {"AAPL", "MSFT"});
+    conflator.subscribe("S2", "R1", {"MSFT"});
+    conflator.onTick("AAPL", 100.0);
+    conflator.onTick("MSFT", 300.0);
+    conflator.onTick("TSLA", 200.0);
+
+    auto out = drainAll(conflator);
+    ASSERT_EQ(out.size(), 2u);
+    EXPECT_EQ(out["S1/R1"].size(), 2u);
+    ASSERT_EQ(out["S2/R1"].size(), 1u);
+    EXPECT_EQ(out["S2/R1"][0].symbol, "MSFT");
+}
+
+// Test: Duplicate MDReqIDs are rejected and unsubscribe stops delivery
+TEST(MarketDataConflatorTest, SubscriptionLifecycle) {
+    MarketDataConflator conflator;
+    EXPECT_TRUE(conflator.subscribe("S1", "R1", {"AAPL"}));
+    EXPECT_FALSE(conflator.subscribe("S1", "R1", {"MSFT"}));
+    EXPECT_TRUE(conflator.subscribe("S2", "R1", {"AAPL"}));
+    EXPECT_TRUE(conflator.subscribe("S1", "R2", {"AAPL"}));
+    EXPECT_EQ(conflator.subscriptionCount(), 3u);
+
+    EXPECT_TRUE(conflator.unsubscribe("S1", "R2"));
+    EXPECT_FALSE(conflator.unsubscribe("S1", "R2"));
+    conflator.removeSubscriber("S2");
+    EXPECT_EQ(conflator.subscriptionCount(), 1u);
+
+    conflator.onTick("AAPL", 100.0);
+    auto out = drainAll(conflator);
+    ASSERT_EQ(out.size(), 1u);
+    EXPECT_EQ(out.count("S1/R1"), 1u);
+
+    conflator.removeSubscriber("S1");
+    conflator.onTick("AAPL", 101.0);
+    EXPECT_TRUE(drainAll(conflator).empty());
+}
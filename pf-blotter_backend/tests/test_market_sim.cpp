@@ -1,6 +1,9 @@
 #include <gtest/gtest.h>
 #include "qfblotter/MarketSim.hpp"
 
+#include <thread>
+#include <vector>
+
 using namespace qfblotter;
 
 class MarketSimTest : public ::testing::Test {
@@ -107,6 +110,22 @@ TEST_F(MarketSimTest, LargeOrdersMayPartialFill) {
     }
 }
 
+// Test: Fill-or-kill fills a large order whole or not at all: the partial
+// fill ratio (which never reaches 100%) does not apply
+TEST_F(MarketSimTest, FillOrKillLargeOrderFillsWhole) {
+    MarketSim fokSim{101, 100.0, 0.01};
+    for (int i = 0; i < 50; ++i) {
+        auto result = fokSim.attemptFillAll("FOK", '1', 200.0, 5000);
+        EXPECT_EQ(result.fillQty, 5000);
+        EXPECT_TRUE(result.complete);
+        EXPECT_GT(result.fillPx, 0.0);
+    }
+    auto killed = fokSim.attemptFillAll("FOK", '1', 1.0, 5000);  // Limit below the market
+    EXPECT_EQ(killed.fillQty, 0);
+    EXPECT_FALSE(killed.complete);
+    EXPECT_EQ(fokSim.attemptFillAll("FOK", '2', 1.0, 0).fillQty, 0);
+}
+
 // Test: No fill on zero leaves
 TEST_F(MarketSimTest, NoFillOnZeroLeaves) {
     auto result = sim.attemptFill("ZERO", '1', 200.0, 0);
@@ -180,3 +199,64 @@ TEST_F(MarketSimTest, DifferentSeedsProduceDifferentResults) {
     }
     EXPECT_TRUE(anyDifferent);
 }
+
+// Test: Tick listener sees every price move, including fill attempts
+TEST_F(MarketSimTest, TickListenerSeesEveryTick) {
+    std::vector<double> seen;
+    sim.addTickListener([&seen](const std::string& symbol, double price) {
+        EXPECT_EQ(symbol, "LSTN");
+        seen.push_back(price);
+    });
+
+    double px = sim.nextTick("LSTN");
+    sim.shouldFill("LSTN", '1', 1000.0);
+    sim.attemptFill("LSTN", '1', 1000.0, 500);
+    sim.mark("LSTN");
+
+    ASSERT_EQ(seen.size(), 3);
+    EXPECT_DOUBLE_EQ(seen[0], px);
+}
+
+// Test: The tick journal sees concurrent ticks in the order prices changed,
+// so its last call for a symbol always carries the current price
+TEST_F(MarketSimTest, TickJournalFollowsPriceOrder) {
+    std::vector<double> journal;
+    sim.setTickJournal([&journal](const std::string&, double price) { journal.push_back(price); });
+
+    std::vector<std::thread> tickers;
+    for (int t = 0; t < 4; ++t) {
+        tickers.emplace_back([this]() {
+            for (int i = 0; i < 500; ++i) {
+                sim.nextTick("JRNL");
+            }
+        });
+    }
+    for (auto& t : tickers) {
+        t.join();
+    }
+
+    ASSERT_EQ(journal.size(), 2000u);
+    EXPECT_DOUBLE_EQ(journal.back(), sim.mark("JRNL"));
+}
+
+// Test: midPrice is the midpoint of the simulated best bid and ask
+TEST_F(MarketSimTest, MidPriceIsBidAskMidpoint) {
+    sim.nextTick("MIDP");
+    const double last = sim.mark("MIDP");
+    const double mid = sim.midPrice("MIDP");
+    // Both sides sit half a spread (at most 0.5%) from the last trade, rounded to the cent
+    EXPECT_NEAR(mid, last, last * 0.0025 + 0.01);
+    EXPECT_DOUBLE_EQ(sim.mark("MIDP"), last);  // Reading the book does not tick
+}
+
+// Test: initSymbols creates state at reference prices without ticking
+TEST_F(MarketSimTest, InitSymbolsDoesNotTick) {
+    int ticks = 0;
+    sim.addTickListener([&ticks](const std::string&, double) { ++ticks; });
+    sim.initSymbols({"AAPL", "ZZZZ"});
+
+    EXPECT_EQ(ticks, 0);
+    EXPECT_DOUBLE_EQ(sim.mark("AAPL"), 185.00);
+    EXPECT_DOUBLE_EQ(sim.mark("ZZZZ"), 100.0);
+    EXPECT_EQ(sim.lastPrices().size(), 2u);
+}
@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+#include "qfblotter/MulticastFeed.hpp"
+
+#include <memory>
+
+#include <unistd.h>
+
+using namespace qfblotter;
+
+namespace {
+// Distinct ports per process so parallel test runs do not collide
+MulticastConfig loopbackConfig() {
+    MulticastConfig config;
+    const auto base = static_cast<uint16_t>(40000 + (::getpid() % 10000) * 2);
+    config.port = base;
+    config.recoveryPort = static_cast<uint16_t>(base + 1);
+    config.retain = 256;
+    return config;
+}
+
+std::vector<FeedTick> batch(int count, double base) {
+    std::vector<FeedTick> ticks;
+    for (int i = 0; i < count; ++i) {
+        ticks.push_back({"SYM" + std::to_string(i), base + i, 100});
+    }
+    return ticks;
+}
+}  // namespace
+
+// Test: Sequencer reports gaps and skips duplicates
+TEST(FeedSequencerTest, GapsAndDuplicates) {
+    FeedSequencer seq;
+    auto r = seq.onPacket(10, 5);  // First packet synchronises
+    EXPECT_EQ(r.gapCount, 0u);
+    EXPECT_EQ(seq.expected(), 15u);
+
+    r = seq.onPacket(20, 2);
+    EXPECT_EQ(r.gapFrom, 15u);
+    EXPECT_EQ(r.gapCount, 5u);
+    EXPECT_EQ(seq.expected(), 22u);
+
+    r = seq.onPacket(18, 6);  // Overlaps what was already seen
+    EXPECT_EQ(r.gapCount, 0u);
+    EXPECT_EQ(r.skip, 4);
+    EXPECT_EQ(seq.expected(), 24u);
+
+    r = seq.onPacket(5, 3);  // Entirely stale
+    EXPECT_EQ(r.skip, 3);
+    EXPECT_EQ(seq.expected(), 24u);
+}
+
+class MulticastFeedTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        config = loopbackConfig();
+        try {
+            publisher = std::make_unique<MulticastPublisher>(config);
+            subscriber = std::make_unique<FeedSubscriber>(config, [this](uint64_t seq, const FeedEntry& entry) {
+                seqs.push_back(seq);
+                prices.push_back(entry.price);
+            });
+        } catch (const std::exception& ex) {
+            GTEST_SKIP() << "Loopback multicast unavailable: " << ex.what();
+        }
+        publisher->start();
+    }
+
+    void drain(size_t want) {
+        for (int i = 0; i < 50 && seqs.size() < want; ++i) {
+            subscriber->poll(20);
+        }
+    }
+
+    MulticastConfig config;
+    std::unique_ptr<MulticastPublisher> publisher;
+    std::unique_ptr<FeedSubscriber> subscriber;
+    std::vector<uint64_t> seqs;
+    std::vector<double> prices;
+};
+
+// Test: A large batch is split into packets and arrives in sequence
+TEST_F(MulticastFeedTest, BatchArrivesInOrder) {
+    publisher->publish(batch(100, 1.0));
+    drain(100);
+    ASSERT_EQ(seqs.size(), 100u);
+    for (size_t i = 0; i < seqs.size(); ++i) {
+        EXPECT_EQ(seqs[i], i + 1);
+    }
+    EXPECT_EQ(publisher->packetsSent(), (100 + FEED_MAX_ENTRIES - 1) / FEED_MAX_ENTRIES);
+}
+
+// Test: Retransmission returns retained entries and refuses expired ones
+TEST_F(MulticastFeedTest, Retransmit) {
+    publisher->publish(batch(50, 10.0));
+    std::vector<FeedEntry> entries;
+    ASSERT_TRUE(subscriber->retransmit(11, 5, entries));
+    ASSERT_EQ(entries.size(), 5u);
+    EXPECT_DOUBLE_EQ(entries[0].price, 20.0);
+
+    for (int i = 0; i < 10; ++i) {
+        publisher->publish(batch(50, 0.0));
+    }
+    EXPECT_FALSE(subscriber->retransmit(1, 5, entries));  // Beyond retention
+    EXPECT_GE(publisher->recoveryRequests(), 2u);
+}
+
+// Test: Snapshot carries the latest entry per symbol and resynchronises
+TEST_F(MulticastFeedTest, SnapshotResynchronises) {
+    publisher->publish(batch(3, 1.0));
+    publisher->publish(batch(3, 5.0));
+    drain(6);
+    seqs.clear();
+    prices.clear();
+
+    ASSERT_TRUE(subscriber->snapshot());
+    ASSERT_EQ(prices.size(), 3u);
+    EXPECT_DOUBLE_EQ(prices[0], 5.0);
+    EXPECT_EQ(seqs[0], 0u);
+    EXPECT_EQ(subscriber->expectedSeq(), publisher->lastSeq() + 1);
+}
+
+// Test: A restarted subscriber fills the gap before live entries
+TEST_F(MulticastFeedTest, GapFilledFromRecovery) {
+    publisher->publish(batch(5, 1.0));
+    drain(5);
+    subscriber.reset();  // Consumer restarts, missing the next 20 entries
+    publisher->publish(batch(20, 100.0));
+
+    seqs.clear();
+    subscriber = std::make_unique<FeedSubscriber>(config, [this](uint64_t seq, const FeedEntry&) {
+        seqs.push_back(seq);
+    });
+    subscriber->resumeFrom(6);
+    publisher->publish(batch(2, 1.0));
+    drain(22);
+    ASSERT_EQ(seqs.size(), 22u);
+    for (size_t i = 0; i < seqs.size(); ++i) {
+        EXPECT_EQ(seqs[i], i + 6);
+    }
+    EXPECT_EQ(subscriber->gapsRecovered(), 1u);
+    EXPECT_EQ(subscriber->entriesLost(), 0u);
+}
+
+// Test: A gap older than retention falls back to a snapshot
+TEST_F(MulticastFeedTest, ExpiredGapFallsBackToSnapshot) {
+    subscriber.reset();
+    for (int i = 0; i < 10; ++i) {
+        publisher->publish(batch(40, 1.0));  // 400 entries, 256 retained
+    }
+    seqs.clear();
+    subscriber = std::make_unique<FeedSubscriber>(config, [this](uint64_t seq, const FeedEntry&) {
+        seqs.push_back(seq);
+    });
+    subscriber->resumeFrom(1);
+    publisher->publish(batch(2, 1.0));
+    drain(40);
+    // One entry per symbol; the live packet is already in the snapshot
+    ASSERT_EQ(seqs.size(), 40u);
+    EXPECT_EQ(seqs.back(), 0u);
+    EXPECT_EQ(subscriber->expectedSeq(), 403u);
+    EXPECT_EQ(subscriber->entriesLost(), 400u);
+}
@@ -147,6 +147,25 @@ TEST_F(OrderStoreTest, StatsCalculation) {
     EXPECT_DOUBLE_EQ(stats.filledNotional, 200*50.0);
 }
 
+// Test: Algo parents report their progress in their own fields, outside the
+// notional their children carry
+TEST_F(OrderStoreTest, StatsReportAlgoParents) {
+    auto parent = createTestOrder("P1", 1000, 100.0);
+    parent.algo = "TWAP";
+    parent.status = STATUS_WORKING;
+    store.upsert(parent);
+    store.updateStatus("P1", STATUS_WORKING, 600, 400, 101.0);
+    store.upsert(createTestOrder("C1", 400, 100.0));
+
+    auto stats = store.getStats();
+    EXPECT_EQ(stats.workingOrders, 1);
+    EXPECT_EQ(stats.algoParents, 1);
+    EXPECT_EQ(stats.algoQty, 1000);
+    EXPECT_EQ(stats.algoCumQty, 400);
+    EXPECT_DOUBLE_EQ(stats.algoFilledNotional, 400 * 101.0);
+    EXPECT_DOUBLE_EQ(stats.totalNotional, 400 * 100.0);
+}
+
 // Test: JSON snapshot
 TEST_F(OrderStoreTest, JsonSnapshot) {
     auto order = createTestOrder("JSON1");
@@ -198,3 +217,101 @@ TEST_F(OrderStoreTest, ConcurrentAccess) {
     auto stats = store.getStats();
     EXPECT_EQ(stats.totalOrders, NUM_ORDERS);
 }
+
+// Test: Batch expiry only touches open orders
+TEST_F(OrderStoreTest, ExpireOrdersBatch) {
+    store.upsert(createTestOrder("EXP1"));
+    store.upsert(createTestOrder("EXP2"));
+    store.upsert(createTestOrder("EXP3"));
+    store.updateStatus("EXP2", "PARTIAL", 40, 60, 150.0);
+    store.updateStatus("EXP3", "FILLED", 0, 100, 150.0);
+
+    auto expired = store.expireOrders({"EXP1", "EXP2", "EXP3", "MISSING"});
+    ASSERT_EQ(expired.size(), 2);
+
+    auto partial = store.get("EXP2");
+    ASSERT_TRUE(partial.has_value());
+    EXPECT_EQ(partial->status, "EXPIRED");
+    EXPECT_EQ(partial->leavesQty, 0);
+    EXPECT_EQ(partial->cumQty, 60);
+    EXPECT_EQ(store.get("EXP3")->status, "FILLED");
+    EXPECT_EQ(store.getStats().expiredOrders, 2);
+}
+
+// Test: Stop activation converts pending stops once and is expirable before it
+TEST_F(OrderStoreTest, ActivatePendingStop) {
+    auto stop = createTestOrder("STP1");
+    stop.status = STATUS_PENDING_STOP;
+    stop.orderType = ORD_STOP;
+    stop.stopPx = 155.0;
+    store.upsert(stop);
+
+    auto stopLimit = createTestOrder("STP2");
+    stopLimit.status = STATUS_PENDING_STOP;
+    stopLimit.orderType = ORD_STOP_LIMIT;
+    stopLimit.stopPx = 155.0;
+    store.upsert(stopLimit);
+
+    store.upsert(createTestOrder("STP3"));
+    EXPECT_EQ(store.getPendingStops().size(), 2);
+    EXPECT_EQ(store.getOpenOrders().size(), 1);
+    EXPECT_EQ(store.getStats().pendingStopOrders, 2);
+
+    auto activated = store.activateStop("STP1");
+    ASSERT_TRUE(activated.has_value());
+    EXPECT_EQ(activated->status, "NEW");
+    EXPECT_EQ(activated->orderType, ORD_MARKET);
+    EXPECT_FALSE(store.activateStop("STP1").has_value());
+    EXPECT_FALSE(store.activateStop("STP3").has_value());
+
+    EXPECT_EQ(store.activateStop("STP2")->orderType, ORD_LIMIT);
+
+    auto pending = createTestOrder("STP4");
+    pending.status = STATUS_PENDING_STOP;
+    store.upsert(pending);
+    EXPECT_EQ(store.expireOrders({"STP4"}).size(), 1);
+    EXPECT_FALSE(store.activateStop("STP4").has_value());
+}
+
+// Test: Every change reaches the listener with the post-change state
+TEST_F(OrderStoreTest, ChangeListenerSeesEveryChange) {
+    std::vector<std::string> seen;
+    store.addChangeListener([&seen](const OrderRecord& record) {
+        seen.push_back(record.clOrdId + ":" + record.status);
+    });
+    store.upsert(createTestOrder("CHG1"));
+    store.updateStatus("CHG1", "PARTIAL", 50, 50, 150.0);
+    store.reject("CHG1", "test");
+    store.updateStatus("MISSING", "FILLED", 0, 100, 1.0);
+
+    ASSERT_EQ(seen.size(), 3);
+    EXPECT_EQ(seen[0], "CHG1:NEW");
+    EXPECT_EQ(seen[1], "CHG1:PARTIAL");
+    EXPECT_EQ(seen[2], "CHG1:REJECTED");
+}
+
+// Test: keys stay valid whichever way the record arrives, and remove()
+// keeps the arrival index in step
+TEST_F(OrderStoreTest, KeysSurviveCallerRecordsAndRemoval) {
+    const std::string longId = "CLIENT-ORDER-0000000001-LONG-ID";
+    {
+        auto shortOrder = createTestOrder("S1");
+        store.upsert(shortOrder);  // Copied: key must not point at shortOrder
+        store.upsert(createTestOrder(longId));  // Moved: key follows the buffer
+        store.upsert(createTestOrder("S2"));
+    }
+    auto amended = createTestOrder("S1", 200);
+    amended.clOrdId.reserve(64);  // Different buffer, same id
+    store.upsert(amended);
+
+    EXPECT_TRUE(store.exists("S1"));
+    EXPECT_TRUE(store.exists(longId));
+    EXPECT_EQ(store.get("S1")->quantity, 200);
+
+    store.remove(longId);
+    EXPECT_FALSE(store.exists(longId));
+    auto all = store.getAll();
+    ASSERT_EQ(all.size(), 2u);
+    EXPECT_EQ(all[0].clOrdId, "S1");
+    EXPECT_EQ(all[1].clOrdId, "S2");
+}
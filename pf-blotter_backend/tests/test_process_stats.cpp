@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+#include "qfblotter/ProcessStats.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace qfblotter;
+
+#if defined(__linux__)
+// Test: Threads, descriptors and heap are read from the live process. Other
+// tests in the binary may leave background threads or descriptors closing
+// concurrently, so counts are checked against the baseline with some slack
+// rather than for equality.
+TEST(ProcessStatsTest, TracksThreadsFdsAndHeap) {
+    constexpr int SLACK = 2;
+    const ProcessStats before = sampleProcessStats();
+    EXPECT_GT(before.rssKB, 0);
+    EXPECT_GE(before.threads, 1);
+    EXPECT_GE(before.openFds, 3);  // stdin, stdout, stderr
+
+    std::atomic<bool> release{false};
+    std::thread worker([&release] {
+        while (!release.load()) {
+            std::this_thread::yield();
+        }
+    });
+    std::FILE* file = std::tmpfile();
+    ASSERT_NE(file, nullptr);
+    std::vector<std::unique_ptr<char[]>> blocks;
+    for (int i = 0; i < 64; ++i) {
+        blocks.emplace_back(new char[64 * 1024]());
+    }
+
+    const ProcessStats during = sampleProcessStats();
+    EXPECT_GE(during.threads, before.threads + 1 - SLACK);
+    EXPECT_LE(during.threads, before.threads + 1 + SLACK);
+    EXPECT_GE(during.openFds, before.openFds + 1 - SLACK);
+    EXPECT_LE(during.openFds, before.openFds + 1 + SLACK);
+    if (before.heapUsedKB >= 0) {
+        EXPECT_GE(during.heapUsedKB, before.heapUsedKB + 4 * 1024 - 64);
+    }
+
+    release = true;
+    worker.join();
+    std::fclose(file);
+    blocks.clear();
+    const ProcessStats after = sampleProcessStats();
+    EXPECT_LE(after.threads, before.threads + SLACK);
+    EXPECT_LE(after.openFds, before.openFds + SLACK);
+}
+#endif
@@ -0,0 +1,222 @@
+#include <gtest/gtest.h>
+#include "qfblotter/MarketSim.hpp"
+#include "qfblotter/Replication.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace qfblotter;
+
+namespace {
+uint16_t testPort(int offset) {
+    return static_cast<uint16_t>(20000 + (::getpid() % 5000) * 5 + offset);
+}
+
+template <typename Pred>
+bool waitFor(Pred pred, int timeoutMs = 3000) {
+    for (int waited = 0; waited < timeoutMs; waited += 10) {
+        if (pred()) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return pred();
+}
+
+OrderRecord order(const std::string& id, const std::string& status, int cumQty = 0) {
+    OrderRecord record;
+    record.clOrdId = id;
+    record.symbol = "AAPL";
+    record.side = '1';
+    record.price = 150.0;
+    record.quantity = 100;
+    record.cumQty = cumQty;
+    record.leavesQty = 100 - cumQty;
+    record.status = status;
+    return record;
+}
+}  // namespace
+
+class ReplicationTest : public ::testing::Test {
+protected:
+    OrderStore primaryStore;
+    MarketSim primaryMarket{1};
+    OrderStore standbyStore;
+    MarketSim standbyMarket{2};
+    std::vector<FixSeqState> primaryFix{{"FIX.4.4:SIM->TRADER", 42, 17}};
+
+    ReplicationPrimary::SnapshotProvider provider() {
+        return [this]() {
+            ReplicationSnapshot snap;
+            snap.orders = primaryStore.getAll();
+            snap.prices = primaryMarket.lastPrices();
+            snap.fixSeqs = primaryFix;
+            return snap;
+        };
+    }
+
+    ReplicationStandby::Handlers handlers() {
+        ReplicationStandby::Handlers h;
+        h.onOrder = [this](const OrderRecord& record) { standbyStore.upsert(record); };
+        h.onTick = [this](const std::string& symbol, double price) { standbyMarket.restorePrice(symbol, price); };
+        return h;
+    }
+};
+
+// Test: Standby receives the snapshot, then live changes, then promotes
+TEST_F(ReplicationTest, SnapshotThenStream) {
+    ReplicationPrimary primary(testPort(0), provider());
+    primaryStore.addChangeListener([&primary](const OrderRecord& record) { primary.publishOrder(record); });
+    primaryMarket.addTickListener([&primary](const std::string& symbol, double price) {
+        primary.publishTick(symbol, price);
+    });
+    primary.start();
+
+    primaryStore.upsert(order("R1", "NEW"));
+    double px = primaryMarket.nextTick("AAPL");
+
+    ReplicationStandby standby("127.0.0.1", testPort(0), handlers());
+    standby.start();
+    ASSERT_TRUE(waitFor([&]() { return standby.synced(); }));
+    ASSERT_TRUE(standbyStore.get("R1").has_value());
+    EXPECT_DOUBLE_EQ(standbyMarket.mark("AAPL"), px);
+    auto fix = standby.fixSeqs();
+    ASSERT_EQ(fix.size(), 1u);
+    EXPECT_EQ(fix[0].senderSeq, 42);
+
+    primaryStore.upsert(order("R2", "NEW"));
+    primaryStore.updateStatus("R1", "PARTIAL", 40, 60, 150.0);
+    ASSERT_TRUE(waitFor([&]() { return standby.lastSeq() == primary.lastSeq() && primary.lastSeq() >= 2; }));
+    EXPECT_EQ(standbyStore.get("R1")->cumQty, 60);
+    EXPECT_TRUE(standbyStore.get("R2").has_value());
+    EXPECT_GE(standby.lagUs(), 0);
+
+    standby.promote();
+    EXPECT_FALSE(standby.connected());
+    primaryStore.upsert(order("R3", "NEW"));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_FALSE(standbyStore.get("R3").has_value());
+}
+
+// Test: Standby started before the primary keeps retrying
+TEST_F(ReplicationTest, StandbyWaitsForPrimary) {
+    ReplicationStandby standby("127.0.0.1", testPort(1), handlers());
+    standby.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_FALSE(standby.connected());
+
+    primaryStore.upsert(order("W1", "FILLED", 100));
+    ReplicationPrimary primary(testPort(1), provider());
+    primary.start();
+    ASSERT_TRUE(waitFor([&]() { return standby.synced(); }));
+    EXPECT_EQ(standbyStore.get("W1")->status, "FILLED");
+}
+
+// Test: A standby that overflows the queue is resynchronised from a snapshot
+TEST_F(ReplicationTest, OverflowForcesResync) {
+    ReplicationPrimary primary(testPort(2), provider(), 4);
+    primaryStore.addChangeListener([&primary](const OrderRecord& record) { primary.publishOrder(record); });
+    primary.start();
+
+    ReplicationStandby standby("127.0.0.1", testPort(2), handlers());
+    standby.start();
+    ASSERT_TRUE(waitFor([&]() { return standby.synced(); }));
+
+    for (int i = 0; i < 2000; ++i) {
+        primaryStore.upsert(order("O" + std::to_string(i), "NEW"));
+    }
+    // The burst overflows the 4-entry queue; the resync still delivers every order
+    ASSERT_TRUE(waitFor([&]() { return standbyStore.getAll().size() == 2000; }, 5000));
+    EXPECT_GE(primary.resyncs(), 2u);  // Initial snapshot plus at least one resync
+}
+
+// Test: Several followers receive the same stream, market data included
+TEST_F(ReplicationTest, MultipleFollowers) {
+    ReplicationPrimary primary(testPort(3), provider());
+    primaryStore.addChangeListener([&primary](const OrderRecord& record) { primary.publishOrder(record); });
+    primary.start();
+
+    OrderStore replicaStore;
+    std::atomic<int> mdBatches{0};
+    ReplicationStandby::Handlers replicaHandlers;
+    replicaHandlers.onOrder = [&replicaStore](const OrderRecord& record) { replicaStore.upsert(record); };
+    replicaHandlers.onMarketData = [&mdBatches](const Json& ticks) {
+        if (ticks.is_array() && ticks.size() == 2) {
+            ++mdBatches;
+        }
+    };
+    ReplicationStandby standby("127.0.0.1", testPort(3), handlers());
+    ReplicationStandby replica("127.0.0.1", testPort(3), replicaHandlers);
+    standby.start();
+    replica.start();
+    ASSERT_TRUE(waitFor([&]() { return standby.synced() && replica.synced() && primary.followers() == 2; }));
+
+    primaryStore.upsert(order("M1", "NEW"));
+    primary.publishMarketData(Json::array({{{"symbol", "AAPL"}, {"price", 1.0}}, {{"symbol", "MSFT"}, {"price", 2.0}}}));
+    ASSERT_TRUE(waitFor([&]() { return replicaStore.get("M1").has_value() && mdBatches == 1; }));
+    ASSERT_TRUE(waitFor([&]() { return standbyStore.get("M1").has_value(); }));
+
+    replica.promote();  // Disconnecting one follower leaves the other streaming
+    ASSERT_TRUE(waitFor([&]() { return primary.followers() == 1; }));
+    primaryStore.upsert(order("M2", "NEW"));
+    ASSERT_TRUE(waitFor([&]() { return standbyStore.get("M2").has_value(); }));
+    EXPECT_FALSE(replicaStore.get("M2").has_value());
+}
+
+// Test: A line the standby cannot apply drops the connection instead of
+// killing the replication thread, and the standby resyncs
+TEST_F(ReplicationTest, MalformedLineForcesResync) {
+    const int listenFd = ::socket(AF_INET, SOCK_STREAM, 0);
+    int reuse = 1;
+    ::setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(testPort(4));
+    ASSERT_EQ(::bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)), 0);
+    ASSERT_EQ(::listen(listenFd, 4), 0);
+
+    ReplicationStandby standby("127.0.0.1", testPort(4), handlers());
+    standby.start();
+
+    timeval acceptTimeout{3, 0};  // A standby that does not come back fails the test instead of hanging it
+    ::setsockopt(listenFd, SOL_SOCKET, SO_RCVTIMEO, &acceptTimeout, sizeof(acceptTimeout));
+
+    // Each connection sends one bad line and stays open: the next accept
+    // only succeeds if the standby dropped it and reconnected by itself
+    const std::vector<std::string> badLines = {
+        "not json\n",
+        "{\"t\":42}\n",
+        "{\"t\":\"order\",\"order\":{\"clOrdId\":\"B1\",\"side\":7}}\n",
+        "{\"t\":\"tick\",\"symbol\":\"AAPL\",\"price\":1.0,\"seq\":\"x\"}\n",
+    };
+    int fd = ::accept(listenFd, nullptr, nullptr);
+    ASSERT_GE(fd, 0);
+    for (const auto& bad : badLines) {
+        ASSERT_EQ(::send(fd, bad.data(), bad.size(), 0), static_cast<ssize_t>(bad.size()));
+        const int next = ::accept(listenFd, nullptr, nullptr);
+        ::close(fd);
+        fd = next;
+        ASSERT_GE(fd, 0) << bad;
+    }
+    EXPECT_FALSE(standby.synced());
+    EXPECT_FALSE(standbyStore.get("B1").has_value());
+
+    const std::string good = Json{{"t", "order"}, {"order", orderToJson(order("G1", "NEW"))}}.dump() + "\n" +
+                             "{\"t\":\"synced\"}\n";
+    ASSERT_EQ(::send(fd, good.data(), good.size(), 0), static_cast<ssize_t>(good.size()));
+    ASSERT_TRUE(waitFor([&]() { return standby.synced(); }));
+    EXPECT_TRUE(standbyStore.get("G1").has_value());
+
+    standby.promote();
+    ::close(fd);
+    ::close(listenFd);
+}
@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include "qfblotter/OrderStore.hpp"
+#include "qfblotter/RollingStats.hpp"
+
+#include <cstdint>
+
+using namespace qfblotter;
+
+// Test: Windows merge their per-second buckets and older seconds roll off
+TEST(RollingStatsTest, WindowsRollOff) {
+    const int64_t start = 1'700'000'000;
+    RollingStats stats(start);
+    stats.record(RollingStats::Flow::ORDER, 1000.0, start);
+    stats.record(RollingStats::Flow::ORDER, 500.0, start + 30);
+    stats.record(RollingStats::Flow::FILL, 250.0, start + 30);
+    stats.record(RollingStats::Flow::REJECT, 0.0, start + 90);
+    stats.record(RollingStats::Flow::CANCEL, 0.0, start + 90);
+
+    auto minute = stats.window(60, start + 90);
+    EXPECT_EQ(minute.seconds, 60);
+    EXPECT_EQ(minute.orders, 0u);  // Both orders are older than a minute
+    EXPECT_EQ(minute.rejects, 1u);
+    EXPECT_EQ(minute.cancels, 1u);
+
+    auto fiveMinutes = stats.window(300, start + 90);
+    EXPECT_EQ(fiveMinutes.orders, 2u);
+    EXPECT_EQ(fiveMinutes.fills, 1u);
+    EXPECT_DOUBLE_EQ(fiveMinutes.notional, 1500.0);
+    EXPECT_DOUBLE_EQ(fiveMinutes.filledNotional, 250.0);
+
+    // A later second reusing the ring slot replaces it; the session keeps all
+    stats.record(RollingStats::Flow::ORDER, 10.0, start + 300);
+    auto later = stats.window(300, start + 300);
+    EXPECT_EQ(later.orders, 2u);  // start+30 and start+300
+    auto session = stats.window(0, start + 300);
+    EXPECT_EQ(session.seconds, 301);
+    EXPECT_EQ(session.orders, 3u);
+    EXPECT_DOUBLE_EQ(session.notional, 1510.0);
+}
+
+// Test: Percentiles come from the merged histogram, within one bin
+TEST(RollingStatsTest, LatencyPercentiles) {
+    const int64_t start = 1'700'000'000;
+    RollingStats stats(start);
+    for (int64_t us = 1; us <= 1000; ++us) {
+        stats.recordLatency(us, start + us % 10);  // Spread across ten buckets
+    }
+
+    auto w = stats.window(60, start + 10);
+    EXPECT_EQ(w.latencySamples, 1000u);
+    EXPECT_EQ(w.avgLatencyUs, 500);
+    EXPECT_EQ(w.maxLatencyUs, 1000);
+    EXPECT_GE(w.p50LatencyUs, 500);
+    EXPECT_LE(w.p50LatencyUs, 500 * 9 / 8);
+    EXPECT_GE(w.p90LatencyUs, 900);
+    EXPECT_LE(w.p90LatencyUs, 1000);
+    EXPECT_GE(w.p99LatencyUs, 990);
+    EXPECT_LE(w.p99LatencyUs, 1000);  // Clamped to the max
+
+    stats.recordLatency(7, start + 200);
+    auto recent = stats.window(60, start + 200);
+    EXPECT_EQ(recent.latencySamples, 1u);
+    EXPECT_EQ(recent.p50LatencyUs, 7);  // Small values are exact
+    EXPECT_EQ(recent.p99LatencyUs, 7);
+}
+
+// Test: Window parameters accept seconds, minutes and the session
+TEST(RollingStatsTest, ParseWindow) {
+    EXPECT_EQ(RollingStats::parseWindow("60s"), 60);
+    EXPECT_EQ(RollingStats::parseWindow("5m"), 300);
+    EXPECT_EQ(RollingStats::parseWindow("15"), 15);
+    EXPECT_EQ(RollingStats::parseWindow("session"), 0);
+    EXPECT_EQ(RollingStats::parseWindow("0s"), -1);
+    EXPECT_EQ(RollingStats::parseWindow("6m"), -1);
+    EXPECT_EQ(RollingStats::parseWindow("1h"), -1);
+    EXPECT_EQ(RollingStats::parseWindow("-5s"), -1);
+    EXPECT_EQ(RollingStats::parseWindow(""), -1);
+}
+
+// Test: The order store records flow transitions, not every update
+TEST(RollingStatsTest, OrderStoreRecordsFlow) {
+    OrderStore store;
+    RollingStats stats;
+    store.setFlowStats(&stats);
+
+    OrderRecord order;
+    order.clOrdId = "ORD1";
+    order.symbol = "AAPL";
+    order.price = 100.0;
+    order.quantity = 10;
+    order.leavesQty = 10;
+    order.status = "NEW";
+    order.latencyUs = 42;
+    store.upsert(order);
+    store.updateStatus("ORD1", "PARTIAL", 6, 4, 100.0);
+    store.updateStatus("ORD1", "PARTIAL", 6, 4, 100.0);  // No new fill
+    store.updateStatus("ORD1", "FILLED", 0, 10, 101.0);
+
+    order.clOrdId = "ORD2";
+    order.latencyUs = 0;
+    store.upsert(order);
+    store.updateStatus("ORD2", "CANCELED", 0, 0, 0.0);
+    order.clOrdId = "ORD3";
+    store.upsert(order);
+    store.reject("ORD3", "Risk limit");
+
+    OrderRecord parent = order;
+    parent.clOrdId = "ALGO1";
+    parent.algo = "TWAP";
+    parent.status = STATUS_WORKING;
+    store.upsert(parent);  // Parents are counted through their children
+
+    auto session = stats.window(0);
+    EXPECT_EQ(session.orders, 3u);
+    EXPECT_DOUBLE_EQ(session.notional, 3000.0);
+    EXPECT_EQ(session.fills, 2u);
+    EXPECT_DOUBLE_EQ(session.filledNotional, 1010.0);
+    EXPECT_EQ(session.cancels, 1u);
+    EXPECT_EQ(session.rejects, 1u);
+    EXPECT_EQ(session.latencySamples, 1u);
+    EXPECT_EQ(session.maxLatencyUs, 42);
+
+    auto j = stats.windowJson(60);
+    EXPECT_EQ(j["window"], "60s");
+    EXPECT_EQ(j["orders"], 3);
+    EXPECT_EQ(j["latency"]["samples"], 1);
+}
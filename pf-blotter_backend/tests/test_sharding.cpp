@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include "qfblotter/Sharding.hpp"
+
+#include <vector>
+
+using namespace qfblotter;
+
+namespace {
+std::vector<std::string> symbols(int count) {
+    std::vector<std::string> out;
+    for (int i = 0; i < count; ++i) {
+        out.push_back("SYM" + std::to_string(i));
+    }
+    return out;
+}
+}  // namespace
+
+// Test: Assignment is deterministic and roughly balanced
+TEST(ShardRingTest, StableAndBalanced) {
+    ShardRing ring(defaultShardNames(4));
+    ShardRing again(defaultShardNames(4));
+    std::vector<int> counts(4, 0);
+    for (const auto& symbol : symbols(10000)) {
+        const size_t shard = ring.shardFor(symbol);
+        ASSERT_LT(shard, 4u);
+        EXPECT_EQ(shard, again.shardFor(symbol));
+        ++counts[shard];
+    }
+    for (int count : counts) {
+        EXPECT_GT(count, 1500);  // 2500 each if perfectly even
+        EXPECT_LT(count, 3500);
+    }
+}
+
+// Test: Adding a shard only moves symbols onto the new shard
+TEST(ShardRingTest, AddingShardMovesFewSymbols) {
+    ShardRing four(defaultShardNames(4));
+    ShardRing five(defaultShardNames(5));
+    int moved = 0;
+    for (const auto& symbol : symbols(10000)) {
+        const size_t before = four.shardFor(symbol);
+        const size_t after = five.shardFor(symbol);
+        if (before != after) {
+            EXPECT_EQ(after, 4u);
+            ++moved;
+        }
+    }
+    EXPECT_GT(moved, 1000);  // About 1/5 of the symbols
+    EXPECT_LT(moved, 3000);
+}
+
+// Test: Stats merge sums allow-listed counters (nested ones too), weights
+// latency averages and takes the max of other gauges; down shards are
+// skipped, and gauges and unsummable fields are kept per shard
+TEST(ShardingTest, MergeStats) {
+    Json a{{"totalOrders", 10}, {"filledNotional", 100.5}, {"avgLatencyUs", 10.0},
+           {"minLatencyUs", 2.0}, {"maxLatencyUs", 50.0}, {"p99LatencyUs", 40.0}, {"replicationRole", "primary"},
+           {"admissionAdmitted", 100}, {"admissionLatencyUs", 200}, {"replicationSeq", 7}, {"rssKB", 1000},
+           {"algo", {{"parents", 1}, {"cumQty", 300}}},
+           {"venues", Json::array({{{"name", "ARCA"}, {"slices", 4}}})}};
+    Json b{{"totalOrders", 30}, {"filledNotional", 50.0}, {"avgLatencyUs", 20.0},
+           {"minLatencyUs", 5.0}, {"maxLatencyUs", 30.0}, {"p99LatencyUs", 25.0},
+           {"admissionAdmitted", 300}, {"admissionLatencyUs", 400}, {"replicationSeq", 5}, {"rssKB", 3000},
+           {"algo", {{"parents", 2}, {"cumQty", 100}}}};
+    Json merged = mergeStats({a, b, Json()});
+    EXPECT_EQ(merged["totalOrders"].get<int64_t>(), 40);
+    EXPECT_DOUBLE_EQ(merged["filledNotional"].get<double>(), 150.5);
+    EXPECT_DOUBLE_EQ(merged["avgLatencyUs"].get<double>(), 17.5);
+    EXPECT_DOUBLE_EQ(merged["minLatencyUs"].get<double>(), 2.0);
+    EXPECT_DOUBLE_EQ(merged["maxLatencyUs"].get<double>(), 50.0);
+    EXPECT_EQ(merged["shardsUp"].get<size_t>(), 2u);
+    EXPECT_FALSE(merged.contains("replicationRole"));
+    EXPECT_EQ(merged["rssKB"].get<int64_t>(), 4000);
+    EXPECT_DOUBLE_EQ(merged["admissionLatencyUs"].get<double>(), 350.0);  // Not 600: a gauge
+    EXPECT_EQ(merged["replicationSeq"].get<int64_t>(), 7);
+    EXPECT_EQ(merged["algo"]["parents"].get<int64_t>(), 3);
+    EXPECT_EQ(merged["algo"]["cumQty"].get<int64_t>(), 400);
+    ASSERT_EQ(merged["byShard"].size(), 3u);
+    EXPECT_EQ(merged["byShard"][0]["replicationRole"], "primary");
+    EXPECT_EQ(merged["byShard"][0]["venues"][0]["name"], "ARCA");
+    EXPECT_EQ(merged["byShard"][1]["replicationSeq"], 5);
+    EXPECT_FALSE(merged["byShard"][1].contains("venues"));
+    EXPECT_FALSE(merged["byShard"][1].contains("totalOrders"));
+    EXPECT_TRUE(merged["byShard"][2].is_null());
+}
+
+// Test: Snapshots concatenate and TCA totals are recombined
+TEST(ShardingTest, MergeSnapshotsAndTca) {
+    Json snap = mergeSnapshots({Json::array({{{"clOrdId", "A"}}}), Json(), Json::array({{{"clOrdId", "B"}}})});
+    ASSERT_EQ(snap.size(), 2u);
+    EXPECT_EQ(snap[1]["clOrdId"], "B");
+
+    // 10 on 10000 notional and 30 on 20000 notional -> 40 on 30000
+    Json tca = mergeTcaSummaries({
+        Json{{"buckets", Json::array({{{"symbol", "AAPL"}}})}, {"totalShortfallCost", 10.0}, {"totalShortfallBps", 10.0}},
+        Json{{"buckets", Json::array({{{"symbol", "MSFT"}}})}, {"totalShortfallCost", 30.0}, {"totalShortfallBps", 15.0}},
+    });
+    EXPECT_EQ(tca["buckets"].size(), 2u);
+    EXPECT_DOUBLE_EQ(tca["totalShortfallCost"].get<double>(), 40.0);
+    EXPECT_NEAR(tca["totalShortfallBps"].get<double>(), 40.0 / 30000.0 * 10000.0, 1e-9);
+}
+
+// Test: Window stats add counts and rates and weight the latency average;
+// percentiles are the worst shard's
+TEST(ShardingTest, MergeWindowStats) {
+    Json a{{"window", "60s"}, {"seconds", 60}, {"orders", 60}, {"ordersPerSec", 1.0}, {"notional", 100.0},
+           {"latency", {{"samples", 10}, {"avgUs", 100}, {"p99Us", 900}, {"maxUs", 1000}}}};
+    Json b{{"window", "60s"}, {"seconds", 60}, {"orders", 120}, {"ordersPerSec", 2.0}, {"notional", 50.0},
+           {"latency", {{"samples", 30}, {"avgUs", 200}, {"p99Us", 500}, {"maxUs", 2000}}}};
+    Json merged = mergeWindowStats({a, Json(), b});
+    EXPECT_EQ(merged["window"], "60s");
+    EXPECT_EQ(merged["seconds"].get<int64_t>(), 60);
+    EXPECT_EQ(merged["orders"].get<int64_t>(), 180);
+    EXPECT_DOUBLE_EQ(merged["ordersPerSec"].get<double>(), 3.0);
+    EXPECT_DOUBLE_EQ(merged["notional"].get<double>(), 150.0);
+    EXPECT_EQ(merged["latency"]["samples"].get<int64_t>(), 40);
+    EXPECT_DOUBLE_EQ(merged["latency"]["avgUs"].get<double>(), 175.0);
+    EXPECT_EQ(merged["latency"]["p99Us"].get<int64_t>(), 900);
+    EXPECT_EQ(merged["latency"]["maxUs"].get<int64_t>(), 2000);
+    EXPECT_TRUE(mergeWindowStats({Json()}).empty());
+}
@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+#include "qfblotter/OrderStore.hpp"
+#include "qfblotter/ShmPublisher.hpp"
+#include "qfblotter/ShmReader.hpp"
+
+#include <thread>
+
+#include <unistd.h>
+
+using namespace qfblotter;
+
+namespace {
+std::string uniqueName(const std::string& test) {
+    return "/qfblotter_test_" + test + "_" + std::to_string(::getpid());
+}
+}  // namespace
+
+// Test: Ticks and order events arrive in order with their fields intact
+TEST(ShmFeedTest, RoundTrip) {
+    ShmPublisher publisher(uniqueName("rt"), 64);
+    ShmReader reader(uniqueName("rt"));
+    ShmRecord record{};
+    EXPECT_EQ(reader.poll(record), ShmReader::Poll::EMPTY);
+
+    publisher.publishTick("AAPL", 187.25);
+    OrderRecord order;
+    order.clOrdId = "SHM1";
+    order.symbol = "MSFT";
+    order.side = '2';
+    order.status = "PARTIAL";
+    order.quantity = 100;
+    order.leavesQty = 40;
+    order.cumQty = 60;
+    order.avgPx = 410.5;
+    publisher.publishOrder(order);
+
+    ASSERT_EQ(reader.poll(record), ShmReader::Poll::RECORD);
+    EXPECT_EQ(record.type, ShmRecordType::TICK);
+    EXPECT_EQ(shmFieldString(record.tick.symbol), "AAPL");
+    EXPECT_DOUBLE_EQ(record.tick.price, 187.25);
+    EXPECT_GT(record.timestampNs, 0);
+
+    ASSERT_EQ(reader.poll(record), ShmReader::Poll::RECORD);
+    EXPECT_EQ(record.type, ShmRecordType::ORDER);
+    EXPECT_EQ(shmFieldString(record.order.clOrdId), "SHM1");
+    EXPECT_EQ(shmFieldString(record.order.status), "PARTIAL");
+    EXPECT_EQ(record.order.side, '2');
+    EXPECT_EQ(record.order.cumQty, 60);
+    EXPECT_DOUBLE_EQ(record.order.avgPx, 410.5);
+
+    EXPECT_EQ(reader.poll(record), ShmReader::Poll::EMPTY);
+}
+
+// Test: A lapped reader is told how much it lost and resumes on live data
+TEST(ShmFeedTest, OverrunIsReported) {
+    ShmPublisher publisher(uniqueName("ovr"), 8);
+    ShmReader reader(uniqueName("ovr"));
+    for (int i = 0; i < 20; ++i) {
+        publisher.publishTick("AAPL", 100.0 + i);
+    }
+    ShmRecord record{};
+    ASSERT_EQ(reader.poll(record), ShmReader::Poll::OVERRUN);
+    EXPECT_GT(reader.lost(), 0u);
+
+    int received = 0;
+    while (reader.poll(record) == ShmReader::Poll::RECORD) {
+        ++received;
+    }
+    EXPECT_EQ(reader.lost() + static_cast<uint64_t>(received), 20u);
+    EXPECT_DOUBLE_EQ(record.tick.price, 119.0);
+}
+
+// Test: Replay starts from the oldest record still in the ring
+TEST(ShmFeedTest, ReplayFromOldest) {
+    ShmPublisher publisher(uniqueName("rep"), 4);
+    for (int i = 0; i < 6; ++i) {
+        publisher.publishTick("AAPL", static_cast<double>(i));
+    }
+    ShmReader reader(uniqueName("rep"), true);
+    ShmRecord record{};
+    ASSERT_EQ(reader.poll(record), ShmReader::Poll::RECORD);
+    EXPECT_DOUBLE_EQ(record.tick.price, 2.0);
+}
+
+// Test: A concurrent reader never sees a torn record
+TEST(ShmFeedTest, ConcurrentReaderSeesConsistentRecords) {
+    constexpr int COUNT = 200'000;
+    ShmPublisher publisher(uniqueName("conc"), 1024);
+    ShmReader reader(uniqueName("conc"));
+
+    std::thread writer([&publisher]() {
+        for (int i = 0; i < COUNT; ++i) {
+            // Symbol and price encode the same value so tearing is detectable
+            publisher.publishTick(std::to_string(i), static_cast<double>(i));
+        }
+    });
+
+    uint64_t received = 0;
+    uint64_t torn = 0;
+    ShmRecord record{};
+    while (received + reader.lost() < COUNT) {
+        auto result = reader.poll(record);
+        if (result == ShmReader::Poll::RECORD) {
+            ++received;
+            if (shmFieldString(record.tick.symbol) != std::to_string(static_cast<int>(record.tick.price))) {
+                ++torn;
+            }
+        }
+    }
+    writer.join();
+    EXPECT_EQ(torn, 0u);
+    EXPECT_EQ(received + reader.lost(), static_cast<uint64_t>(COUNT));
+}
+
+// Test: Opening a missing feed throws
+TEST(ShmFeedTest, MissingSegmentThrows) {
+    EXPECT_THROW(ShmReader(uniqueName("missing")), std::runtime_error);
+}
@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+#include "qfblotter/CoarseClock.hpp"
+#include "qfblotter/EventScheduler.hpp"
+#include "qfblotter/OrderExpiry.hpp"
+#include "qfblotter/SimClock.hpp"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+using namespace qfblotter;
+
+namespace {
+constexpr int64_t START_MS = 1'767'260'400'000;  // 2026-01-01T09:40:00Z
+
+// Every test leaves the process on the real clock
+class SimClockTest : public ::testing::Test {
+protected:
+    void TearDown() override { SimClock::setReal(); }
+};
+}  // namespace
+
+// Test: Virtual time stands still until advanced, never goes backwards, and
+// drives the timestamp clock
+TEST_F(SimClockTest, VirtualTimeMovesOnlyWhenAdvanced) {
+    SimClock::setVirtual(START_MS);
+    EXPECT_TRUE(SimClock::isVirtual());
+    EXPECT_EQ(SimClock::epochMs(), START_MS);
+    EXPECT_EQ(SimClock::steadyUs(), START_MS * 1000);
+
+    SimClock::advanceBy(1'500'000);
+    EXPECT_EQ(SimClock::epochMs(), START_MS + 1500);
+    SimClock::advanceTo(START_MS * 1000);  // Earlier: ignored
+    EXPECT_EQ(SimClock::epochMs(), START_MS + 1500);
+
+    EXPECT_EQ(CoarseClock::nowMs(), START_MS + 1500);
+    EXPECT_EQ(CoarseClock::isoSeconds(), "2026-01-01T09:40:01Z");
+    char buf[CoarseClock::ISO_MILLIS_SIZE];
+    EXPECT_EQ(std::string(CoarseClock::isoMillis(buf)), "2026-01-01T09:40:01.500Z");
+
+    SimClock::setReal();
+    const auto realMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    EXPECT_NEAR(static_cast<double>(SimClock::epochMs()), static_cast<double>(realMs), 1000.0);
+}
+
+// Test: runUntil jumps the clock from event to event, so recurring and
+// one-off events interleave exactly and a simulated hour takes no real time
+TEST_F(SimClockTest, SchedulerRunsVirtualTime) {
+    SimClock::setVirtual(START_MS);
+    EventScheduler scheduler;
+    std::vector<int64_t> ticks;
+    std::vector<int64_t> fills;
+    scheduler.every(250'000, [&] { ticks.push_back(SimClock::epochMs() - START_MS); });
+    scheduler.after(600'000, [&] {
+        fills.push_back(SimClock::epochMs() - START_MS);
+        scheduler.after(150'000, [&] { fills.push_back(SimClock::epochMs() - START_MS); });
+    });
+
+    const auto realStart = std::chrono::steady_clock::now();
+    scheduler.runUntil(SimClock::steadyUs() + 1'000'000);
+    EXPECT_EQ(ticks, (std::vector<int64_t>{250, 500, 750, 1000}));
+    EXPECT_EQ(fills, (std::vector<int64_t>{600, 750}));
+    EXPECT_EQ(SimClock::epochMs(), START_MS + 1000);
+
+    scheduler.runUntil(SimClock::steadyUs() + 3'600'000'000LL);
+    EXPECT_EQ(ticks.size(), 4u + 3600u * 4u);
+    EXPECT_EQ(ticks.back(), 3'601'000);
+    EXPECT_LT(std::chrono::steady_clock::now() - realStart, std::chrono::seconds(5));
+}
+
+// Test: Order expiry follows the virtual clock through runDue
+TEST_F(SimClockTest, ExpiryOnVirtualTime) {
+    SimClock::setVirtual(START_MS);
+    std::vector<std::string> expired;
+    OrderExpiry expiry([&](const std::vector<std::string>& ids) {
+        expired.insert(expired.end(), ids.begin(), ids.end());
+    });
+    expiry.schedule("ORD1", START_MS + 60'000);
+    EventScheduler scheduler;
+    scheduler.every(100'000, [&] { expiry.runDue(SimClock::epochMs()); });
+
+    scheduler.runUntil(SimClock::steadyUs() + 59'000'000);
+    EXPECT_TRUE(expired.empty());
+    scheduler.runUntil(SimClock::steadyUs() + 2'000'000);
+    EXPECT_EQ(expired, (std::vector<std::string>{"ORD1"}));
+}
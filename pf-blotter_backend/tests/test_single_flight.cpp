@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+#include "qfblotter/SingleFlight.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace qfblotter;
+using namespace std::chrono_literals;
+
+// Test: Concurrent callers of one key share a single computation
+TEST(SingleFlightTest, CoalescesConcurrentCalls) {
+    SingleFlight flight;
+    std::atomic<int> calls{0};
+    std::atomic<bool> release{false};
+    auto compute = [&]() {
+        ++calls;
+        while (!release.load()) {
+            std::this_thread::yield();
+        }
+        return std::string("{\"orders\":[]}");
+    };
+
+    std::vector<std::thread> readers;
+    std::vector<SingleFlight::Result> results(8);
+    for (size_t i = 0; i < results.size(); ++i) {
+        readers.emplace_back([&, i] { results[i] = flight.get("/snapshot", 0ms, compute); });
+    }
+    while (flight.coalesced() < results.size() - 1) {
+        std::this_thread::yield();
+    }
+    release = true;
+    for (auto& t : readers) {
+        t.join();
+    }
+
+    EXPECT_EQ(calls.load(), 1);
+    EXPECT_EQ(flight.computed(), 1u);
+    for (const auto& result : results) {
+        ASSERT_TRUE(result);
+        EXPECT_EQ(result.get(), results[0].get());  // The same shared string
+    }
+    // Without a TTL the next call computes again
+    flight.get("/snapshot", 0ms, compute);
+    EXPECT_EQ(calls.load(), 2);
+}
+
+// Test: Results are served from cache for the TTL, per key
+TEST(SingleFlightTest, CachesForTtl) {
+    SingleFlight flight;
+    int calls = 0;
+    auto compute = [&]() { return std::to_string(++calls); };
+
+    EXPECT_EQ(*flight.get("/stats", 50ms, compute), "1");
+    EXPECT_EQ(*flight.get("/stats", 50ms, compute), "1");
+    EXPECT_EQ(*flight.get("/orderbook?symbol=AAPL", 50ms, compute), "2");
+    EXPECT_EQ(flight.cacheHits(), 1u);
+
+    std::this_thread::sleep_for(60ms);
+    EXPECT_EQ(*flight.get("/stats", 50ms, compute), "3");
+}
+
+// Test: A failed computation reaches every waiter and is not cached
+TEST(SingleFlightTest, ExceptionsAreShared) {
+    SingleFlight flight;
+    std::atomic<bool> release{false};
+    auto failing = [&]() -> std::string {
+        while (!release.load()) {
+            std::this_thread::yield();
+        }
+        throw std::runtime_error("store unavailable");
+    };
+
+    std::atomic<int> failures{0};
+    std::thread leader([&] {
+        try {
+            flight.get("/tca", 1000ms, failing);
+        } catch (const std::runtime_error&) {
+            ++failures;
+        }
+    });
+    while (flight.computed() < 1) {
+        std::this_thread::yield();
+    }
+    std::thread waiter([&] {
+        try {
+            flight.get("/tca", 1000ms, failing);
+        } catch (const std::runtime_error&) {
+            ++failures;
+        }
+    });
+    while (flight.coalesced() < 1) {
+        std::this_thread::yield();
+    }
+    release = true;
+    leader.join();
+    waiter.join();
+    EXPECT_EQ(failures.load(), 2);
+
+    EXPECT_EQ(*flight.get("/tca", 1000ms, [] { return std::string("{}"); }), "{}");
+}
+
+// Test: Empty ("not found") results are not cached, and invalidate() makes
+// the next caller recompute
+TEST(SingleFlightTest, SkipsEmptyResultsAndInvalidates) {
+    SingleFlight flight;
+    int calls = 0;
+    std::string value;
+    auto compute = [&]() {
+        ++calls;
+        return value;
+    };
+
+    EXPECT_TRUE(flight.get("/tca?clOrdId=X", 10s, compute)->empty());
+    value = "{\"clOrdId\":\"X\"}";
+    EXPECT_EQ(*flight.get("/tca?clOrdId=X", 10s, compute), value);
+    EXPECT_EQ(calls, 2);
+
+    EXPECT_EQ(*flight.get("/tca?clOrdId=X", 10s, compute), value);
+    EXPECT_EQ(calls, 2);
+
+    value = "{\"clOrdId\":\"X\",\"cumQty\":100}";
+    flight.invalidate("/tca?clOrdId=X");
+    EXPECT_EQ(*flight.get("/tca?clOrdId=X", 10s, compute), value);
+    EXPECT_EQ(calls, 3);
+}
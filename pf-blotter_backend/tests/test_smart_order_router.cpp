@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include "qfblotter/SmartOrderRouter.hpp"
+
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace qfblotter;
+
+namespace {
+OrderBook book(std::vector<BookLevel> bids, std::vector<BookLevel> asks) {
+    OrderBook b;
+    b.symbol = "AAPL";
+    b.bids = std::move(bids);
+    b.asks = std::move(asks);
+    return b;
+}
+
+VenueConfig venue(const std::string& name, int64_t latencyUs, double fee) {
+    VenueConfig config;
+    config.name = name;
+    config.latencyUs = latencyUs;
+    config.jitterUs = 0;
+    config.feePerShare = fee;
+    return config;
+}
+}  // namespace
+
+// Test: Venue specs parse in order and malformed ones are rejected
+TEST(SmartOrderRouterTest, ParsesVenues) {
+    const auto venues = parseVenues("ARCA:400:80:0.003,BATS:900:200:-0.002");
+    ASSERT_EQ(venues.size(), 2u);
+    EXPECT_EQ(venues[0].name, "ARCA");
+    EXPECT_EQ(venues[0].latencyUs, 400);
+    EXPECT_EQ(venues[1].jitterUs, 200);
+    EXPECT_DOUBLE_EQ(venues[1].feePerShare, -0.002);
+    EXPECT_NE(venues[0].seed, venues[1].seed);
+
+    EXPECT_THROW(parseVenues("ARCA:400:0.003"), std::runtime_error);
+    EXPECT_THROW(parseVenues("ARCA:fast:80:0.003"), std::runtime_error);
+    EXPECT_THROW(parseVenues("ARCA:-1:0:0"), std::runtime_error);
+    EXPECT_THROW(parseVenues(""), std::runtime_error);
+}
+
+// Test: Liquidity is taken cheapest first by price + fee + latency drift,
+// within the limit, and grouped into one slice per venue
+TEST(SmartOrderRouterTest, PlansByEffectivePrice) {
+    EventScheduler scheduler;
+    // A: fast, expensive fee. B: rebate. C: cheap fee but 20ms away.
+    SmartOrderRouter router({venue("A", 100, 0.01), venue("B", 100, -0.002), venue("C", 20000, 0.0)}, scheduler,
+                            [](const std::string&) { return 100.0; }, 0.5);
+    const std::vector<OrderBook> books = {
+        book({}, {{100.00, 100}, {100.10, 500}}),
+        book({}, {{100.00, 100}, {100.05, 100}}),
+        book({}, {{100.00, 300}}),  // Drift 100 x 0.5bp x 20ms = 0.10/share
+    };
+
+    // Costs: B 99.9985, A 100.0105, B 100.0485, C 100.10, then A 100.1105 (unused)
+    const auto slices = router.plan('1', 100.10, 400, books);
+    ASSERT_EQ(slices.size(), 3u);
+    EXPECT_EQ(slices[0].venue, 0u);
+    EXPECT_EQ(slices[0].qty, 100);
+    EXPECT_EQ(slices[1].venue, 1u);
+    EXPECT_EQ(slices[1].qty, 200);
+    EXPECT_NEAR(slices[1].expectedPx, 100.025, 1e-9);
+    EXPECT_EQ(slices[2].venue, 2u);
+    EXPECT_EQ(slices[2].qty, 100);
+
+    // Nothing within the limit means no route
+    EXPECT_TRUE(router.plan('1', 99.0, 100, books).empty());
+    // Sells rank by net proceeds; only bids are used
+    const std::vector<OrderBook> bids = {book({{99.9, 50}}, {}), book({{99.9, 50}}, {}), book({}, {})};
+    const auto sells = router.plan('2', 0.0, 80, bids);
+    ASSERT_EQ(sells.size(), 2u);
+    EXPECT_EQ(sells[0].venue, 0u);
+    EXPECT_EQ(sells[0].qty, 30);  // B's rebate makes it the better sell
+    EXPECT_EQ(sells[1].venue, 1u);
+    EXPECT_EQ(sells[1].qty, 50);
+}
+
+// Test: Slices execute after the venue latency, report back on the
+// scheduler, and keep the order in flight until the last one returns
+TEST(SmartOrderRouterTest, RoutesThroughScheduler) {
+    EventScheduler scheduler;
+    SmartOrderRouter router({venue("A", 500, 0.003), venue("B", 2000, 0.001)}, scheduler,
+                            [](const std::string&) { return 100.0; });
+    std::vector<VenueExecution> executions;
+    const auto record = [&](const VenueExecution& e) {
+        executions.push_back(e);
+        return executions.size() == 1 ? e.fillQty : 0;  // Refuse all but the first
+    };
+
+    // No limit: the whole order routes against the venues' books
+    const int sent = router.route("ORD1", "AAPL", '1', 0.0, 300, record);
+    EXPECT_EQ(sent, 300);
+    EXPECT_TRUE(router.inFlight("ORD1"));
+    EXPECT_EQ(router.route("ORD1", "AAPL", '1', 0.0, 300, record), 0);
+    EXPECT_GE(scheduler.pending(), 1u);
+    EXPECT_TRUE(executions.empty());  // Nothing happens until time passes
+
+    scheduler.runDue(std::numeric_limits<int64_t>::max());
+    EXPECT_FALSE(router.inFlight("ORD1"));
+    ASSERT_FALSE(executions.empty());
+    int filled = 0;
+    for (const auto& e : executions) {
+        EXPECT_EQ(e.clOrdId, "ORD1");
+        EXPECT_GT(e.fillQty, 0);
+        EXPECT_NEAR(e.fillPx, 100.0, 1.0);
+        EXPECT_GT(e.fee, 0.0);
+        EXPECT_GE(e.latencyUs, 2 * 500);  // Out and back, jitter 0
+        filled += e.fillQty;
+    }
+    EXPECT_LE(filled, 300);
+
+    uint64_t statsFilled = 0;
+    uint64_t statsBusted = 0;
+    for (const auto& s : router.stats()) {
+        statsFilled += s.filledQty;
+        statsBusted += s.bustedQty;
+        if (s.slices > 0) {
+            EXPECT_GT(s.avgLatencyUs, 0);
+        }
+    }
+    EXPECT_EQ(statsFilled, static_cast<uint64_t>(filled));
+    EXPECT_EQ(statsBusted, static_cast<uint64_t>(filled - executions[0].fillQty));
+}
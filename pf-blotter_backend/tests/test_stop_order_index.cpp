@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+#include "qfblotter/StopOrderIndex.hpp"
+
+using namespace qfblotter;
+
+class StopOrderIndexTest : public ::testing::Test {
+protected:
+    StopOrderIndex index;
+    std::vector<StopTrigger> triggered;
+};
+
+// Test: Buy stops trigger at or above the stop price, lowest first
+TEST_F(StopOrderIndexTest, BuyStopsTriggerOnRise) {
+    index.add("B1", "AAPL", '1', 101.0);
+    index.add("B2", "AAPL", '1', 100.5);
+    index.add("B3", "AAPL", '1', 102.0);
+
+    index.onTick("AAPL", 100.0, triggered);
+    EXPECT_TRUE(triggered.empty());
+
+    index.onTick("AAPL", 101.0, triggered);
+    ASSERT_EQ(triggered.size(), 2);
+    EXPECT_EQ(triggered[0].clOrdId, "B2");
+    EXPECT_EQ(triggered[1].clOrdId, "B1");
+    EXPECT_DOUBLE_EQ(triggered[1].triggerPx, 101.0);
+    EXPECT_EQ(index.size(), 1);
+}
+
+// Test: Sell stops trigger at or below the stop price, highest first
+TEST_F(StopOrderIndexTest, SellStopsTriggerOnFall) {
+    index.add("S1", "AAPL", '2', 99.0);
+    index.add("S2", "AAPL", '2', 99.5);
+
+    index.onTick("AAPL", 99.6, triggered);
+    EXPECT_TRUE(triggered.empty());
+
+    index.onTick("AAPL", 98.0, triggered);
+    ASSERT_EQ(triggered.size(), 2);
+    EXPECT_EQ(triggered[0].clOrdId, "S2");
+    EXPECT_EQ(triggered[1].clOrdId, "S1");
+    EXPECT_EQ(triggered[0].side, '2');
+    EXPECT_EQ(index.size(), 0);
+}
+
+// Test: Ticks only affect their own symbol, and a stop triggers once
+TEST_F(StopOrderIndexTest, PerSymbolAndOneShot) {
+    index.add("A", "AAPL", '1', 100.0);
+    index.add("M", "MSFT", '1', 100.0);
+
+    index.onTick("MSFT", 150.0, triggered);
+    ASSERT_EQ(triggered.size(), 1);
+    EXPECT_EQ(triggered[0].clOrdId, "M");
+
+    triggered.clear();
+    index.onTick("MSFT", 150.0, triggered);
+    index.onTick("GOOGL", 150.0, triggered);
+    EXPECT_TRUE(triggered.empty());
+    EXPECT_EQ(index.size(), 1);
+}
+
+// Test: Removed stops never trigger; duplicates are ignored
+TEST_F(StopOrderIndexTest, RemoveAndDuplicate) {
+    index.add("X", "AAPL", '1', 100.0);
+    index.add("X", "AAPL", '1', 90.0);
+    index.add("Y", "AAPL", '2', 100.0);
+    EXPECT_EQ(index.size(), 2);
+
+    EXPECT_TRUE(index.remove("X"));
+    EXPECT_FALSE(index.remove("X"));
+
+    index.onTick("AAPL", 100.0, triggered);
+    ASSERT_EQ(triggered.size(), 1);
+    EXPECT_EQ(triggered[0].clOrdId, "Y");
+}
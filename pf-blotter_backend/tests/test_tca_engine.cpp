@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include "qfblotter/OrderStore.hpp"
+#include "qfblotter/TcaEngine.hpp"
+
+using namespace qfblotter;
+
+class TcaEngineTest : public ::testing::Test {
+protected:
+    TcaEngine tca;
+
+    OrderRecord order(const std::string& clOrdId, char side, double arrivalPx = 0.0) {
+        OrderRecord o;
+        o.clOrdId = clOrdId;
+        o.symbol = "AAPL";
+        o.side = side;
+        o.arrivalPx = arrivalPx;
+        return o;
+    }
+};
+
+// Test: Buy shortfall is positive when filled above arrival
+TEST_F(TcaEngineTest, BuyShortfall) {
+    tca.onArrival("B1", "AAPL", '1', 100.0);
+    tca.onFill(order("B1", '1'), 100, 100.10);
+    tca.onFill(order("B1", '1'), 100, 100.30);
+
+    auto j = tca.orderJson("B1");
+    ASSERT_TRUE(j.has_value());
+    EXPECT_EQ((*j)["filledQty"], 200);
+    EXPECT_NEAR((*j)["avgPx"].get<double>(), 100.20, 1e-9);
+    EXPECT_NEAR((*j)["shortfallCost"].get<double>(), 40.0, 1e-9);
+    EXPECT_NEAR((*j)["shortfallBps"].get<double>(), 20.0, 1e-9);
+}
+
+// Test: Sell shortfall sign is inverted
+TEST_F(TcaEngineTest, SellShortfall) {
+    tca.onArrival("S1", "AAPL", '2', 100.0);
+    tca.onFill(order("S1", '2'), 50, 99.0);
+
+    auto j = tca.orderJson("S1");
+    ASSERT_TRUE(j.has_value());
+    EXPECT_NEAR((*j)["shortfallCost"].get<double>(), 50.0, 1e-9);
+}
+
+// Test: Interval VWAP only counts market prints after the order arrived;
+// the blotter's own fills are not prints
+TEST_F(TcaEngineTest, IntervalVwap) {
+    tca.onMarketPrint("AAPL", 90.0, 1000);
+    tca.onArrival("LATE", "AAPL", '1', 100.0);
+    tca.onMarketPrint("AAPL", 99.0, 100);
+    tca.onMarketPrint("AAPL", 101.0, 100);
+    tca.onFill(order("LATE", '1'), 100, 101.0);
+
+    auto j = tca.orderJson("LATE");
+    ASSERT_TRUE(j.has_value());
+    EXPECT_NEAR((*j)["intervalVwap"].get<double>(), 100.0, 1e-9);
+    EXPECT_NEAR((*j)["vwapSlippageBps"].get<double>(), 100.0, 1e-9);
+
+    // Session VWAP covers all prints, and only prints
+    EXPECT_NEAR(tca.marketVwap("AAPL"), (90.0 * 1000 + 99.0 * 100 + 101.0 * 100) / 1200.0, 1e-9);
+}
+
+// Test: VWAP slippage is measured against market prints, so filling above
+// the market costs even when the blotter is the only one filling
+TEST_F(TcaEngineTest, VwapSlippageAgainstMarket) {
+    tca.onArrival("B1", "AAPL", '1', 100.0);
+    tca.onFill(order("B1", '1'), 100, 100.5);  // Before any print: no benchmark
+    tca.onMarketPrint("AAPL", 100.0, 500);
+    tca.onFill(order("B1", '1'), 100, 100.5);
+
+    auto summary = tca.summaryJson();
+    ASSERT_EQ(summary["buckets"].size(), 1u);
+    EXPECT_NEAR(summary["buckets"][0]["vwapCost"].get<double>(), 50.0, 1e-9);
+    EXPECT_NEAR(summary["buckets"][0]["vwapSlippageBps"].get<double>(), 50.0, 1e-9);
+}
+
+// Test: Terminal orders leave the live table, stay queryable while among the
+// most recent finished orders, and keep the interval VWAP of their lifetime
+TEST(TcaEngineRetireTest, RetiresTerminalOrders) {
+    TcaEngine tca(2);
+    OrderRecord record;
+    record.symbol = "AAPL";
+    record.side = '1';
+    record.quantity = 100;
+
+    tca.onArrival("F1", "AAPL", '1', 100.0);
+    tca.onMarketPrint("AAPL", 100.0, 100);
+    record.clOrdId = "F1";
+    tca.onFill(record, 40, 100.0);
+    EXPECT_EQ(tca.liveOrders(), 1u);
+    record.cumQty = 40;
+    tca.onFill(record, 60, 100.0);  // Completes the order
+    EXPECT_EQ(tca.liveOrders(), 0u);
+
+    tca.onMarketPrint("AAPL", 200.0, 100);  // After F1 finished
+    auto j = tca.orderJson("F1");
+    ASSERT_TRUE(j.has_value());
+    EXPECT_NEAR((*j)["intervalVwap"].get<double>(), 100.0, 1e-9);
+
+    tca.onArrival("C1", "AAPL", '1', 100.0);
+    tca.onArrival("C2", "AAPL", '1', 100.0);
+    tca.onTerminal("C1");
+    tca.onTerminal("C2");
+    EXPECT_EQ(tca.liveOrders(), 0u);
+    EXPECT_FALSE(tca.orderJson("F1").has_value());  // Evicted: capacity 2
+    EXPECT_TRUE(tca.orderJson("C1").has_value());
+    EXPECT_TRUE(tca.orderJson("C2").has_value());
+}
+
+// Test: Summary aggregates by symbol and side
+TEST_F(TcaEngineTest, SummaryBuckets) {
+    tca.onArrival("B1", "AAPL", '1', 100.0);
+    tca.onArrival("S1", "AAPL", '2', 100.0);
+    tca.onFill(order("B1", '1'), 10, 101.0);
+    tca.onFill(order("S1", '2'), 10, 101.0);
+
+    auto summary = tca.summaryJson();
+    ASSERT_EQ(summary["buckets"].size(), 2);
+    EXPECT_EQ(summary["buckets"][0]["side"], "1");
+    EXPECT_NEAR(summary["buckets"][0]["shortfallCost"].get<double>(), 10.0, 1e-9);
+    EXPECT_NEAR(summary["buckets"][1]["shortfallCost"].get<double>(), -10.0, 1e-9);
+    EXPECT_NEAR(summary["totalShortfallCost"].get<double>(), 0.0, 1e-9);
+}
+
+// Test: Unregistered orders use the persisted arrival price; renames are followed
+TEST_F(TcaEngineTest, RecoveredOrderAndRename) {
+    tca.onFill(order("REC1", '1', 50.0), 10, 51.0);
+    tca.rename("REC1", "REC1_AMD");
+
+    EXPECT_FALSE(tca.orderJson("REC1").has_value());
+    auto j = tca.orderJson("REC1_AMD");
+    ASSERT_TRUE(j.has_value());
+    EXPECT_DOUBLE_EQ((*j)["arrivalPx"].get<double>(), 50.0);
+}
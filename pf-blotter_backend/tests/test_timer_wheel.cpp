@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "qfblotter/OrderExpiry.hpp"
+#include "qfblotter/TimerWheel.hpp"
+
+using namespace qfblotter;
+
+class TimerWheelTest : public ::testing::Test {
+protected:
+    TimerWheel wheel{10, 0};  // 10ms ticks starting at t=0
+    std::vector<std::string> expired;
+};
+
+// Test: Timers fire at (not before) their deadline
+TEST_F(TimerWheelTest, FiresAtDeadline) {
+    wheel.schedule("A", 50);
+    wheel.schedule("B", 100);
+
+    EXPECT_EQ(wheel.advance(40, expired), 0);
+    EXPECT_EQ(wheel.advance(50, expired), 1);
+    EXPECT_EQ(expired.back(), "A");
+    EXPECT_EQ(wheel.advance(99, expired), 0);
+    EXPECT_EQ(wheel.advance(100, expired), 1);
+    EXPECT_EQ(expired.back(), "B");
+    EXPECT_EQ(wheel.size(), 0);
+}
+
+// Test: Cancelled timers never fire and stale ids are rejected
+TEST_F(TimerWheelTest, CancelIsFinal) {
+    auto id = wheel.schedule("A", 50);
+    EXPECT_TRUE(wheel.cancel(id));
+    EXPECT_FALSE(wheel.cancel(id));
+
+    auto reused = wheel.schedule("B", 60);  // Reuses the freed node
+    EXPECT_FALSE(wheel.cancel(id));
+    EXPECT_EQ(wheel.advance(100, expired), 1);
+    EXPECT_EQ(expired.back(), "B");
+    EXPECT_FALSE(wheel.cancel(reused));
+}
+
+// Test: Far deadlines cascade through higher levels and fire on time
+TEST_F(TimerWheelTest, CascadesAcrossLevels) {
+    const std::vector<int64_t> deadlines = {2'570, 655'370, 3'000'000, 167'772'170};
+    for (size_t i = 0; i < deadlines.size(); ++i) {
+        wheel.schedule("T" + std::to_string(i), deadlines[i]);
+    }
+
+    for (size_t i = 0; i < deadlines.size(); ++i) {
+        expired.clear();
+        wheel.advance(deadlines[i] - 10, expired);
+        EXPECT_TRUE(std::find(expired.begin(), expired.end(), "T" + std::to_string(i)) == expired.end());
+        wheel.advance(deadlines[i], expired);
+        EXPECT_TRUE(std::find(expired.begin(), expired.end(), "T" + std::to_string(i)) != expired.end())
+            << "deadline " << deadlines[i];
+    }
+}
+
+// Test: Thousands of timers due together come back as one batch
+TEST_F(TimerWheelTest, BatchExpiry) {
+    for (int i = 0; i < 5000; ++i) {
+        wheel.schedule("ORD" + std::to_string(i), 60'000);
+    }
+    EXPECT_EQ(wheel.size(), 5000);
+    EXPECT_EQ(wheel.advance(60'000, expired), 5000);
+    EXPECT_EQ(wheel.size(), 0);
+}
+
+// Test: Past deadlines fire on the next advance
+TEST_F(TimerWheelTest, PastDeadline) {
+    wheel.advance(1'000, expired);
+    wheel.schedule("LATE", 500);
+    EXPECT_EQ(wheel.advance(1'010, expired), 1);
+}
+
+// Test: Daily cutoff rolls to the next day once passed
+TEST(OrderExpiryTest, NextDailyCutoff) {
+    constexpr int64_t DAY_MS = 86'400'000;
+    const int64_t midnight = 20'000 * DAY_MS;
+    EXPECT_EQ(OrderExpiry::nextDailyCutoffMs("16:00:00", midnight + 1'000), midnight + 16 * 3'600'000);
+    EXPECT_EQ(OrderExpiry::nextDailyCutoffMs("16:00:00", midnight + 17 * 3'600'000),
+              midnight + DAY_MS + 16 * 3'600'000);
+}
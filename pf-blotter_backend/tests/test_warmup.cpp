@@ -0,0 +1,37 @@
+#include <gtest/gtest.h>
+#include "qfblotter/Warmup.hpp"
+
+using namespace qfblotter;
+
+TEST(WarmupTest, RunsSyntheticOrdersThroughShadowPipeline) {
+    WarmupOptions options;
+    options.symbols = {"AAPL", "MSFT", "NVDA"};
+    options.syntheticOrders = 600;
+
+    const auto report = runWarmup(options);
+    EXPECT_EQ(report.syntheticOrders, 600u);
+    EXPECT_GT(report.fills, 0u);
+    EXPECT_LE(report.fills, 600u);
+    EXPECT_EQ(report.prefaultedBytes, 0u);
+    EXPECT_FALSE(report.memoryLocked);
+    EXPECT_GE(report.elapsedMs, 0.0);
+}
+
+TEST(WarmupTest, PrefaultsRequestedHeap) {
+    WarmupOptions options;
+    options.syntheticOrders = 0;
+    options.prefaultBytes = 20 * 1024 * 1024;  // Spans more than one chunk
+
+    const auto report = runWarmup(options);
+    EXPECT_EQ(report.prefaultedBytes, options.prefaultBytes);
+    EXPECT_EQ(report.syntheticOrders, 0u);
+}
+
+TEST(WarmupTest, NoSymbolsSkipsSyntheticOrders) {
+    WarmupOptions options;
+    options.syntheticOrders = 100;
+
+    const auto report = runWarmup(options);
+    EXPECT_EQ(report.syntheticOrders, 0u);
+    EXPECT_EQ(report.fills, 0u);
+}